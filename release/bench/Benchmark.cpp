@@ -0,0 +1,84 @@
+/*
+ * File:   Benchmark.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Benchmark.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+void Benchmark::Print(std::ostream& os, const BenchmarkResult& result) {
+  os << std::left << std::setw(40) << result.name
+     << std::right << std::setw(12) << result.iterations << " iterations"
+     << std::fixed << std::setprecision(1) << std::setw(12) << result.ns_per_op
+     << " ns/op" << std::setprecision(2) << std::setw(10) << result.allocs_per_op
+     << " allocs/op" << std::endl;
+}
+
+void Benchmark::WriteBaseline(std::ostream& os, const std::vector<BenchmarkResult>& results) {
+  os << "# name\tns/op\tallocs/op" << std::endl;
+  for (auto& result : results) {
+    os << result.name << '\t' << std::fixed << std::setprecision(1) << result.ns_per_op
+       << '\t' << std::setprecision(2) << result.allocs_per_op << std::endl;
+  }
+}
+
+baseline_t Benchmark::ReadBaseline(std::istream& is) {
+  baseline_t baseline;
+  std::string line;
+  while (std::getline(is, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::istringstream fields(line);
+    BenchmarkResult result;
+    std::string ns_per_op;
+    std::string allocs_per_op;
+    if (std::getline(fields, result.name, '\t') && std::getline(fields, ns_per_op, '\t') &&
+        std::getline(fields, allocs_per_op, '\t')) {
+      result.iterations = 0;
+      result.ns_per_op = std::stod(ns_per_op);
+      result.allocs_per_op = std::stod(allocs_per_op);
+      baseline[result.name] = result;
+    }
+  }
+  return baseline;
+}
+
+size_t Benchmark::Compare(std::ostream& os, const std::vector<BenchmarkResult>& results,
+    const baseline_t& baseline, const double& threshold)
+{
+  size_t regressions = 0;
+  for (auto& result : results) {
+    os << std::left << std::setw(40) << result.name << std::right;
+
+    baseline_t::const_iterator found = baseline.find(result.name);
+    if (found == baseline.end()) {
+      os << "  not in baseline" << std::endl;
+      continue;
+    }
+
+    const BenchmarkResult& base = found->second;
+    double time_change = base.ns_per_op > 0.0 ? result.ns_per_op / base.ns_per_op - 1.0 : 0.0;
+    // Allocation counts are exact, so compare them with a little slack for
+    // the operations that allocate less than once per call.
+    bool time_regressed = time_change > threshold;
+    bool allocs_regressed = result.allocs_per_op > base.allocs_per_op * (1.0 + threshold) + 0.01;
+
+    os << std::fixed << std::setprecision(1) << std::setw(12) << base.ns_per_op << " -> "
+       << std::setw(10) << result.ns_per_op << " ns/op (" << std::showpos
+       << time_change * 100.0 << std::noshowpos << "%)" << std::setprecision(2)
+       << std::setw(8) << base.allocs_per_op << " -> " << std::setw(6)
+       << result.allocs_per_op << " allocs/op";
+
+    if (time_regressed || allocs_regressed) {
+      os << "  REGRESSION";
+      regressions++;
+    }
+    os << std::endl;
+  }
+  return regressions;
+}
@@ -0,0 +1,127 @@
+/*
+ * File:   Benchmark.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef BENCHMARK_HPP
+#define	BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.hpp"
+
+///
+/// The outcome of one benchmark run.
+///
+struct BenchmarkResult {
+    std::string name;       /*!< What was measured */
+    uint64_t    iterations; /*!< How many times the operation ran */
+    double      ns_per_op;  /*!< Wall clock nanoseconds per operation */
+    double      allocs_per_op; /*!< Heap allocations per operation */
+};
+
+///
+/// Recorded results to compare a run against, keyed by name.
+///
+typedef std::map<std::string, BenchmarkResult> baseline_t;
+
+///
+/// Minimal timing harness for the microbenchmarks.  Runs an operation a
+/// fixed number of times after a short warm up, split into rounds, and
+/// reports the mean cost of the fastest round (the least disturbed by
+/// everything else on the machine) and the mean number of heap allocations.
+/// Executables that use it must link AllocationCounter.cpp.
+///
+class Benchmark {
+public:
+    ///
+    /// Times an operation.
+    ///
+    /// \param name The name to report
+    /// \param iterations How many times to run the operation
+    /// \param op The operation; called with the iteration number
+    /// \return The result
+    ///
+    template<typename F>
+    static BenchmarkResult Run(const std::string& name, const uint64_t& iterations, F op) {
+        const uint64_t rounds = 5;
+        for (uint64_t i = 0; i < iterations / 10 + 1; i++) {
+            op(i);
+        }
+
+        uint64_t per_round = iterations < rounds ? 1 : iterations / rounds;
+        double fastest = 0.0;
+        uint64_t allocations = AllocationCounter::Allocations();
+        for (uint64_t round = 0; round < rounds; round++) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (uint64_t i = round * per_round; i < (round + 1) * per_round; i++) {
+                op(i);
+            }
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+            double ns_per_op = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                end - start).count() / (double)per_round;
+            if (round == 0 || ns_per_op < fastest) {
+                fastest = ns_per_op;
+            }
+        }
+        allocations = AllocationCounter::Allocations() - allocations;
+
+        BenchmarkResult result;
+        result.name = name;
+        result.iterations = per_round * rounds;
+        result.ns_per_op = fastest;
+        result.allocs_per_op = (double)allocations / (double)result.iterations;
+        return result;
+    }
+
+    ///
+    /// Writes a result as a single aligned line.
+    ///
+    /// \param os The stream to write to
+    /// \param result The result
+    ///
+    static void Print(std::ostream& os, const BenchmarkResult& result);
+
+    ///
+    /// Writes results in the baseline format, one tab separated
+    /// "name, ns/op, allocs/op" line per result.
+    ///
+    /// \param os The stream to write to
+    /// \param results The results
+    ///
+    static void WriteBaseline(std::ostream& os, const std::vector<BenchmarkResult>& results);
+
+    ///
+    /// Reads a file written by WriteBaseline.  Blank lines and lines
+    /// starting with '#' are skipped.
+    ///
+    /// \param is The stream to read from
+    /// \return The baseline
+    ///
+    static baseline_t ReadBaseline(std::istream& is);
+
+    ///
+    /// Compares results against a baseline and reports each one.  A result
+    /// regresses if its ns/op or allocs/op exceeds the baseline's by more
+    /// than the threshold.  Results missing from the baseline are reported
+    /// but do not count as regressions.
+    ///
+    /// \param os The stream to write the report to
+    /// \param results The results
+    /// \param baseline The baseline
+    /// \param threshold The allowed increase (0.10 for 10%)
+    /// \return The number of regressions
+    ///
+    static size_t Compare(std::ostream& os, const std::vector<BenchmarkResult>& results,
+                          const baseline_t& baseline, const double& threshold = 0.10);
+};
+
+#endif	/* BENCHMARK_HPP */
@@ -0,0 +1,252 @@
+/*
+ * File:   MicroBench.cpp
+ *
+ * Created on October 19, 2026
+ *
+ * Microbenchmarks for the per-request hot paths.
+ *
+ *     mlcppmicrobench                         run and print the results
+ *     mlcppmicrobench --write-baseline=FILE   also record them as a baseline
+ *     mlcppmicrobench --compare=FILE          compare against a baseline and
+ *                                             exit 1 on a regression over 10%
+ *
+ * bench/baseline.tsv is the checked in baseline.  Timings only compare
+ * meaningfully on the machine that recorded them, so regenerate it with
+ * --write-baseline on the reference machine after an intended change.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "AuthorizationBuilder.hpp"
+#include "Credentials.hpp"
+#include "JsonView.hpp"
+#include "LatencyHistogram.hpp"
+#include "LatencyRegistry.hpp"
+#include "Logger.hpp"
+#include "MLCrypto.hpp"
+#include "Response.hpp"
+
+const uint64_t ITERATIONS = 10000000;
+
+// What a MarkLogic 7 server sends back with a 401 and a 200.
+const std::string CHALLENGE = "Digest realm=\"public\", qop=\"auth\", "
+    "nonce=\"4d8c3f1e2b7a9d6c0e5f8a1b3c7d9e2f\", opaque=\"a9f3c1d7e5b2f4a6\"";
+const std::string CONTENT_TYPE = "application/json; charset=UTF-8";
+
+///
+/// Reaches the protected and private parts of Credentials and Response that
+/// run on every request.
+///
+class HotPathBench {
+public:
+    static void Run(std::vector<BenchmarkResult>& results);
+};
+
+void HotPathBench::Run(std::vector<BenchmarkResult>& results) {
+  const uint64_t iterations = ITERATIONS / 20;
+  const std::string path = "/v1/documents?uri=/document/test.json";
+
+  MLCrypto crypto;
+  const std::string ha1_input = "admin:public:admin";
+  results.push_back(Benchmark::Run("MLCrypto::Md5", iterations,
+      [&crypto, &ha1_input](uint64_t i) {
+    crypto.Md5(ha1_input);
+  }));
+
+  uint8_t digest[16];
+  for (uint8_t i = 0; i < 16; i++) {
+    digest[i] = (uint8_t)(i * 17 + 3);
+  }
+  results.push_back(Benchmark::Run("MLCrypto::ToHex (16 bytes)", iterations,
+      [&crypto, &digest](uint64_t i) {
+    crypto.ToHex(digest, sizeof(digest));
+  }));
+
+  AuthorizationBuilder builder;
+  const std::string nonce = "4d8c3f1e2b7a9d6c0e5f8a1b3c7d9e2f";
+  const std::string cnonce = "0a4f113b9e7c2d5f";
+  results.push_back(Benchmark::Run("AuthorizationBuilder HA1+HA2+response", iterations,
+      [&builder, &nonce, &cnonce, &path](uint64_t i) {
+    std::string ha1 = builder.UsernameRealmAndPassword("admin", "public", "admin");
+    std::string ha2 = builder.MethodAndURL("GET", path);
+    builder.Response(ha1, nonce, "00000001", cnonce, "auth", ha2);
+  }));
+
+  Credentials credentials("admin", "admin", cnonce, 0);
+  results.push_back(Benchmark::Run("Credentials::ParseWWWAthenticateHeader", iterations,
+      [&credentials](uint64_t i) {
+    credentials.ParseWWWAthenticateHeader(CHALLENGE);
+  }));
+
+  results.push_back(Benchmark::Run("Credentials::Authenticate", iterations,
+      [&credentials, &path](uint64_t i) {
+    credentials.Authenticate("GET", path);
+  }));
+
+  results.push_back(Benchmark::Run("Credentials::Authenticate (challenge)", iterations,
+      [&credentials, &path](uint64_t i) {
+    credentials.Authenticate("GET", path, CHALLENGE);
+  }));
+
+  Response response;
+  results.push_back(Benchmark::Run("Response::ParseContentTypeHeader", iterations,
+      [&response](uint64_t i) {
+    response.ParseContentTypeHeader(CONTENT_TYPE);
+  }));
+
+  web::http::http_headers headers;
+  headers["Content-type"] = CONTENT_TYPE;
+  headers["Content-Length"] = "1024";
+  headers["Server"] = "MarkLogic";
+  headers["Connection"] = "Keep-Alive";
+  headers["Keep-Alive"] = "timeout=5";
+  headers["ETag"] = "\"14063455472381110\"";
+  headers["vnd.marklogic.document-format"] = "json";
+  results.push_back(Benchmark::Run("Response::SetResponseHeaders", iterations,
+      [&response, &headers](uint64_t i) {
+    response.SetResponseHeaders(headers);
+  }));
+}
+
+static void BenchHistogram(std::vector<BenchmarkResult>& results) {
+  LatencyHistogram histogram;
+  std::vector<uint64_t> samples;
+  for (uint64_t i = 0; i < 1024; i++) {
+    samples.push_back(50000 + i * 977);
+  }
+
+  results.push_back(Benchmark::Run("LatencyHistogram::Record", ITERATIONS,
+      [&histogram, &samples](uint64_t i) {
+    histogram.Record(samples[i & 1023]);
+  }));
+
+  const std::string method = "GET";
+  const std::string path = "/v1/documents?uri=/document/test.json";
+  LatencyRegistry* registry = LatencyRegistry::Instance();
+  results.push_back(Benchmark::Run("LatencyRegistry::Histogram", ITERATIONS / 10,
+      [registry, &method, &path](uint64_t i) {
+    registry->Histogram(method, path);
+  }));
+
+  results.push_back(Benchmark::Run("LatencyTimer (lookup + record)", ITERATIONS / 10,
+      [&method, &path](uint64_t i) {
+    LatencyTimer timer(method, path);
+  }));
+
+  const unsigned threads = 4;
+  std::vector<BenchmarkResult> per_thread(threads);
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; t++) {
+    workers.push_back(std::thread([&histogram, &samples, &per_thread, t]() {
+      per_thread[t] = Benchmark::Run("LatencyHistogram::Record (4 threads)", ITERATIONS,
+          [&histogram, &samples](uint64_t i) {
+        histogram.Record(samples[i & 1023]);
+      });
+    }));
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  // One line for the lot, so the baseline has a single entry to compare.
+  BenchmarkResult combined = per_thread[0];
+  combined.ns_per_op = 0.0;
+  for (auto& result : per_thread) {
+    combined.ns_per_op += result.ns_per_op / threads;
+  }
+  results.push_back(combined);
+}
+
+static void BenchLogger(std::vector<BenchmarkResult>& results) {
+  const std::string path = "/v1/documents?uri=/document/test.json";
+  Logger::Instance()->SetLevel(LogLevel::WARNING);
+
+  results.push_back(Benchmark::Run("MLLOG (filtered out)", ITERATIONS,
+      [&path](uint64_t i) {
+    MLLOG(LogLevel::FINE).Message("Could not read the response body")
+        .Field("method", "GET").Field("path", path);
+  }));
+}
+
+static void BenchJson(std::vector<BenchmarkResult>& results) {
+  // A page of search results, about 150 KB.
+  std::string page = "{\"total\":1000,\"start\":1,\"page-length\":1000,\"results\":[";
+  for (int i = 0; i < 1000; i++) {
+    page += std::string(i > 0 ? "," : "") + "{\"index\":" + std::to_string(i + 1) +
+        ",\"uri\":\"/documents/" + std::to_string(i) + ".json\",\"path\":\"fn:doc(\\\"/documents/" +
+        std::to_string(i) + ".json\\\")\",\"score\":" + std::to_string(i * 7) +
+        ",\"confidence\":0.58,\"fitness\":0.72,\"format\":\"json\",\"mimetype\":"
+        "\"application/json\"}";
+  }
+  page += "]}";
+
+  // Keeps the compiler from dropping the parse as dead code.
+  volatile uint64_t sink = 0;
+
+  results.push_back(Benchmark::Run("JsonDocument (search page)", ITERATIONS / 10000,
+      [&page, &sink](uint64_t i) {
+    JsonDocument document(page.data(), page.size());
+    sink = sink + document.Root()["total"].Unsigned();
+  }));
+
+  results.push_back(Benchmark::Run("web::json::value::parse (search page)", ITERATIONS / 10000,
+      [&page, &sink](uint64_t i) {
+    sink = sink + web::json::value::parse(page)[U("total")].as_integer();
+  }));
+}
+
+int main(int argc, const char * argv[])
+{
+    std::string write_baseline;
+    std::string compare;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 17, "--write-baseline=") == 0) {
+            write_baseline = arg.substr(17);
+        } else if (arg.compare(0, 10, "--compare=") == 0) {
+            compare = arg.substr(10);
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--write-baseline=FILE] [--compare=FILE]" << std::endl;
+            return 2;
+        }
+    }
+
+    baseline_t baseline;
+    if (!compare.empty()) {
+        std::ifstream in(compare);
+        if (!in) {
+            std::cerr << "Cannot read " << compare << std::endl;
+            return 2;
+        }
+        baseline = Benchmark::ReadBaseline(in);
+    }
+
+    std::vector<BenchmarkResult> results;
+    HotPathBench::Run(results);
+    BenchHistogram(results);
+    BenchLogger(results);
+    BenchJson(results);
+
+    for (auto& result : results) {
+        Benchmark::Print(std::cout, result);
+    }
+
+    if (!write_baseline.empty()) {
+        std::ofstream out(write_baseline);
+        Benchmark::WriteBaseline(out, results);
+    }
+
+    if (!compare.empty()) {
+        std::cout << std::endl << "Compared with " << compare << std::endl;
+        size_t regressions = Benchmark::Compare(std::cout, results, baseline);
+        std::cout << regressions << " regression(s)" << std::endl;
+        return regressions == 0 ? 0 : 1;
+    }
+    return 0;
+}
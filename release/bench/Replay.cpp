@@ -0,0 +1,213 @@
+/*
+ * File:   Replay.cpp
+ *
+ * Created on October 19, 2026
+ *
+ * Replays a log written by TrafficRecorder through AuthenticatingProxy
+ * against an in-process StubServer, so library changes can be measured
+ * against a real access pattern.
+ *
+ *     mlcppreplay --log=FILE [--speed=original|max|FACTOR]
+ *                 [--concurrency=8] [--address=http://127.0.0.1:8399]
+ *                 [--latency-us=0] [--payload-bytes=1024]
+ *
+ * At original speed each request is issued at its recorded offset; a FACTOR
+ * of 2 issues them twice as fast; max issues them as fast as the workers
+ * can.  Documents the log reads or deletes are seeded into the stub first.
+ * Bodies recorded in full are sent as they were; otherwise a generated
+ * document of the recorded length is sent.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cpprest/json.h>
+
+#include "AuthenticatingProxy.hpp"
+#include "Credentials.hpp"
+#include "LatencyHistogram.hpp"
+#include "StubServer.hpp"
+#include "TrafficRecorder.hpp"
+
+struct ReplayOptions {
+    StubServerConfig server;
+    std::string log;
+    double speed;           /*!< Playback speed factor, 0 for as fast as possible */
+    unsigned concurrency;
+
+    ReplayOptions() : speed(1.0), concurrency(8) {
+
+    }
+};
+
+static bool ParseOptions(int argc, const char* argv[], ReplayOptions& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    size_t equals = arg.find('=');
+    std::string key = arg.substr(0, equals);
+    std::string value = equals == std::string::npos ? "" : arg.substr(equals + 1);
+
+    if (key == "--log") {
+      options.log = value;
+    } else if (key == "--speed") {
+      if (value == "original") {
+        options.speed = 1.0;
+      } else if (value == "max") {
+        options.speed = 0.0;
+      } else {
+        options.speed = std::stod(value);
+      }
+    } else if (key == "--concurrency") {
+      options.concurrency = (unsigned)std::stoul(value);
+    } else if (key == "--address") {
+      options.server.address = value;
+    } else if (key == "--latency-us") {
+      options.server.latency_us = (uint32_t)std::stoul(value);
+    } else if (key == "--payload-bytes") {
+      options.server.document_bytes = (size_t)std::stoul(value);
+    } else {
+      std::cerr << "Unknown option " << arg << std::endl;
+      return false;
+    }
+  }
+  return !options.log.empty() && options.concurrency > 0 && options.speed >= 0.0;
+}
+
+///
+/// Returns the decoded uri parameter of a /v1/documents path, or an empty
+/// string.
+///
+static std::string DocumentUri(const std::string& path) {
+  if (path.compare(0, 13, "/v1/documents") != 0) {
+    return "";
+  }
+
+  size_t start = path.find("uri=");
+  if (start == std::string::npos || (start > 0 && path[start - 1] != '?' && path[start - 1] != '&')) {
+    return "";
+  }
+  start += 4;
+  size_t end = path.find('&', start);
+  return web::uri::decode(path.substr(start, end == std::string::npos ? std::string::npos : end - start));
+}
+
+static web::json::value ReplayBody(const TrafficRecord& record) {
+  if (record.body_kind == TrafficBodies::FULL) {
+    try {
+      return web::json::value::parse(record.body);
+    } catch (const std::exception& e) {
+      // Not JSON; fall through to a generated document of the same size.
+    }
+  }
+  return web::json::value::parse(StubServer::MakeDocument((size_t)record.body_length));
+}
+
+static ResponseCodes Issue(AuthenticatingProxy& proxy, const std::string& host,
+    const TrafficRecord& record)
+{
+  Response response;
+  if (record.method == "GET") {
+    response = proxy.Get(host, record.path, record.headers);
+  } else if (record.method == "DELETE") {
+    response = proxy.Delete(host, record.path, record.headers);
+  } else if (record.method == "PUT") {
+    response = proxy.Put(host, record.path, ReplayBody(record), record.headers);
+  } else if (record.method == "POST") {
+    response = proxy.Post(host, record.path, ReplayBody(record), record.headers);
+  }
+  return response.GetResponseCode();
+}
+
+int main(int argc, const char * argv[])
+{
+    ReplayOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " --log=FILE [--speed=original|max|FACTOR]"
+                  << " [--concurrency=N] [--address=URL] [--latency-us=N]"
+                  << " [--payload-bytes=N]" << std::endl;
+        return 2;
+    }
+
+    std::vector<TrafficRecord> records;
+    try {
+        TrafficReader reader(options.log);
+        TrafficRecord record;
+        while (reader.Next(record)) {
+            records.push_back(record);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    StubServer server(options.server);
+    std::string document = StubServer::MakeDocument(options.server.document_bytes);
+    for (auto& record : records) {
+        std::string uri = DocumentUri(record.path);
+        if (!uri.empty() && (record.method == "GET" || record.method == "DELETE")) {
+            server.Store(uri, document);
+        }
+    }
+    server.Start();
+
+    LatencyHistogram latencies;
+    LatencyHistogram lag;
+    std::atomic<size_t> next(0);
+    std::atomic<uint64_t> mismatches(0);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < options.concurrency; t++) {
+        workers.push_back(std::thread([&]() {
+            AuthenticatingProxy proxy;
+            proxy.AddCredentials(Credentials(options.server.username, options.server.password));
+
+            for (size_t i = next.fetch_add(1); i < records.size(); i = next.fetch_add(1)) {
+                const TrafficRecord& record = records[i];
+                if (options.speed > 0.0) {
+                    std::chrono::steady_clock::time_point due = start +
+                        std::chrono::nanoseconds((uint64_t)((double)record.offset_ns / options.speed));
+                    std::this_thread::sleep_until(due);
+                    lag.Record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - due).count());
+                }
+
+                std::chrono::steady_clock::time_point issued = std::chrono::steady_clock::now();
+                ResponseCodes code = Issue(proxy, options.server.address, record);
+                latencies.Record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - issued).count());
+                if ((uint16_t)code != record.status) {
+                    mismatches.fetch_add(1);
+                }
+            }
+        }));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    server.Stop();
+
+    LatencySnapshot snapshot = latencies.Snapshot();
+    std::cout << std::fixed << std::setprecision(1)
+              << records.size() << " requests from " << options.log << " in " << seconds
+              << " s, " << (double)records.size() / seconds << " req/s" << std::endl
+              << "latency us: p50 " << snapshot.Percentile(50.0) / 1000.0
+              << "  p99 " << snapshot.Percentile(99.0) / 1000.0
+              << "  p99.9 " << snapshot.Percentile(99.9) / 1000.0
+              << "  max " << snapshot.Max() / 1000.0 << std::endl;
+    if (options.speed > 0.0) {
+        LatencySnapshot late = lag.Snapshot();
+        std::cout << "schedule lag us: p99 " << late.Percentile(99.0) / 1000.0
+                  << "  max " << late.Max() / 1000.0 << std::endl;
+    }
+    std::cout << mismatches.load() << " responses with a different status than recorded"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,277 @@
+/*
+ * File:   ThroughputBench.cpp
+ *
+ * Created on October 19, 2026
+ *
+ * End to end throughput benchmark.  Starts a StubServer on loopback and
+ * drives it through AuthenticatingProxy at increasing concurrency, reporting
+ * requests per second, latency percentiles, CPU time per request and heap
+ * allocations per request.
+ *
+ *     mlcppbench [--address=http://127.0.0.1:8399] [--concurrency=1,2,4,8,16]
+ *                [--requests=2000] [--latency-us=0] [--payload-bytes=1024]
+ *                [--documents=1000] [--writes=5000]
+ *
+ * The CPU and allocation figures are for the whole process, so they include
+ * the stub server's share of each request.  Afterwards the same number of
+ * small documents is written at the highest concurrency, once with a PUT
+ * each and once through a BatchWriter, to compare the two.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cpprest/json.h>
+
+#include "AllocationCounter.hpp"
+#include "AuthenticatingProxy.hpp"
+#include "BatchWriter.hpp"
+#include "Credentials.hpp"
+#include "LatencyHistogram.hpp"
+#include "StubServer.hpp"
+
+struct BenchOptions {
+    StubServerConfig server;
+    std::vector<unsigned> concurrency;
+    uint64_t requests;      /*!< Requests per concurrency level */
+    size_t documents;       /*!< Documents seeded before the first level */
+    uint64_t writes;        /*!< Small documents written by each write method */
+
+    BenchOptions() : requests(2000), documents(1000), writes(5000) {
+        concurrency.push_back(1);
+        concurrency.push_back(2);
+        concurrency.push_back(4);
+        concurrency.push_back(8);
+        concurrency.push_back(16);
+    }
+};
+
+static bool ParseOptions(int argc, const char* argv[], BenchOptions& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    size_t equals = arg.find('=');
+    std::string key = arg.substr(0, equals);
+    std::string value = equals == std::string::npos ? "" : arg.substr(equals + 1);
+
+    if (key == "--address") {
+      options.server.address = value;
+    } else if (key == "--concurrency") {
+      options.concurrency.clear();
+      std::istringstream levels(value);
+      std::string level;
+      while (std::getline(levels, level, ',')) {
+        options.concurrency.push_back((unsigned)std::stoul(level));
+      }
+    } else if (key == "--requests") {
+      options.requests = std::stoull(value);
+    } else if (key == "--latency-us") {
+      options.server.latency_us = (uint32_t)std::stoul(value);
+    } else if (key == "--payload-bytes") {
+      options.server.document_bytes = (size_t)std::stoul(value);
+    } else if (key == "--documents") {
+      options.documents = (size_t)std::stoul(value);
+    } else if (key == "--writes") {
+      options.writes = std::stoull(value);
+    } else {
+      std::cerr << "Unknown option " << arg << std::endl;
+      return false;
+    }
+  }
+  return !options.concurrency.empty() && options.requests > 0 && options.documents > 0;
+}
+
+///
+/// One request from the mix: half reads, the rest split between writes,
+/// deletes and searches, roughly what a document-centric application does.
+///
+static bool Issue(AuthenticatingProxy& proxy, const BenchOptions& options,
+    const web::json::value& document, const web::json::value& query,
+    const unsigned& worker, const uint64_t& i)
+{
+  const std::string& host = options.server.address;
+  const std::string scratch = "/v1/documents?uri=/bench/" + std::to_string(worker) +
+      "/" + std::to_string(i / 10) + ".json";
+  Response response;
+
+  switch (i % 10) {
+    case 5:
+      response = proxy.Put(host, scratch, document);
+      break;
+    case 6:
+      response = proxy.Post(host, "/v1/documents?directory=/bench/posted/&extension=json",
+          document);
+      break;
+    case 7:
+      response = proxy.Delete(host, scratch);
+      break;
+    case 8:
+      response = proxy.Get(host, "/v1/search?format=json&pageLength=10&start=" +
+          std::to_string(i % options.documents + 1));
+      break;
+    case 9:
+      response = proxy.Post(host, "/v1/search?format=json&pageLength=10", query);
+      break;
+    default:
+      response = proxy.Get(host, "/v1/documents?uri=/bench/" +
+          std::to_string((i * 7919 + worker) % options.documents) + ".json");
+      break;
+  }
+
+  return (int)response.GetResponseCode() >= 200 && (int)response.GetResponseCode() < 300;
+}
+
+static void RunLevel(const BenchOptions& options, const unsigned& threads) {
+  web::json::value document = web::json::value::parse(
+      StubServer::MakeDocument(options.server.document_bytes));
+  web::json::value query = web::json::value::parse(
+      "{\"query\":{\"queries\":[{\"term-query\":{\"text\":[\"bench\"]}}]}}");
+
+  LatencyHistogram latencies;
+  std::atomic<uint64_t> failures(0);
+  uint64_t per_thread = options.requests / threads + (options.requests % threads ? 1 : 0);
+
+  uint64_t allocations = AllocationCounter::Allocations();
+  std::clock_t cpu = std::clock();
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; t++) {
+    workers.push_back(std::thread([&, t]() {
+      // The proxy's credentials track the nonce count, so each thread gets
+      // its own proxy.
+      AuthenticatingProxy proxy;
+      proxy.AddCredentials(Credentials(options.server.username, options.server.password));
+
+      for (uint64_t i = 0; i < per_thread; i++) {
+        std::chrono::steady_clock::time_point issued = std::chrono::steady_clock::now();
+        if (!Issue(proxy, options, document, query, t, i)) {
+          failures.fetch_add(1);
+        }
+        latencies.Record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - issued).count());
+      }
+    }));
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double cpu_seconds = (double)(std::clock() - cpu) / CLOCKS_PER_SEC;
+  allocations = AllocationCounter::Allocations() - allocations;
+
+  LatencySnapshot snapshot = latencies.Snapshot();
+  double requests = (double)snapshot.Count();
+  std::cout << std::fixed << std::setprecision(1)
+            << std::setw(8) << threads
+            << std::setw(10) << snapshot.Count()
+            << std::setw(12) << requests / seconds
+            << std::setw(10) << snapshot.Percentile(50.0) / 1000.0
+            << std::setw(10) << snapshot.Percentile(99.0) / 1000.0
+            << std::setw(10) << snapshot.Percentile(99.9) / 1000.0
+            << std::setw(10) << snapshot.Max() / 1000.0
+            << std::setw(12) << cpu_seconds * 1000000.0 / requests
+            << std::setw(12) << (double)allocations / requests
+            << std::setw(8) << failures.load() << std::endl;
+}
+
+///
+/// Writes options.writes small documents from the given number of threads,
+/// either with a PUT each or through one shared BatchWriter, and reports
+/// documents per second.
+///
+static void RunWrites(const BenchOptions& options, const unsigned& threads, const bool& batched) {
+  const std::string& host = options.server.address;
+  Credentials credentials(options.server.username, options.server.password);
+  web::json::value document = web::json::value::parse("{\"status\":\"open\",\"total\":12.5}");
+  std::string text = document.serialize();
+  uint64_t per_thread = options.writes / threads + (options.writes % threads ? 1 : 0);
+  std::atomic<uint64_t> failures(0);
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  {
+    std::unique_ptr<BatchWriter> writer(batched ? new BatchWriter(host, credentials) : nullptr);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+      workers.push_back(std::thread([&, t]() {
+        AuthenticatingProxy proxy;
+        proxy.AddCredentials(credentials.Fork());
+        std::vector<std::future<WriteResult> > pending;
+        for (uint64_t i = 0; i < per_thread; i++) {
+          std::string uri = "/bench/small/" + std::to_string(t) + "/" + std::to_string(i) +
+              ".json";
+          if (batched) {
+            pending.push_back(writer->Write(uri, text));
+          } else if ((int)proxy.Put(host, "/v1/documents?uri=" + uri, document)
+              .GetResponseCode() >= 300) {
+            failures.fetch_add(1);
+          }
+        }
+        for (auto& done : pending) {
+          if (!done.get().written) {
+            failures.fetch_add(1);
+          }
+        }
+      }));
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << std::fixed << std::setprecision(1)
+            << std::setw(12) << (batched ? "batched" : "put")
+            << std::setw(8) << threads
+            << std::setw(10) << per_thread * threads
+            << std::setw(12) << (double)(per_thread * threads) / seconds
+            << std::setw(8) << failures.load() << std::endl;
+}
+
+int main(int argc, const char * argv[])
+{
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    StubServer server(options.server);
+    server.Seed(options.documents);
+    server.Start();
+
+    std::cout << "stub server " << server.Address() << ", " << options.documents
+              << " documents of " << options.server.document_bytes << " bytes, "
+              << options.server.latency_us << " us added latency" << std::endl
+              << "latencies in us; cpu and allocations are per request for the whole"
+              << " process, stub server included" << std::endl
+              << std::setw(8) << "threads" << std::setw(10) << "requests"
+              << std::setw(12) << "req/s" << std::setw(10) << "p50"
+              << std::setw(10) << "p99" << std::setw(10) << "p99.9"
+              << std::setw(10) << "max" << std::setw(12) << "cpu us"
+              << std::setw(12) << "allocs" << std::setw(8) << "errors" << std::endl;
+
+    for (auto threads : options.concurrency) {
+        RunLevel(options, threads);
+    }
+
+    std::cout << std::setw(12) << "writes" << std::setw(8) << "threads"
+              << std::setw(10) << "documents" << std::setw(12) << "docs/s"
+              << std::setw(8) << "errors" << std::endl;
+    RunWrites(options, options.concurrency.back(), false);
+    RunWrites(options, options.concurrency.back(), true);
+
+    std::cout << server.Requests() << " requests served, " << server.Challenges()
+              << " digest challenges" << std::endl;
+    server.Stop();
+    return 0;
+}
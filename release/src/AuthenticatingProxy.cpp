@@ -16,121 +16,45 @@
 #include <cpprest/json.h>
 #include "ResponseCodes.hpp"
 
-const std::string AUTHORIZATION_HEADER_NAME = "Authorization";
-const std::string WWW_AUTHENTICATE_HEADER = "WWW-Authenticate";
-
 const std::string DEFAULT_KEY = "__DEFAULT";
 
 using namespace web;
 using namespace utility;
 
-AuthenticatingProxy::AuthenticatingProxy() : _attempts(0)
+AuthenticatingProxy::AuthenticatingProxy()
 {
 
 }
 
+AuthenticatingProxy::AuthenticatingProxy(const ProxyOptions& options) :
+    _pipeline(StageFunctions(options.stages), options.retry, options.cache, TimingStage(),
+        RecordStage(), DigestAuthStage())
+{
+    _pipeline.Get<HttpTransport>() = HttpTransport(options.connections);
+}
+
 
 void AuthenticatingProxy::AddCredentials(const Credentials &c) 
 {
-    _credentials = c;
+    _pipeline.Get<DigestAuthStage>().SetCredentials(c);
 }
 
 Credentials AuthenticatingProxy::GetCredentials() const {
-    return _credentials;
+    return _pipeline.Get<DigestAuthStage>().GetCredentials();
+}
+
+AuthenticatingProxy AuthenticatingProxy::Dedicated() const {
+    AuthenticatingProxy dedicated(*this);
+    dedicated._pipeline.Get<HttpTransport>() = HttpTransport(ConnectionPool());
+    dedicated.AddCredentials(GetCredentials().Fork());
+    return dedicated;
 }
 
 Response AuthenticatingProxy::Get(const std::string& host,
                                   const std::string& path,
                                   const header_t& headers)
 {
-  Response response;
-  header_t request_headers = headers;  
-  http::client::http_client raw_client(U(host));
-
-  try {
-    http::http_request req(http::methods::GET);
-    req.set_request_uri(path);
-    
-    if (_credentials.Authenticating()) {
-      req.headers().add(AUTHORIZATION_HEADER_NAME, _credentials.Authenticate("GET", path));
-    }
-    
-    header_t::const_iterator iter;
-    for (iter = headers.begin(); iter != headers.end(); iter++) {
-      if (req.headers().has(iter->first)) {
-        req.headers().remove(iter->first);
-      }
-      req.headers().add(iter->first, iter->second);
-    }
-    
-    raw_client.request(req).then([&response](http::http_response raw_response) {      
-      raw_response.extract_json().then([&response](pplx::task<web::json::value> previousTask)
-      {
-        try
-        {
-          response.SetJson(previousTask.get());
-        }
-        catch (const web::http::http_exception& e)
-        {
-          // Print error.
-          std::wostringstream ss;
-          ss << "There was an error on the first request!!!" << e.what() << std::endl;
-          std::wcout << ss.str();
-        }
-        
-      }).wait();
-      
-      response.SetResponseCode((ResponseCodes)raw_response.status_code());
-      response.SetResponseHeaders(raw_response.headers());
-    }).wait();
-  } catch(std::exception e) {
-    std::cerr << e.what() << std::endl;
-  }
-
-  if (response.GetResponseCode() == ResponseCodes::UNAUTHORIZED) {
-    header_t response_headers = response.GetResponseHeaders();
-    
-    try {
-      http::http_request req(http::methods::GET);
-      req.set_request_uri(path);
-      
-      req.headers().add(AUTHORIZATION_HEADER_NAME, _credentials.Authenticate("GET", path, 
-          response.GetResponseHeaders()[WWW_AUTHENTICATE_HEADER]));
-      
-      header_t::const_iterator iter;
-      for (iter = headers.begin(); iter != headers.end(); iter++) {
-        if (req.headers().has(iter->first)) {
-          req.headers().remove(iter->first);
-        }
-        req.headers().add(iter->first, iter->second);
-      }
-      
-      raw_client.request(req).then([&response](http::http_response raw_response) {
-        raw_response.extract_json().then([&response](pplx::task<web::json::value> previousTask)
-          {
-            try
-            {
-              response.SetJson(previousTask.get());
-            }
-            catch (const web::http::http_exception& e)
-            {
-              // Print error.
-              std::wostringstream ss;
-              ss << "There was an error!!!!" << e.what() << std::endl;
-              std::wcout << ss.str();
-            }
-        }).wait();
-        
-        response.SetResponseCode((ResponseCodes)raw_response.status_code());
-        response.SetResponseHeaders(raw_response.headers());
-      }).wait();
-      
-    } catch(std::exception e) {
-      std::cerr << e.what() << std::endl;
-    }
-  }
-    
-  return response;
+  return Send(host, Request<NoPayload>(RequestMethod::GET, path, NO_PAYLOAD, headers));
 }
 
 void AuthenticatingProxy::Get_Async(const std::string& host,
@@ -146,59 +70,14 @@ Response AuthenticatingProxy::Post(const std::string& host,
                   const json::value& body,
                   const header_t& headers)
 {
-  Response response;
-  header_t request_headers = headers;
-  
-  http::client::http_client raw_client(U(host));
-
-  try {
-    http::http_request req(http::methods::POST);
-    req.set_request_uri(path);
-    req.set_body(body);
-    
-    if (_credentials.Authenticating()) {
-      req.headers().add(AUTHORIZATION_HEADER_NAME, _credentials.Authenticate("POST", path));
-    }
-    
-    raw_client.request(req).then([&response](http::http_response raw_response) {
-      response.SetResponseCode((ResponseCodes)raw_response.status_code());
-      response.SetResponseHeaders(raw_response.headers());
-    }).wait();
-  } catch(std::exception e) {
-    std::cerr << e.what() << std::endl;
-  }
-
-  if (response.GetResponseCode() == ResponseCodes::UNAUTHORIZED) {
-    header_t response_headers = response.GetResponseHeaders();
-    
-    try {
-      http::http_request req(http::methods::POST);
-      req.set_request_uri(path);
-      req.set_body(body);
-      
-      req.headers().add(AUTHORIZATION_HEADER_NAME, _credentials.Authenticate("POST", path, 
-          response.GetResponseHeaders()[WWW_AUTHENTICATE_HEADER]));
-      
-      raw_client.request(req).then([&response](http::http_response raw_response) {
-        response.SetResponseCode((ResponseCodes)raw_response.status_code());
-        response.SetResponseHeaders(raw_response.headers());
-      }).wait();
-      
-    } catch(std::exception e) {
-      std::cerr << e.what() << std::endl;
-    }
-  }
-    
-  return response;
+  return Send(host, Request<json::value>(RequestMethod::POST, path, body, headers));
 }
 Response AuthenticatingProxy::Post(const std::string& host, 
                   const std::string& path,
                   const xmlDocPtr body,
                   const header_t& headers)
 {
-  Response result;
-  
-  return result;
+  return Send(host, Request<xmlDocPtr>(RequestMethod::POST, path, body, headers));
 }
 
 Response AuthenticatingProxy::Post(const std::string& host, 
@@ -206,9 +85,7 @@ Response AuthenticatingProxy::Post(const std::string& host,
                   const std::wstring& text_body,
                   const header_t& headers)
 {
-  Response result;
-  
-  return result;
+  return Send(host, Request<std::wstring>(RequestMethod::POST, path, text_body, headers));
 }
 
 Response AuthenticatingProxy::Post(const std::string& host, 
@@ -217,21 +94,26 @@ Response AuthenticatingProxy::Post(const std::string& host,
                   const size_t& size,
                   const header_t& headers) 
 {
-  Response result;
-  
-  return result;
+  RawPayload payload(data, size);
+  return Send(host, Request<RawPayload>(RequestMethod::POST, path, payload, headers));
 }
+
 Response AuthenticatingProxy::PostFile(const std::string& host, 
                       const std::string& path,
                       const std::string& file_path,
                       const header_t& headers)
 {
-  Response result;
-  
-  return result;
+  FilePayload payload(file_path);
+  return Send(host, Request<FilePayload>(RequestMethod::POST, path, payload, headers));
 }
 
-
+Response AuthenticatingProxy::Post(const std::string& host,
+                                   const std::string& path,
+                                   const JsonBodyWriter& write,
+                                   const header_t& headers)
+{
+  return Send(host, Request<JsonBodyWriter>(RequestMethod::POST, path, write, headers));
+}
 
 void AuthenticatingProxy::Post_Async(const std::string& host,
                                      const std::string& path,
@@ -264,58 +146,14 @@ Response AuthenticatingProxy::Put(const std::string& host,
              const std::wstring& text_body,
              const header_t& headers) 
 {
-  Response result;
-  return result;
+  return Send(host, Request<std::wstring>(RequestMethod::PUT, path, text_body, headers));
 }
 Response AuthenticatingProxy::Put(const std::string& host,
              const std::string& path,
              const json::value& json_body,
              const header_t& headers) 
 {
-  Response response;
-  header_t request_headers = headers;
-  
-  http::client::http_client raw_client(U(host));
-
-  try {
-    http::http_request req(http::methods::PUT);
-    req.set_request_uri(path);
-    req.set_body(json_body);
-    
-    if (_credentials.Authenticating()) {
-      req.headers().add(AUTHORIZATION_HEADER_NAME, _credentials.Authenticate("PUT", path));
-    }
-    
-    raw_client.request(req).then([&response](http::http_response raw_response) {
-      response.SetResponseCode((ResponseCodes)raw_response.status_code());
-      response.SetResponseHeaders(raw_response.headers());
-    }).wait();
-  } catch(std::exception e) {
-    std::cerr << e.what() << std::endl;
-  }
-
-  if (response.GetResponseCode() == ResponseCodes::UNAUTHORIZED) {
-    header_t response_headers = response.GetResponseHeaders();
-    
-    try {
-      http::http_request req(http::methods::PUT);
-      req.set_request_uri(path);
-      req.set_body(json_body);
-      
-      req.headers().add(AUTHORIZATION_HEADER_NAME, _credentials.Authenticate("PUT", path, 
-          response.GetResponseHeaders()[WWW_AUTHENTICATE_HEADER]));
-      
-      raw_client.request(req).then([&response](http::http_response raw_response) {
-        response.SetResponseCode((ResponseCodes)raw_response.status_code());
-        response.SetResponseHeaders(raw_response.headers());
-      }).wait();
-      
-    } catch(std::exception e) {
-      std::cerr << e.what() << std::endl;
-    }
-  }
-    
-  return response;
+  return Send(host, Request<json::value>(RequestMethod::PUT, path, json_body, headers));
 }
 
 Response AuthenticatingProxy::Put(const std::string& host,
@@ -323,8 +161,7 @@ Response AuthenticatingProxy::Put(const std::string& host,
              const xmlDocPtr& xml_body,
              const header_t& headers) 
 {
-  Response result;
-  return result;
+  return Send(host, Request<xmlDocPtr>(RequestMethod::PUT, path, xml_body, headers));
 }
 
 Response AuthenticatingProxy::Put(const std::string& host,
@@ -333,11 +170,28 @@ Response AuthenticatingProxy::Put(const std::string& host,
              const size_t& size,
              const header_t& headers) 
 {
-  Response result;
-  return result;
+  RawPayload payload(data, size);
+  return Send(host, Request<RawPayload>(RequestMethod::PUT, path, payload, headers));
 }
 
 
+Response AuthenticatingProxy::PutFile(const std::string& host,
+                                      const std::string& path,
+                                      const std::string& file_path,
+                                      const header_t& headers)
+{
+  FilePayload payload(file_path);
+  return Send(host, Request<FilePayload>(RequestMethod::PUT, path, payload, headers));
+}
+
+Response AuthenticatingProxy::Put(const std::string& host,
+                                  const std::string& path,
+                                  const JsonBodyWriter& write,
+                                  const header_t& headers)
+{
+  return Send(host, Request<JsonBodyWriter>(RequestMethod::PUT, path, write, headers));
+}
+
 void AuthenticatingProxy::Put_Async(const std::string& host,
                                     const std::string& path,
                                     const header_t& headers,
@@ -364,52 +218,21 @@ void AuthenticatingProxy::Put_Async(const std::string& host,
     Put_Async(host, path, blank_headers, handler);
 }
 
+Response AuthenticatingProxy::Patch(const std::string& host,
+                                    const std::string& path,
+                                    const uint8_t* data,
+                                    const size_t& size,
+                                    const header_t& headers)
+{
+  RawPayload payload(data, size);
+  return Send(host, Request<RawPayload>(RequestMethod::PATCH, path, payload, headers));
+}
+
 Response AuthenticatingProxy::Delete(const std::string& host,
                                      const std::string& path,
                                      const header_t& headers)
 {
-  Response response;
-  header_t request_headers = headers;
-  
-  http::client::http_client raw_client(U(host));
-
-  try {
-    http::http_request req(http::methods::DEL);
-    req.set_request_uri(path);
-    
-    if (_credentials.Authenticating()) {
-      req.headers().add(AUTHORIZATION_HEADER_NAME, _credentials.Authenticate("DELETE", path));
-    }
-    
-    raw_client.request(req).then([&response](http::http_response raw_response) {
-      response.SetResponseCode((ResponseCodes)raw_response.status_code());
-      response.SetResponseHeaders(raw_response.headers());
-    }).wait();
-  } catch(std::exception e) {
-    std::cerr << e.what() << std::endl;
-  }
-
-  if (response.GetResponseCode() == ResponseCodes::UNAUTHORIZED) {
-    header_t response_headers = response.GetResponseHeaders();
-    
-    try {
-      http::http_request req(http::methods::DEL);
-      req.set_request_uri(path);
-      
-      req.headers().add(AUTHORIZATION_HEADER_NAME, _credentials.Authenticate("DELETE", path, 
-          response.GetResponseHeaders()[WWW_AUTHENTICATE_HEADER]));
-      
-      raw_client.request(req).then([&response](http::http_response raw_response) {
-        response.SetResponseCode((ResponseCodes)raw_response.status_code());
-        response.SetResponseHeaders(raw_response.headers());
-      }).wait();
-      
-    } catch(std::exception e) {
-      std::cerr << e.what() << std::endl;
-    }
-  }
-    
-  return response;
+  return Send(host, Request<NoPayload>(RequestMethod::DEL, path, NO_PAYLOAD, headers));
 }
 
 
@@ -18,6 +18,9 @@
 #include "Response.hpp"
 #include "ResponseCodes.hpp"
 #include "Credentials.hpp"
+#include "JsonWriter.hpp"
+#include "Pipeline.hpp"
+#include "Request.hpp"
 #include "Types.hpp"
 
 const header_t blank_headers;
@@ -29,22 +32,37 @@ const header_t blank_headers;
 /// necessary.  It includes both synchronous and asynchronous methods to allow
 /// users to select the method of invocation most suited to their application.
 ///
+/// A proxy may be shared between threads, though they take turns to sign
+/// their requests; a thread of its own with Credentials::Fork is faster.
+///
 /// Note that some concepts contained run against "REST" principles.  This is 
 /// not only a REST library and is meant to be used as a general MarkLogic 
 /// C++ library.  It should be backward compatible with non RESTful end points
 /// as well as REST.
 ///
 class AuthenticatingProxy {
-    Credentials _credentials;
-    uint32_t _attempts;
-    
-    
-        
+    ///
+    /// The stages every request goes through, those of ProxyOptions first.
+    /// Credentials live in the DigestAuthStage.
+    ///
+    typedef Pipeline<StageFunctions, OptionalStage<RetryStage>, OptionalStage<CacheStage>,
+                     TimingStage, RecordStage, DigestAuthStage> pipeline_t;
+
+    pipeline_t _pipeline;
+
 public:    
     ///
     /// Constructor
     ///
     AuthenticatingProxy();
+
+    ///
+    /// Constructor, for a proxy that retries, caches or runs stages of the
+    /// caller's.
+    ///
+    /// \param options The stages
+    ///
+    explicit AuthenticatingProxy(const ProxyOptions& options);
     
     /// 
     /// Add credentials to the authenticating proxy
@@ -59,6 +77,57 @@ public:
     /// \return The credentials
     ///
     Credentials GetCredentials(void) const;
+
+    ///
+    /// Returns a proxy running the same stages with forked credentials and
+    /// an HTTP client of its own, so that its requests keep to their own
+    /// connection instead of those shared with other proxies.
+    ///
+    /// \return The new proxy
+    ///
+    AuthenticatingProxy Dedicated(void) const;
+
+    ///
+    /// Sends a request, answering a digest challenge as needed.  Every
+    /// other method comes here.  The payload's PayloadTraits decide, when
+    /// this is compiled, whether it is serialized once or streamed, its
+    /// content type, and whether it can be sent again after a challenge.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param request The method, path, headers and payload
+    /// \return The Response object
+    ///
+    template<typename T>
+    Response Send(const std::string& host, const Request<T>& request) {
+        return _pipeline.Send(host, request);
+    }
+
+    ///
+    /// Sends a request as Send does, handing a successful body to
+    /// read_body as it arrives instead of keeping it, so a large response
+    /// is read in constant memory.
+    ///
+    ///     proxy.Stream(host, Request<NoPayload>(RequestMethod::GET,
+    ///             "/v1/search?q=cat&format=xml&pageLength=100000", NO_PAYLOAD),
+    ///         [](const Response& response, Concurrency::streams::istream& body) {
+    ///             XmlReader reader(body);
+    ///             XmlSearchReader results(reader);
+    ///             SearchResult result;
+    ///             while (results.Next(result)) {
+    ///                 ...
+    ///             }
+    ///         });
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param request The method, path, headers and payload
+    /// \param read_body Reads the body; what it throws is thrown from here
+    /// \return The Response object, with a body only if it was not read
+    ///
+    template<typename T>
+    Response Stream(const std::string& host, const Request<T>& request,
+                    const BodyReader& read_body) {
+        return _pipeline.Stream(host, request, read_body);
+    }
     
     ///
     /// Invokes a synchronous GET operation on the MarkLogic server.
@@ -90,15 +159,61 @@ public:
                   const std::string& path,
                   const std::wstring& text_body,
                   const header_t& headers = blank_headers);
+
+    ///
+    /// Invokes a synchronous POST with a raw body.  The Content-Type header
+    /// should be given; it defaults to application/octet-stream.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param path The path to invoke
+    /// \param data The body
+    /// \param size The body's length in bytes
+    /// \param headers The HTTP headers to include in the invocation
+    /// \return The Response object
+    ///
     Response Post(const std::string& host, 
                   const std::string& path,
                   const uint8_t* data, 
                   const size_t& size,
                   const header_t& headers = blank_headers);
+
+    ///
+    /// Invokes a synchronous POST whose body is streamed from a file, so
+    /// the file is never held in memory.  The Content-Type header should be
+    /// given.  An unauthenticated proxy sends the file twice, once to be
+    /// challenged, so make a small request first when the file is large.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param path The path to invoke
+    /// \param file_path The file to send
+    /// \param headers The HTTP headers to include in the invocation
+    /// \return The Response object
+    ///
     Response PostFile(const std::string& host, 
                       const std::string& path,
                       const std::string& file_path,
                       const header_t& headers = blank_headers);
+
+    ///
+    /// Invokes a synchronous POST whose JSON body is written by write as it
+    /// is sent, so neither a web::json::value nor its serialization is ever
+    /// held whole.  The length is not known up front, so the body goes with
+    /// chunked transfer encoding.  The Content-Type is application/json
+    /// unless a header says otherwise.  write runs on another thread and,
+    /// on an unauthenticated proxy, runs twice, once to be challenged; if
+    /// it throws, or leaves the document incomplete, the request is
+    /// abandoned and the response has no status.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param path The path to invoke
+    /// \param write Writes the body
+    /// \param headers The HTTP headers to include in the invocation
+    /// \return The Response object
+    ///
+    Response Post(const std::string& host,
+                  const std::string& path,
+                  const JsonBodyWriter& write,
+                  const header_t& headers = blank_headers);
     
     void Post_Async(const std::string& host,
                    const std::string& path,
@@ -125,12 +240,56 @@ public:
                  const std::string& path,
                  const xmlDocPtr& xml_body,
                  const header_t& headers = blank_headers);
+
+    ///
+    /// Invokes a synchronous PUT with a raw body.  The Content-Type header
+    /// should be given; it defaults to application/octet-stream.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param path The path to invoke
+    /// \param data The body
+    /// \param size The body's length in bytes
+    /// \param headers The HTTP headers to include in the invocation
+    /// \return The Response object
+    ///
     Response Put(const std::string& host,
                  const std::string& path,
                  const uint8_t* data, 
                  const size_t& size,
                  const header_t& headers = blank_headers);
     
+    ///
+    /// Invokes a synchronous PUT whose body is streamed from a file, so the
+    /// file is never held in memory.  The Content-Type header should be
+    /// given.  As with PostFile, make a small request first when the proxy
+    /// has not yet been challenged.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param path The path to invoke
+    /// \param file_path The file to send
+    /// \param headers The HTTP headers to include in the invocation
+    /// \return The Response object
+    ///
+    Response PutFile(const std::string& host,
+                     const std::string& path,
+                     const std::string& file_path,
+                     const header_t& headers = blank_headers);
+
+    ///
+    /// Invokes a synchronous PUT whose JSON body is written by write as it
+    /// is sent, as the streaming Post does.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param path The path to invoke
+    /// \param write Writes the body
+    /// \param headers The HTTP headers to include in the invocation
+    /// \return The Response object
+    ///
+    Response Put(const std::string& host,
+                 const std::string& path,
+                 const JsonBodyWriter& write,
+                 const header_t& headers = blank_headers);
+    
     void Put_Async(const std::string& host,
                    const std::string& path,
                    const header_t& headers,
@@ -144,6 +303,23 @@ public:
                    const std::string& path,
                    const std::function<void(const Response&)> handler);
     
+    ///
+    /// Invokes a synchronous PATCH, such as a partial update of a document
+    /// with PATCH /v1/documents.  The Content-Type header should be given.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param path The path to invoke
+    /// \param data The body
+    /// \param size The body's length in bytes
+    /// \param headers The HTTP headers to include in the invocation
+    /// \return The Response object
+    ///
+    Response Patch(const std::string& host,
+                   const std::string& path,
+                   const uint8_t* data,
+                   const size_t& size,
+                   const header_t& headers = blank_headers);
+
     Response Delete(const std::string& host,
                  const std::string& path,
                  const header_t& headers = blank_headers);
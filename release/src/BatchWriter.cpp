@@ -0,0 +1,309 @@
+/*
+ * File:   BatchWriter.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "BatchWriter.hpp"
+
+#include <chrono>
+
+#include "AuthenticatingProxy.hpp"
+#include "Logger.hpp"
+
+namespace {
+
+WriteResult Closed(void) {
+  WriteResult closed;
+  closed.error = "The writer is closed";
+  return closed;
+}
+
+///
+/// Returns why a document cannot go in a batch, or nothing if it can.  The
+/// URI and content type are written into each part's headers as they are,
+/// so a quote or a line break would end them early.
+///
+std::string Unsendable(const std::string& uri, const std::string& content_type) {
+  if (uri.find_first_of("\"\r\n") != std::string::npos) {
+    return "The URI contains a quote or a line break: " + uri;
+  }
+  if (content_type.find_first_of("\r\n") != std::string::npos) {
+    return "The content type contains a line break";
+  }
+  return std::string();
+}
+
+}
+
+BatchWriterOptions::BatchWriterOptions() : max_documents(100), max_bytes(4 * 1024 * 1024),
+    max_delay_ms(20), queue_capacity(4096), flushers(4)
+{
+
+}
+
+WriteResult::WriteResult() : written(false), status(0) {
+
+}
+
+BatchWriter::BatchWriter(const std::string& host, const Credentials& credentials,
+    const BatchWriterOptions& options) : _host(host), _credentials(credentials),
+    _options(options), _queue(options.queue_capacity > 0 ? options.queue_capacity : 1),
+    _queued(0), _idle(0), _flush_requests(0), _accepted(0), _completed(0), _batches(0),
+    _closing(false), _pushing(0)
+{
+  if (_options.max_documents == 0) {
+    _options.max_documents = 1;
+  }
+  // Any text that cannot appear in the documents will do; this one is
+  // unlikely to.
+  _boundary = "mlcpp-batch-" + std::to_string(
+      std::chrono::steady_clock::now().time_since_epoch().count()) + "-" +
+      std::to_string((uintptr_t)this);
+
+  unsigned flushers = _options.flushers > 0 ? _options.flushers : 1;
+  for (unsigned i = 0; i < flushers; i++) {
+    _flushers.push_back(std::thread(&BatchWriter::FlushLoop, this, _credentials.Fork()));
+  }
+}
+
+BatchWriter::~BatchWriter() {
+  Close();
+}
+
+std::future<WriteResult> BatchWriter::Write(const std::string& uri, std::string body,
+    const std::string& content_type, const std::string& metadata)
+{
+  std::string unsendable = Unsendable(uri, content_type);
+  if (!unsendable.empty()) {
+    WriteResult refused;
+    refused.error = unsendable;
+    std::promise<WriteResult> result;
+    result.set_value(refused);
+    return result.get_future();
+  }
+
+  PendingWrite* write = new PendingWrite();
+  write->uri = uri;
+  write->body = std::move(body);
+  write->content_type = content_type;
+  write->metadata = metadata;
+  std::future<WriteResult> done = write->done.get_future();
+
+  // Close waits for writes that got past this check to push, so it sees
+  // each one in the queue after its flushers stop.  Counting first and
+  // checking after, against Close setting _closing first and waiting
+  // after, means one of the two always sees the other.
+  _pushing++;
+  if (_closing) {
+    Pushed();
+    Complete(write, Closed());
+    return done;
+  }
+
+  // Counted before it is pushed, so a flusher that pops it never takes
+  // _queued below zero; a flusher that sees the count first just tries
+  // again until the push lands.
+  _accepted++;
+  _queued++;
+  while (!_queue.TryPush(write)) {
+    if (_closing) {
+      _queued--;
+      _accepted--;
+      Pushed();
+      Complete(write, Closed());
+      return done;
+    }
+    // Backpressure: wait for a flusher to take a batch.  The timeout covers
+    // a batch taken between the failed push and the wait.
+    std::unique_lock<std::mutex> lock(_mutex);
+    _not_full.wait_for(lock, std::chrono::milliseconds(1));
+  }
+  Pushed();
+
+  // A flusher counts itself idle before checking _queued, and this checks
+  // _idle after counting the write, so one of the two always sees the
+  // other.  Taking the lock orders the notify after the flusher's wait.
+  if (_idle > 0) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+    }
+    _not_empty.notify_one();
+  }
+  return done;
+}
+
+void BatchWriter::Pushed(void) {
+  if (--_pushing == 0 && _closing) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+    }
+    _drained.notify_all();
+  }
+}
+
+void BatchWriter::FlushLoop(Credentials credentials) {
+  AuthenticatingProxy proxy(_options.proxy);
+  proxy.AddCredentials(credentials);
+
+  std::vector<PendingWrite*> batch;
+  batch.reserve(_options.max_documents);
+  while (Collect(batch)) {
+    _not_full.notify_all();
+    Send(proxy, batch);
+    batch.clear();
+  }
+}
+
+bool BatchWriter::Collect(std::vector<PendingWrite*>& batch) {
+  PendingWrite* write = nullptr;
+  while (!_queue.TryPop(write)) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_closing && _queued == 0) {
+      return false;
+    }
+    _idle++;
+    _not_empty.wait(lock, [this]() {
+      return _queued > 0 || _closing;
+    });
+    _idle--;
+  }
+  _queued--;
+  batch.push_back(write);
+  size_t bytes = write->body.size();
+
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() +
+      std::chrono::milliseconds(_options.max_delay_ms);
+  while (batch.size() < _options.max_documents && bytes < _options.max_bytes) {
+    if (_queue.TryPop(write)) {
+      _queued--;
+      batch.push_back(write);
+      bytes += write->body.size();
+      continue;
+    }
+    if (_closing || _flush_requests > 0 || std::chrono::steady_clock::now() >= deadline) {
+      break;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle++;
+    _not_empty.wait_until(lock, deadline, [this]() {
+      return _queued > 0 || _closing || _flush_requests > 0;
+    });
+    _idle--;
+  }
+  return true;
+}
+
+void BatchWriter::Send(AuthenticatingProxy& proxy, std::vector<PendingWrite*>& batch) {
+  size_t size = 0;
+  for (auto write : batch) {
+    size += write->body.size() + write->metadata.size() + 2 * write->uri.size() +
+        write->content_type.size() + 256;
+  }
+
+  std::string body;
+  body.reserve(size + _boundary.size() + 8);
+  for (auto write : batch) {
+    if (!write->metadata.empty()) {
+      body += "--";
+      body += _boundary;
+      body += "\r\nContent-Type: application/json\r\nContent-Disposition: attachment; filename=\"";
+      body += write->uri;
+      body += "\"; category=metadata\r\n\r\n";
+      body += write->metadata;
+      body += "\r\n";
+    }
+    body += "--";
+    body += _boundary;
+    body += "\r\nContent-Type: ";
+    body += write->content_type;
+    body += "\r\nContent-Disposition: attachment; filename=\"";
+    body += write->uri;
+    body += "\"\r\n\r\n";
+    body += write->body;
+    body += "\r\n";
+  }
+  body += "--";
+  body += _boundary;
+  body += "--\r\n";
+
+  header_t headers;
+  headers["Content-Type"] = "multipart/mixed; boundary=" + _boundary;
+  headers["Accept"] = "application/json";
+  Response response = proxy.Post(_host, "/v1/documents", (const uint8_t*)body.data(),
+      body.size(), headers);
+
+  WriteResult result;
+  result.status = (int)response.GetResponseCode();
+  result.written = result.status >= 200 && result.status <= 299;
+  if (!result.written) {
+    result.error = response.Body().substr(0, 500);
+    MLLOG(LogLevel::WARNING).Message("Batch write failed").Field("documents", batch.size())
+        .Field("status", result.status);
+  }
+
+  _batches++;
+  for (auto write : batch) {
+    Complete(write, result);
+  }
+}
+
+void BatchWriter::Complete(PendingWrite* write, const WriteResult& result) {
+  write->done.set_value(result);
+  delete write;
+  _completed++;
+  if (_flush_requests > 0) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+    }
+    _drained.notify_all();
+  }
+}
+
+void BatchWriter::Flush(void) {
+  uint64_t target = _accepted;
+  std::unique_lock<std::mutex> lock(_mutex);
+  _flush_requests++;
+  _not_empty.notify_all();
+  _drained.wait(lock, [this, target]() {
+    return _completed >= target;
+  });
+  _flush_requests--;
+}
+
+void BatchWriter::Close(void) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_closing) {
+      return;
+    }
+    _closing = true;
+  }
+  _not_empty.notify_all();
+  for (auto& flusher : _flushers) {
+    flusher.join();
+  }
+  _flushers.clear();
+
+  // A write that was queued as the flushers stopped.
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _drained.wait(lock, [this]() {
+      return _pushing == 0;
+    });
+  }
+  PendingWrite* write = nullptr;
+  while (_queue.TryPop(write)) {
+    _queued--;
+    Complete(write, Closed());
+  }
+}
+
+uint64_t BatchWriter::Batches(void) const {
+  return _batches;
+}
+
+uint64_t BatchWriter::Completed(void) const {
+  return _completed;
+}
@@ -0,0 +1,168 @@
+/*
+ * File:   BatchWriter.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef BATCHWRITER_HPP
+#define	BATCHWRITER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Credentials.hpp"
+#include "Pipeline.hpp"
+#include "RingBuffer.hpp"
+
+class AuthenticatingProxy;
+
+///
+/// When a BatchWriter sends a batch.
+///
+struct BatchWriterOptions {
+    size_t   max_documents;     /*!< Send once this many documents are waiting */
+    size_t   max_bytes;         /*!< Send once the bodies add up to this */
+    uint32_t max_delay_ms;      /*!< Send this long after the first document arrived */
+    size_t   queue_capacity;    /*!< Writes block while this many are queued */
+    unsigned flushers;          /*!< Batches in flight at once */
+    ProxyOptions proxy;         /*!< For the flushers' proxies */
+
+    BatchWriterOptions();
+};
+
+///
+/// The outcome of one write.  Every document in a batch gets the same
+/// outcome, since the server applies a batch as a single transaction.
+///
+struct WriteResult {
+    bool        written;
+    int         status;     /*!< The HTTP status of the batch, 0 if it was never sent */
+    std::string error;      /*!< The server's message when not written */
+
+    WriteResult();
+};
+
+///
+/// Collects documents written one at a time, from any number of threads,
+/// and sends them as multi-document writes: one POST /v1/documents with a
+/// multipart/mixed body per batch, instead of a PUT per document.
+///
+///     BatchWriter writer(host, proxy.GetCredentials());
+///     std::future<WriteResult> done = writer.Write("/orders/1.json", order);
+///     ...
+///     if (!done.get().written) {
+///         ...
+///     }
+///
+/// Writes go into a lock free queue and return at once.  A pool of flusher
+/// threads, each with its own AuthenticatingProxy, takes them off in
+/// batches, sending a batch when it reaches max_documents or max_bytes, or
+/// max_delay_ms after its first document was queued.  When the queue is
+/// full Write blocks until a flusher makes room, so a producer that outruns
+/// the server is slowed down rather than growing the queue without limit.
+///
+/// Destroying the writer sends whatever is queued and waits for it.
+///
+class BatchWriter {
+    struct PendingWrite {
+        std::string uri;
+        std::string body;
+        std::string content_type;
+        std::string metadata;
+        std::promise<WriteResult> done;
+    };
+
+    std::string _host;
+    Credentials _credentials;
+    BatchWriterOptions _options;
+    std::string _boundary;
+
+    RingBuffer<PendingWrite*> _queue;
+    std::atomic<size_t> _queued;            /*!< Being pushed or pushed, not yet popped */
+    std::atomic<unsigned> _idle;            /*!< Flushers waiting for documents */
+    std::atomic<unsigned> _flush_requests;  /*!< Callers waiting in Flush */
+    std::atomic<uint64_t> _accepted;
+    std::atomic<uint64_t> _completed;
+    std::atomic<uint64_t> _batches;
+    std::atomic<bool> _closing;
+    std::atomic<unsigned> _pushing;         /*!< Writes past their check of _closing */
+
+    std::mutex _mutex;
+    std::condition_variable _not_empty;
+    std::condition_variable _not_full;
+    std::condition_variable _drained;
+    std::vector<std::thread> _flushers;
+
+    BatchWriter(const BatchWriter& orig);
+    BatchWriter& operator=(const BatchWriter& orig);
+
+    void Pushed(void);
+    void FlushLoop(Credentials credentials);
+    bool Collect(std::vector<PendingWrite*>& batch);
+    void Send(AuthenticatingProxy& proxy, std::vector<PendingWrite*>& batch);
+    void Complete(PendingWrite* write, const WriteResult& result);
+public:
+    ///
+    /// Constructor.  Starts the flushers.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param credentials The credentials; each flusher uses a Fork of them
+    /// \param options When to send batches
+    ///
+    BatchWriter(const std::string& host, const Credentials& credentials,
+                const BatchWriterOptions& options = BatchWriterOptions());
+
+    ///
+    /// Destructor.  Calls Close.
+    ///
+    ~BatchWriter();
+
+    ///
+    /// Queues a document, blocking while the queue is full.
+    ///
+    /// \param uri The document URI
+    /// \param body The document, moved from
+    /// \param content_type Its media type
+    /// \param metadata The document's metadata as JSON ({"collections":[...],
+    ///        "metadataValues":{...}}), replacing the categories it holds;
+    ///        empty to leave the metadata alone
+    /// \return Ready once the batch holding the document has been answered
+    ///
+    std::future<WriteResult> Write(const std::string& uri, std::string body,
+                                   const std::string& content_type = "application/json",
+                                   const std::string& metadata = std::string());
+
+    ///
+    /// Sends everything queued without waiting for the thresholds, and
+    /// returns once it has been answered.
+    ///
+    void Flush(void);
+
+    ///
+    /// Sends everything queued and stops the flushers.  Writes after this
+    /// are not sent; their results say so.
+    ///
+    void Close(void);
+
+    ///
+    /// Returns the number of batches sent.
+    ///
+    /// \return The count
+    ///
+    uint64_t Batches(void) const;
+
+    ///
+    /// Returns the number of documents whose batch has been answered.
+    ///
+    /// \return The count
+    ///
+    uint64_t Completed(void) const;
+};
+
+#endif	/* BATCHWRITER_HPP */
@@ -150,3 +150,12 @@ std::string Credentials::Realm(void) const {
     return _realm;
 }
 
+Credentials Credentials::Fork(void) const {
+    Credentials forked(_user, _pass);
+    forked._nonce = _nonce;
+    forked._qop = _qop;
+    forked._opaque = _opaque;
+    forked._realm = _realm;
+    return forked;
+}
+
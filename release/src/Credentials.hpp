@@ -150,9 +150,21 @@ public:
     /// \return The realm
     ///
     std::string Realm(void) const;
+
+    ///
+    /// Returns credentials for the same user with a new client nonce and
+    /// the nonce count reset, keeping any challenge already received.  Give
+    /// one to each AuthenticatingProxy that runs on its own thread, so their
+    /// nonce counts never collide.
+    ///
+    /// \return The new credentials
+    ///
+    Credentials Fork(void) const;
         
-    friend class AuthenticatingProxy;
+    friend class DigestAuthStage;
     friend class TestCredentials;
+    friend class HotPathBench;
+    friend class AllocationBudgetTest;
 };
 
 #endif /* defined(__Scratch__Credentials__) */
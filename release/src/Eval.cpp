@@ -0,0 +1,218 @@
+/*
+ * File:   Eval.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Eval.hpp"
+
+#include <cpprest/http_client.h>
+
+#include "AuthenticatingProxy.hpp"
+#include "Response.hpp"
+
+namespace {
+
+const std::string FORM_CONTENT_TYPE = "application/x-www-form-urlencoded";
+
+Response Run(AuthenticatingProxy& proxy, const std::string& host, const EvalCall& call) {
+  header_t headers;
+  headers["Accept"] = "multipart/mixed";
+
+  Response response;
+  const std::string& method = call.Method();
+  if (method == "GET") {
+    response = proxy.Get(host, call.Path(), headers);
+  } else if (method == "DELETE") {
+    response = proxy.Delete(host, call.Path(), headers);
+  } else {
+    std::string body = call.RequestBody();
+    headers["Content-Type"] = call.ContentType();
+    if (method == "PUT") {
+      response = proxy.Put(host, call.Path(), (const uint8_t*)body.data(), body.size(), headers);
+    } else {
+      response = proxy.Post(host, call.Path(), (const uint8_t*)body.data(), body.size(),
+          headers);
+    }
+  }
+
+  int status = (int)response.GetResponseCode();
+  if (status < 200 || status > 299) {
+    std::string detail = response.Body().substr(0, 500);
+    throw EvalException(method + " " + call.Path().substr(0, call.Path().find('?')) +
+        " failed with status " + std::to_string(status) +
+        (detail.empty() ? std::string() : ": " + detail));
+  }
+  return response;
+}
+
+}
+
+EvalException::EvalException(const std::string& message) : _message(message) {
+
+}
+
+const char* EvalException::what() const throw() {
+  return _message.c_str();
+}
+
+EvalItem::EvalItem() : data(nullptr), size(0) {
+
+}
+
+std::string EvalItem::Content(void) const {
+  return std::string(data, size);
+}
+
+EvalCall::EvalCall(const std::string& method, const std::string& endpoint,
+    const std::string& code_field, const std::string& code) : _method(method),
+    _endpoint(endpoint), _code_field(code_field), _code(code)
+{
+
+}
+
+EvalCall EvalCall::XQuery(const std::string& code) {
+  return EvalCall("POST", "/v1/eval", "xquery", code);
+}
+
+EvalCall EvalCall::JavaScript(const std::string& code) {
+  return EvalCall("POST", "/v1/eval", "javascript", code);
+}
+
+EvalCall EvalCall::Invoke(const std::string& module) {
+  return EvalCall("POST", "/v1/invoke", "module", module);
+}
+
+EvalCall EvalCall::Resource(const std::string& name, const std::string& method) {
+  return EvalCall(method, "/v1/resources/" + web::uri::encode_data_string(name),
+      std::string(), std::string());
+}
+
+EvalCall& EvalCall::Variable(const std::string& name, const web::json::value& value) {
+  _variables.push_back(std::make_pair(name, value));
+  return *this;
+}
+
+EvalCall& EvalCall::Variable(const std::string& name, const std::string& value) {
+  return Variable(name, web::json::value::string(value));
+}
+
+EvalCall& EvalCall::Variable(const std::string& name, const char* value) {
+  return Variable(name, std::string(value));
+}
+
+EvalCall& EvalCall::Database(const std::string& database) {
+  _database = database;
+  return *this;
+}
+
+EvalCall& EvalCall::Txid(const std::string& txid) {
+  _txid = txid;
+  return *this;
+}
+
+EvalCall& EvalCall::Body(const std::string& body, const std::string& content_type) {
+  _body = body;
+  _content_type = content_type;
+  return *this;
+}
+
+const std::string& EvalCall::Method(void) const {
+  return _method;
+}
+
+std::string EvalCall::Path(void) const {
+  std::string query;
+  if (_code_field.empty()) {
+    for (auto& variable : _variables) {
+      std::string value = variable.second.is_string() ? variable.second.as_string() :
+          variable.second.serialize();
+      query += "&rs:" + web::uri::encode_data_string(variable.first) + "=" +
+          web::uri::encode_data_string(value);
+    }
+  }
+  if (!_database.empty()) {
+    query += "&database=" + web::uri::encode_data_string(_database);
+  }
+  if (!_txid.empty()) {
+    query += "&txid=" + web::uri::encode_data_string(_txid);
+  }
+
+  if (query.empty()) {
+    return _endpoint;
+  }
+  query[0] = '?';
+  return _endpoint + query;
+}
+
+std::string EvalCall::RequestBody(void) const {
+  if (_code_field.empty()) {
+    return _body;
+  }
+
+  std::string form = _code_field + "=" + web::uri::encode_data_string(_code);
+  if (!_variables.empty()) {
+    web::json::value vars = web::json::value::object();
+    for (auto& variable : _variables) {
+      vars[variable.first] = variable.second;
+    }
+    form += "&vars=" + web::uri::encode_data_string(vars.serialize());
+  }
+  return form;
+}
+
+std::string EvalCall::ContentType(void) const {
+  if (_code_field.empty()) {
+    return _content_type.empty() ? "application/octet-stream" : _content_type;
+  }
+  return FORM_CONTENT_TYPE;
+}
+
+EvalResults::EvalResults(AuthenticatingProxy& proxy, const std::string& host,
+    const EvalCall& call) : EvalResults(Run(proxy, host, call))
+{
+
+}
+
+EvalResults::EvalResults(const Response& response) : EvalResults(response.Body(),
+    response.Header("Content-Type"))
+{
+
+}
+
+EvalResults::EvalResults(std::string body, const std::string& content_type) :
+    _body(std::move(body)), _content_type(content_type), _done(_body.empty())
+{
+  if (!_done && _content_type.compare(0, 10, "multipart/") == 0) {
+    _reader.reset(new MultipartReader(_body, MultipartReader::Boundary(_content_type)));
+  }
+}
+
+bool EvalResults::Next(EvalItem& item) {
+  if (_done) {
+    return false;
+  }
+
+  if (!_reader) {
+    // A single document, not a sequence.
+    item.content_type = _content_type;
+    item.primitive.clear();
+    item.path.clear();
+    item.data = _body.data();
+    item.size = _body.size();
+    _done = true;
+    return true;
+  }
+
+  MultipartPart part;
+  if (!_reader->Next(part)) {
+    _done = true;
+    return false;
+  }
+  item.content_type = part.Header("Content-Type");
+  item.primitive = part.Header("X-Primitive");
+  item.path = part.Header("X-Path");
+  item.data = part.data;
+  item.size = part.size;
+  return true;
+}
@@ -0,0 +1,251 @@
+/*
+ * File:   Eval.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef EVAL_HPP
+#define	EVAL_HPP
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cpprest/json.h>
+
+#include "Multipart.hpp"
+
+class AuthenticatingProxy;
+class Response;
+
+///
+/// Thrown when the server refuses or fails to run code.
+///
+class EvalException : public std::exception {
+    std::string _message;
+public:
+    explicit EvalException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// One item of the sequence returned by server side code.  The content
+/// points into the EvalResults it came from, so it is only valid while
+/// those results are.
+///
+struct EvalItem {
+    std::string content_type;   /*!< The item's media type ("application/json") */
+    std::string primitive;      /*!< X-Primitive: the XDM type ("string", "integer", "map") */
+    std::string path;           /*!< X-Path: the node's path, for nodes from documents */
+    const char* data;           /*!< The item's content */
+    size_t      size;           /*!< Its length in bytes */
+
+    EvalItem();
+
+    ///
+    /// Returns the content as a string.
+    ///
+    /// \return A copy of the content
+    ///
+    std::string Content(void) const;
+};
+
+///
+/// Code to run on the server: an ad hoc XQuery or JavaScript program with
+/// POST /v1/eval, an installed module with POST /v1/invoke, or a method of
+/// a resource service extension at /v1/resources/{name}.
+///
+///     EvalCall call = EvalCall::JavaScript(
+///         "var prefix; cts.uris(prefix, null, cts.directoryQuery(prefix))");
+///     call.Variable("prefix", "/orders/");
+///
+/// Variables are sent to eval and invoke as external variables, and to a
+/// resource extension as rs: parameters.
+///
+class EvalCall {
+    std::string _method;
+    std::string _endpoint;      /*!< "/v1/eval", "/v1/invoke" or "/v1/resources/{name}" */
+    std::string _code_field;    /*!< "xquery", "javascript" or "module"; empty for resources */
+    std::string _code;
+    std::vector<std::pair<std::string, web::json::value> > _variables;
+    std::string _database;
+    std::string _txid;
+    std::string _body;
+    std::string _content_type;
+
+    EvalCall(const std::string& method, const std::string& endpoint,
+             const std::string& code_field, const std::string& code);
+public:
+    ///
+    /// Returns a call that evaluates XQuery.
+    ///
+    /// \param code The main module
+    /// \return The call
+    ///
+    static EvalCall XQuery(const std::string& code);
+
+    ///
+    /// Returns a call that evaluates server side JavaScript.
+    ///
+    /// \param code The program
+    /// \return The call
+    ///
+    static EvalCall JavaScript(const std::string& code);
+
+    ///
+    /// Returns a call that invokes a module installed in the modules
+    /// database.
+    ///
+    /// \param module The module path ("/ext/summarize.sjs")
+    /// \return The call
+    ///
+    static EvalCall Invoke(const std::string& module);
+
+    ///
+    /// Returns a call to a resource service extension.
+    ///
+    /// \param name The extension's name
+    /// \param method "GET", "POST", "PUT" or "DELETE"
+    /// \return The call
+    ///
+    static EvalCall Resource(const std::string& name, const std::string& method = "GET");
+
+    ///
+    /// Binds an external variable, or a resource parameter.
+    ///
+    /// \param name The variable name, without a namespace
+    /// \param value The value
+    /// \return This call
+    ///
+    EvalCall& Variable(const std::string& name, const web::json::value& value);
+
+    ///
+    /// Binds an external variable, or a resource parameter, to a string.
+    ///
+    /// \param name The variable name, without a namespace
+    /// \param value The value
+    /// \return This call
+    ///
+    EvalCall& Variable(const std::string& name, const std::string& value);
+
+    ///
+    /// Binds an external variable, or a resource parameter, to a string.
+    /// Without this, a literal would convert to a boolean JSON value.
+    ///
+    /// \param name The variable name, without a namespace
+    /// \param value The value
+    /// \return This call
+    ///
+    EvalCall& Variable(const std::string& name, const char* value);
+
+    ///
+    /// Runs the code against a database other than the REST server's.
+    ///
+    /// \param database The database name
+    /// \return This call
+    ///
+    EvalCall& Database(const std::string& database);
+
+    ///
+    /// Runs the code in a multi-statement transaction.
+    ///
+    /// \param txid The transaction id, from Transaction::Id
+    /// \return This call
+    ///
+    EvalCall& Txid(const std::string& txid);
+
+    ///
+    /// Sets the body sent to a resource extension's POST or PUT method.
+    ///
+    /// \param body The body
+    /// \param content_type Its media type
+    /// \return This call
+    ///
+    EvalCall& Body(const std::string& body, const std::string& content_type);
+
+    ///
+    /// Returns the HTTP method.
+    ///
+    /// \return The method ("POST")
+    ///
+    const std::string& Method(void) const;
+
+    ///
+    /// Returns the request path.
+    ///
+    /// \return The path and query string
+    ///
+    std::string Path(void) const;
+
+    ///
+    /// Returns the request body: a form for eval and invoke, the body given
+    /// to Body for resources.
+    ///
+    /// \return The body
+    ///
+    std::string RequestBody(void) const;
+
+    ///
+    /// Returns the media type of RequestBody.
+    ///
+    /// \return The Content-Type
+    ///
+    std::string ContentType(void) const;
+};
+
+///
+/// The sequence returned by server side code, read one item at a time.
+///
+/// The response is requested as multipart/mixed, one part per item, and
+/// each part is found as Next is called, straight from the response text;
+/// nothing is copied until the caller asks for an item's content.  A
+/// resource extension that returns a single document that is not
+/// multipart gives one item.
+///
+///     EvalResults results(proxy, host, EvalCall::XQuery("cts:uris()"));
+///     EvalItem item;
+///     while (results.Next(item)) {
+///         std::cout << item.Content() << std::endl;
+///     }
+///
+class EvalResults {
+    std::string _body;
+    std::string _content_type;
+    std::unique_ptr<MultipartReader> _reader;  /*!< Null unless the body is multipart */
+    bool _done;
+
+    EvalResults(const EvalResults& orig);
+    EvalResults& operator=(const EvalResults& orig);
+
+    explicit EvalResults(const Response& response);
+public:
+    ///
+    /// Runs the code.  Throws EvalException if the server reports an error.
+    ///
+    /// \param proxy The proxy to send the request through
+    /// \param host The server ("http://localhost:8000")
+    /// \param call The code to run
+    ///
+    EvalResults(AuthenticatingProxy& proxy, const std::string& host, const EvalCall& call);
+
+    ///
+    /// Reads results already fetched.
+    ///
+    /// \param body The response body, moved from
+    /// \param content_type The response Content-Type
+    ///
+    EvalResults(std::string body, const std::string& content_type);
+
+    ///
+    /// Returns the next item.  Throws MultipartException if the body is
+    /// malformed.
+    ///
+    /// \param item Set to the item
+    /// \return False when there are no more items
+    ///
+    bool Next(EvalItem& item);
+};
+
+#endif	/* EVAL_HPP */
@@ -0,0 +1,323 @@
+/*
+ * File:   Export.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Export.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <cpprest/http_client.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <direct.h>
+#define MAKE_DIRECTORY(path) _mkdir(path)
+#else
+#include <sys/stat.h>
+#define MAKE_DIRECTORY(path) mkdir(path, 0755)
+#endif
+
+#include "AuthenticatingProxy.hpp"
+#include "Logger.hpp"
+#include "Multipart.hpp"
+#include "Response.hpp"
+#include "Search.hpp"
+
+const std::string EFFECTIVE_TIMESTAMP_HEADER = "ML-Effective-Timestamp";
+
+namespace {
+
+void CreateParentDirectories(const std::string& path) {
+  for (size_t slash = path.find('/', 1); slash != std::string::npos;
+       slash = path.find('/', slash + 1)) {
+    // Failures, usually because the directory exists, show up when the
+    // file itself is opened.
+    MAKE_DIRECTORY(path.substr(0, slash).c_str());
+  }
+}
+
+bool ReplaceFile(const std::string& source, const std::string& target) {
+#ifdef _WIN32
+  return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return std::rename(source.c_str(), target.c_str()) == 0;
+#endif
+}
+
+}
+
+ExportOptions::ExportOptions() : partitioning(ExportPartitioning::URI_RANGE),
+    partitions(4), batch_size(100), page_length(1000), output_directory("."),
+    replace_files(false)
+{
+
+}
+
+ExportSummary::ExportSummary() : timestamp(0), documents(0), bytes(0), skipped(0) {
+
+}
+
+ExportException::ExportException(const std::string& message) : _message(message) {
+
+}
+
+const char* ExportException::what() const throw() {
+  return _message.c_str();
+}
+
+Exporter::Exporter(const std::string& host, const Credentials& credentials,
+    const ExportOptions& options) : _host(host), _credentials(credentials),
+    _options(options), _timestamp(0), _failed(false), _documents(0), _bytes(0),
+    _skipped(0)
+{
+  if (_options.partitions == 0) {
+    _options.partitions = 1;
+  }
+  if (_options.batch_size == 0) {
+    _options.batch_size = 1;
+  }
+}
+
+uint64_t Exporter::CaptureTimestamp(void) {
+  if (_timestamp != 0) {
+    return _timestamp;
+  }
+
+  AuthenticatingProxy proxy(_options.proxy);
+  proxy.AddCredentials(_credentials);
+  SearchQuery scope;
+  scope.Collection(_options.collection).Directory(_options.directory);
+  Response response = proxy.Get(_host, scope.Path(1, 0));
+  if (response.GetResponseCode() != ResponseCodes::OK) {
+    throw ExportException("Could not get the server timestamp, status " +
+        std::to_string((int)response.GetResponseCode()));
+  }
+
+  std::string timestamp = response.Header(EFFECTIVE_TIMESTAMP_HEADER);
+  if (timestamp.empty()) {
+    throw ExportException("The server did not send " + EFFECTIVE_TIMESTAMP_HEADER +
+        "; point in time reads need MarkLogic 9 or later");
+  }
+  _timestamp = std::stoull(timestamp);
+  MLLOG(LogLevel::INFO).Message("Export snapshot").Field("timestamp", _timestamp);
+  return _timestamp;
+}
+
+void Exporter::Fail(const std::string& error) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  MLLOG(LogLevel::SEVERE).Message("Export failed").Field("error", error);
+  if (_error.empty()) {
+    _error = error;
+  }
+  _failed = true;
+}
+
+std::vector<std::vector<std::string> > Exporter::ListRanges(void) {
+  SearchQuery query;
+  query.Collection(_options.collection).Directory(_options.directory)
+      .Structured(_options.query).Timestamp(_timestamp);
+
+  std::vector<std::string> uris;
+  try {
+    SearchResults results(_host, _credentials, query, _options.page_length,
+        _options.partitions, _options.proxy);
+    SearchResult result;
+    while (results.Next(result)) {
+      uris.push_back(std::move(result.uri));
+    }
+  } catch (const SearchException& e) {
+    throw ExportException(std::string("Could not list the documents: ") + e.what());
+  }
+  std::sort(uris.begin(), uris.end());
+
+  // Contiguous ranges whose sizes differ by at most one.
+  std::vector<std::vector<std::string> > ranges(_options.partitions);
+  size_t begin = 0;
+  for (size_t i = 0; i < ranges.size(); i++) {
+    size_t end = begin + uris.size() / ranges.size() + (i < uris.size() % ranges.size() ? 1 : 0);
+    ranges[i].assign(std::make_move_iterator(uris.begin() + begin),
+                     std::make_move_iterator(uris.begin() + end));
+    begin = end;
+  }
+  return ranges;
+}
+
+ExportSummary Exporter::Run(void) {
+  ExportSummary summary;
+  summary.timestamp = CaptureTimestamp();
+  _error.clear();
+  _failed = false;
+  _documents = 0;
+  _bytes = 0;
+  _skipped = 0;
+
+  std::vector<std::vector<std::string> > ranges;
+  std::vector<std::thread> workers;
+  if (_options.partitioning == ExportPartitioning::FOREST) {
+    if (_options.forests.empty()) {
+      throw ExportException("FOREST partitioning needs at least one forest name");
+    }
+    summary.partition_documents.assign(_options.forests.size(), 0);
+    for (size_t i = 0; i < _options.forests.size(); i++) {
+      workers.push_back(std::thread(&Exporter::ExportForest, this,
+          std::cref(_options.forests[i]), _credentials.Fork(),
+          std::ref(summary.partition_documents[i])));
+    }
+  } else {
+    ranges = ListRanges();
+    summary.partition_documents.assign(ranges.size(), 0);
+    for (size_t i = 0; i < ranges.size(); i++) {
+      workers.push_back(std::thread(&Exporter::ExportRange, this, std::cref(ranges[i]),
+          _credentials.Fork(), std::ref(summary.partition_documents[i])));
+    }
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  if (_failed) {
+    throw ExportException(_error);
+  }
+  summary.documents = _documents;
+  summary.bytes = _bytes;
+  summary.skipped = _skipped;
+  return summary;
+}
+
+void Exporter::ExportRange(const std::vector<std::string>& uris, Credentials credentials,
+    uint64_t& documents)
+{
+  AuthenticatingProxy proxy(_options.proxy);
+  proxy.AddCredentials(credentials);
+
+  std::vector<std::string> batch;
+  batch.reserve(_options.batch_size);
+  for (size_t i = 0; i < uris.size() && !_failed; i += _options.batch_size) {
+    batch.assign(uris.begin() + i, uris.begin() + std::min(uris.size(), i + _options.batch_size));
+    ExportBatch(proxy, batch, documents);
+  }
+}
+
+void Exporter::ExportForest(const std::string& forest, Credentials credentials,
+    uint64_t& documents)
+{
+  AuthenticatingProxy proxy(_options.proxy);
+  proxy.AddCredentials(credentials);
+  SearchQuery query;
+  query.Collection(_options.collection).Directory(_options.directory)
+      .Structured(_options.query).Forest(forest).Timestamp(_timestamp);
+
+  // The forest is listed and read at the same time: the listing's prefetch
+  // threads fetch the next pages of URIs while this one reads documents.
+  try {
+    SearchResults results(_host, credentials.Fork(), query, _options.page_length, 2,
+        _options.proxy);
+    std::vector<std::string> batch;
+    batch.reserve(_options.batch_size);
+    SearchResult result;
+    while (!_failed && results.Next(result)) {
+      batch.push_back(std::move(result.uri));
+      if (batch.size() == _options.batch_size) {
+        ExportBatch(proxy, batch, documents);
+        batch.clear();
+      }
+    }
+    if (!batch.empty() && !_failed) {
+      ExportBatch(proxy, batch, documents);
+    }
+  } catch (const SearchException& e) {
+    Fail("Could not list forest " + forest + ": " + e.what());
+  }
+}
+
+void Exporter::ExportBatch(AuthenticatingProxy& proxy, const std::vector<std::string>& uris,
+    uint64_t& documents)
+{
+  header_t headers;
+  headers["Accept"] = "multipart/mixed";
+  Response response = proxy.Get(_host, BulkReadPath(uris, _timestamp), headers);
+  if (response.GetResponseCode() != ResponseCodes::OK) {
+    Fail("Bulk read failed with status " + std::to_string((int)response.GetResponseCode()));
+    return;
+  }
+
+  try {
+    MultipartReader reader(response.Body(), MultipartReader::Boundary(
+        response.Header("Content-Type")));
+    MultipartPart part;
+    while (reader.Next(part)) {
+      std::string uri = part.Filename();
+      std::string path = OutputPath(_options.output_directory, uri);
+      if (path.empty()) {
+        MLLOG(LogLevel::WARNING).Message("Skipped a document that cannot be written safely")
+            .Field("uri", uri);
+        _skipped++;
+        continue;
+      }
+
+      CreateParentDirectories(path);
+      std::string target = _options.replace_files ? path + ".mlexport" : path;
+      {
+        std::ofstream out(target.c_str(), std::ios::binary | std::ios::trunc);
+        out.write(part.data, (std::streamsize)part.size);
+        if (!out) {
+          Fail("Could not write " + target);
+          return;
+        }
+      }
+      if (_options.replace_files && !ReplaceFile(target, path)) {
+        std::remove(target.c_str());
+        Fail("Could not replace " + path);
+        return;
+      }
+      documents++;
+      _documents++;
+      _bytes += part.size;
+    }
+  } catch (const MultipartException& e) {
+    Fail(std::string("Could not read the bulk response: ") + e.what());
+  }
+}
+
+std::string Exporter::BulkReadPath(const std::vector<std::string>& uris,
+    const uint64_t& timestamp)
+{
+  std::string path = "/v1/documents?category=content";
+  if (timestamp != 0) {
+    path += "&timestamp=" + std::to_string(timestamp);
+  }
+  for (auto& uri : uris) {
+    path += "&uri=" + web::uri::encode_data_string(uri);
+  }
+  return path;
+}
+
+std::string Exporter::OutputPath(const std::string& output_directory, const std::string& uri) {
+  if (uri.empty()) {
+    return std::string();
+  }
+
+  // Reject any ".." segment so a URI cannot write outside the directory.
+  size_t begin = 0;
+  while (begin <= uri.size()) {
+    size_t end = uri.find_first_of("/\\", begin);
+    if (end == std::string::npos) {
+      end = uri.size();
+    }
+    if (uri.compare(begin, end - begin, "..") == 0) {
+      return std::string();
+    }
+    begin = end + 1;
+  }
+
+  std::string path = output_directory;
+  if (!path.empty() && path[path.size() - 1] == '/') {
+    path.erase(path.size() - 1);
+  }
+  return path + (uri[0] == '/' ? "" : "/") + uri;
+}
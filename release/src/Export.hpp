@@ -0,0 +1,171 @@
+/*
+ * File:   Export.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef EXPORT_HPP
+#define	EXPORT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cpprest/json.h>
+
+#include "Credentials.hpp"
+#include "Pipeline.hpp"
+
+class AuthenticatingProxy;
+
+///
+/// How an export divides the documents between its workers.
+///
+enum class ExportPartitioning {
+    URI_RANGE,  /*!< List every URI, sort, and split into contiguous ranges */
+    FOREST      /*!< One partition per forest, each listed by its own worker */
+};
+
+///
+/// Settings for an Exporter.
+///
+struct ExportOptions {
+    std::string collection;         /*!< Export this collection... */
+    std::string directory;          /*!< ...and/or this directory */
+    web::json::value query;         /*!< A structured query the documents must also match */
+    ExportPartitioning partitioning;
+    unsigned partitions;            /*!< Workers for URI_RANGE */
+    std::vector<std::string> forests; /*!< Forest names for FOREST */
+    size_t batch_size;              /*!< Documents per bulk read */
+    uint64_t page_length;           /*!< URIs per search page while listing */
+    std::string output_directory;   /*!< Documents are written here, by URI */
+    bool replace_files;             /*!< Write each file beside its target and rename it over */
+    ProxyOptions proxy;             /*!< For the workers' proxies */
+
+    ExportOptions();
+};
+
+///
+/// What an export did.
+///
+struct ExportSummary {
+    uint64_t timestamp;                     /*!< The point in time exported */
+    uint64_t documents;
+    uint64_t bytes;
+    uint64_t skipped;                       /*!< URIs that could not be used as paths */
+    std::vector<uint64_t> partition_documents;
+
+    ExportSummary();
+};
+
+///
+/// Thrown when an export fails.
+///
+class ExportException : public std::exception {
+    std::string _message;
+public:
+    explicit ExportException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// Exports a collection or directory to files as one consistent snapshot.
+///
+/// The server's timestamp is captured once, from the ML-Effective-Timestamp
+/// header, and every request after that, the URI listing as well as the
+/// bulk reads, is pinned to it with timestamp=, so documents updated or
+/// deleted while the export runs are seen as they were when it started.
+/// The documents are split into partitions, by URI range or by forest, and
+/// each partition is read by its own worker thread with its own
+/// AuthenticatingProxy in batches of GET /v1/documents?uri=...&uri=...,
+/// which return a multipart body that is written out part by part.
+///
+///     ExportOptions options;
+///     options.directory = "/orders/";
+///     options.output_directory = "/var/tmp/orders";
+///     Exporter exporter("http://localhost:8000", proxy.GetCredentials(), options);
+///     ExportSummary summary = exporter.Run();
+///
+/// A document with URI /orders/1.json is written to
+/// /var/tmp/orders/orders/1.json.  With replace_files set it is written to
+/// 1.json.mlexport first and renamed, so a reader of the directory never
+/// sees half a document.  The server must be MarkLogic 9 or later,
+/// and the merge timestamp must hold old fragments for long enough for the
+/// export to finish.
+///
+class Exporter {
+    std::string _host;
+    Credentials _credentials;
+    ExportOptions _options;
+    uint64_t _timestamp;
+
+    std::mutex _mutex;
+    std::string _error;
+    std::atomic<bool> _failed;
+    std::atomic<uint64_t> _documents;
+    std::atomic<uint64_t> _bytes;
+    std::atomic<uint64_t> _skipped;
+
+    Exporter(const Exporter& orig);
+    Exporter& operator=(const Exporter& orig);
+
+    std::vector<std::vector<std::string> > ListRanges(void);
+    void ExportRange(const std::vector<std::string>& uris, Credentials credentials,
+                     uint64_t& documents);
+    void ExportForest(const std::string& forest, Credentials credentials,
+                      uint64_t& documents);
+    void ExportBatch(AuthenticatingProxy& proxy, const std::vector<std::string>& uris,
+                     uint64_t& documents);
+    void Fail(const std::string& error);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param credentials The credentials; each worker uses a Fork of them
+    /// \param options What to export and where
+    ///
+    Exporter(const std::string& host, const Credentials& credentials,
+             const ExportOptions& options);
+
+    ///
+    /// Asks the server for its current timestamp, the first time it is
+    /// called, and returns it.  Run calls this; call it earlier to fix the
+    /// snapshot before the export starts.
+    ///
+    /// \return The timestamp
+    ///
+    uint64_t CaptureTimestamp(void);
+
+    ///
+    /// Runs the export, returning once every partition has been written.
+    /// Throws ExportException if a request fails.
+    ///
+    /// \return The summary
+    ///
+    ExportSummary Run(void);
+
+    ///
+    /// Returns the bulk read request path for some URIs.
+    ///
+    /// \param uris The document URIs
+    /// \param timestamp The point in time, 0 for the latest state
+    /// \return The path and query string
+    ///
+    static std::string BulkReadPath(const std::vector<std::string>& uris,
+                                    const uint64_t& timestamp);
+
+    ///
+    /// Returns the file a document is written to.
+    ///
+    /// \param output_directory The export directory
+    /// \param uri The document URI
+    /// \return The path, empty if the URI has a ".." segment
+    ///
+    static std::string OutputPath(const std::string& output_directory,
+                                  const std::string& uri);
+};
+
+#endif	/* EXPORT_HPP */
@@ -0,0 +1,493 @@
+/*
+ * File:   Ingest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Ingest.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <cpprest/http_client.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+#include "AuthenticatingProxy.hpp"
+#include "Logger.hpp"
+#include "Response.hpp"
+
+namespace {
+
+const char CHECKPOINT_MAGIC[8] = { 'M', 'L', 'C', 'K', 'P', 'T', '0', '1' };
+const size_t CHECKPOINT_FLUSH = 64;
+const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+uint64_t Fnv1a(uint64_t hash, const void* data, const size_t& size) {
+  const unsigned char* bytes = (const unsigned char*)data;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+// Keys are written little endian whatever the platform, so a checkpoint
+// can be moved between machines.
+void EncodeKey(uint64_t key, unsigned char* out) {
+  for (size_t i = 0; i < 8; i++) {
+    out[i] = (unsigned char)(key & 0xff);
+    key >>= 8;
+  }
+}
+
+uint64_t DecodeKey(const unsigned char* in) {
+  uint64_t key = 0;
+  for (size_t i = 8; i > 0; i--) {
+    key = (key << 8) | in[i - 1];
+  }
+  return key;
+}
+
+///
+/// Replaces target with source, in one step where the platform allows.
+///
+bool ReplaceFile(const std::string& source, const std::string& target) {
+#ifdef _WIN32
+  return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return std::rename(source.c_str(), target.c_str()) == 0;
+#endif
+}
+
+std::string Join(const std::string& directory, const std::string& name) {
+  return directory.empty() ? name : directory + "/" + name;
+}
+
+}
+
+IngestOptions::IngestOptions() : uri_prefix("/"), directory_collections(false), threads(8),
+    progress_interval_ms(1000)
+{
+  content_types["json"] = "application/json";
+  content_types["xml"] = "application/xml";
+  content_types["xhtml"] = "application/xhtml+xml";
+  content_types["html"] = "text/html";
+  content_types["txt"] = "text/plain";
+  content_types["csv"] = "text/csv";
+  content_types["nt"] = "application/n-triples";
+  content_types["ttl"] = "text/turtle";
+  content_types["pdf"] = "application/pdf";
+  content_types["png"] = "image/png";
+  content_types["jpg"] = "image/jpeg";
+  content_types["jpeg"] = "image/jpeg";
+  content_types["gif"] = "image/gif";
+  content_types["zip"] = "application/zip";
+}
+
+IngestProgress::IngestProgress() : files(0), bytes(0), skipped(0), failed(0), seconds(0.0) {
+
+}
+
+double IngestProgress::FilesPerSecond(void) const {
+  return seconds > 0.0 ? (double)files / seconds : 0.0;
+}
+
+double IngestProgress::MegabytesPerSecond(void) const {
+  return seconds > 0.0 ? (double)bytes / (1024.0 * 1024.0) / seconds : 0.0;
+}
+
+IngestException::IngestException(const std::string& message) : _message(message) {
+
+}
+
+const char* IngestException::what() const throw() {
+  return _message.c_str();
+}
+
+Ingester::Ingester(const std::string& host, const Credentials& credentials,
+    const IngestOptions& options) : _host(host), _credentials(credentials), _options(options),
+    _outstanding(0), _checkpoint(nullptr), _unflushed(0), _files(0), _bytes(0), _skipped(0),
+    _failed(0)
+{
+  if (_options.threads == 0) {
+    _options.threads = 1;
+  }
+}
+
+Ingester::~Ingester() {
+  if (_checkpoint) {
+    std::fclose(_checkpoint);
+  }
+}
+
+std::string Ingester::UriFor(const std::string& prefix, const std::string& relative) {
+  if (!prefix.empty() && prefix[prefix.size() - 1] == '/' && !relative.empty() &&
+      relative[0] == '/') {
+    return prefix + relative.substr(1);
+  }
+  return prefix + relative;
+}
+
+std::string Ingester::ContentType(const IngestOptions& options, const std::string& relative) {
+  size_t dot = relative.rfind('.');
+  size_t slash = relative.rfind('/');
+  if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) {
+    std::string extension = relative.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        [](char c) { return (char)std::tolower((unsigned char)c); });
+    std::map<std::string, std::string>::const_iterator found =
+        options.content_types.find(extension);
+    if (found != options.content_types.end()) {
+      return found->second;
+    }
+  }
+  return "application/octet-stream";
+}
+
+uint64_t Ingester::CheckpointKey(const std::string& relative, const uint64_t& size,
+    const int64_t& modified)
+{
+  unsigned char fields[17];
+  fields[0] = 0;  // Ends the path, so "a1" + size 2 and "a" + size 12 differ
+  EncodeKey(size, fields + 1);
+  EncodeKey((uint64_t)modified, fields + 9);
+  uint64_t hash = Fnv1a(FNV_OFFSET, relative.data(), relative.size());
+  return Fnv1a(hash, fields, sizeof(fields));
+}
+
+void Ingester::OpenCheckpoint(void) {
+  _done.clear();
+  _unflushed = 0;
+  if (_options.checkpoint_path.empty()) {
+    return;
+  }
+
+  std::FILE* existing = std::fopen(_options.checkpoint_path.c_str(), "rb");
+  bool fresh = existing == nullptr;
+  if (existing) {
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    size_t read = std::fread(magic, 1, sizeof(magic), existing);
+    if (read == 0) {
+      fresh = true;
+    } else if (read != sizeof(magic) || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0) {
+      std::fclose(existing);
+      throw IngestException(_options.checkpoint_path + " is not a checkpoint");
+    }
+
+    // A run that crashed mid-write may leave a partial key at the end.
+    // That file is sent again, and the checkpoint is written afresh from
+    // the whole keys, since appending after the partial one would shift
+    // every key after it.  The new one is written beside it and moved
+    // over it, so a crash while rewriting loses none of the keys.
+    unsigned char key[8];
+    size_t read_key;
+    while ((read_key = std::fread(key, 1, sizeof(key), existing)) == sizeof(key)) {
+      _done.insert(DecodeKey(key));
+    }
+    std::fclose(existing);
+    if (read_key != 0) {
+      fresh = true;
+    }
+  }
+
+  if (fresh) {
+    std::string temporary = _options.checkpoint_path + ".tmp";
+    std::FILE* rewritten = std::fopen(temporary.c_str(), "wb");
+    if (!rewritten) {
+      throw IngestException("Could not open " + temporary);
+    }
+    std::fwrite(CHECKPOINT_MAGIC, 1, sizeof(CHECKPOINT_MAGIC), rewritten);
+    unsigned char encoded[8];
+    for (uint64_t done : _done) {
+      EncodeKey(done, encoded);
+      std::fwrite(encoded, 1, sizeof(encoded), rewritten);
+    }
+    bool written = std::fflush(rewritten) == 0 && !std::ferror(rewritten);
+    if (std::fclose(rewritten) != 0 || !written) {
+      throw IngestException("Could not write " + temporary);
+    }
+    if (!ReplaceFile(temporary, _options.checkpoint_path)) {
+      throw IngestException("Could not replace " + _options.checkpoint_path);
+    }
+  }
+
+  _checkpoint = std::fopen(_options.checkpoint_path.c_str(), "ab");
+  if (!_checkpoint) {
+    throw IngestException("Could not open " + _options.checkpoint_path);
+  }
+}
+
+bool Ingester::NextTask(const unsigned worker, Task& task) {
+  {
+    WorkQueue& own = *_queues[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      return true;
+    }
+  }
+
+  // Steal the oldest task, which for a tree walk is usually a directory
+  // near the root and so carries the most work with it.
+  for (size_t i = 1; i < _queues.size(); i++) {
+    WorkQueue& other = *_queues[(worker + i) % _queues.size()];
+    std::lock_guard<std::mutex> lock(other.mutex);
+    if (!other.tasks.empty()) {
+      task = std::move(other.tasks.front());
+      other.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void Ingester::ListDirectory(const unsigned worker, const Task& task) {
+  std::string directory = _options.input_directory + (task.relative.empty() ? "" : "/" +
+      task.relative);
+  std::vector<Task> found;
+
+#ifdef _WIN32
+  WIN32_FIND_DATAA entry;
+  HANDLE handle = FindFirstFileA((directory + "\\*").c_str(), &entry);
+  if (handle == INVALID_HANDLE_VALUE) {
+    Fail(task.relative, "Could not list the directory");
+    return;
+  }
+  do {
+    if (std::strcmp(entry.cFileName, ".") == 0 || std::strcmp(entry.cFileName, "..") == 0) {
+      continue;
+    }
+    Task child;
+    child.relative = Join(task.relative, entry.cFileName);
+    child.directory = (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+    child.size = ((uint64_t)entry.nFileSizeHigh << 32) | entry.nFileSizeLow;
+    uint64_t ticks = ((uint64_t)entry.ftLastWriteTime.dwHighDateTime << 32) |
+        entry.ftLastWriteTime.dwLowDateTime;
+    child.modified = (int64_t)((ticks - 116444736000000000ULL) / 10000000ULL);
+    found.push_back(std::move(child));
+  } while (FindNextFileA(handle, &entry));
+  FindClose(handle);
+#else
+  DIR* listing = opendir(directory.c_str());
+  if (!listing) {
+    Fail(task.relative, std::string("Could not list the directory: ") + std::strerror(errno));
+    return;
+  }
+  while (struct dirent* entry = readdir(listing)) {
+    if (std::strcmp(entry->d_name, ".") == 0 || std::strcmp(entry->d_name, "..") == 0) {
+      continue;
+    }
+    Task child;
+    child.relative = Join(task.relative, entry->d_name);
+    struct stat info;
+    if (stat((_options.input_directory + "/" + child.relative).c_str(), &info) != 0) {
+      Fail(child.relative, std::string("Could not stat the file: ") + std::strerror(errno));
+      continue;
+    }
+    if (!S_ISDIR(info.st_mode) && !S_ISREG(info.st_mode)) {
+      continue;
+    }
+    child.directory = S_ISDIR(info.st_mode);
+    child.size = (uint64_t)info.st_size;
+    child.modified = (int64_t)info.st_mtime;
+    found.push_back(std::move(child));
+  }
+  closedir(listing);
+#endif
+
+  // Counted before the directory itself is finished, so the count cannot
+  // touch zero while there is still work.
+  _outstanding += found.size();
+  WorkQueue& own = *_queues[worker];
+  std::lock_guard<std::mutex> lock(own.mutex);
+  for (auto& child : found) {
+    own.tasks.push_back(std::move(child));
+  }
+}
+
+void Ingester::LoadFile(AuthenticatingProxy& proxy, const Task& task) {
+  uint64_t key = CheckpointKey(task.relative, task.size, task.modified);
+  if (_done.count(key) > 0) {
+    _skipped++;
+    return;
+  }
+
+  std::string uri = UriFor(_options.uri_prefix, task.relative);
+  std::string path = "/v1/documents?uri=" + web::uri::encode_data_string(uri);
+  for (auto& collection : _options.collections) {
+    path += "&collection=" + web::uri::encode_data_string(collection);
+  }
+  size_t slash = task.relative.rfind('/');
+  if (_options.directory_collections && slash != std::string::npos) {
+    path += "&collection=" + web::uri::encode_data_string(
+        UriFor(_options.uri_prefix, task.relative.substr(0, slash + 1)));
+  }
+
+  header_t headers;
+  headers["Content-Type"] = ContentType(_options, task.relative);
+
+  try {
+    // A cheap request first, so the first file is not sent once just to be
+    // challenged for credentials.
+    if (!proxy.GetCredentials().Authenticating()) {
+      proxy.Get(_host, "/v1/search?format=json&pageLength=0");
+    }
+    Response response = proxy.PutFile(_host, path,
+        _options.input_directory + "/" + task.relative, headers);
+    int status = (int)response.GetResponseCode();
+    if (status < 200 || status > 299) {
+      Fail(task.relative, "Status " + std::to_string(status) +
+          (response.Body().empty() ? std::string() : ": " + response.Body().substr(0, 500)));
+      return;
+    }
+  } catch (const std::exception& e) {
+    Fail(task.relative, e.what());
+    return;
+  }
+
+  _files++;
+  _bytes += task.size;
+
+  if (_checkpoint) {
+    unsigned char encoded[8];
+    EncodeKey(key, encoded);
+    std::lock_guard<std::mutex> lock(_checkpoint_mutex);
+    std::fwrite(encoded, 1, sizeof(encoded), _checkpoint);
+    if (++_unflushed >= CHECKPOINT_FLUSH) {
+      std::fflush(_checkpoint);
+      _unflushed = 0;
+    }
+  }
+}
+
+void Ingester::Fail(const std::string& relative, const std::string& error) {
+  MLLOG(LogLevel::WARNING).Message("Ingest failed").Field("file", relative)
+      .Field("error", error);
+  _failed++;
+  std::lock_guard<std::mutex> lock(_failures_mutex);
+  _failures.push_back(std::make_pair(relative, error));
+}
+
+void Ingester::Work(const unsigned worker, Credentials credentials) {
+  AuthenticatingProxy proxy(_options.proxy);
+  proxy.AddCredentials(credentials);
+
+  Task task;
+  while (_outstanding > 0) {
+    if (!NextTask(worker, task)) {
+      // Everything left is being listed or loaded by someone else; what
+      // they list may yet be stolen.
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+    if (task.directory) {
+      ListDirectory(worker, task);
+    } else {
+      LoadFile(proxy, task);
+    }
+    _outstanding--;
+  }
+}
+
+IngestProgress Ingester::Progress(const double& seconds) const {
+  IngestProgress progress;
+  progress.files = _files;
+  progress.bytes = _bytes;
+  progress.skipped = _skipped;
+  progress.failed = _failed;
+  progress.seconds = seconds;
+  return progress;
+}
+
+IngestSummary Ingester::Run(const std::function<void(const IngestProgress&)>& progress) {
+#ifdef _WIN32
+  DWORD attributes = GetFileAttributesA(_options.input_directory.c_str());
+  if (attributes == INVALID_FILE_ATTRIBUTES || !(attributes & FILE_ATTRIBUTE_DIRECTORY)) {
+#else
+  struct stat info;
+  if (stat(_options.input_directory.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+#endif
+    throw IngestException(_options.input_directory + " is not a directory");
+  }
+  OpenCheckpoint();
+
+  _files = 0;
+  _bytes = 0;
+  _skipped = 0;
+  _failed = 0;
+  _failures.clear();
+  _queues.clear();
+  for (unsigned i = 0; i < _options.threads; i++) {
+    _queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+  }
+  Task root;
+  root.directory = true;
+  root.size = 0;
+  root.modified = 0;
+  _queues[0]->tasks.push_back(root);
+  _outstanding = 1;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  auto elapsed = [&start]() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  std::mutex reporter_mutex;
+  std::condition_variable reporter_wake;
+  bool finished = false;
+  std::thread reporter;
+  if (progress && _options.progress_interval_ms > 0) {
+    reporter = std::thread([&]() {
+      std::unique_lock<std::mutex> lock(reporter_mutex);
+      while (!reporter_wake.wait_for(lock,
+          std::chrono::milliseconds(_options.progress_interval_ms), [&finished]() {
+            return finished;
+          })) {
+        progress(Progress(elapsed()));
+      }
+    });
+  }
+
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < _options.threads; i++) {
+    workers.push_back(std::thread(&Ingester::Work, this, i, _credentials.Fork()));
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(reporter_mutex);
+    finished = true;
+  }
+  reporter_wake.notify_all();
+  if (reporter.joinable()) {
+    reporter.join();
+  }
+
+  if (_checkpoint) {
+    std::fclose(_checkpoint);
+    _checkpoint = nullptr;
+  }
+
+  IngestSummary summary;
+  summary.totals = Progress(elapsed());
+  summary.failures = _failures;
+  if (progress) {
+    progress(summary.totals);
+  }
+  return summary;
+}
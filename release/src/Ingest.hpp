@@ -0,0 +1,214 @@
+/*
+ * File:   Ingest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef INGEST_HPP
+#define	INGEST_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "Credentials.hpp"
+#include "Pipeline.hpp"
+
+class AuthenticatingProxy;
+
+///
+/// Settings for an Ingester.
+///
+struct IngestOptions {
+    std::string input_directory;        /*!< The tree to load */
+    std::string uri_prefix;             /*!< Prepended to each file's relative path */
+    std::vector<std::string> collections;   /*!< Added to every document */
+    bool directory_collections;         /*!< Also add the file's directory, as a URI */
+    std::map<std::string, std::string> content_types;  /*!< Extension ("json") to media type */
+    unsigned threads;
+    std::string checkpoint_path;        /*!< Empty for no checkpoint */
+    uint32_t progress_interval_ms;
+    ProxyOptions proxy;                 /*!< For the workers' proxies */
+
+    ///
+    /// Constructor.  Sets the usual extensions for JSON, XML, text and
+    /// common binary formats; anything else is sent as
+    /// application/octet-stream.
+    ///
+    IngestOptions();
+};
+
+///
+/// How far an ingest has got, passed to the progress callback.
+///
+struct IngestProgress {
+    uint64_t files;         /*!< Files loaded */
+    uint64_t bytes;         /*!< Bytes loaded */
+    uint64_t skipped;       /*!< Files the checkpoint says were loaded before */
+    uint64_t failed;
+    double   seconds;       /*!< Since the run started */
+
+    IngestProgress();
+
+    ///
+    /// Returns the files loaded per second.
+    ///
+    /// \return The rate
+    ///
+    double FilesPerSecond(void) const;
+
+    ///
+    /// Returns the megabytes (2^20 bytes) loaded per second.
+    ///
+    /// \return The rate
+    ///
+    double MegabytesPerSecond(void) const;
+};
+
+///
+/// What an ingest did.
+///
+struct IngestSummary {
+    IngestProgress totals;
+    std::vector<std::pair<std::string, std::string> > failures;  /*!< Path and error */
+};
+
+///
+/// Thrown when an ingest cannot start.
+///
+class IngestException : public std::exception {
+    std::string _message;
+public:
+    explicit IngestException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// Loads a directory tree into the database, a document per file.
+///
+/// The tree is walked and loaded by a pool of worker threads, each with its
+/// own AuthenticatingProxy.  Listing a directory queues its entries on the
+/// worker's own deque; a worker takes its newest task first and, when it
+/// has none, steals the oldest from another worker, so a deep or lopsided
+/// tree keeps every worker busy without a central queue.  Each file is
+/// streamed from disk with PUT /v1/documents.
+///
+///     IngestOptions options;
+///     options.input_directory = "/data/orders";
+///     options.uri_prefix = "/orders/";
+///     options.checkpoint_path = "orders.ckpt";
+///     Ingester ingester("http://localhost:8000", proxy.GetCredentials(), options);
+///     IngestSummary summary = ingester.Run();
+///
+/// With a checkpoint, every loaded file is recorded as an 8 byte hash of
+/// its path, size and modification time.  A run that finds the checkpoint
+/// from an earlier one skips the files it lists, so a crashed load can be
+/// run again and only sends what is left, plus anything changed since.
+///
+class Ingester {
+    struct Task {
+        std::string relative;   /*!< Path below input_directory, '/' separated */
+        bool directory;
+        uint64_t size;
+        int64_t modified;       /*!< Seconds since the epoch */
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::string _host;
+    Credentials _credentials;
+    IngestOptions _options;
+
+    std::vector<std::unique_ptr<WorkQueue> > _queues;
+    std::atomic<uint64_t> _outstanding;     /*!< Tasks queued or running */
+
+    std::unordered_set<uint64_t> _done;     /*!< Loaded by earlier runs */
+    std::FILE* _checkpoint;
+    std::mutex _checkpoint_mutex;
+    size_t _unflushed;                      /*!< Keys written since the last fflush */
+
+    std::atomic<uint64_t> _files;
+    std::atomic<uint64_t> _bytes;
+    std::atomic<uint64_t> _skipped;
+    std::atomic<uint64_t> _failed;
+    std::mutex _failures_mutex;
+    std::vector<std::pair<std::string, std::string> > _failures;
+
+    Ingester(const Ingester& orig);
+    Ingester& operator=(const Ingester& orig);
+
+    void OpenCheckpoint(void);
+    void Work(const unsigned worker, Credentials credentials);
+    bool NextTask(const unsigned worker, Task& task);
+    void ListDirectory(const unsigned worker, const Task& task);
+    void LoadFile(AuthenticatingProxy& proxy, const Task& task);
+    void Fail(const std::string& relative, const std::string& error);
+    IngestProgress Progress(const double& seconds) const;
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param credentials The credentials; each worker uses a Fork of them
+    /// \param options What to load and how
+    ///
+    Ingester(const std::string& host, const Credentials& credentials,
+             const IngestOptions& options);
+    ~Ingester();
+
+    ///
+    /// Loads the tree, returning once every file has been tried.  Throws
+    /// IngestException if the checkpoint cannot be opened.  A file that
+    /// cannot be loaded is recorded in the summary and the rest carry on.
+    ///
+    /// \param progress Called every progress_interval_ms from another
+    ///        thread, and once at the end; may be empty
+    /// \return The summary
+    ///
+    IngestSummary Run(const std::function<void(const IngestProgress&)>& progress =
+                      std::function<void(const IngestProgress&)>());
+
+    ///
+    /// Returns the URI for a file.
+    ///
+    /// \param prefix The URI prefix ("/orders/")
+    /// \param relative The file's path below the input directory
+    /// \return The URI
+    ///
+    static std::string UriFor(const std::string& prefix, const std::string& relative);
+
+    ///
+    /// Returns the media type for a file, by its extension.
+    ///
+    /// \param options The extension mapping
+    /// \param relative The file's path
+    /// \return The media type
+    ///
+    static std::string ContentType(const IngestOptions& options, const std::string& relative);
+
+    ///
+    /// Returns the checkpoint key for a file.
+    ///
+    /// \param relative The file's path below the input directory
+    /// \param size Its size in bytes
+    /// \param modified Its modification time
+    /// \return The key
+    ///
+    static uint64_t CheckpointKey(const std::string& relative, const uint64_t& size,
+                                  const int64_t& modified);
+};
+
+#endif	/* INGEST_HPP */
@@ -0,0 +1,100 @@
+/*
+ * File:   JsonBind.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "JsonBind.hpp"
+
+namespace {
+
+///
+/// Reads the digits of an integer into its magnitude, failing on a
+/// fraction, an exponent or anything over the limit.
+///
+uint64_t ParseMagnitude(JsonScanner& scanner, const std::string& text, const size_t& begin,
+    const uint64_t& limit)
+{
+  uint64_t value = 0;
+  for (size_t i = begin; i < text.size(); i++) {
+    if (text[i] < '0' || text[i] > '9') {
+      throw JsonParseException("Expected an integer", scanner.Offset() - text.size());
+    }
+    if (value > (limit - (uint64_t)(text[i] - '0')) / 10) {
+      throw JsonParseException("Integer out of range", scanner.Offset() - text.size());
+    }
+    value = value * 10 + (uint64_t)(text[i] - '0');
+  }
+  if (begin == text.size()) {
+    throw JsonParseException("Expected an integer", scanner.Offset() - text.size());
+  }
+  return value;
+}
+
+}
+
+int64_t JsonBind::ReadInteger(JsonScanner& scanner, const int64_t& min, const int64_t& max) {
+  Expect(scanner, JsonToken::NUMBER, "an integer");
+  std::string text;
+  scanner.ReadNumber(text);
+  if (!text.empty() && text[0] == '-') {
+    uint64_t magnitude = ParseMagnitude(scanner, text, 1, (uint64_t)-(min + 1) + 1);
+    return (int64_t)(0 - magnitude);
+  }
+  return (int64_t)ParseMagnitude(scanner, text, 0, (uint64_t)max);
+}
+
+uint64_t JsonBind::ReadUnsigned(JsonScanner& scanner, const uint64_t& max) {
+  Expect(scanner, JsonToken::NUMBER, "an unsigned integer");
+  std::string text;
+  scanner.ReadNumber(text);
+  return ParseMagnitude(scanner, text, 0, max);
+}
+
+void JsonBind::Expect(JsonScanner& scanner, const JsonToken& token, const char* what) {
+  if (scanner.Peek() != token) {
+    throw JsonParseException(std::string("Expected ") + what, scanner.Offset());
+  }
+}
+
+void JsonBind::ExpectEnd(JsonScanner& scanner) {
+  if (scanner.Peek() != JsonToken::END) {
+    throw JsonParseException("Expected the end of the document", scanner.Offset());
+  }
+}
+
+bool JsonBind::FindResultContent(JsonScanner& scanner) {
+  if (scanner.Peek() != JsonToken::OBJECT) {
+    return false;
+  }
+
+  std::string key;
+  scanner.BeginObject();
+  while (scanner.NextMember(key)) {
+    if (key == "content") {
+      return true;
+    } else if (key == "extracted" && scanner.Peek() == JsonToken::OBJECT) {
+      scanner.BeginObject();
+      while (scanner.NextMember(key)) {
+        if (key == "content" && scanner.Peek() == JsonToken::ARRAY) {
+          scanner.BeginArray();
+          return scanner.NextElement();
+        }
+        scanner.Skip();
+      }
+    } else {
+      scanner.Skip();
+    }
+  }
+  return false;
+}
+
+void JsonBind::Read(JsonScanner& scanner, std::string& value) {
+  Expect(scanner, JsonToken::STRING, "a string");
+  scanner.ReadString(value);
+}
+
+void JsonBind::Read(JsonScanner& scanner, bool& value) {
+  Expect(scanner, JsonToken::BOOLEAN, "true or false");
+  value = scanner.ReadBoolean();
+}
@@ -0,0 +1,275 @@
+/*
+ * File:   JsonBind.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef JSONBIND_HPP
+#define	JSONBIND_HPP
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "JsonScanner.hpp"
+
+///
+/// Declares how a struct is read from JSON.  Specialize it for each struct
+/// with a Bind that names every field it wants:
+///
+///     struct Person {
+///         std::string name;
+///         int age;
+///         std::vector<std::string> tags;
+///     };
+///
+///     template<> struct JsonBinding<Person> {
+///         template<typename Fields>
+///         static void Bind(Fields& fields, Person& person) {
+///             fields("name", person.name);
+///             fields("age", person.age);
+///             fields("tags", person.tags);
+///         }
+///     };
+///
+/// Fields may be strings, bool, integers, floating point numbers, other
+/// bound structs, and std::vector or std::map<std::string, ...> of any of
+/// them.
+///
+template<typename T>
+struct JsonBinding {
+    static_assert(sizeof(T) == 0, "Specialize JsonBinding<T> to read T from JSON");
+};
+
+///
+/// One page of a /v1/search response with each result read into a T.
+///
+template<typename T>
+struct TypedSearchPage {
+    uint64_t total;         /*!< Matching documents; an estimate for unfiltered searches */
+    uint64_t start;
+    uint64_t page_length;
+    std::vector<T> results;
+
+    TypedSearchPage() : total(0), start(0), page_length(0) {
+    }
+};
+
+///
+/// Reads JSON text straight into bound structs.  The text is walked once
+/// with a JsonScanner: members a binding names are decoded into their
+/// fields, and everything else is skipped without being copied, so no
+/// web::json::value is built and unknown fields never reach memory.  The
+/// matching is resolved at compile time; there is no virtual call or table
+/// per field.
+///
+///     Person person;
+///     JsonBind::Decode(response.Body(), person);
+///
+/// A member that is missing or null leaves its field as it was.  A value
+/// of the wrong kind, or an integer out of range for its field, throws
+/// JsonParseException, as does text that is not JSON.
+///
+class JsonBind {
+    JsonBind();
+
+    template<typename T>
+    class FieldReader {
+        JsonScanner& _scanner;
+        const std::string& _key;
+        bool _matched;
+    public:
+        FieldReader(JsonScanner& scanner, const std::string& key) : _scanner(scanner),
+            _key(key), _matched(false) {
+        }
+
+        template<typename F>
+        void operator()(const char* name, F& field) {
+            if (!_matched && _key == name) {
+                _matched = true;
+                if (_scanner.Peek() == JsonToken::NULL_VALUE) {
+                    _scanner.ReadNull();
+                } else {
+                    Read(_scanner, field);
+                }
+            }
+        }
+
+        bool Matched(void) const {
+            return _matched;
+        }
+    };
+
+    static int64_t ReadInteger(JsonScanner& scanner, const int64_t& min, const int64_t& max);
+    static uint64_t ReadUnsigned(JsonScanner& scanner, const uint64_t& max);
+    static void Expect(JsonScanner& scanner, const JsonToken& token, const char* what);
+    static void ExpectEnd(JsonScanner& scanner);
+    static bool FindResultContent(JsonScanner& scanner);
+public:
+    ///
+    /// Reads a whole document.
+    ///
+    /// \param data The JSON text
+    /// \param size Its length in bytes
+    /// \param value Filled in from the document
+    ///
+    template<typename T>
+    static void Decode(const char* data, const size_t& size, T& value) {
+        JsonScanner scanner(data, size);
+        Read(scanner, value);
+        ExpectEnd(scanner);
+    }
+
+    ///
+    /// Reads a whole document.
+    ///
+    /// \param body The JSON text
+    /// \param value Filled in from the document
+    ///
+    template<typename T>
+    static void Decode(const std::string& body, T& value) {
+        Decode(body.data(), body.size(), value);
+    }
+
+    ///
+    /// Reads a /v1/search response.  Each result is read from its document
+    /// when the search returns one, as "content" (transform-results raw)
+    /// or as the first of "extracted"."content" (extract-document-data);
+    /// otherwise from the result itself, so a binding may name "uri",
+    /// "score" and the like.
+    ///
+    /// \param body The response body
+    /// \param page Filled in with the page
+    ///
+    template<typename T>
+    static void DecodeSearchPage(const std::string& body, TypedSearchPage<T>& page) {
+        page = TypedSearchPage<T>();
+        JsonScanner scanner(body.data(), body.size());
+        std::string key;
+        Expect(scanner, JsonToken::OBJECT, "a search response");
+        scanner.BeginObject();
+        while (scanner.NextMember(key)) {
+            if (key == "total") {
+                page.total = ReadUnsigned(scanner, std::numeric_limits<uint64_t>::max());
+            } else if (key == "start") {
+                page.start = ReadUnsigned(scanner, std::numeric_limits<uint64_t>::max());
+            } else if (key == "page-length") {
+                page.page_length = ReadUnsigned(scanner, std::numeric_limits<uint64_t>::max());
+            } else if (key == "results" && scanner.Peek() == JsonToken::ARRAY) {
+                page.results.reserve((size_t)page.page_length);
+                scanner.BeginArray();
+                while (scanner.NextElement()) {
+                    page.results.push_back(T());
+                    ReadResult(scanner, page.results.back());
+                }
+            } else {
+                scanner.Skip();
+            }
+        }
+        ExpectEnd(scanner);
+    }
+
+    ///
+    /// Reads the value at the scanner's position into a bound struct.  Use
+    /// it to read a bound struct out of a larger document.
+    ///
+    /// \param scanner The scanner
+    /// \param value Filled in from the object
+    ///
+    template<typename T>
+    static typename std::enable_if<!std::is_arithmetic<T>::value>::type
+    Read(JsonScanner& scanner, T& value) {
+        Expect(scanner, JsonToken::OBJECT, "an object");
+        std::string key;
+        scanner.BeginObject();
+        while (scanner.NextMember(key)) {
+            FieldReader<T> reader(scanner, key);
+            JsonBinding<T>::Bind(reader, value);
+            if (!reader.Matched()) {
+                scanner.Skip();
+            }
+        }
+    }
+
+    static void Read(JsonScanner& scanner, std::string& value);
+    static void Read(JsonScanner& scanner, bool& value);
+
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+    Read(JsonScanner& scanner, T& value) {
+        value = (T)ReadInteger(scanner, std::numeric_limits<T>::min(),
+            std::numeric_limits<T>::max());
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type
+    Read(JsonScanner& scanner, T& value) {
+        value = (T)ReadUnsigned(scanner, std::numeric_limits<T>::max());
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type
+    Read(JsonScanner& scanner, T& value) {
+        Expect(scanner, JsonToken::NUMBER, "a number");
+        value = (T)scanner.ReadNumber();
+    }
+
+    ///
+    /// Reads an array, appending its elements; null elements are appended
+    /// as T().
+    ///
+    template<typename T>
+    static void Read(JsonScanner& scanner, std::vector<T>& values) {
+        Expect(scanner, JsonToken::ARRAY, "an array");
+        scanner.BeginArray();
+        while (scanner.NextElement()) {
+            values.push_back(T());
+            if (scanner.Peek() == JsonToken::NULL_VALUE) {
+                scanner.ReadNull();
+            } else {
+                Read(scanner, values.back());
+            }
+        }
+    }
+
+    ///
+    /// Reads an object with arbitrary keys; null members are stored as T().
+    ///
+    template<typename T>
+    static void Read(JsonScanner& scanner, std::map<std::string, T>& values) {
+        Expect(scanner, JsonToken::OBJECT, "an object");
+        std::string key;
+        scanner.BeginObject();
+        while (scanner.NextMember(key)) {
+            T& value = values[key];
+            if (scanner.Peek() == JsonToken::NULL_VALUE) {
+                scanner.ReadNull();
+            } else {
+                Read(scanner, value);
+            }
+        }
+    }
+
+private:
+    template<typename T>
+    static void ReadResult(JsonScanner& scanner, T& value) {
+        // A second scanner looks ahead for the document, which can come
+        // after any number of other members; the first then skips the lot.
+        JsonScanner probe = scanner;
+        if (!FindResultContent(probe)) {
+            Read(scanner, value);
+        } else {
+            if (probe.Peek() == JsonToken::NULL_VALUE) {
+                probe.ReadNull();
+            } else {
+                Read(probe, value);
+            }
+            scanner.Skip();
+        }
+    }
+};
+
+#endif	/* JSONBIND_HPP */
@@ -0,0 +1,336 @@
+/*
+ * File:   JsonScanner.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "JsonScanner.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+JsonParseException::JsonParseException(const std::string& message, const size_t& offset) :
+    _message(message + " at offset " + std::to_string(offset))
+{
+
+}
+
+const char* JsonParseException::what() const throw() {
+  return _message.c_str();
+}
+
+JsonScanner::JsonScanner(const char* data, const size_t& size) : _begin(data),
+    _pos(data), _end(data + size), _first(0), _depth(0)
+{
+
+}
+
+void JsonScanner::Fail(const std::string& message) const {
+  throw JsonParseException(message, Offset());
+}
+
+void JsonScanner::SkipWhitespace(void) {
+  while (_pos < _end && (*_pos == ' ' || *_pos == '\n' || *_pos == '\r' || *_pos == '\t')) {
+    _pos++;
+  }
+}
+
+void JsonScanner::Expect(const char& c) {
+  SkipWhitespace();
+  if (_pos >= _end || *_pos != c) {
+    Fail(std::string("Expected '") + c + "'");
+  }
+  _pos++;
+}
+
+void JsonScanner::Push(void) {
+  if (_depth >= MAX_DEPTH) {
+    Fail("Nested too deeply");
+  }
+  _first |= (uint64_t)1 << _depth;
+  _depth++;
+}
+
+bool JsonScanner::NextInContainer(const char& close) {
+  if (_depth == 0) {
+    Fail("Not in an object or array");
+  }
+
+  SkipWhitespace();
+  if (_pos < _end && *_pos == close) {
+    _pos++;
+    _depth--;
+    return false;
+  }
+
+  uint64_t bit = (uint64_t)1 << (_depth - 1);
+  if (_first & bit) {
+    _first &= ~bit;
+  } else {
+    Expect(',');
+  }
+  SkipWhitespace();
+  return true;
+}
+
+JsonToken JsonScanner::Peek(void) {
+  SkipWhitespace();
+  if (_pos >= _end) {
+    return JsonToken::END;
+  }
+
+  switch (*_pos) {
+    case '{':
+      return JsonToken::OBJECT;
+    case '[':
+      return JsonToken::ARRAY;
+    case '"':
+      return JsonToken::STRING;
+    case 't':
+    case 'f':
+      return JsonToken::BOOLEAN;
+    case 'n':
+      return JsonToken::NULL_VALUE;
+    default:
+      if (*_pos == '-' || (*_pos >= '0' && *_pos <= '9')) {
+        return JsonToken::NUMBER;
+      }
+  }
+  Fail("Unexpected character");
+  return JsonToken::END;
+}
+
+void JsonScanner::BeginObject(void) {
+  Expect('{');
+  Push();
+}
+
+bool JsonScanner::NextMember(std::string& key) {
+  if (!NextInContainer('}')) {
+    return false;
+  }
+  ReadString(key);
+  Expect(':');
+  SkipWhitespace();
+  return true;
+}
+
+void JsonScanner::BeginArray(void) {
+  Expect('[');
+  Push();
+}
+
+bool JsonScanner::NextElement(void) {
+  return NextInContainer(']');
+}
+
+uint32_t JsonScanner::ReadHex4(void) {
+  if (_end - _pos < 4) {
+    Fail("Truncated \\u escape");
+  }
+
+  uint32_t value = 0;
+  for (int i = 0; i < 4; i++, _pos++) {
+    char c = *_pos;
+    value <<= 4;
+    if (c >= '0' && c <= '9') {
+      value |= (uint32_t)(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      value |= (uint32_t)(c - 'a' + 10);
+    } else if (c >= 'A' && c <= 'F') {
+      value |= (uint32_t)(c - 'A' + 10);
+    } else {
+      Fail("Bad \\u escape");
+    }
+  }
+  return value;
+}
+
+void JsonScanner::AppendCodePoint(std::string& value, uint32_t code_point) {
+  if (code_point < 0x80) {
+    value.push_back((char)code_point);
+  } else if (code_point < 0x800) {
+    value.push_back((char)(0xc0 | (code_point >> 6)));
+    value.push_back((char)(0x80 | (code_point & 0x3f)));
+  } else if (code_point < 0x10000) {
+    value.push_back((char)(0xe0 | (code_point >> 12)));
+    value.push_back((char)(0x80 | ((code_point >> 6) & 0x3f)));
+    value.push_back((char)(0x80 | (code_point & 0x3f)));
+  } else {
+    value.push_back((char)(0xf0 | (code_point >> 18)));
+    value.push_back((char)(0x80 | ((code_point >> 12) & 0x3f)));
+    value.push_back((char)(0x80 | ((code_point >> 6) & 0x3f)));
+    value.push_back((char)(0x80 | (code_point & 0x3f)));
+  }
+}
+
+void JsonScanner::ReadString(std::string& value) {
+  Expect('"');
+  value.clear();
+
+  while (true) {
+    const char* run = _pos;
+    while (_pos < _end && *_pos != '"' && *_pos != '\\') {
+      _pos++;
+    }
+    value.append(run, (size_t)(_pos - run));
+
+    if (_pos >= _end) {
+      Fail("Unterminated string");
+    }
+    if (*_pos++ == '"') {
+      return;
+    }
+
+    if (_pos >= _end) {
+      Fail("Unterminated string");
+    }
+    switch (*_pos++) {
+      case '"':
+        value.push_back('"');
+        break;
+      case '\\':
+        value.push_back('\\');
+        break;
+      case '/':
+        value.push_back('/');
+        break;
+      case 'b':
+        value.push_back('\b');
+        break;
+      case 'f':
+        value.push_back('\f');
+        break;
+      case 'n':
+        value.push_back('\n');
+        break;
+      case 'r':
+        value.push_back('\r');
+        break;
+      case 't':
+        value.push_back('\t');
+        break;
+      case 'u': {
+        uint32_t code_point = ReadHex4();
+        if (code_point >= 0xd800 && code_point < 0xdc00 && _end - _pos >= 6 &&
+            _pos[0] == '\\' && _pos[1] == 'u') {
+          _pos += 2;
+          uint32_t low = ReadHex4();
+          code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+        }
+        AppendCodePoint(value, code_point);
+        break;
+      }
+      default:
+        Fail("Bad escape");
+    }
+  }
+}
+
+std::string JsonScanner::ReadString(void) {
+  std::string value;
+  ReadString(value);
+  return value;
+}
+
+double JsonScanner::ReadNumber(void) {
+  SkipWhitespace();
+  char buffer[64];
+  size_t length = 0;
+  while (_pos < _end && length < sizeof(buffer) - 1 &&
+      ((*_pos >= '0' && *_pos <= '9') || *_pos == '-' || *_pos == '+' ||
+       *_pos == '.' || *_pos == 'e' || *_pos == 'E')) {
+    buffer[length++] = *_pos++;
+  }
+  buffer[length] = '\0';
+
+  char* parsed = nullptr;
+  double value = std::strtod(buffer, &parsed);
+  if (length == 0 || parsed != buffer + length) {
+    Fail("Expected a number");
+  }
+  return value;
+}
+
+void JsonScanner::ReadNumber(std::string& text) {
+  SkipWhitespace();
+  const char* start = _pos;
+  ReadNumber();
+  text.assign(start, (size_t)(_pos - start));
+}
+
+void JsonScanner::ReadLiteral(const char* literal) {
+  size_t length = std::strlen(literal);
+  if ((size_t)(_end - _pos) < length || std::strncmp(_pos, literal, length) != 0) {
+    Fail(std::string("Expected ") + literal);
+  }
+  _pos += length;
+}
+
+bool JsonScanner::ReadBoolean(void) {
+  SkipWhitespace();
+  if (_pos < _end && *_pos == 't') {
+    ReadLiteral("true");
+    return true;
+  }
+  ReadLiteral("false");
+  return false;
+}
+
+void JsonScanner::ReadNull(void) {
+  SkipWhitespace();
+  ReadLiteral("null");
+}
+
+void JsonScanner::Skip(void) {
+  switch (Peek()) {
+    case JsonToken::STRING:
+      _pos++;
+      while (_pos < _end && *_pos != '"') {
+        _pos += *_pos == '\\' ? 2 : 1;
+      }
+      if (_pos >= _end) {
+        Fail("Unterminated string");
+      }
+      _pos++;
+      break;
+    case JsonToken::NUMBER:
+      ReadNumber();
+      break;
+    case JsonToken::BOOLEAN:
+      ReadBoolean();
+      break;
+    case JsonToken::NULL_VALUE:
+      ReadNull();
+      break;
+    case JsonToken::OBJECT:
+    case JsonToken::ARRAY: {
+      // Brackets only need counting, not matching, to find the end; the
+      // text is assumed to be well formed inside values that are skipped.
+      int depth = 0;
+      do {
+        if (_pos >= _end) {
+          Fail("Unterminated object or array");
+        }
+        char c = *_pos++;
+        if (c == '{' || c == '[') {
+          depth++;
+        } else if (c == '}' || c == ']') {
+          depth--;
+        } else if (c == '"') {
+          while (_pos < _end && *_pos != '"') {
+            _pos += *_pos == '\\' ? 2 : 1;
+          }
+          _pos++;
+        }
+      } while (depth > 0);
+      break;
+    }
+    case JsonToken::END:
+      Fail("Unexpected end of text");
+  }
+}
+
+size_t JsonScanner::Offset(void) const {
+  return (size_t)(_pos - _begin);
+}
@@ -0,0 +1,169 @@
+/*
+ * File:   JsonScanner.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef JSONSCANNER_HPP
+#define	JSONSCANNER_HPP
+
+#include <cstdint>
+#include <exception>
+#include <string>
+
+///
+/// The kind of value at the scanner's position.
+///
+enum class JsonToken { OBJECT, ARRAY, STRING, NUMBER, BOOLEAN, NULL_VALUE, END };
+
+///
+/// Thrown when the scanner meets text that is not valid JSON.
+///
+class JsonParseException : public std::exception {
+    std::string _message;
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param message What was wrong
+    /// \param offset Where in the text it was found
+    ///
+    JsonParseException(const std::string& message, const size_t& offset);
+
+    virtual const char* what() const throw() override;
+};
+
+///
+/// A forward only pull parser over JSON text.  The caller walks the document
+/// by asking for the members and elements it expects and skipping the rest,
+/// so only the values that are actually wanted are ever copied out; nothing
+/// builds a tree.  Use it to read large responses, such as search pages,
+/// where a web::json::value would allocate a node for every value.
+///
+///     JsonScanner scanner(body.data(), body.size());
+///     std::string key;
+///     scanner.BeginObject();
+///     while (scanner.NextMember(key)) {
+///         if (key == "total") {
+///             total = (uint64_t)scanner.ReadNumber();
+///         } else {
+///             scanner.Skip();
+///         }
+///     }
+///
+/// The text must outlive the scanner.  Objects and arrays nest up to 64 deep
+/// through Begin/Next; Skip handles any depth.
+///
+class JsonScanner {
+    static const int MAX_DEPTH = 64;
+
+    const char* _begin;
+    const char* _pos;
+    const char* _end;
+    uint64_t _first;    /*!< Bit n set until container n has had a member */
+    int _depth;
+
+    void SkipWhitespace(void);
+    void Expect(const char& c);
+    void Push(void);
+    bool NextInContainer(const char& close);
+    void ReadLiteral(const char* literal);
+    void AppendCodePoint(std::string& value, uint32_t code_point);
+    uint32_t ReadHex4(void);
+    void Fail(const std::string& message) const;
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param data The JSON text
+    /// \param size Its length in bytes
+    ///
+    JsonScanner(const char* data, const size_t& size);
+
+    ///
+    /// Returns the kind of the next value without consuming it.
+    ///
+    /// \return The token, END if only whitespace remains
+    ///
+    JsonToken Peek(void);
+
+    ///
+    /// Consumes the '{' that starts an object.
+    ///
+    void BeginObject(void);
+
+    ///
+    /// Moves to the next member of the current object.
+    ///
+    /// \param key Set to the member's key
+    /// \return False, having consumed the closing '}', if there are no more
+    ///
+    bool NextMember(std::string& key);
+
+    ///
+    /// Consumes the '[' that starts an array.
+    ///
+    void BeginArray(void);
+
+    ///
+    /// Moves to the next element of the current array.
+    ///
+    /// \return False, having consumed the closing ']', if there are no more
+    ///
+    bool NextElement(void);
+
+    ///
+    /// Reads a string, decoding escapes to UTF-8.
+    ///
+    /// \param value Set to the string
+    ///
+    void ReadString(std::string& value);
+
+    ///
+    /// Reads a string.
+    ///
+    /// \return The string
+    ///
+    std::string ReadString(void);
+
+    ///
+    /// Reads a number.
+    ///
+    /// \return The number
+    ///
+    double ReadNumber(void);
+
+    ///
+    /// Reads a number as it is written, for values such as 64 bit integers
+    /// that would lose precision as a double.
+    ///
+    /// \param text Set to the number's text
+    ///
+    void ReadNumber(std::string& text);
+
+    ///
+    /// Reads true or false.
+    ///
+    /// \return The value
+    ///
+    bool ReadBoolean(void);
+
+    ///
+    /// Reads null.
+    ///
+    void ReadNull(void);
+
+    ///
+    /// Skips the next value, whatever it is, including everything inside it.
+    ///
+    void Skip(void);
+
+    ///
+    /// Returns the scanner's position.
+    ///
+    /// \return The offset in bytes from the start of the text
+    ///
+    size_t Offset(void) const;
+};
+
+#endif	/* JSONSCANNER_HPP */
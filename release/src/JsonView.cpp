@@ -0,0 +1,515 @@
+/*
+ * File:   JsonView.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "JsonView.hpp"
+
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JSONVIEW_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+const uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+
+///
+/// The quotes, backslashes and structural characters of a 64 byte block, a
+/// bit per byte.
+///
+struct BlockMasks {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t structural;
+};
+
+#ifdef JSONVIEW_SSE2
+inline uint64_t Mask(const __m128i& matches, const int& shift) {
+  return (uint64_t)(uint16_t)_mm_movemask_epi8(matches) << shift;
+}
+
+void Classify(const char* block, BlockMasks& masks) {
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  // '[' and ']' are '{' and '}' without the 0x20 bit, and no other byte
+  // becomes either with it set.
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  const __m128i open = _mm_set1_epi8('{');
+  const __m128i close = _mm_set1_epi8('}');
+  const __m128i colon = _mm_set1_epi8(':');
+  const __m128i comma = _mm_set1_epi8(',');
+
+  masks.quote = 0;
+  masks.backslash = 0;
+  masks.structural = 0;
+  for (int i = 0; i < 4; i++) {
+    __m128i bytes = _mm_loadu_si128((const __m128i*)(block + 16 * i));
+    __m128i folded = _mm_or_si128(bytes, case_bit);
+    __m128i structural = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)),
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, colon), _mm_cmpeq_epi8(bytes, comma)));
+    masks.quote |= Mask(_mm_cmpeq_epi8(bytes, quote), 16 * i);
+    masks.backslash |= Mask(_mm_cmpeq_epi8(bytes, backslash), 16 * i);
+    masks.structural |= Mask(structural, 16 * i);
+  }
+}
+#else
+void Classify(const char* block, BlockMasks& masks) {
+  masks.quote = 0;
+  masks.backslash = 0;
+  masks.structural = 0;
+  for (int i = 0; i < 64; i++) {
+    uint64_t bit = (uint64_t)1 << i;
+    switch (block[i]) {
+      case '"': masks.quote |= bit; break;
+      case '\\': masks.backslash |= bit; break;
+      case '{': case '}': case '[': case ']': case ':': case ',':
+        masks.structural |= bit;
+        break;
+    }
+  }
+}
+#endif
+
+///
+/// Returns the characters escaped by an odd run of backslashes.  escaped
+/// carries whether the next block's first character is escaped.
+///
+inline uint64_t FindEscaped(uint64_t backslash, uint64_t& escaped) {
+  const uint64_t EVEN_BITS = 0x5555555555555555ULL;
+  backslash &= ~escaped;
+  uint64_t follows_escape = backslash << 1 | escaped;
+  // Adding the starts of the runs that begin on odd bits to the runs
+  // carries through each run, and leaves the bit after it set or clear
+  // according to the run's length.
+  uint64_t odd_starts = backslash & ~EVEN_BITS & ~follows_escape;
+  uint64_t even_carries = odd_starts + backslash;
+  escaped = even_carries < odd_starts ? 1 : 0;
+  uint64_t invert = even_carries << 1;
+  return (EVEN_BITS ^ invert) & follows_escape;
+}
+
+///
+/// Sets each bit to the xor of itself and every bit below it, turning the
+/// quotes into the spans between them.
+///
+inline uint64_t PrefixXor(uint64_t bits) {
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+inline unsigned TrailingZeros(const uint64_t& bits) {
+#if defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index;
+  _BitScanForward64(&index, bits);
+  return (unsigned)index;
+#elif defined(__GNUC__)
+  return (unsigned)__builtin_ctzll(bits);
+#else
+  unsigned count = 0;
+  while (!(bits & ((uint64_t)1 << count))) {
+    count++;
+  }
+  return count;
+#endif
+}
+
+inline bool IsWhitespace(const char& c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool IsNumberCharacter(const char& c) {
+  return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+}
+
+const uint8_t JsonDocument::ESCAPED;
+const uint8_t JsonDocument::MEMBER;
+const uint8_t JsonDocument::LAST;
+const uint8_t JsonDocument::KEY;
+
+void JsonDocument::Structurals(const char* data, const size_t& size,
+    std::vector<uint32_t>& positions)
+{
+  positions.clear();
+  positions.reserve(size / 6 + 16);
+
+  uint64_t escaped = 0;
+  uint64_t in_string = 0;
+  char tail[64];
+  BlockMasks masks;
+  for (size_t base = 0; base < size; base += 64) {
+    const char* block = data + base;
+    if (size - base < 64) {
+      std::memset(tail, ' ', sizeof(tail));
+      std::memcpy(tail, block, size - base);
+      block = tail;
+    }
+    Classify(block, masks);
+
+    uint64_t quotes = masks.quote & ~FindEscaped(masks.backslash, escaped);
+    uint64_t strings = PrefixXor(quotes) ^ in_string;
+    in_string = (uint64_t)((int64_t)strings >> 63);
+
+    uint64_t bits = (masks.structural & ~strings) | quotes;
+    while (bits != 0) {
+      positions.push_back((uint32_t)(base + TrailingZeros(bits)));
+      bits &= bits - 1;
+    }
+  }
+}
+
+JsonDocument::JsonDocument(const char* data, const size_t& size) : _text(data), _size(size) {
+  Index();
+}
+
+JsonDocument::JsonDocument(std::string&& text) : _owned(std::move(text)),
+    _text(_owned.data()), _size(_owned.size())
+{
+  Index();
+}
+
+void JsonDocument::Index(void) {
+  if (_size >= NO_NODE) {
+    throw JsonParseException("The text is larger than 4 GB", 0);
+  }
+
+  std::vector<uint32_t> structurals;
+  Structurals(_text, _size, structurals);
+  _nodes.clear();
+  _nodes.reserve(structurals.size() / 2 + 1);
+
+  size_t p = 0;
+  uint32_t cursor = 0;
+  const uint32_t size = (uint32_t)_size;
+  auto skip_whitespace = [this, &cursor, &size]() {
+    while (cursor < size && IsWhitespace(_text[cursor])) {
+      cursor++;
+    }
+  };
+  // Consumes the structural character at the cursor.
+  auto consume = [this, &structurals, &p, &cursor](const char& c, const char* message) {
+    if (p >= structurals.size() || structurals[p] != cursor || _text[cursor] != c) {
+      throw JsonParseException(message, cursor);
+    }
+    p++;
+    cursor++;
+  };
+
+  // An open container's node, and the last value added to it.
+  std::vector<std::pair<uint32_t, uint32_t> > open;
+
+  // Adds the value at the cursor, opening it if it is a container.
+  auto value = [&](const uint8_t& flags) {
+    skip_whitespace();
+    if (cursor >= size) {
+      throw JsonParseException("Expected a value", cursor);
+    }
+    JsonNode node;
+    node.begin = cursor;
+    node.count = 0;
+    node.flags = flags;
+    uint32_t index = (uint32_t)_nodes.size();
+    char c = _text[cursor];
+
+    if (c == '{' || c == '[') {
+      consume(c, "Unexpected character");
+      node.type = c == '{' ? JsonToken::OBJECT : JsonToken::ARRAY;
+      node.end = 0;
+      node.next = 0;
+      _nodes.push_back(node);
+      open.push_back(std::make_pair(index, NO_NODE));
+      return;
+    }
+
+    if (c == '"') {
+      if (p + 1 >= structurals.size() || structurals[p] != cursor) {
+        throw JsonParseException("Unterminated string", cursor);
+      }
+      uint32_t quote = structurals[p + 1];
+      if (_text[quote] != '"') {
+        throw JsonParseException("Unterminated string", cursor);
+      }
+      node.type = JsonToken::STRING;
+      node.end = quote + 1;
+      if (std::memchr(_text + cursor + 1, '\\', quote - cursor - 1) != nullptr) {
+        node.flags |= ESCAPED;
+      }
+      p += 2;
+    } else {
+      // A literal or number runs to the next structural character.
+      uint32_t end = p < structurals.size() ? structurals[p] : size;
+      while (end > cursor && IsWhitespace(_text[end - 1])) {
+        end--;
+      }
+      const char* literal = _text + cursor;
+      size_t length = end - cursor;
+      if ((length == 4 && std::memcmp(literal, "true", 4) == 0) ||
+          (length == 5 && std::memcmp(literal, "false", 5) == 0)) {
+        node.type = JsonToken::BOOLEAN;
+      } else if (length == 4 && std::memcmp(literal, "null", 4) == 0) {
+        node.type = JsonToken::NULL_VALUE;
+      } else if (c == '-' || (c >= '0' && c <= '9')) {
+        for (size_t i = 0; i < length; i++) {
+          if (!IsNumberCharacter(literal[i])) {
+            throw JsonParseException("Expected a number", cursor + (uint32_t)i);
+          }
+        }
+        node.type = JsonToken::NUMBER;
+      } else {
+        throw JsonParseException("Unexpected character", cursor);
+      }
+      node.end = end;
+    }
+    node.next = index + 1;
+    cursor = node.end;
+    _nodes.push_back(node);
+  };
+
+  value(0);
+  while (!open.empty()) {
+    uint32_t container = open.back().first;
+    bool object = _nodes[container].type == JsonToken::OBJECT;
+    skip_whitespace();
+    if (cursor >= size) {
+      throw JsonParseException(object ? "Unterminated object" : "Unterminated array", cursor);
+    }
+
+    if (_text[cursor] == (object ? '}' : ']')) {
+      consume(_text[cursor], "Unexpected character");
+      _nodes[container].end = cursor;
+      _nodes[container].next = (uint32_t)_nodes.size();
+      if (open.back().second != NO_NODE) {
+        _nodes[open.back().second].flags |= LAST;
+      }
+      open.pop_back();
+      continue;
+    }
+
+    if (_nodes[container].count > 0) {
+      consume(',', object ? "Expected ',' or '}'" : "Expected ',' or ']'");
+    }
+    uint8_t flags = 0;
+    if (object) {
+      skip_whitespace();
+      if (cursor >= size || _text[cursor] != '"') {
+        throw JsonParseException("Expected a key", cursor);
+      }
+      value(KEY);
+      skip_whitespace();
+      consume(':', "Expected ':'");
+      flags = MEMBER;
+    }
+    _nodes[container].count++;
+    open.back().second = (uint32_t)_nodes.size();
+    value(flags);
+  }
+
+  skip_whitespace();
+  if (cursor != size) {
+    throw JsonParseException("Unexpected text after the value", cursor);
+  }
+}
+
+JsonView JsonDocument::Root(void) const {
+  return JsonView(this, 0);
+}
+
+const char* JsonDocument::Data(void) const {
+  return _text;
+}
+
+size_t JsonDocument::Size(void) const {
+  return _size;
+}
+
+const JsonNode& JsonDocument::Node(const uint32_t& index) const {
+  return _nodes[index];
+}
+
+size_t JsonDocument::Nodes(void) const {
+  return _nodes.size();
+}
+
+JsonView::JsonView() : _document(nullptr), _node(0) {
+
+}
+
+JsonView::JsonView(const JsonDocument* document, const uint32_t& node) :
+    _document(document), _node(node)
+{
+
+}
+
+const JsonNode& JsonView::Node(void) const {
+  return _document->Node(_node);
+}
+
+void JsonView::Require(const JsonToken& type, const char* what) const {
+  if (!Exists()) {
+    throw JsonParseException(std::string("Expected ") + what + ", found nothing", 0);
+  }
+  if (Node().type != type) {
+    throw JsonParseException(std::string("Expected ") + what, Node().begin);
+  }
+}
+
+bool JsonView::Exists(void) const {
+  return _document != nullptr;
+}
+
+JsonToken JsonView::Type(void) const {
+  return Exists() ? Node().type : JsonToken::END;
+}
+
+size_t JsonView::Size(void) const {
+  return Exists() ? Node().count : 0;
+}
+
+JsonView JsonView::operator[](const std::string& key) const {
+  if (Type() != JsonToken::OBJECT) {
+    return JsonView();
+  }
+
+  const char* text = _document->Data();
+  uint32_t end = Node().next;
+  for (uint32_t k = _node + 1; k < end; k = _document->Node(k + 1).next) {
+    const JsonNode& name = _document->Node(k);
+    size_t length = name.end - name.begin - 2;
+    bool match;
+    if (name.flags & JsonDocument::ESCAPED) {
+      JsonScanner scanner(text + name.begin, name.end - name.begin);
+      match = scanner.ReadString() == key;
+    } else {
+      match = length == key.size() && std::memcmp(text + name.begin + 1, key.data(), length) == 0;
+    }
+    if (match) {
+      return JsonView(_document, k + 1);
+    }
+  }
+  return JsonView();
+}
+
+JsonView JsonView::operator[](const size_t& index) const {
+  JsonView child = Child();
+  for (size_t i = 0; i < index && child.Exists(); i++) {
+    child = child.Sibling();
+  }
+  return child;
+}
+
+JsonView JsonView::Child(void) const {
+  if (Size() == 0) {
+    return JsonView();
+  }
+  return JsonView(_document, _node + (Node().type == JsonToken::OBJECT ? 2 : 1));
+}
+
+JsonView JsonView::Sibling(void) const {
+  if (!Exists() || (Node().flags & JsonDocument::LAST)) {
+    return JsonView();
+  }
+  uint32_t next = Node().next + ((Node().flags & JsonDocument::MEMBER) ? 1 : 0);
+  return next < _document->Nodes() ? JsonView(_document, next) : JsonView();
+}
+
+boost::string_ref JsonView::Key(void) const {
+  if (!Exists() || !(Node().flags & JsonDocument::MEMBER)) {
+    return boost::string_ref();
+  }
+  const JsonNode& name = _document->Node(_node - 1);
+  return boost::string_ref(_document->Data() + name.begin + 1, name.end - name.begin - 2);
+}
+
+boost::string_ref JsonView::Raw(void) const {
+  if (!Exists()) {
+    return boost::string_ref();
+  }
+  const JsonNode& node = Node();
+  if (node.type == JsonToken::STRING) {
+    return boost::string_ref(_document->Data() + node.begin + 1, node.end - node.begin - 2);
+  }
+  return boost::string_ref(_document->Data() + node.begin, node.end - node.begin);
+}
+
+bool JsonView::Plain(void) const {
+  return Type() == JsonToken::STRING && !(Node().flags & JsonDocument::ESCAPED);
+}
+
+std::string JsonView::String(void) const {
+  Require(JsonToken::STRING, "a string");
+  if (!(Node().flags & JsonDocument::ESCAPED)) {
+    boost::string_ref raw = Raw();
+    return std::string(raw.data(), raw.size());
+  }
+  JsonScanner scanner(_document->Data() + Node().begin, Node().end - Node().begin);
+  return scanner.ReadString();
+}
+
+double JsonView::Number(void) const {
+  Require(JsonToken::NUMBER, "a number");
+  size_t length = Node().end - Node().begin;
+  JsonScanner scanner(_document->Data() + Node().begin, length);
+  double value = scanner.ReadNumber();
+  if (scanner.Offset() != length) {
+    throw JsonParseException("Expected a number", Node().begin);
+  }
+  return value;
+}
+
+int64_t JsonView::Integer(void) const {
+  Require(JsonToken::NUMBER, "an integer");
+  boost::string_ref raw = Raw();
+  bool negative = raw[0] == '-';
+  uint64_t limit = negative ? (uint64_t)std::numeric_limits<int64_t>::max() + 1 :
+      (uint64_t)std::numeric_limits<int64_t>::max();
+  uint64_t value = 0;
+  for (size_t i = negative ? 1 : 0; i < raw.size(); i++) {
+    if (raw[i] < '0' || raw[i] > '9' || value > (limit - (uint64_t)(raw[i] - '0')) / 10) {
+      throw JsonParseException("Expected an integer in range", Node().begin);
+    }
+    value = value * 10 + (uint64_t)(raw[i] - '0');
+  }
+  if (raw.size() == (negative ? 1u : 0u)) {
+    throw JsonParseException("Expected an integer", Node().begin);
+  }
+  return negative ? (int64_t)(0 - value) : (int64_t)value;
+}
+
+uint64_t JsonView::Unsigned(void) const {
+  Require(JsonToken::NUMBER, "an unsigned integer");
+  boost::string_ref raw = Raw();
+  const uint64_t limit = std::numeric_limits<uint64_t>::max();
+  uint64_t value = 0;
+  for (size_t i = 0; i < raw.size(); i++) {
+    if (raw[i] < '0' || raw[i] > '9' || value > (limit - (uint64_t)(raw[i] - '0')) / 10) {
+      throw JsonParseException("Expected an unsigned integer in range", Node().begin);
+    }
+    value = value * 10 + (uint64_t)(raw[i] - '0');
+  }
+  return value;
+}
+
+bool JsonView::Boolean(void) const {
+  Require(JsonToken::BOOLEAN, "true or false");
+  return _document->Data()[Node().begin] == 't';
+}
+
+bool JsonView::IsNull(void) const {
+  return Type() == JsonToken::NULL_VALUE;
+}
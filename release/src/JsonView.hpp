@@ -0,0 +1,287 @@
+/*
+ * File:   JsonView.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef JSONVIEW_HPP
+#define	JSONVIEW_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <boost/utility/string_ref.hpp>
+
+#include "JsonScanner.hpp"
+
+class JsonDocument;
+
+///
+/// One value in a JsonDocument's index.  Containers are followed by their
+/// members or elements, and each member by its key node and then its value.
+///
+struct JsonNode {
+    uint32_t begin;     /*!< Offset of the value's first character */
+    uint32_t end;       /*!< Offset one past its last character */
+    uint32_t next;      /*!< Index of the node after the value and everything in it */
+    uint32_t count;     /*!< Members or elements, for containers */
+    JsonToken type;
+    uint8_t flags;      /*!< JsonDocument::ESCAPED, MEMBER and LAST */
+};
+
+///
+/// A read only handle on one value of a JsonDocument.  Views are two words
+/// and are passed by value; a view of something that is not there, such as
+/// a missing member, is valid and reports !Exists().  Strings are decoded,
+/// and numbers parsed, only when they are asked for.
+///
+///     JsonDocument document(response.Body().data(), response.Body().size());
+///     JsonView page = document.Root();
+///     uint64_t total = page["total"].Unsigned();
+///     for (JsonView result = page["results"].Child(); result.Exists();
+///          result = result.Sibling()) {
+///         uris.push_back(result["uri"].String());
+///     }
+///
+class JsonView {
+    const JsonDocument* _document;
+    uint32_t _node;
+
+    const JsonNode& Node(void) const;
+    void Require(const JsonToken& type, const char* what) const;
+public:
+    ///
+    /// Constructor for a view of nothing.
+    ///
+    JsonView();
+
+    ///
+    /// Constructor
+    ///
+    /// \param document The document
+    /// \param node The value's index in the document
+    ///
+    JsonView(const JsonDocument* document, const uint32_t& node);
+
+    ///
+    /// Returns false for a view of nothing, such as a missing member.
+    ///
+    /// \return Whether there is a value
+    ///
+    bool Exists(void) const;
+
+    ///
+    /// Returns the kind of value.
+    ///
+    /// \return The token, END for a view of nothing
+    ///
+    JsonToken Type(void) const;
+
+    ///
+    /// Returns the number of members of an object or elements of an array.
+    ///
+    /// \return The count, 0 for anything else
+    ///
+    size_t Size(void) const;
+
+    ///
+    /// Finds an object member, comparing the keys in place.  The first of
+    /// any duplicates is returned.
+    ///
+    /// \param key The key
+    /// \return The member's value, a view of nothing if there is none
+    ///
+    JsonView operator[](const std::string& key) const;
+
+    ///
+    /// Finds an array element or object member by position.  Each call
+    /// walks the container from the start; use Child and Sibling to visit
+    /// every element.
+    ///
+    /// \param index The position
+    /// \return The value, a view of nothing if there is none
+    ///
+    JsonView operator[](const size_t& index) const;
+
+    ///
+    /// Returns the first element of an array or the first member of an
+    /// object.
+    ///
+    /// \return The value, a view of nothing if there is none
+    ///
+    JsonView Child(void) const;
+
+    ///
+    /// Returns the next value in the same array or object.
+    ///
+    /// \return The value, a view of nothing after the last
+    ///
+    JsonView Sibling(void) const;
+
+    ///
+    /// Returns the key of an object member.
+    ///
+    /// \return The key, escapes and all; empty for array elements
+    ///
+    boost::string_ref Key(void) const;
+
+    ///
+    /// Returns the value's text in the document: a string without its
+    /// quotes but with its escapes, a number as written, or a whole object
+    /// or array.
+    ///
+    /// \return The text
+    ///
+    boost::string_ref Raw(void) const;
+
+    ///
+    /// Returns true if a string has no escapes, so Raw is its value.
+    ///
+    /// \return Whether Raw can be used as it is
+    ///
+    bool Plain(void) const;
+
+    ///
+    /// Reads a string, decoding escapes to UTF-8.  Throws
+    /// JsonParseException for anything else.
+    ///
+    /// \return The string
+    ///
+    std::string String(void) const;
+
+    ///
+    /// Reads a number.  Throws JsonParseException for anything else.
+    ///
+    /// \return The number
+    ///
+    double Number(void) const;
+
+    ///
+    /// Reads a number that must be an integer, without going through a
+    /// double.  Throws JsonParseException if it is not one or is out of
+    /// range.
+    ///
+    /// \return The number
+    ///
+    int64_t Integer(void) const;
+
+    ///
+    /// As Integer, for numbers that cannot be negative.
+    ///
+    /// \return The number
+    ///
+    uint64_t Unsigned(void) const;
+
+    ///
+    /// Reads true or false.  Throws JsonParseException for anything else.
+    ///
+    /// \return The value
+    ///
+    bool Boolean(void) const;
+
+    ///
+    /// Returns true for null.
+    ///
+    /// \return Whether the value is null
+    ///
+    bool IsNull(void) const;
+};
+
+///
+/// An index of a JSON text for random access without building a tree of
+/// values.
+///
+/// Parsing has two passes.  The first finds every quote and structural
+/// character ({}[]:,) that is not inside a string, 64 bytes at a time:
+/// SSE2 compares build bit masks of the quotes, backslashes and
+/// structurals, the escaped quotes are removed with carries across blocks,
+/// and a prefix xor of the quotes masks out everything inside strings.  The
+/// second walks those positions, checks the structure and records a
+/// JsonNode per value, roughly 20 bytes each, with no allocation per value
+/// and no copy of any string.  Numbers and literals are checked for their
+/// characters here, and read when touched.
+///
+/// The text is borrowed and must outlive the document and its views, or
+/// is moved in.  Documents are limited to 4 GB.
+///
+class JsonDocument {
+    std::string _owned;
+    const char* _text;
+    size_t _size;
+    std::vector<JsonNode> _nodes;
+
+    JsonDocument(const JsonDocument& orig);
+    JsonDocument& operator=(const JsonDocument& orig);
+
+    void Index(void);
+public:
+    static const uint8_t ESCAPED = 1;   /*!< A string with at least one backslash */
+    static const uint8_t MEMBER = 2;    /*!< An object member's value */
+    static const uint8_t LAST = 4;      /*!< The last value in its container */
+    static const uint8_t KEY = 8;       /*!< An object member's key */
+
+    ///
+    /// Constructor.  Throws JsonParseException if the text is not JSON.
+    ///
+    /// \param data The text, which must outlive the document
+    /// \param size Its length in bytes
+    ///
+    JsonDocument(const char* data, const size_t& size);
+
+    ///
+    /// Constructor for a document that keeps its text.  Throws
+    /// JsonParseException if the text is not JSON.
+    ///
+    /// \param text The text, moved from
+    ///
+    explicit JsonDocument(std::string&& text);
+
+    ///
+    /// Returns the top level value.
+    ///
+    /// \return The view
+    ///
+    JsonView Root(void) const;
+
+    ///
+    /// Returns the text the document indexes.
+    ///
+    /// \return The first byte
+    ///
+    const char* Data(void) const;
+
+    ///
+    /// Returns the length of the text.
+    ///
+    /// \return The length in bytes
+    ///
+    size_t Size(void) const;
+
+    ///
+    /// Returns a node of the index.
+    ///
+    /// \param index The node's index
+    /// \return The node
+    ///
+    const JsonNode& Node(const uint32_t& index) const;
+
+    ///
+    /// Returns the number of nodes in the index.
+    ///
+    /// \return The count
+    ///
+    size_t Nodes(void) const;
+
+    ///
+    /// Finds the quotes, and the structural characters outside strings, of
+    /// a JSON text; the first pass of parsing.
+    ///
+    /// \param data The text
+    /// \param size Its length in bytes
+    /// \param positions Set to their offsets, in order
+    ///
+    static void Structurals(const char* data, const size_t& size,
+                            std::vector<uint32_t>& positions);
+};
+
+#endif	/* JSONVIEW_HPP */
@@ -0,0 +1,241 @@
+/*
+ * File:   JsonWriter.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "JsonWriter.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const char* HEX = "0123456789abcdef";
+
+///
+/// Characters that cannot appear in a JSON string as they are.
+///
+inline bool NeedsEscape(const unsigned char& c) {
+  return c < 0x20 || c == '"' || c == '\\';
+}
+
+}
+
+JsonWriteException::JsonWriteException(const std::string& message) : _message(message) {
+
+}
+
+const char* JsonWriteException::what() const throw() {
+  return _message.c_str();
+}
+
+JsonWriter::JsonWriter(const JsonSink& sink, const size_t& buffer_size) : _sink(sink),
+    _buffer_size(buffer_size > 0 ? buffer_size : 1), _bytes(0), _needs_comma(false),
+    _after_key(false), _complete(false)
+{
+  _buffer.reserve(_buffer_size);
+}
+
+JsonWriter::JsonWriter(std::string& out) : _buffer_size(4096), _bytes(0),
+    _needs_comma(false), _after_key(false), _complete(false)
+{
+  _sink = [&out](const char* data, const size_t& size) {
+    out.append(data, size);
+  };
+  _buffer.reserve(_buffer_size);
+}
+
+JsonWriter::~JsonWriter() {
+  try {
+    Flush();
+  } catch (...) {
+  }
+}
+
+void JsonWriter::Append(const char* data, const size_t& size) {
+  _bytes += size;
+  if (_buffer.size() + size > _buffer_size) {
+    Flush();
+    if (size >= _buffer_size) {
+      _sink(data, size);
+      return;
+    }
+  }
+  _buffer.append(data, size);
+}
+
+void JsonWriter::Append(const char& c) {
+  _bytes++;
+  if (_buffer.size() == _buffer_size) {
+    Flush();
+  }
+  _buffer.push_back(c);
+}
+
+void JsonWriter::Flush(void) {
+  if (!_buffer.empty()) {
+    _sink(_buffer.data(), _buffer.size());
+    _buffer.clear();
+  }
+}
+
+void JsonWriter::BeginValue(void) {
+  if (_open.empty()) {
+    if (_complete) {
+      throw JsonWriteException("The document already has its value");
+    }
+  } else if (_open.back() == '{') {
+    if (!_after_key) {
+      throw JsonWriteException("An object member needs a key");
+    }
+  } else if (_needs_comma) {
+    Append(',');
+  }
+}
+
+void JsonWriter::EndValue(void) {
+  _needs_comma = true;
+  _after_key = false;
+  _complete = _open.empty();
+}
+
+JsonWriter& JsonWriter::BeginObject(void) {
+  BeginValue();
+  Append('{');
+  _open.push_back('{');
+  _needs_comma = false;
+  _after_key = false;
+  return *this;
+}
+
+JsonWriter& JsonWriter::EndObject(void) {
+  if (_open.empty() || _open.back() != '{' || _after_key) {
+    throw JsonWriteException(_after_key ? "The last key has no value" : "No object is open");
+  }
+  _open.pop_back();
+  Append('}');
+  EndValue();
+  return *this;
+}
+
+JsonWriter& JsonWriter::BeginArray(void) {
+  BeginValue();
+  Append('[');
+  _open.push_back('[');
+  _needs_comma = false;
+  return *this;
+}
+
+JsonWriter& JsonWriter::EndArray(void) {
+  if (_open.empty() || _open.back() != '[') {
+    throw JsonWriteException("No array is open");
+  }
+  _open.pop_back();
+  Append(']');
+  EndValue();
+  return *this;
+}
+
+JsonWriter& JsonWriter::Key(const std::string& key) {
+  if (_open.empty() || _open.back() != '{' || _after_key) {
+    throw JsonWriteException("A key must be followed by a value, inside an object");
+  }
+  if (_needs_comma) {
+    Append(',');
+  }
+  Escaped(key.data(), key.size());
+  Append(':');
+  _after_key = true;
+  return *this;
+}
+
+void JsonWriter::Escaped(const char* data, const size_t& size) {
+  Append('"');
+  // Runs of ordinary characters are appended whole.
+  size_t begin = 0;
+  for (size_t i = 0; i < size; i++) {
+    unsigned char c = (unsigned char)data[i];
+    if (!NeedsEscape(c)) {
+      continue;
+    }
+    Append(data + begin, i - begin);
+    begin = i + 1;
+    switch (c) {
+      case '"': Append("\\\"", 2); break;
+      case '\\': Append("\\\\", 2); break;
+      case '\b': Append("\\b", 2); break;
+      case '\f': Append("\\f", 2); break;
+      case '\n': Append("\\n", 2); break;
+      case '\r': Append("\\r", 2); break;
+      case '\t': Append("\\t", 2); break;
+      default: {
+        char escape[6] = { '\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 15] };
+        Append(escape, 6);
+      }
+    }
+  }
+  Append(data + begin, size - begin);
+  Append('"');
+}
+
+JsonWriter& JsonWriter::String(const std::string& value) {
+  return String(value.data(), value.size());
+}
+
+JsonWriter& JsonWriter::String(const char* data, const size_t& size) {
+  BeginValue();
+  Escaped(data, size);
+  EndValue();
+  return *this;
+}
+
+JsonWriter& JsonWriter::Integer(const int64_t& value) {
+  char text[24];
+  int length = std::snprintf(text, sizeof(text), "%lld", (long long)value);
+  return Raw(text, (size_t)length);
+}
+
+JsonWriter& JsonWriter::Unsigned(const uint64_t& value) {
+  char text[24];
+  int length = std::snprintf(text, sizeof(text), "%llu", (unsigned long long)value);
+  return Raw(text, (size_t)length);
+}
+
+JsonWriter& JsonWriter::Number(const double& value) {
+  if (!std::isfinite(value)) {
+    throw JsonWriteException("JSON has no infinities or NaN");
+  }
+  // 15 significant digits are enough for most values; 17 always are.
+  char text[32];
+  int length = std::snprintf(text, sizeof(text), "%.15g", value);
+  if (std::strtod(text, nullptr) != value) {
+    length = std::snprintf(text, sizeof(text), "%.17g", value);
+  }
+  return Raw(text, (size_t)length);
+}
+
+JsonWriter& JsonWriter::Boolean(const bool& value) {
+  return value ? Raw("true", 4) : Raw("false", 5);
+}
+
+JsonWriter& JsonWriter::Null(void) {
+  return Raw("null", 4);
+}
+
+JsonWriter& JsonWriter::Raw(const char* data, const size_t& size) {
+  BeginValue();
+  Append(data, size);
+  EndValue();
+  return *this;
+}
+
+bool JsonWriter::Complete(void) const {
+  return _complete;
+}
+
+uint64_t JsonWriter::Bytes(void) const {
+  return _bytes;
+}
@@ -0,0 +1,176 @@
+/*
+ * File:   JsonWriter.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef JSONWRITER_HPP
+#define	JSONWRITER_HPP
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+///
+/// Receives the text a JsonWriter produces, a buffer at a time.  The bytes
+/// are only valid for the duration of the call.
+///
+typedef std::function<void(const char* data, const size_t& size)> JsonSink;
+
+///
+/// Thrown when values are written out of order, such as a member without
+/// a key, or a number JSON cannot hold.
+///
+class JsonWriteException : public std::exception {
+    std::string _message;
+public:
+    explicit JsonWriteException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// A forward only JSON generator, the counterpart of JsonScanner.  Values
+/// are written in document order and go straight to a sink, through a
+/// small buffer, so a large body is never held as a web::json::value tree
+/// and then again as its serialization.
+///
+///     std::string body;
+///     JsonWriter writer(body);
+///     writer.BeginObject();
+///     writer.Key("uris").BeginArray();
+///     for (auto& uri : uris) {
+///         writer.String(uri);
+///     }
+///     writer.EndArray();
+///     writer.Key("total").Unsigned(uris.size());
+///     writer.EndObject();
+///
+/// Pass a JsonBodyWriter to AuthenticatingProxy::Post or Put to write the
+/// request body as it is sent.  The order is checked as it goes and a
+/// mistake throws JsonWriteException; strings are expected to be UTF-8 and
+/// are not validated.
+///
+class JsonWriter {
+    JsonSink _sink;
+    std::string _buffer;
+    size_t _buffer_size;
+    uint64_t _bytes;
+    std::vector<char> _open;    /*!< '{' or '[' for each open container */
+    bool _needs_comma;
+    bool _after_key;
+    bool _complete;
+
+    JsonWriter(const JsonWriter& orig);
+    JsonWriter& operator=(const JsonWriter& orig);
+
+    void Append(const char* data, const size_t& size);
+    void Append(const char& c);
+    void BeginValue(void);
+    void EndValue(void);
+    void Escaped(const char* data, const size_t& size);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param sink Receives the text
+    /// \param buffer_size Bytes gathered before the sink is called
+    ///
+    explicit JsonWriter(const JsonSink& sink, const size_t& buffer_size = 16384);
+
+    ///
+    /// Constructor for a writer that appends to a string.
+    ///
+    /// \param out The string
+    ///
+    explicit JsonWriter(std::string& out);
+
+    ///
+    /// Flushes what is buffered.  Errors from the sink are dropped; call
+    /// Flush to see them.
+    ///
+    virtual ~JsonWriter();
+
+    JsonWriter& BeginObject(void);
+    JsonWriter& EndObject(void);
+    JsonWriter& BeginArray(void);
+    JsonWriter& EndArray(void);
+
+    ///
+    /// Writes the key of the next object member.
+    ///
+    /// \param key The key
+    /// \return This writer
+    ///
+    JsonWriter& Key(const std::string& key);
+
+    ///
+    /// Writes a string value, escaping it.
+    ///
+    /// \param value The UTF-8 string
+    /// \return This writer
+    ///
+    JsonWriter& String(const std::string& value);
+
+    ///
+    /// Writes a string value, escaping it.
+    ///
+    /// \param data The UTF-8 text
+    /// \param size Its length in bytes
+    /// \return This writer
+    ///
+    JsonWriter& String(const char* data, const size_t& size);
+
+    JsonWriter& Integer(const int64_t& value);
+    JsonWriter& Unsigned(const uint64_t& value);
+
+    ///
+    /// Writes a number with the fewest digits that read back as the same
+    /// double.  Throws JsonWriteException for infinities and NaN.
+    ///
+    /// \param value The number
+    /// \return This writer
+    ///
+    JsonWriter& Number(const double& value);
+
+    JsonWriter& Boolean(const bool& value);
+    JsonWriter& Null(void);
+
+    ///
+    /// Writes a value that is already JSON text, such as a document read
+    /// from a file, without checking it.
+    ///
+    /// \param data The JSON text
+    /// \param size Its length in bytes
+    /// \return This writer
+    ///
+    JsonWriter& Raw(const char* data, const size_t& size);
+
+    ///
+    /// Passes whatever is buffered to the sink.
+    ///
+    void Flush(void);
+
+    ///
+    /// Returns true once a whole top level value has been written.
+    ///
+    /// \return Whether the document is complete
+    ///
+    bool Complete(void) const;
+
+    ///
+    /// Returns the number of bytes written, buffered or not.
+    ///
+    /// \return The count
+    ///
+    uint64_t Bytes(void) const;
+};
+
+///
+/// Writes a request body.  It may be called more than once for one request:
+/// a request that is answered with a digest challenge is sent again.
+///
+typedef std::function<void(JsonWriter& writer)> JsonBodyWriter;
+
+#endif	/* JSONWRITER_HPP */
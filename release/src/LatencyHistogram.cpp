@@ -0,0 +1,195 @@
+/*
+ * File:   LatencyHistogram.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+uint32_t HighestBit(const uint64_t& value) {
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return (uint32_t)index;
+#else
+  return 63 - (uint32_t)__builtin_clzll(value);
+#endif
+}
+
+///
+/// Threads are handed stripes round robin the first time they record into
+/// any histogram.  The same index is used for every histogram.
+///
+uint32_t ThreadStripeIndex(void) {
+  static std::atomic<uint32_t> next(0);
+  thread_local uint32_t index =
+      next.fetch_add(1, std::memory_order_relaxed) % LatencyHistogram::STRIPES;
+  return index;
+}
+
+}
+
+LatencySnapshot::LatencySnapshot() :
+    _counts(LatencyHistogram::BUCKET_COUNT, 0), _count(0), _sum(0), _max(0)
+{
+
+}
+
+void LatencySnapshot::Merge(const LatencySnapshot& other) {
+  for (size_t i = 0; i < _counts.size(); i++) {
+    _counts[i] += other._counts[i];
+  }
+  _count += other._count;
+  _sum += other._sum;
+  _max = std::max(_max, other._max);
+}
+
+uint64_t LatencySnapshot::Count(void) const {
+  return _count;
+}
+
+uint64_t LatencySnapshot::Max(void) const {
+  return _max;
+}
+
+double LatencySnapshot::Mean(void) const {
+  return _count == 0 ? 0.0 : (double)_sum / (double)_count;
+}
+
+uint64_t LatencySnapshot::Percentile(const double& percentile) const {
+  if (_count == 0) {
+    return 0;
+  }
+
+  double fraction = std::min(std::max(percentile, 0.0), 100.0) / 100.0;
+  uint64_t rank = (uint64_t)std::ceil(fraction * (double)_count);
+  if (rank == 0) {
+    rank = 1;
+  }
+
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < _counts.size(); i++) {
+    seen += _counts[i];
+    if (seen >= rank) {
+      return std::min(LatencyHistogram::BucketValue(i), _max);
+    }
+  }
+  return _max;
+}
+
+LatencyHistogram::Stripe::Stripe() : sum(0), max(0) {
+  for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+    counts[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+LatencyHistogram::LatencyHistogram() {
+  for (uint32_t i = 0; i < STRIPES; i++) {
+    _stripes[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+LatencyHistogram::~LatencyHistogram() {
+  for (uint32_t i = 0; i < STRIPES; i++) {
+    delete _stripes[i].load(std::memory_order_acquire);
+  }
+}
+
+uint32_t LatencyHistogram::BucketIndex(uint64_t value) {
+  if (value < 2 * SUB_BUCKET_COUNT) {
+    return (uint32_t)value;
+  }
+
+  uint32_t magnitude = HighestBit(value);
+  if (magnitude > MAX_MAGNITUDE) {
+    magnitude = MAX_MAGNITUDE;
+    value = (UINT64_C(2) << MAX_MAGNITUDE) - 1;
+  }
+
+  uint32_t shift = magnitude - SUB_BUCKET_BITS;
+  return 2 * SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_COUNT +
+      (uint32_t)(value >> shift) - SUB_BUCKET_COUNT;
+}
+
+uint64_t LatencyHistogram::BucketValue(const uint32_t& index) {
+  if (index < 2 * SUB_BUCKET_COUNT) {
+    return index;
+  }
+
+  uint32_t shift = (index - 2 * SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT + 1;
+  uint64_t sub_bucket = (index - 2 * SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT +
+      SUB_BUCKET_COUNT;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+LatencyHistogram::Stripe* LatencyHistogram::LocalStripe(void) {
+  std::atomic<Stripe*>& slot = _stripes[ThreadStripeIndex()];
+  Stripe* stripe = slot.load(std::memory_order_acquire);
+
+  if (stripe == nullptr) {
+    Stripe* created = new Stripe();
+    if (slot.compare_exchange_strong(stripe, created, std::memory_order_acq_rel)) {
+      stripe = created;
+    } else {
+      delete created;
+    }
+  }
+  return stripe;
+}
+
+void LatencyHistogram::Record(const uint64_t& nanos) {
+  Stripe* stripe = LocalStripe();
+
+  stripe->counts[BucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+  stripe->sum.fetch_add(nanos, std::memory_order_relaxed);
+
+  uint64_t seen = stripe->max.load(std::memory_order_relaxed);
+  while (nanos > seen &&
+      !stripe->max.compare_exchange_weak(seen, nanos, std::memory_order_relaxed)) {
+    ;
+  }
+}
+
+LatencySnapshot LatencyHistogram::Snapshot(void) const {
+  LatencySnapshot result;
+
+  for (uint32_t s = 0; s < STRIPES; s++) {
+    const Stripe* stripe = _stripes[s].load(std::memory_order_acquire);
+    if (stripe == nullptr) {
+      continue;
+    }
+
+    for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+      uint64_t count = stripe->counts[i].load(std::memory_order_relaxed);
+      result._counts[i] += count;
+      result._count += count;
+    }
+    result._sum += stripe->sum.load(std::memory_order_relaxed);
+    result._max = std::max(result._max, stripe->max.load(std::memory_order_relaxed));
+  }
+  return result;
+}
+
+void LatencyHistogram::Reset(void) {
+  for (uint32_t s = 0; s < STRIPES; s++) {
+    Stripe* stripe = _stripes[s].load(std::memory_order_acquire);
+    if (stripe == nullptr) {
+      continue;
+    }
+
+    for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+      stripe->counts[i].store(0, std::memory_order_relaxed);
+    }
+    stripe->sum.store(0, std::memory_order_relaxed);
+    stripe->max.store(0, std::memory_order_relaxed);
+  }
+}
@@ -0,0 +1,151 @@
+/*
+ * File:   LatencyHistogram.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef LATENCYHISTOGRAM_HPP
+#define	LATENCYHISTOGRAM_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+///
+/// A merged, read-only copy of a LatencyHistogram.  Snapshots are what get
+/// reported; the live histogram is only ever written to.
+///
+class LatencySnapshot {
+    std::vector<uint64_t> _counts;
+    uint64_t _count;
+    uint64_t _sum;
+    uint64_t _max;
+
+public:
+    ///
+    /// Constructor
+    ///
+    LatencySnapshot();
+
+    ///
+    /// Adds the counts of another snapshot to this one.
+    ///
+    /// \param other The snapshot to merge in
+    ///
+    void Merge(const LatencySnapshot& other);
+
+    ///
+    /// Returns the number of recorded values.
+    ///
+    /// \return The number of values
+    ///
+    uint64_t Count(void) const;
+
+    ///
+    /// Returns the largest recorded value (exact, not bucketed).
+    ///
+    /// \return The maximum in nanoseconds
+    ///
+    uint64_t Max(void) const;
+
+    ///
+    /// Returns the mean of the recorded values.
+    ///
+    /// \return The mean in nanoseconds
+    ///
+    double Mean(void) const;
+
+    ///
+    /// Returns the value at the given percentile, to the precision of the
+    /// histogram buckets.
+    ///
+    /// \param percentile The percentile (50.0, 99.0, 99.9)
+    /// \return The value in nanoseconds
+    ///
+    uint64_t Percentile(const double& percentile) const;
+
+    friend class LatencyHistogram;
+};
+
+///
+/// HDR style latency histogram
+///
+/// Values (nanoseconds) are counted in log-linear buckets: every power of two
+/// is split into 64 linear sub-buckets, so any value is reported to within
+/// about 1.5%.  Values up to 2^41 ns (about 36 minutes) are tracked, anything
+/// larger lands in the last bucket.
+///
+/// Recording is lock free.  Each thread is assigned a stripe with its own
+/// set of counters which is allocated on first use, so with up to STRIPES
+/// threads no two threads ever touch the same cache lines.  The stripes are
+/// merged when a Snapshot is taken.
+///
+class LatencyHistogram {
+public:
+    static const uint32_t SUB_BUCKET_BITS = 6;
+    static const uint32_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const uint32_t MAX_MAGNITUDE = 40;
+    static const uint32_t BUCKET_COUNT = 2 * SUB_BUCKET_COUNT +
+        (MAX_MAGNITUDE - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT;
+    static const uint32_t STRIPES = 16;
+
+    ///
+    /// Constructor
+    ///
+    LatencyHistogram();
+    ~LatencyHistogram();
+
+    ///
+    /// Records a single value.  Safe to call from any thread.
+    ///
+    /// \param nanos The latency in nanoseconds
+    ///
+    void Record(const uint64_t& nanos);
+
+    ///
+    /// Merges all of the per-thread stripes.
+    ///
+    /// \return The merged counts
+    ///
+    LatencySnapshot Snapshot(void) const;
+
+    ///
+    /// Zeroes all counters.  Values recorded concurrently with a reset may or
+    /// may not survive it.
+    ///
+    void Reset(void);
+
+    ///
+    /// Returns the bucket a value is counted in.
+    ///
+    /// \param value The value
+    /// \return The bucket index
+    ///
+    static uint32_t BucketIndex(uint64_t value);
+
+    ///
+    /// Returns the highest value that is counted in a bucket.
+    ///
+    /// \param index The bucket index
+    /// \return The value
+    ///
+    static uint64_t BucketValue(const uint32_t& index);
+
+private:
+    struct Stripe {
+        std::atomic<uint64_t> counts[BUCKET_COUNT];
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> max;
+
+        Stripe();
+    };
+
+    std::atomic<Stripe*> _stripes[STRIPES];
+
+    Stripe* LocalStripe(void);
+
+    LatencyHistogram(const LatencyHistogram& orig);
+    LatencyHistogram& operator=(const LatencyHistogram& orig);
+};
+
+#endif	/* LATENCYHISTOGRAM_HPP */
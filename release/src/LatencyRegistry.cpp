@@ -0,0 +1,184 @@
+/*
+ * File:   LatencyRegistry.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "LatencyRegistry.hpp"
+
+#include <cstring>
+#include <iomanip>
+
+namespace {
+
+// The methods a thread's table has slots for; others go to the registry.
+const struct {
+  const char* name;
+  size_t size;
+} METHODS[] = { { "GET", 3 }, { "PUT", 3 }, { "POST", 4 }, { "DELETE", 6 }, { "HEAD", 4 },
+                { "PATCH", 5 } };
+const size_t METHOD_COUNT = sizeof(METHODS) / sizeof(METHODS[0]);
+const size_t CACHE_SLOTS = 256;
+
+///
+/// A slot in a thread's table of histograms.
+///
+struct CachedHistogram {
+  size_t method;
+  bool collapsed;             /*!< Whether the template ends in "/*" */
+  std::string resource;       /*!< The part of the path the template keeps */
+  LatencyHistogram* histogram;
+
+  CachedHistogram() : method(0), collapsed(false), histogram(nullptr) { }
+};
+
+size_t MethodIndex(const std::string& method) {
+  for (size_t i = 0; i < METHOD_COUNT; i++) {
+    if (method.size() == METHODS[i].size &&
+        std::memcmp(method.data(), METHODS[i].name, METHODS[i].size) == 0) {
+      return i;
+    }
+  }
+  return METHOD_COUNT;
+}
+
+// Cheap rather than thorough: a slot is checked against the path before it
+// is used, and a process sees few endpoints.
+size_t Slot(const size_t& method, const std::string& path, const size_t& length,
+            const bool& collapsed)
+{
+  size_t hash = method * 2 + (collapsed ? 1 : 0);
+  if (length > 0) {
+    hash = hash * 31 + length;
+    hash = hash * 31 + (unsigned char)path[length / 2];
+    hash = hash * 31 + (unsigned char)path[length - 1];
+  }
+  return hash % CACHE_SLOTS;
+}
+
+}
+
+LatencyRegistry::LatencyRegistry() : _enabled(true) {
+
+}
+
+LatencyRegistry* LatencyRegistry::Instance(void) {
+  static LatencyRegistry instance;
+  return &instance;
+}
+
+size_t LatencyRegistry::TemplateLength(const std::string& path, bool& collapsed) {
+  // Keep "/v1/resource", collapse whatever follows it.  One pass, since
+  // this runs on every request.
+  collapsed = false;
+  size_t slashes = 0;
+  for (size_t i = 0; i < path.size(); i++) {
+    char c = path[i];
+    if (c == '?' || c == '#') {
+      return i;
+    }
+    if (c == '/' && i > 0 && ++slashes == 2) {
+      collapsed = i + 1 < path.size() && path[i + 1] != '?' && path[i + 1] != '#';
+      return collapsed ? i : i + 1;
+    }
+  }
+  return path.size();
+}
+
+std::string LatencyRegistry::EndpointTemplate(const std::string& path) {
+  bool collapsed;
+  std::string result(path, 0, TemplateLength(path, collapsed));
+  if (collapsed) {
+    result.append("/*");
+  }
+  return result;
+}
+
+LatencyHistogram& LatencyRegistry::Histogram(const std::string& method,
+    const std::string& path)
+{
+  thread_local CachedHistogram cache[CACHE_SLOTS];
+
+  bool collapsed;
+  size_t length = TemplateLength(path, collapsed);
+  size_t method_index = MethodIndex(method);
+  CachedHistogram* slot = nullptr;
+  if (method_index < METHOD_COUNT) {
+    slot = &cache[Slot(method_index, path, length, collapsed)];
+    if (slot->histogram != nullptr && slot->method == method_index &&
+        slot->collapsed == collapsed && path.compare(0, length, slot->resource) == 0) {
+      return *slot->histogram;
+    }
+  }
+
+  std::string key = method + " " + path.substr(0, length) + (collapsed ? "/*" : "");
+  std::lock_guard<std::mutex> lock(_mutex);
+  LatencyHistogram*& histogram = _histograms[key];
+  if (histogram == nullptr) {
+    histogram = new LatencyHistogram();
+  }
+  if (slot != nullptr) {
+    slot->method = method_index;
+    slot->collapsed = collapsed;
+    slot->resource.assign(path, 0, length);
+    slot->histogram = histogram;
+  }
+  return *histogram;
+}
+
+std::map<std::string, LatencySnapshot> LatencyRegistry::Snapshot(void) const {
+  std::map<std::string, LatencySnapshot> result;
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  for (auto& iter : _histograms) {
+    result[iter.first] = iter.second->Snapshot();
+  }
+  return result;
+}
+
+void LatencyRegistry::Report(std::ostream& os) const {
+  std::map<std::string, LatencySnapshot> snapshots = Snapshot();
+
+  os << std::fixed << std::setprecision(1);
+  for (auto& iter : snapshots) {
+    const LatencySnapshot& s = iter.second;
+    os << iter.first
+       << " count=" << s.Count()
+       << " p50=" << s.Percentile(50.0) / 1000.0 << "us"
+       << " p99=" << s.Percentile(99.0) / 1000.0 << "us"
+       << " p999=" << s.Percentile(99.9) / 1000.0 << "us"
+       << " max=" << s.Max() / 1000.0 << "us" << std::endl;
+  }
+}
+
+void LatencyRegistry::Reset(void) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (auto& iter : _histograms) {
+    iter.second->Reset();
+  }
+}
+
+bool LatencyRegistry::Enabled(void) const {
+  return _enabled.load(std::memory_order_relaxed);
+}
+
+void LatencyRegistry::SetEnabled(const bool& enabled) {
+  _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+LatencyTimer::LatencyTimer(const std::string& method, const std::string& path) :
+    _histogram(nullptr)
+{
+  LatencyRegistry* registry = LatencyRegistry::Instance();
+  if (registry->Enabled()) {
+    _histogram = &registry->Histogram(method, path);
+    _start = std::chrono::steady_clock::now();
+  }
+}
+
+LatencyTimer::~LatencyTimer() {
+  if (_histogram != nullptr) {
+    _histogram->Record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - _start).count());
+  }
+}
@@ -0,0 +1,123 @@
+/*
+ * File:   LatencyRegistry.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef LATENCYREGISTRY_HPP
+#define	LATENCYREGISTRY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include "LatencyHistogram.hpp"
+
+///
+/// Process wide set of latency histograms, one per method and endpoint
+/// template ("GET /v1/documents", "POST /v1/search").
+///
+/// Histograms are created on first use and are never destroyed, so the
+/// references handed out stay valid for the life of the process.  Each thread
+/// keeps a fixed table of histograms, indexed by the method and a hash of
+/// the path's template, so a lookup neither builds the key nor allocates,
+/// and the registry lock is only taken the first time a thread sees a key.
+///
+class LatencyRegistry {
+    mutable std::mutex _mutex;
+    std::map<std::string, LatencyHistogram*> _histograms;
+    std::atomic<bool> _enabled;
+
+    LatencyRegistry();
+    LatencyRegistry(const LatencyRegistry& orig);
+    LatencyRegistry& operator=(const LatencyRegistry& orig);
+
+    static size_t TemplateLength(const std::string& path, bool& collapsed);
+public:
+    ///
+    /// Returns the process wide registry.
+    ///
+    /// \return The registry
+    ///
+    static LatencyRegistry* Instance(void);
+
+    ///
+    /// Reduces a request path to the endpoint it addresses.  The query string
+    /// is dropped and anything after the resource name is collapsed, so
+    /// "/v1/documents?uri=/a.json" is "/v1/documents" and
+    /// "/v1/transactions/1234" is "/v1/transactions/*".
+    ///
+    /// \param path The request path
+    /// \return The endpoint template
+    ///
+    static std::string EndpointTemplate(const std::string& path);
+
+    ///
+    /// Returns the histogram for a method and request path.
+    ///
+    /// \param method The HTTP method (GET, POST, etc.)
+    /// \param path The request path, which is reduced to its template
+    /// \return The histogram
+    ///
+    LatencyHistogram& Histogram(const std::string& method, const std::string& path);
+
+    ///
+    /// Merges and returns every histogram, keyed by "METHOD /endpoint".
+    ///
+    /// \return The snapshots
+    ///
+    std::map<std::string, LatencySnapshot> Snapshot(void) const;
+
+    ///
+    /// Writes count, p50, p99, p999 and max (in microseconds) for every
+    /// endpoint, one line each.
+    ///
+    /// \param os The stream to write to
+    ///
+    void Report(std::ostream& os) const;
+
+    ///
+    /// Zeroes every histogram.
+    ///
+    void Reset(void);
+
+    ///
+    /// Returns whether the proxy records request latencies.
+    ///
+    /// \return True if recording
+    ///
+    bool Enabled(void) const;
+
+    ///
+    /// Turns recording in the proxy on or off.  Recording is on by default.
+    ///
+    /// \param enabled True to record
+    ///
+    void SetEnabled(const bool& enabled);
+};
+
+///
+/// Records the time between construction and destruction into the histogram
+/// for a method and path.  Does nothing if the registry is disabled.
+///
+class LatencyTimer {
+    LatencyHistogram* _histogram;
+    std::chrono::steady_clock::time_point _start;
+
+    LatencyTimer(const LatencyTimer& orig);
+    LatencyTimer& operator=(const LatencyTimer& orig);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param method The HTTP method
+    /// \param path The request path
+    ///
+    LatencyTimer(const std::string& method, const std::string& path);
+    ~LatencyTimer();
+};
+
+#endif	/* LATENCYREGISTRY_HPP */
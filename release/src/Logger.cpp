@@ -0,0 +1,249 @@
+/*
+ * File:   Logger.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Logger.hpp"
+
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+uint32_t ThreadId(void) {
+  static std::atomic<uint32_t> next(1);
+  thread_local uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+  return id;
+}
+
+void CopyTruncated(char* dest, const size_t& size, const char* src) {
+  std::strncpy(dest, src, size - 1);
+  dest[size - 1] = '\0';
+}
+
+void WriteValue(std::ostream& os, const char* value) {
+  if (*value != '\0' && std::strpbrk(value, " \"=") == nullptr) {
+    os << value;
+    return;
+  }
+
+  os << '"';
+  for (const char* c = value; *c != '\0'; c++) {
+    if (*c == '"' || *c == '\\') {
+      os << '\\';
+    }
+    os << *c;
+  }
+  os << '"';
+}
+
+}
+
+std::ostream& operator << (std::ostream& os, const LogLevel& level) {
+  switch (level) {
+    case LogLevel::TRACE:
+      os << "TRACE";
+      break;
+    case LogLevel::FINE:
+      os << "FINE";
+      break;
+    case LogLevel::INFO:
+      os << "INFO";
+      break;
+    case LogLevel::WARNING:
+      os << "WARNING";
+      break;
+    case LogLevel::SEVERE:
+      os << "SEVERE";
+      break;
+    case LogLevel::OFF:
+      os << "OFF";
+      break;
+  }
+  return os;
+}
+
+LogRecord::LogRecord() : level(LogLevel::INFO), timestamp_ns(0), thread_id(0),
+    field_count(0)
+{
+  message[0] = '\0';
+}
+
+LogSink::~LogSink() {
+
+}
+
+void LogSink::Flush(void) {
+
+}
+
+StreamLogSink::StreamLogSink(std::ostream& os) : _os(os) {
+
+}
+
+void StreamLogSink::Write(const LogRecord& record) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  Format(_os, record);
+  _os << '\n';
+}
+
+void StreamLogSink::Flush(void) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _os.flush();
+}
+
+void StreamLogSink::Format(std::ostream& os, const LogRecord& record) {
+  std::time_t seconds = (std::time_t)(record.timestamp_ns / 1000000000);
+  std::tm utc;
+#ifdef _WIN32
+  gmtime_s(&utc, &seconds);
+#else
+  gmtime_r(&seconds, &utc);
+#endif
+
+  char stamp[32];
+  std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", &utc);
+  os << stamp << '.' << std::setfill('0') << std::setw(3)
+     << (record.timestamp_ns / 1000000) % 1000 << "Z "
+     << record.level << " [" << record.thread_id << "] " << record.message;
+
+  for (int i = 0; i < record.field_count; i++) {
+    os << ' ' << record.fields[i].key << '=';
+    WriteValue(os, record.fields[i].value);
+  }
+}
+
+AsyncLogSink::AsyncLogSink(const std::shared_ptr<LogSink>& target,
+    const size_t& capacity, const uint32_t& interval_ms) :
+    _target(target), _buffer(capacity), _dropped(0), _interval(interval_ms),
+    _stopping(false)
+{
+  _drainer = std::thread(&AsyncLogSink::DrainLoop, this);
+}
+
+AsyncLogSink::~AsyncLogSink() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+  }
+  _wake.notify_all();
+  _drainer.join();
+  Flush();
+}
+
+void AsyncLogSink::Write(const LogRecord& record) {
+  if (!_buffer.TryPush(record)) {
+    _dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void AsyncLogSink::Flush(void) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  Drain();
+}
+
+uint64_t AsyncLogSink::Dropped(void) const {
+  return _dropped.load(std::memory_order_relaxed);
+}
+
+void AsyncLogSink::Drain(void) {
+  LogRecord record;
+  bool any = false;
+  while (_buffer.TryPop(record)) {
+    _target->Write(record);
+    any = true;
+  }
+  if (any) {
+    _target->Flush();
+  }
+}
+
+void AsyncLogSink::DrainLoop(void) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (!_stopping) {
+    _wake.wait_for(lock, _interval);
+    Drain();
+  }
+}
+
+Logger::Logger() : _level((int)LogLevel::WARNING), _sink(nullptr) {
+  std::shared_ptr<LogSink> console(new StreamLogSink(std::cerr));
+  SetSink(std::shared_ptr<LogSink>(new AsyncLogSink(console)));
+}
+
+Logger* Logger::Instance(void) {
+  static Logger instance;
+  return &instance;
+}
+
+void Logger::SetLevel(const LogLevel& level) {
+  _level.store((int)level, std::memory_order_relaxed);
+}
+
+LogLevel Logger::Level(void) const {
+  return (LogLevel)_level.load(std::memory_order_relaxed);
+}
+
+void Logger::SetSink(const std::shared_ptr<LogSink>& sink) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  LogSink* previous = _sink.load(std::memory_order_acquire);
+  if (previous != nullptr) {
+    previous->Flush();
+  }
+  _sinks.push_back(sink);
+  _sink.store(sink.get(), std::memory_order_release);
+}
+
+void Logger::Log(const LogRecord& record) {
+  if (!Enabled(record.level)) {
+    return;
+  }
+
+  LogSink* sink = _sink.load(std::memory_order_acquire);
+  if (sink != nullptr) {
+    sink->Write(record);
+  }
+}
+
+void Logger::Flush(void) {
+  LogSink* sink = _sink.load(std::memory_order_acquire);
+  if (sink != nullptr) {
+    sink->Flush();
+  }
+}
+
+LogMessage::LogMessage(const LogLevel& level) {
+  _record.level = level;
+  _record.thread_id = ThreadId();
+  _record.timestamp_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+LogMessage::~LogMessage() {
+  Logger::Instance()->Log(_record);
+}
+
+LogMessage& LogMessage::Message(const char* message) {
+  CopyTruncated(_record.message, sizeof(_record.message), message);
+  return *this;
+}
+
+LogMessage& LogMessage::Message(const std::string& message) {
+  return Message(message.c_str());
+}
+
+LogMessage& LogMessage::Field(const char* key, const char* value) {
+  if (_record.field_count < LogRecord::MAX_FIELDS) {
+    LogField& field = _record.fields[_record.field_count++];
+    field.key = key;
+    CopyTruncated(field.value, sizeof(field.value), value);
+  }
+  return *this;
+}
+
+LogMessage& LogMessage::Field(const char* key, const std::string& value) {
+  return Field(key, value.c_str());
+}
@@ -0,0 +1,249 @@
+/*
+ * File:   Logger.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef LOGGER_HPP
+#define	LOGGER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RingBuffer.hpp"
+
+///
+/// Log levels, least to most severe.  (Named to stay clear of the DEBUG and
+/// LOG_* macros that platform headers and build configurations define.)
+///
+enum class LogLevel : int { TRACE, FINE, INFO, WARNING, SEVERE, OFF };
+
+std::ostream& operator << (std::ostream& os, const LogLevel& level);
+
+///
+/// A key and value attached to a log message.
+///
+struct LogField {
+    const char* key;    /*!< The key, must be a string literal */
+    char value[64];     /*!< The value, truncated to 63 characters */
+};
+
+///
+/// A single log message.  Fixed size so it can be queued without allocating.
+///
+struct LogRecord {
+    static const int MAX_FIELDS = 6;
+
+    LogLevel level;
+    uint64_t timestamp_ns;  /*!< Unix epoch nanoseconds */
+    uint32_t thread_id;
+    int      field_count;
+    char     message[192];
+    LogField fields[MAX_FIELDS];
+
+    LogRecord();
+};
+
+///
+/// Where log records end up.  Implement this to route the library's logging
+/// into an application's own logging framework.  Write is called on whatever
+/// thread logs, so a sink must be thread safe unless it is wrapped in an
+/// AsyncLogSink, which only ever calls its target from one thread at a time.
+///
+class LogSink {
+public:
+    virtual ~LogSink();
+
+    ///
+    /// Handles one record.
+    ///
+    /// \param record The record
+    ///
+    virtual void Write(const LogRecord& record) = 0;
+
+    ///
+    /// Pushes out anything the sink has buffered.
+    ///
+    virtual void Flush(void);
+};
+
+///
+/// Writes records as single lines of text:
+/// "2014-07-08T11:01:00.123Z SEVERE [3] Request failed method=GET path=/v1/search"
+///
+class StreamLogSink : public LogSink {
+    std::ostream& _os;
+    std::mutex _mutex;
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param os The stream to write to, which must outlive the sink
+    ///
+    explicit StreamLogSink(std::ostream& os);
+
+    virtual void Write(const LogRecord& record) override;
+    virtual void Flush(void) override;
+
+    ///
+    /// Formats a record the way Write does, without the trailing newline.
+    ///
+    /// \param os The stream to write to
+    /// \param record The record
+    ///
+    static void Format(std::ostream& os, const LogRecord& record);
+};
+
+///
+/// Queues records in a lock free ring buffer and hands them to another sink
+/// on a background thread, so the thread that logs never waits on I/O.
+/// Records are dropped (and counted) if the buffer is full.
+///
+class AsyncLogSink : public LogSink {
+    std::shared_ptr<LogSink> _target;
+    RingBuffer<LogRecord> _buffer;
+    std::atomic<uint64_t> _dropped;
+    std::chrono::milliseconds _interval;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    bool _stopping;
+    std::thread _drainer;
+
+    void Drain(void);
+    void DrainLoop(void);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param target The sink that does the writing
+    /// \param capacity The number of records the buffer holds
+    /// \param interval_ms How often the buffer is drained
+    ///
+    AsyncLogSink(const std::shared_ptr<LogSink>& target,
+                 const size_t& capacity = 4096,
+                 const uint32_t& interval_ms = 50);
+    virtual ~AsyncLogSink();
+
+    virtual void Write(const LogRecord& record) override;
+
+    ///
+    /// Drains the buffer to the target on the calling thread.
+    ///
+    virtual void Flush(void) override;
+
+    ///
+    /// Returns the number of records dropped because the buffer was full.
+    ///
+    /// \return The count
+    ///
+    uint64_t Dropped(void) const;
+};
+
+///
+/// The library's logger.  By default WARNING and above go to std::cerr
+/// through an AsyncLogSink.
+///
+/// Log through the MLLOG macro, which checks the level before any of the
+/// message is built, so a filtered out call costs a load and a compare:
+///
+///     MLLOG(LogLevel::SEVERE).Message("Request failed")
+///         .Field("path", path).Field("error", e.what());
+///
+class Logger {
+    std::atomic<int> _level;
+    std::atomic<LogSink*> _sink;
+    std::mutex _mutex;
+    std::vector<std::shared_ptr<LogSink> > _sinks;
+
+    Logger();
+    Logger(const Logger& orig);
+    Logger& operator=(const Logger& orig);
+public:
+    ///
+    /// Returns the process wide logger.
+    ///
+    /// \return The logger
+    ///
+    static Logger* Instance(void);
+
+    ///
+    /// Returns whether messages at a level will be logged.
+    ///
+    /// \param level The level
+    /// \return True if logged
+    ///
+    bool Enabled(const LogLevel& level) const {
+        return (int)level >= _level.load(std::memory_order_relaxed);
+    }
+
+    ///
+    /// Sets the lowest level that is logged.
+    ///
+    /// \param level The level, OFF to disable logging
+    ///
+    void SetLevel(const LogLevel& level);
+
+    ///
+    /// Returns the lowest level that is logged.
+    ///
+    /// \return The level
+    ///
+    LogLevel Level(void) const;
+
+    ///
+    /// Replaces the sink.  Sinks that have been replaced are kept alive until
+    /// the logger is destroyed since other threads may still be writing to
+    /// them.
+    ///
+    /// \param sink The new sink
+    ///
+    void SetSink(const std::shared_ptr<LogSink>& sink);
+
+    ///
+    /// Hands a record to the sink, if its level is enabled.
+    ///
+    /// \param record The record
+    ///
+    void Log(const LogRecord& record);
+
+    ///
+    /// Flushes the sink.
+    ///
+    void Flush(void);
+};
+
+///
+/// Builds a LogRecord and logs it when it goes out of scope.  Use MLLOG
+/// rather than creating these directly.
+///
+class LogMessage {
+    LogRecord _record;
+
+    LogMessage& operator=(const LogMessage& orig);
+public:
+    explicit LogMessage(const LogLevel& level);
+    ~LogMessage();
+
+    LogMessage& Message(const char* message);
+    LogMessage& Message(const std::string& message);
+    LogMessage& Field(const char* key, const char* value);
+    LogMessage& Field(const char* key, const std::string& value);
+
+    template<typename T>
+    LogMessage& Field(const char* key, const T& value) {
+        return Field(key, std::to_string(value));
+    }
+};
+
+#define MLLOG(level) \
+    if (!Logger::Instance()->Enabled(level)) ; else LogMessage(level)
+
+#endif	/* LOGGER_HPP */
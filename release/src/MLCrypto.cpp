@@ -12,6 +12,43 @@
 #include <sstream>
 #include <openssl/md5.h>
 
+namespace {
+
+const uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+const uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t RotateLeft(const uint64_t& x, const int& bits) {
+  return (x << bits) | (x >> (64 - bits));
+}
+
+// XXH64 reads its input little endian; compilers turn these into a
+// single load on little endian machines.
+inline uint64_t Read64(const uint8_t* p) {
+  return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+      ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) |
+      ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+}
+
+inline uint64_t Read32(const uint8_t* p) {
+  return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+      ((uint64_t)p[3] << 24);
+}
+
+inline uint64_t Round(uint64_t accumulator, const uint64_t& input) {
+  accumulator += input * PRIME64_2;
+  return RotateLeft(accumulator, 31) * PRIME64_1;
+}
+
+inline uint64_t Merge(uint64_t accumulator, const uint64_t& value) {
+  accumulator ^= Round(0, value);
+  return accumulator * PRIME64_1 + PRIME64_4;
+}
+
+}
+
 
 MLCrypto::MLCrypto() {
 }
@@ -33,6 +70,66 @@ std::string MLCrypto::Md5(const std::string& raw) const {
   return ToHex(buffer, 16);
 }
 
+uint64_t MLCrypto::FastHash(const uint8_t* bytes, const size_t& length,
+    const uint64_t& seed) const
+{
+  const uint8_t* p = bytes;
+  const uint8_t* end = bytes + length;
+  uint64_t hash;
+
+  if (length >= 32) {
+    uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+    uint64_t v2 = seed + PRIME64_2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - PRIME64_1;
+    do {
+      v1 = Round(v1, Read64(p));
+      v2 = Round(v2, Read64(p + 8));
+      v3 = Round(v3, Read64(p + 16));
+      v4 = Round(v4, Read64(p + 24));
+      p += 32;
+    } while (end - p >= 32);
+    hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+    hash = Merge(hash, v1);
+    hash = Merge(hash, v2);
+    hash = Merge(hash, v3);
+    hash = Merge(hash, v4);
+  } else {
+    hash = seed + PRIME64_5;
+  }
+  hash += (uint64_t)length;
+
+  for (; end - p >= 8; p += 8) {
+    hash ^= Round(0, Read64(p));
+    hash = RotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+  }
+  if (end - p >= 4) {
+    hash ^= Read32(p) * PRIME64_1;
+    hash = RotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+    p += 4;
+  }
+  for (; p < end; p++) {
+    hash ^= (uint64_t)*p * PRIME64_5;
+    hash = RotateLeft(hash, 11) * PRIME64_1;
+  }
+
+  hash ^= hash >> 33;
+  hash *= PRIME64_2;
+  hash ^= hash >> 29;
+  hash *= PRIME64_3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+std::string MLCrypto::FastHash(const std::string& raw) const {
+  uint64_t hash = FastHash((const uint8_t*)raw.data(), raw.size());
+  uint8_t buffer[8];
+  for (size_t i = 0; i < 8; i++) {
+    buffer[i] = (uint8_t)(hash >> (56 - 8 * i));
+  }
+  return ToHex(buffer, 8);
+}
+
 std::string MLCrypto::ToHex(const uint8_t* bytes, const size_t& length) const {
   std::ostringstream hex_ss;
   hex_ss << std::hex;
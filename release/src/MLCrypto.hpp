@@ -14,6 +14,7 @@
 #ifndef MLCRYPTO_HPP
 #define	MLCRYPTO_HPP
 
+#include <cstdint>
 #include <string>
 
 /// Crypto support classs
@@ -42,6 +43,28 @@ public:
     /// \return The MD5 hash as a hex string
     ///
     std::string Md5(const std::string& raw) const;
+
+    ///
+    /// Returns a fast 64 bit hash (XXH64) of the given bytes, for telling
+    /// whether content has changed.  It runs at memory speed but is not a
+    /// cryptographic hash: do not use it where someone may choose the
+    /// content to collide.
+    ///
+    /// \param bytes The raw bytes
+    /// \param length The number of bytes
+    /// \param seed Starts the hash; different seeds give unrelated hashes
+    /// \return The hash
+    ///
+    uint64_t FastHash(const uint8_t* bytes, const size_t& length,
+                      const uint64_t& seed = 0) const;
+
+    ///
+    /// Returns the fast hash of the given string.
+    ///
+    /// \param raw The raw string to hash
+    /// \return The hash as 16 hex digits
+    ///
+    std::string FastHash(const std::string& raw) const;
     
     ///
     /// Convert a set of bytes to a hex encoded string.
@@ -0,0 +1,151 @@
+/*
+ * File:   Multipart.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Multipart.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+std::string Lower(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(), [](char c) {
+    return (char)std::tolower((unsigned char)c);
+  });
+  return value;
+}
+
+std::string Trim(const std::string& value) {
+  size_t first = value.find_first_not_of(" \t");
+  if (first == std::string::npos) {
+    return std::string();
+  }
+  size_t last = value.find_last_not_of(" \t");
+  return value.substr(first, last - first + 1);
+}
+
+}
+
+MultipartException::MultipartException(const std::string& message) : _message(message) {
+
+}
+
+const char* MultipartException::what() const throw() {
+  return _message.c_str();
+}
+
+MultipartPart::MultipartPart() : data(nullptr), size(0) {
+
+}
+
+std::string MultipartPart::Header(const std::string& name) const {
+  header_t::const_iterator found = headers.find(Lower(name));
+  return found == headers.end() ? std::string() : found->second;
+}
+
+std::string MultipartPart::Filename(void) const {
+  return MultipartReader::Parameter(Header("content-disposition"), "filename");
+}
+
+std::string MultipartPart::Content(void) const {
+  return std::string(data, size);
+}
+
+MultipartReader::MultipartReader(const std::string& body, const std::string& boundary) :
+    _body(body), _delimiter("\r\n--" + boundary), _pos(0), _done(false)
+{
+  if (boundary.empty()) {
+    throw MultipartException("No multipart boundary");
+  }
+
+  // The first delimiter may start the body, without the leading CRLF.
+  if (_body.compare(0, _delimiter.size() - 2, _delimiter, 2, std::string::npos) == 0) {
+    _pos = _delimiter.size() - 2;
+  } else {
+    size_t found = _body.find(_delimiter);
+    if (found == std::string::npos) {
+      throw MultipartException("Multipart boundary not found");
+    }
+    _pos = found + _delimiter.size();
+  }
+}
+
+bool MultipartReader::Next(MultipartPart& part) {
+  if (_done) {
+    return false;
+  }
+
+  // _pos is just past a delimiter: "--" closes the body, CRLF starts a part.
+  if (_body.compare(_pos, 2, "--") == 0) {
+    _done = true;
+    return false;
+  }
+  size_t line_end = _body.find("\r\n", _pos);
+  if (line_end == std::string::npos) {
+    throw MultipartException("Truncated multipart body");
+  }
+  _pos = line_end + 2;
+
+  part.headers.clear();
+  while (true) {
+    line_end = _body.find("\r\n", _pos);
+    if (line_end == std::string::npos) {
+      throw MultipartException("Truncated part headers");
+    }
+    if (line_end == _pos) {
+      _pos += 2;
+      break;
+    }
+
+    size_t colon = _body.find(':', _pos);
+    if (colon == std::string::npos || colon > line_end) {
+      throw MultipartException("Malformed part header");
+    }
+    part.headers[Lower(Trim(_body.substr(_pos, colon - _pos)))] =
+        Trim(_body.substr(colon + 1, line_end - colon - 1));
+    _pos = line_end + 2;
+  }
+
+  size_t next = _body.find(_delimiter, _pos);
+  if (next == std::string::npos) {
+    throw MultipartException("Missing closing multipart boundary");
+  }
+  part.data = _body.data() + _pos;
+  part.size = next - _pos;
+  _pos = next + _delimiter.size();
+  return true;
+}
+
+std::string MultipartReader::Boundary(const std::string& content_type) {
+  return Parameter(content_type, "boundary");
+}
+
+std::string MultipartReader::Parameter(const std::string& value, const std::string& name) {
+  std::string lower = Lower(value);
+  std::string key = Lower(name) + "=";
+  size_t pos = 0;
+  while ((pos = lower.find(key, pos)) != std::string::npos) {
+    // Only match whole parameter names, not the tail of a longer one.
+    if (pos == 0 || lower[pos - 1] == ';' || lower[pos - 1] == ' ' || lower[pos - 1] == '\t') {
+      break;
+    }
+    pos += key.size();
+  }
+  if (pos == std::string::npos) {
+    return std::string();
+  }
+
+  pos += key.size();
+  if (pos < value.size() && value[pos] == '"') {
+    size_t close = value.find('"', pos + 1);
+    if (close == std::string::npos) {
+      return value.substr(pos + 1);
+    }
+    return value.substr(pos + 1, close - pos - 1);
+  }
+  size_t end = value.find(';', pos);
+  return Trim(value.substr(pos, end == std::string::npos ? std::string::npos : end - pos));
+}
@@ -0,0 +1,114 @@
+/*
+ * File:   Multipart.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef MULTIPART_HPP
+#define	MULTIPART_HPP
+
+#include <exception>
+#include <string>
+
+#include "Types.hpp"
+
+///
+/// Thrown when a multipart body is malformed.
+///
+class MultipartException : public std::exception {
+    std::string _message;
+public:
+    explicit MultipartException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// One part of a multipart body.  The content points into the body the
+/// MultipartReader was given, so it is only valid while that body is.
+///
+struct MultipartPart {
+    header_t    headers;    /*!< Part headers, names lower cased */
+    const char* data;       /*!< The part's content */
+    size_t      size;       /*!< Its length in bytes */
+
+    MultipartPart();
+
+    ///
+    /// Returns a part header.
+    ///
+    /// \param name The header name, in any case
+    /// \return The value, empty if the part has no such header
+    ///
+    std::string Header(const std::string& name) const;
+
+    ///
+    /// Returns the filename parameter of the Content-Disposition header.  In
+    /// a bulk read from /v1/documents this is the document URI.
+    ///
+    /// \return The filename, empty if there is none
+    ///
+    std::string Filename(void) const;
+
+    ///
+    /// Returns the content as a string.
+    ///
+    /// \return A copy of the content
+    ///
+    std::string Content(void) const;
+};
+
+///
+/// A forward only reader over a multipart/mixed body, such as the response
+/// to a bulk read from /v1/documents.  Parts are found by searching for the
+/// boundary; the content is not copied.
+///
+///     MultipartReader reader(response.Body(),
+///         MultipartReader::Boundary(response.GetResponseHeaders()["Content-Type"]));
+///     MultipartPart part;
+///     while (reader.Next(part)) {
+///         Save(part.Filename(), part.data, part.size);
+///     }
+///
+class MultipartReader {
+    const std::string& _body;
+    std::string _delimiter;     /*!< "\r\n--" followed by the boundary */
+    size_t _pos;
+    bool _done;
+public:
+    ///
+    /// Constructor.  The body must outlive the reader and its parts.
+    ///
+    /// \param body The multipart body
+    /// \param boundary The boundary, from the Content-Type header
+    ///
+    MultipartReader(const std::string& body, const std::string& boundary);
+
+    ///
+    /// Reads the next part.  Throws MultipartException if the body is
+    /// malformed.
+    ///
+    /// \param part Set to the part
+    /// \return False after the closing boundary
+    ///
+    bool Next(MultipartPart& part);
+
+    ///
+    /// Extracts the boundary parameter from a Content-Type header value.
+    ///
+    /// \param content_type The value ("multipart/mixed; boundary=ML_BOUNDARY_1")
+    /// \return The boundary, empty if there is none
+    ///
+    static std::string Boundary(const std::string& content_type);
+
+    ///
+    /// Extracts a parameter from a header value such as Content-Disposition,
+    /// removing quotes.
+    ///
+    /// \param value The header value
+    /// \param name The parameter name
+    /// \return The parameter, empty if it is not present
+    ///
+    static std::string Parameter(const std::string& value, const std::string& name);
+};
+
+#endif	/* MULTIPART_HPP */
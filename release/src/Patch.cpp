@@ -0,0 +1,281 @@
+/*
+ * File:   Patch.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Patch.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <cpprest/http_client.h>
+
+#include "AuthenticatingProxy.hpp"
+#include "Logger.hpp"
+
+namespace {
+
+const char* XML_PATCH_OPEN = "<rapi:patch xmlns:rapi=\"http://marklogic.com/rest-api\">";
+
+const char* PositionName(const PatchPosition& position) {
+  switch (position) {
+    case PatchPosition::BEFORE:
+      return "before";
+    case PatchPosition::AFTER:
+      return "after";
+    case PatchPosition::FIRST_CHILD:
+      return "first-child";
+    case PatchPosition::LAST_CHILD:
+      break;
+  }
+  return "last-child";
+}
+
+void AppendJsonString(std::string& out, const std::string& text) {
+  out.push_back('"');
+  for (char c : text) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          char escape[8];
+          std::snprintf(escape, sizeof(escape), "\\u%04x", (unsigned)c);
+          out += escape;
+        } else {
+          out.push_back(c);
+        }
+    }
+  }
+  out.push_back('"');
+}
+
+void AppendXmlEscaped(std::string& out, const std::string& text) {
+  for (char c : text) {
+    switch (c) {
+      case '<':
+        out += "&lt;";
+        break;
+      case '>':
+        out += "&gt;";
+        break;
+      case '&':
+        out += "&amp;";
+        break;
+      case '"':
+        out += "&quot;";
+        break;
+      default:
+        out.push_back(c);
+    }
+  }
+}
+
+}
+
+PatchBuilder::PatchBuilder(const PatchFormat& format) : _format(format), _operations(0) {
+  _body = _format == PatchFormat::JSON ? "{\"patch\":[" : XML_PATCH_OPEN;
+}
+
+void PatchBuilder::Begin(const char* operation) {
+  if (_format == PatchFormat::JSON) {
+    if (_operations > 0) {
+      _body.push_back(',');
+    }
+    _body += "{\"";
+    _body += operation;
+    _body += "\":{";
+  } else {
+    _body += "<rapi:";
+    _body += operation;
+  }
+  _operations++;
+}
+
+void PatchBuilder::Attribute(const char* name, const std::string& value) {
+  if (_format == PatchFormat::JSON) {
+    if (_body.back() != '{') {
+      _body.push_back(',');
+    }
+    _body.push_back('"');
+    _body += name;
+    _body += "\":";
+    AppendJsonString(_body, value);
+  } else {
+    _body.push_back(' ');
+    _body += name;
+    _body += "=\"";
+    AppendXmlEscaped(_body, value);
+    _body.push_back('"');
+  }
+}
+
+void PatchBuilder::End(const char* operation, const std::string& content) {
+  if (_format == PatchFormat::JSON) {
+    if (!content.empty()) {
+      _body += ",\"content\":";
+      _body += content;
+    }
+    _body += "}}";
+  } else if (content.empty()) {
+    _body += "/>";
+  } else {
+    _body.push_back('>');
+    _body += content;
+    _body += "</rapi:";
+    _body += operation;
+    _body.push_back('>');
+  }
+}
+
+PatchBuilder& PatchBuilder::Insert(const std::string& context, const PatchPosition& position,
+    const std::string& content, const std::string& cardinality)
+{
+  Begin("insert");
+  Attribute("context", context);
+  Attribute("position", PositionName(position));
+  if (!cardinality.empty()) {
+    Attribute("cardinality", cardinality);
+  }
+  End("insert", content);
+  return *this;
+}
+
+PatchBuilder& PatchBuilder::Replace(const std::string& select, const std::string& content,
+    const std::string& cardinality)
+{
+  Begin("replace");
+  Attribute("select", select);
+  if (!cardinality.empty()) {
+    Attribute("cardinality", cardinality);
+  }
+  End("replace", content);
+  return *this;
+}
+
+PatchBuilder& PatchBuilder::Delete(const std::string& select, const std::string& cardinality) {
+  Begin("delete");
+  Attribute("select", select);
+  if (!cardinality.empty()) {
+    Attribute("cardinality", cardinality);
+  }
+  End("delete", std::string());
+  return *this;
+}
+
+PatchBuilder& PatchBuilder::ReplaceInsert(const std::string& select, const std::string& context,
+    const PatchPosition& position, const std::string& content, const std::string& cardinality)
+{
+  Begin("replace-insert");
+  Attribute("select", select);
+  Attribute("context", context);
+  Attribute("position", PositionName(position));
+  if (!cardinality.empty()) {
+    Attribute("cardinality", cardinality);
+  }
+  End("replace-insert", content);
+  return *this;
+}
+
+size_t PatchBuilder::Operations(void) const {
+  return _operations;
+}
+
+std::string PatchBuilder::Body(void) const {
+  return _body + (_format == PatchFormat::JSON ? "]}" : "</rapi:patch>");
+}
+
+std::string PatchBuilder::ContentType(void) const {
+  return _format == PatchFormat::JSON ? "application/json" : "application/xml";
+}
+
+std::string PatchBuilder::Quote(const std::string& text) const {
+  std::string quoted;
+  if (_format == PatchFormat::JSON) {
+    AppendJsonString(quoted, text);
+  } else {
+    AppendXmlEscaped(quoted, text);
+  }
+  return quoted;
+}
+
+std::string PatchBuilder::Path(const std::string& uri, const bool& metadata) {
+  return "/v1/documents?uri=" + web::uri::encode_data_string(uri) +
+      (metadata ? "&category=metadata" : "");
+}
+
+PatchSummary::PatchSummary() : applied(0), failed(0) {
+
+}
+
+Patcher::Patcher(const std::string& host, const Credentials& credentials,
+    const unsigned& workers, const ProxyOptions& proxy) : _host(host), _credentials(credentials),
+    _workers(workers > 0 ? workers : 1), _proxy(proxy), _next(0)
+{
+
+}
+
+void Patcher::Add(const std::string& uri, const PatchBuilder& patch, const bool& metadata) {
+  Pending pending;
+  pending.path = PatchBuilder::Path(uri, metadata);
+  pending.uri = uri;
+  pending.body = patch.Body();
+  pending.content_type = patch.ContentType();
+  _pending.push_back(std::move(pending));
+}
+
+void Patcher::Work(Credentials credentials) {
+  AuthenticatingProxy proxy(_proxy);
+  proxy.AddCredentials(credentials);
+
+  for (size_t i = _next++; i < _pending.size(); i = _next++) {
+    const Pending& pending = _pending[i];
+    header_t headers;
+    headers["Content-Type"] = pending.content_type;
+    Response response = proxy.Patch(_host, pending.path, (const uint8_t*)pending.body.data(),
+        pending.body.size(), headers);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    int status = (int)response.GetResponseCode();
+    if (status >= 200 && status <= 299) {
+      _summary.applied++;
+    } else {
+      MLLOG(LogLevel::WARNING).Message("Patch failed").Field("uri", pending.uri)
+          .Field("status", status);
+      _summary.failed++;
+      _summary.failures[pending.uri] = "Status " + std::to_string(status) +
+          (response.Body().empty() ? std::string() : ": " + response.Body().substr(0, 500));
+    }
+  }
+}
+
+PatchSummary Patcher::Run(void) {
+  _next = 0;
+  _summary = PatchSummary();
+
+  std::vector<std::thread> workers;
+  size_t count = std::min<size_t>(_workers, _pending.size());
+  for (size_t i = 0; i < count; i++) {
+    workers.push_back(std::thread(&Patcher::Work, this, _credentials.Fork()));
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  _pending.clear();
+  return _summary;
+}
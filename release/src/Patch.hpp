@@ -0,0 +1,233 @@
+/*
+ * File:   Patch.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef PATCH_HPP
+#define	PATCH_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Credentials.hpp"
+#include "Pipeline.hpp"
+
+///
+/// The patch syntax: JSON patches apply to JSON documents and metadata,
+/// XML patches to XML documents and metadata.
+///
+enum class PatchFormat { JSON, XML };
+
+///
+/// Where inserted content goes relative to the context node.
+///
+enum class PatchPosition { BEFORE, AFTER, FIRST_CHILD, LAST_CHILD };
+
+///
+/// Builds the body of a PATCH /v1/documents request: a list of insert,
+/// replace, delete and replace-insert operations.
+///
+/// Each operation is written straight into the request body as it is
+/// added; no JSON value or XML tree is built.  Paths and content are given
+/// as text in the document's syntax: XPath (or JSONPath, for JSON patches
+/// that ask for it) for select and context, and a JSON or XML fragment for
+/// content.  Use Quote to turn a string into a fragment.
+///
+///     PatchBuilder patch;
+///     patch.Replace("/status", patch.Quote("shipped"))
+///          .Insert("/history", PatchPosition::LAST_CHILD, "{\"shipped\":\"2014-06-01\"}")
+///          .Delete("/pending");
+///     proxy.Patch(host, PatchBuilder::Path("/orders/1.json"),
+///                 patch.Body(), patch.ContentType());
+///
+/// A cardinality ("?", ".", "*" or "+") may be given with each operation;
+/// the server's default is "*".
+///
+class PatchBuilder {
+    PatchFormat _format;
+    std::string _body;      /*!< The opening and every operation so far */
+    size_t _operations;
+
+    void Begin(const char* operation);
+    void Attribute(const char* name, const std::string& value);
+    void End(const char* operation, const std::string& content);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param format The patch syntax
+    ///
+    explicit PatchBuilder(const PatchFormat& format = PatchFormat::JSON);
+
+    ///
+    /// Inserts content next to, or inside, each node matching context.
+    ///
+    /// \param context The path to the context node
+    /// \param position Where the content goes
+    /// \param content The content, a JSON value or XML fragment
+    /// \param cardinality How many nodes context must match
+    /// \return This builder
+    ///
+    PatchBuilder& Insert(const std::string& context, const PatchPosition& position,
+                         const std::string& content,
+                         const std::string& cardinality = std::string());
+
+    ///
+    /// Replaces each node matching select.
+    ///
+    /// \param select The path to the nodes to replace
+    /// \param content The new content, a JSON value or XML fragment
+    /// \param cardinality How many nodes select must match
+    /// \return This builder
+    ///
+    PatchBuilder& Replace(const std::string& select, const std::string& content,
+                          const std::string& cardinality = std::string());
+
+    ///
+    /// Deletes each node matching select.
+    ///
+    /// \param select The path to the nodes to delete
+    /// \param cardinality How many nodes select must match
+    /// \return This builder
+    ///
+    PatchBuilder& Delete(const std::string& select,
+                         const std::string& cardinality = std::string());
+
+    ///
+    /// Replaces the nodes matching select or, if there are none, inserts
+    /// the content relative to context.
+    ///
+    /// \param select The path, relative to context, to the nodes to replace
+    /// \param context The path to the context node
+    /// \param position Where the content goes when it is inserted
+    /// \param content The content, a JSON value or XML fragment
+    /// \param cardinality How many nodes context must match
+    /// \return This builder
+    ///
+    PatchBuilder& ReplaceInsert(const std::string& select, const std::string& context,
+                                const PatchPosition& position, const std::string& content,
+                                const std::string& cardinality = std::string());
+
+    ///
+    /// Returns the number of operations added.
+    ///
+    /// \return The count
+    ///
+    size_t Operations(void) const;
+
+    ///
+    /// Returns the finished patch.
+    ///
+    /// \return The request body
+    ///
+    std::string Body(void) const;
+
+    ///
+    /// Returns the media type of the patch.
+    ///
+    /// \return "application/json" or "application/xml"
+    ///
+    std::string ContentType(void) const;
+
+    ///
+    /// Returns a string as content: a quoted JSON string, or escaped XML
+    /// text.
+    ///
+    /// \param text The string
+    /// \return The content
+    ///
+    std::string Quote(const std::string& text) const;
+
+    ///
+    /// Returns the path to PATCH for a document.
+    ///
+    /// \param uri The document URI
+    /// \param metadata True to patch the document's metadata rather than
+    ///        its content
+    /// \return The path and query string
+    ///
+    static std::string Path(const std::string& uri, const bool& metadata = false);
+};
+
+///
+/// What a Patcher did.
+///
+struct PatchSummary {
+    uint64_t applied;
+    uint64_t failed;
+    std::map<std::string, std::string> failures;    /*!< URI to the server's error */
+
+    PatchSummary();
+};
+
+///
+/// Applies patches to many documents at once.  Patches are sent by worker
+/// threads, each with its own AuthenticatingProxy, taking the next patch
+/// as each request completes.  A patch the server refuses, because the
+/// document does not exist or a path matched the wrong number of nodes, is
+/// recorded in the summary and the others carry on.
+///
+///     Patcher patcher(host, proxy.GetCredentials(), 8);
+///     for (auto& uri : shipped) {
+///         patcher.Add(uri, PatchBuilder().Replace("/status", "\"shipped\""));
+///     }
+///     PatchSummary summary = patcher.Run();
+///
+class Patcher {
+    struct Pending {
+        std::string path;
+        std::string uri;
+        std::string body;
+        std::string content_type;
+    };
+
+    std::string _host;
+    Credentials _credentials;
+    unsigned _workers;
+    ProxyOptions _proxy;
+    std::vector<Pending> _pending;
+
+    std::atomic<size_t> _next;
+    std::mutex _mutex;
+    PatchSummary _summary;
+
+    Patcher(const Patcher& orig);
+    Patcher& operator=(const Patcher& orig);
+
+    void Work(Credentials credentials);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param credentials The credentials; each worker uses a Fork of them
+    /// \param workers The number of requests in flight
+    /// \param proxy The stages of the workers' proxies
+    ///
+    Patcher(const std::string& host, const Credentials& credentials,
+            const unsigned& workers = 4, const ProxyOptions& proxy = ProxyOptions());
+
+    ///
+    /// Queues a patch.  The builder's body is copied, so it may be reused.
+    ///
+    /// \param uri The document URI
+    /// \param patch The patch
+    /// \param metadata True to patch the document's metadata
+    ///
+    void Add(const std::string& uri, const PatchBuilder& patch, const bool& metadata = false);
+
+    ///
+    /// Sends every queued patch, returning once all have been answered.
+    /// The queue is emptied.
+    ///
+    /// \return The summary
+    ///
+    PatchSummary Run(void);
+};
+
+#endif	/* PATCH_HPP */
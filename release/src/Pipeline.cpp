@@ -0,0 +1,322 @@
+/*
+ * File:   Pipeline.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Pipeline.hpp"
+
+#include <algorithm>
+#include <thread>
+#include "Logger.hpp"
+
+using namespace web;
+
+namespace {
+
+const std::string AUTHORIZATION_HEADER_NAME = "Authorization";
+
+///
+/// Adds headers to a request, replacing any already set.
+///
+void AddRequestHeaders(http::http_request& req, const header_t& headers) {
+  for (auto& header : headers) {
+    if (req.headers().has(header.first)) {
+      req.headers().remove(header.first);
+    }
+    req.headers().add(header.first, header.second);
+  }
+}
+
+///
+/// Closes the read side of a request body the client stopped reading
+/// partway, so that a writer waiting for the client to catch up stops.
+/// Only bodies made for the attempt are closed: one that cannot be sent
+/// again is a StreamPayload, whose stream is the caller's.
+///
+void CloseBody(const Exchange& exchange, http::http_request& req) {
+  if (!exchange.send_body || !exchange.replayable) {
+    return;
+  }
+  try {
+    req.body().close().wait();
+  } catch (const std::exception& e) {
+    MLLOG(LogLevel::FINE).Message("Could not close the request body")
+        .Field("method", exchange.method).Field("path", exchange.path).Field("error", e.what());
+  }
+}
+
+}
+
+Exchange::Exchange(const char* method, const std::string& host, const std::string& path,
+    const header_t& headers, const BodySetter& set_body,
+    const std::function<std::string(void)>& recorded_body, bool replayable) : method(method),
+    host(host), path(path), headers(headers), set_body(set_body), recorded_body(recorded_body),
+    replayable(replayable), send_body(true), body_length(-1), trace(nullptr),
+    read_body(nullptr)
+{
+
+}
+
+void Exchange::Begin(const TracePhase& phase) {
+  if (trace != nullptr) {
+    trace->Begin(phase);
+  }
+}
+
+void Exchange::End(const TracePhase& phase) {
+  if (trace != nullptr) {
+    trace->End(phase);
+  }
+}
+
+void Exchange::Finish(void) {
+  for (auto& writer : writers) {
+    writer.wait();
+  }
+}
+
+ConnectionPool::ConnectionPool() : _state(std::make_shared<State>()) {
+
+}
+
+std::shared_ptr<http::client::http_client> ConnectionPool::Client(const std::string& host) {
+  std::lock_guard<std::mutex> lock(_state->mutex);
+  std::shared_ptr<http::client::http_client>& client = _state->clients[host];
+  if (!client) {
+    client = std::make_shared<http::client::http_client>(U(host));
+  }
+  return client;
+}
+
+HttpTransport::HttpTransport() {
+
+}
+
+HttpTransport::HttpTransport(const ConnectionPool& connections) : _connections(connections) {
+
+}
+
+void HttpTransport::Handle(Exchange& exchange) {
+  const char* method = exchange.method;
+  const std::string& path = exchange.path;
+  http::http_request req(method);
+  try {
+    if (!exchange.client) {
+      exchange.Begin(TracePhase::CONNECT);
+      exchange.client = _connections.Client(exchange.host);
+      exchange.End(TracePhase::CONNECT);
+    }
+
+    req.set_request_uri(path);
+    if (exchange.send_body) {
+      exchange.writers.push_back(exchange.set_body(req));
+    }
+    if (!exchange.authorization.empty()) {
+      req.headers().add(AUTHORIZATION_HEADER_NAME, exchange.authorization);
+    }
+    AddRequestHeaders(req, exchange.extra_headers);
+    AddRequestHeaders(req, exchange.headers);
+
+    // The response is taken here rather than in a continuation, so that
+    // read_body, which may block on the caller's work, runs on the
+    // calling thread and not on one of cpprest's pool.
+    Response& response = exchange.response;
+    exchange.Begin(TracePhase::SEND);
+    http::http_response raw_response = exchange.client->request(req).get();
+    exchange.End(TracePhase::SEND);
+    exchange.Begin(TracePhase::RECEIVE);
+    int status = raw_response.status_code();
+    if (exchange.read_body != nullptr && status >= 200 && status < 300) {
+      response.SetResponseCode((ResponseCodes)status);
+      response.SetResponseHeaders(raw_response.headers());
+      Concurrency::streams::istream body = raw_response.body();
+      try {
+        (*exchange.read_body)(response, body);
+      } catch (...) {
+        exchange.read_error = std::current_exception();
+      }
+      exchange.End(TracePhase::RECEIVE);
+      return;
+    }
+    try {
+      response.SetBody(raw_response.extract_string(true).get());
+    } catch (const web::http::http_exception& e) {
+      MLLOG(LogLevel::FINE).Message("Could not read the response body")
+          .Field("method", method).Field("path", path).Field("error", e.what());
+    }
+    exchange.End(TracePhase::RECEIVE);
+    exchange.Begin(TracePhase::PARSE);
+    response.SetResponseCode((ResponseCodes)status);
+    response.SetResponseHeaders(raw_response.headers());
+    exchange.End(TracePhase::PARSE);
+  } catch(const std::exception& e) {
+    exchange.error = e.what();
+    MLLOG(LogLevel::SEVERE).Message("Request failed")
+        .Field("method", method).Field("path", path).Field("error", e.what());
+    CloseBody(exchange, req);
+  }
+}
+
+DigestAuthStage::DigestAuthStage() {
+
+}
+
+DigestAuthStage::DigestAuthStage(const Credentials& credentials) : _credentials(credentials) {
+
+}
+
+DigestAuthStage::DigestAuthStage(const DigestAuthStage& orig) :
+    _credentials(orig.GetCredentials())
+{
+
+}
+
+DigestAuthStage& DigestAuthStage::operator=(const DigestAuthStage& orig) {
+  if (this != &orig) {
+    SetCredentials(orig.GetCredentials());
+  }
+  return *this;
+}
+
+void DigestAuthStage::SetCredentials(const Credentials& credentials) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _credentials = credentials;
+}
+
+Credentials DigestAuthStage::GetCredentials(void) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _credentials;
+}
+
+bool DigestAuthStage::Authenticating(void) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _credentials.Authenticating();
+}
+
+void DigestAuthStage::Sign(Exchange& exchange, const std::string& challenge) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!challenge.empty()) {
+    exchange.authorization = _credentials.Authenticate(exchange.method, exchange.path, challenge);
+  } else if (_credentials.Authenticating()) {
+    exchange.authorization = _credentials.Authenticate(exchange.method, exchange.path);
+  }
+}
+
+RetryStage::RetryStage(const unsigned& attempts, const std::chrono::milliseconds& backoff) :
+    _attempts(attempts > 0 ? attempts : 1), _backoff(backoff)
+{
+
+}
+
+bool RetryStage::Retry(Exchange& exchange, const unsigned& attempt) const {
+  if (attempt >= _attempts || !exchange.replayable) {
+    return false;
+  }
+
+  ResponseCodes code = exchange.response.GetResponseCode();
+  bool idempotent = std::strcmp(exchange.method, "POST") != 0 &&
+      std::strcmp(exchange.method, "PATCH") != 0;
+  if (code != ResponseCodes::SERVICE_UNAVAILABLE && !(code == (ResponseCodes)0 && idempotent)) {
+    return false;
+  }
+
+  std::chrono::milliseconds wait = _backoff * (1 << std::min(attempt - 1, 16u));
+  MLLOG(LogLevel::WARNING).Message("Retrying request")
+      .Field("method", exchange.method).Field("path", exchange.path)
+      .Field("attempt", (uint64_t)attempt + 1).Field("status", (uint64_t)code)
+      .Field("error", exchange.error);
+  std::this_thread::sleep_for(wait);
+  exchange.response = Response();
+  exchange.error.clear();
+  return true;
+}
+
+CacheStage::CacheStage(const size_t& capacity, const std::chrono::milliseconds& max_age) :
+    _capacity(capacity > 0 ? capacity : 1), _max_age(max_age), _state(new State())
+{
+  _state->hits = 0;
+}
+
+uint64_t CacheStage::Hits(void) const {
+  std::lock_guard<std::mutex> lock(_state->mutex);
+  return _state->hits;
+}
+
+void CacheStage::Clear(void) {
+  std::lock_guard<std::mutex> lock(_state->mutex);
+  _state->entries.clear();
+}
+
+std::string CacheStage::Key(const Exchange& exchange) {
+  // The host and path first, so Invalidate finds every variant together.
+  std::string key = exchange.host + exchange.path;
+  for (auto& header : exchange.headers) {
+    key += "\n" + header.first + ": " + header.second;
+  }
+  return key;
+}
+
+bool CacheStage::Lookup(Exchange& exchange, const std::string& key) {
+  std::lock_guard<std::mutex> lock(_state->mutex);
+  std::map<std::string, Entry>::const_iterator found = _state->entries.find(key);
+  if (found == _state->entries.end()) {
+    return false;
+  }
+  if (std::chrono::steady_clock::now() - found->second.fetched < _max_age) {
+    exchange.response = found->second.response;
+    _state->hits++;
+    return true;
+  }
+  if (!found->second.etag.empty()) {
+    exchange.extra_headers["If-None-Match"] = found->second.etag;
+  }
+  return false;
+}
+
+void CacheStage::Store(Exchange& exchange, const std::string& key) {
+  std::lock_guard<std::mutex> lock(_state->mutex);
+  std::map<std::string, Entry>& entries = _state->entries;
+  ResponseCodes code = exchange.response.GetResponseCode();
+  if (code == ResponseCodes::NOT_MODIFIED) {
+    std::map<std::string, Entry>::iterator found = entries.find(key);
+    if (found != entries.end()) {
+      found->second.fetched = std::chrono::steady_clock::now();
+      exchange.response = found->second.response;
+      _state->hits++;
+    }
+    return;
+  }
+  if (code != ResponseCodes::OK) {
+    entries.erase(key);
+    return;
+  }
+
+  if (entries.size() >= _capacity && entries.find(key) == entries.end()) {
+    std::map<std::string, Entry>::iterator oldest = entries.begin();
+    for (std::map<std::string, Entry>::iterator i = entries.begin(); i != entries.end(); ++i) {
+      if (i->second.fetched < oldest->second.fetched) {
+        oldest = i;
+      }
+    }
+    entries.erase(oldest);
+  }
+  Entry& entry = entries[key];
+  entry.response = exchange.response;
+  entry.etag = exchange.response.Header("ETag");
+  entry.fetched = std::chrono::steady_clock::now();
+}
+
+void CacheStage::Invalidate(const Exchange& exchange) {
+  std::string prefix = exchange.host + exchange.path;
+  std::lock_guard<std::mutex> lock(_state->mutex);
+  std::map<std::string, Entry>& entries = _state->entries;
+  std::map<std::string, Entry>::iterator i = entries.lower_bound(prefix);
+  while (i != entries.end() && i->first.compare(0, prefix.size(), prefix) == 0) {
+    if (i->first.size() == prefix.size() || i->first[prefix.size()] == '\n') {
+      i = entries.erase(i);
+    } else {
+      ++i;
+    }
+  }
+}
@@ -0,0 +1,627 @@
+/*
+ * File:   Pipeline.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef PIPELINE_HPP
+#define	PIPELINE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <cpprest/http_client.h>
+
+#include "Credentials.hpp"
+#include "LatencyRegistry.hpp"
+#include "Request.hpp"
+#include "Response.hpp"
+#include "Tracer.hpp"
+#include "TrafficRecorder.hpp"
+#include "Types.hpp"
+
+///
+/// Sets the body of one attempt at a request.  The task it returns ends
+/// once the body is written.
+///
+typedef std::function<pplx::task<void>(web::http::http_request& request)> BodySetter;
+
+///
+/// Reads a successful response body as it arrives, instead of it being
+/// kept in the Response.  Given the response, with its code and headers,
+/// and the stream of its body.
+///
+typedef std::function<void(const Response& response,
+                           Concurrency::streams::istream& body)> BodyReader;
+
+///
+/// One request on its way through a Pipeline, and its response on the way
+/// back.  Stages read and change it; the transport at the end sends it.
+///
+struct Exchange {
+    const char* method;
+    const std::string& host;
+    const std::string& path;
+    const header_t& headers;                /*!< The caller's headers */
+    const BodySetter& set_body;
+    const std::function<std::string(void)>& recorded_body;  /*!< May be empty */
+    bool replayable;        /*!< Whether the body can be sent more than once */
+    bool send_body;         /*!< False to send the request without its body */
+    int64_t body_length;    /*!< The body's length, -1 if not known up front */
+    std::string authorization;              /*!< The Authorization header, if any */
+    header_t extra_headers;                 /*!< Added by stages; the caller's win */
+    RequestTrace* trace;                    /*!< Set by TimingStage */
+    Response response;
+    std::string error;      /*!< Why there is no response, if there is none */
+    const BodyReader* read_body;            /*!< Reads a 2xx body, if set */
+    std::exception_ptr read_error;          /*!< What read_body threw */
+    std::shared_ptr<web::http::client::http_client> client;  /*!< Set by the transport */
+    std::vector<pplx::task<void> > writers;
+
+    Exchange(const char* method, const std::string& host, const std::string& path,
+             const header_t& headers, const BodySetter& set_body,
+             const std::function<std::string(void)>& recorded_body, bool replayable);
+
+    void Begin(const TracePhase& phase);
+    void End(const TracePhase& phase);
+
+    ///
+    /// Waits for the tasks writing request bodies, which use the caller's
+    /// payload.
+    ///
+    void Finish(void);
+private:
+    Exchange(const Exchange& orig);
+    Exchange& operator=(const Exchange& orig);
+};
+
+///
+/// The HTTP clients a transport sends with, one per host, so that requests
+/// to a host reuse the connections its client keeps open.  Copies share
+/// the clients; a pool made on its own starts with none.
+///
+class ConnectionPool {
+    struct State {
+        std::mutex mutex;
+        std::map<std::string, std::shared_ptr<web::http::client::http_client> > clients;
+    };
+
+    std::shared_ptr<State> _state;
+public:
+    ConnectionPool();
+
+    ///
+    /// Returns the client for a host, making it the first time.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \return The client
+    ///
+    std::shared_ptr<web::http::client::http_client> Client(const std::string& host);
+};
+
+///
+/// The end of every pipeline: sends the exchange over HTTP and fills in
+/// its response.  A failure is logged and left in Exchange::error, with no
+/// response code.
+///
+class HttpTransport {
+    ConnectionPool _connections;
+public:
+    HttpTransport();
+
+    ///
+    /// Constructor
+    ///
+    /// \param connections The clients to send with
+    ///
+    explicit HttpTransport(const ConnectionPool& connections);
+
+    void Handle(Exchange& exchange);
+};
+
+///
+/// An ordered list of stages in front of an HttpTransport, fixed when it
+/// is compiled.  A stage is any copyable class with
+///
+///     template<typename Next>
+///     void Handle(Exchange& exchange, Next& next);
+///
+/// that calls next.Handle(exchange) as many times as it likes, including
+/// not at all.  Each stage holds the rest of the pipeline by value, so a
+/// request makes no virtual calls, the compiler can inline the lot, and
+/// the stages allocate nothing unless they have something to keep.
+///
+///     Pipeline<RetryStage, CacheStage, TimingStage, DigestAuthStage> pipeline(
+///         RetryStage(3), CacheStage(), TimingStage(), DigestAuthStage(credentials));
+///     Response response = pipeline.Send(host,
+///         Request<NoPayload>(RequestMethod::GET, path, NO_PAYLOAD));
+///
+/// Stages run in the order given on the way out, and in reverse on the way
+/// back.  A pipeline is safe to share between threads if its stages are;
+/// the built in stages are.
+///
+template<typename... Stages>
+class Pipeline;
+
+template<>
+class Pipeline<> {
+    HttpTransport _transport;
+public:
+    void Handle(Exchange& exchange) {
+        _transport.Handle(exchange);
+    }
+
+    template<typename S>
+    S& Get(void) {
+        static_assert(std::is_same<S, HttpTransport>::value, "No such stage in the pipeline");
+        return _transport;
+    }
+
+    template<typename S>
+    const S& Get(void) const {
+        static_assert(std::is_same<S, HttpTransport>::value, "No such stage in the pipeline");
+        return _transport;
+    }
+};
+
+template<typename Stage, typename... Rest>
+class Pipeline<Stage, Rest...> {
+    Stage _stage;
+    Pipeline<Rest...> _next;
+public:
+    Pipeline() {
+    }
+
+    ///
+    /// Constructor
+    ///
+    /// \param stage The first stage
+    /// \param rest The stages after it
+    ///
+    explicit Pipeline(const Stage& stage, const Rest&... rest) : _stage(stage), _next(rest...) {
+    }
+
+    void Handle(Exchange& exchange) {
+        _stage.Handle(exchange, _next);
+    }
+
+    ///
+    /// Returns the first stage of the given type, or the HttpTransport at
+    /// the end, to configure it.
+    ///
+    /// \return The stage
+    ///
+    template<typename S>
+    typename std::enable_if<std::is_same<S, Stage>::value, S&>::type Get(void) {
+        return _stage;
+    }
+
+    template<typename S>
+    typename std::enable_if<!std::is_same<S, Stage>::value, S&>::type Get(void) {
+        return _next.template Get<S>();
+    }
+
+    template<typename S>
+    typename std::enable_if<std::is_same<S, Stage>::value, const S&>::type Get(void) const {
+        return _stage;
+    }
+
+    template<typename S>
+    typename std::enable_if<!std::is_same<S, Stage>::value, const S&>::type Get(void) const {
+        return _next.template Get<S>();
+    }
+
+    ///
+    /// Sends a request through the stages.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param request The request
+    /// \return The response
+    ///
+    template<typename T>
+    Response Send(const std::string& host, const Request<T>& request);
+
+    ///
+    /// Sends a request through the stages, handing a successful body to
+    /// read_body as it arrives, so it is never held whole.  Other bodies,
+    /// such as errors, are kept in the response as usual.  What read_body
+    /// throws is thrown from here.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param request The request
+    /// \param read_body Reads the body
+    /// \return The response, without the body read_body was given
+    ///
+    template<typename T>
+    Response Stream(const std::string& host, const Request<T>& request,
+                    const BodyReader& read_body);
+};
+
+namespace pipeline_detail {
+
+template<typename P, typename T>
+Response Run(P& pipeline, const std::string& host, const Request<T>& request,
+             const BodySetter& set_body, const std::function<std::string(void)>& recorded_body,
+             const int64_t& body_length, const BodyReader* read_body)
+{
+    Exchange exchange(MethodName(request.Method()), host, request.Path(), request.Headers(),
+        set_body, recorded_body, PayloadTraits<T>::REPLAYABLE);
+    exchange.body_length = body_length;
+    exchange.read_body = read_body;
+    pipeline.Handle(exchange);
+    exchange.Finish();
+    if (exchange.read_error) {
+        std::rethrow_exception(exchange.read_error);
+    }
+    return exchange.response;
+}
+
+template<typename P, typename T>
+Response Send(P& pipeline, const std::string& host, const Request<T>& request,
+              const BodyReader* read_body, std::true_type)
+{
+    typedef PayloadTraits<T> Traits;
+    std::string scratch;
+    const std::string& body = Traits::Serialize(request.Payload(), scratch);
+    return Run(pipeline, host, request, [&body](web::http::http_request& req) {
+        req.set_body(body, Traits::ContentType());
+        return pplx::task_from_result();
+    }, [&body]() {
+        return body;
+    }, (int64_t)body.size(), read_body);
+}
+
+template<typename P, typename T>
+Response Send(P& pipeline, const std::string& host, const Request<T>& request,
+              const BodyReader* read_body, std::false_type)
+{
+    typedef PayloadTraits<T> Traits;
+    const T& payload = request.Payload();
+    return Run(pipeline, host, request, [&payload](web::http::http_request& req) {
+        return Traits::Attach(req, payload);
+    }, [&payload]() {
+        return Traits::Recorded(payload);
+    }, Traits::Length(payload), read_body);
+}
+
+}
+
+template<typename Stage, typename... Rest>
+template<typename T>
+Response Pipeline<Stage, Rest...>::Send(const std::string& host, const Request<T>& request) {
+    return pipeline_detail::Send(*this, host, request, nullptr,
+        std::integral_constant<bool, PayloadTraits<T>::BUFFERED>());
+}
+
+template<typename Stage, typename... Rest>
+template<typename T>
+Response Pipeline<Stage, Rest...>::Stream(const std::string& host, const Request<T>& request,
+                                          const BodyReader& read_body)
+{
+    return pipeline_detail::Send(*this, host, request, &read_body,
+        std::integral_constant<bool, PayloadTraits<T>::BUFFERED>());
+}
+
+///
+/// Signs requests with digest authentication.  Requests are signed up
+/// front once a challenge has been seen; a 401 is answered by signing with
+/// its challenge and sending again.  A body that cannot be sent twice is
+/// sent once: until the first challenge, a HEAD collects one beforehand.
+/// Threads signing through one stage take turns, since each signature
+/// counts a nonce; give each busy thread its own Credentials::Fork.
+///
+class DigestAuthStage {
+    Credentials _credentials;
+    mutable std::mutex _mutex;      /*!< Signing counts nonces in _credentials */
+
+    bool Authenticating(void) const;
+    void Sign(Exchange& exchange, const std::string& challenge);
+public:
+    DigestAuthStage();
+
+    ///
+    /// Constructor
+    ///
+    /// \param credentials The user and password
+    ///
+    explicit DigestAuthStage(const Credentials& credentials);
+
+    DigestAuthStage(const DigestAuthStage& orig);
+    DigestAuthStage& operator=(const DigestAuthStage& orig);
+
+    void SetCredentials(const Credentials& credentials);
+    Credentials GetCredentials(void) const;
+
+    template<typename Next>
+    void Handle(Exchange& exchange, Next& next) {
+        std::string challenge;
+        if (!exchange.replayable && !Authenticating()) {
+            exchange.Begin(TracePhase::AUTH_CHALLENGE);
+            const char* method = exchange.method;
+            const BodyReader* read_body = exchange.read_body;
+            exchange.method = "HEAD";
+            exchange.send_body = false;
+            exchange.read_body = nullptr;
+            next.Handle(exchange);
+            exchange.method = method;
+            exchange.send_body = true;
+            exchange.read_body = read_body;
+            if (exchange.response.GetResponseCode() == ResponseCodes::UNAUTHORIZED) {
+                challenge = exchange.response.Header("WWW-Authenticate");
+            }
+            exchange.response = Response();
+            exchange.error.clear();
+            exchange.End(TracePhase::AUTH_CHALLENGE);
+        }
+
+        Sign(exchange, challenge);
+        next.Handle(exchange);
+
+        if (exchange.replayable &&
+            exchange.response.GetResponseCode() == ResponseCodes::UNAUTHORIZED) {
+            exchange.Begin(TracePhase::AUTH_CHALLENGE);
+            Sign(exchange, exchange.response.Header("WWW-Authenticate"));
+            next.Handle(exchange);
+            exchange.End(TracePhase::AUTH_CHALLENGE);
+        }
+    }
+};
+
+///
+/// Sends a request again when it failed in a way that is safe to repeat:
+/// a 503, which MarkLogic sends before doing any work, or, for GET, HEAD,
+/// PUT and DELETE, no response at all.  Waits twice as long before each
+/// retry as the last.  Bodies that cannot be sent twice are not retried.
+///
+class RetryStage {
+    unsigned _attempts;
+    std::chrono::milliseconds _backoff;
+
+    bool Retry(Exchange& exchange, const unsigned& attempt) const;
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param attempts Tries in all, including the first
+    /// \param backoff The wait before the first retry
+    ///
+    explicit RetryStage(const unsigned& attempts = 3,
+                        const std::chrono::milliseconds& backoff = std::chrono::milliseconds(100));
+
+    template<typename Next>
+    void Handle(Exchange& exchange, Next& next) {
+        for (unsigned attempt = 1; ; attempt++) {
+            next.Handle(exchange);
+            if (!Retry(exchange, attempt)) {
+                return;
+            }
+        }
+    }
+};
+
+///
+/// Times each request into the LatencyRegistry and traces it with the
+/// Tracer; the transport and DigestAuthStage mark their phases.
+///
+class TimingStage {
+public:
+    template<typename Next>
+    void Handle(Exchange& exchange, Next& next) {
+        LatencyTimer timer(exchange.method, exchange.path);
+        RequestTrace trace(exchange.method, exchange.path);
+        RequestTrace* outer = exchange.trace;
+        exchange.trace = &trace;
+        next.Handle(exchange);
+        exchange.trace = outer;
+    }
+};
+
+///
+/// Hands each request and its status to the TrafficRecorder, once however
+/// many times the stages after it send it.
+///
+class RecordStage {
+public:
+    template<typename Next>
+    void Handle(Exchange& exchange, Next& next) {
+        RecordedRequest recorded(exchange.method, exchange.path, exchange.headers);
+        if (recorded.Recording() && exchange.recorded_body) {
+            std::string body = exchange.recorded_body();
+            if (body.empty() && exchange.body_length > 0) {
+                // A file or stream, whose bytes are not kept to record.
+                recorded.BodyLength((uint64_t)exchange.body_length);
+            } else {
+                recorded.Body(body);
+            }
+        }
+        next.Handle(exchange);
+        recorded.Status(exchange.response.GetResponseCode());
+    }
+};
+
+///
+/// Keeps successful GET responses in memory.  Within max_age a response is
+/// answered from the cache without a request; after that it is fetched
+/// again, conditionally with If-None-Match when the server sent an ETag,
+/// and a 304 reuses the cached body.  Any other method on the same path
+/// drops what is cached for it.  Streamed responses are not cached.  Copies
+/// of the stage share one cache.
+///
+class CacheStage {
+    struct Entry {
+        Response response;
+        std::string etag;
+        std::chrono::steady_clock::time_point fetched;
+    };
+
+    struct State {
+        std::mutex mutex;
+        std::map<std::string, Entry> entries;
+        uint64_t hits;
+    };
+
+    size_t _capacity;
+    std::chrono::milliseconds _max_age;
+    std::shared_ptr<State> _state;
+
+    static std::string Key(const Exchange& exchange);
+    bool Lookup(Exchange& exchange, const std::string& key);
+    void Store(Exchange& exchange, const std::string& key);
+    void Invalidate(const Exchange& exchange);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param capacity Responses kept; the oldest goes first
+    /// \param max_age How long a response is used without asking again
+    ///
+    explicit CacheStage(const size_t& capacity = 256,
+                        const std::chrono::milliseconds& max_age = std::chrono::milliseconds(1000));
+
+    ///
+    /// Returns the number of requests answered without the server sending
+    /// a body: fresh hits and 304s.
+    ///
+    /// \return The count
+    ///
+    uint64_t Hits(void) const;
+
+    ///
+    /// Drops everything cached.
+    ///
+    void Clear(void);
+
+    template<typename Next>
+    void Handle(Exchange& exchange, Next& next) {
+        if (std::strcmp(exchange.method, "GET") != 0) {
+            next.Handle(exchange);
+            Invalidate(exchange);
+            return;
+        }
+
+        if (exchange.read_body != nullptr) {
+            next.Handle(exchange);
+            return;
+        }
+
+        std::string key = Key(exchange);
+        if (!Lookup(exchange, key)) {
+            next.Handle(exchange);
+            Store(exchange, key);
+        }
+    }
+};
+
+///
+/// A stage that is switched on or off when the pipeline is built; when
+/// off, requests go straight past it.
+///
+template<typename Stage>
+class OptionalStage {
+    Stage _stage;
+    bool _enabled;
+public:
+    OptionalStage() : _enabled(false) {
+    }
+
+    ///
+    /// Constructor, for a stage that is on.
+    ///
+    /// \param stage The stage
+    ///
+    OptionalStage(const Stage& stage) : _stage(stage), _enabled(true) {
+    }
+
+    bool Enabled(void) const {
+        return _enabled;
+    }
+
+    template<typename Next>
+    void Handle(Exchange& exchange, Next& next) {
+        if (_enabled) {
+            _stage.Handle(exchange, next);
+        } else {
+            next.Handle(exchange);
+        }
+    }
+};
+
+///
+/// A stage chosen at run time.  It calls send to pass the exchange on, as
+/// many times as it likes, including not at all.
+///
+///     StageFunction tag = [](Exchange& exchange, const std::function<void(Exchange&)>& send) {
+///         exchange.extra_headers["X-Request-Source"] = "nightly-export";
+///         send(exchange);
+///     };
+///
+typedef std::function<void(Exchange& exchange,
+                           const std::function<void(Exchange&)>& send)> StageFunction;
+
+///
+/// Runs a list of StageFunctions, in order, in front of the stages after
+/// it.  An empty list costs a comparison.  The functions are shared by
+/// every thread using the pipeline, so they must be safe to call at once.
+///
+class StageFunctions {
+    std::vector<StageFunction> _stages;
+
+    template<typename Next>
+    void Run(Exchange& exchange, Next& next, const size_t& stage) {
+        if (stage == _stages.size()) {
+            next.Handle(exchange);
+            return;
+        }
+        _stages[stage](exchange, [this, &next, stage](Exchange& passed) {
+            Run(passed, next, stage + 1);
+        });
+    }
+public:
+    StageFunctions() {
+    }
+
+    ///
+    /// Constructor
+    ///
+    /// \param stages The functions, outermost first
+    ///
+    explicit StageFunctions(const std::vector<StageFunction>& stages) : _stages(stages) {
+    }
+
+    template<typename Next>
+    void Handle(Exchange& exchange, Next& next) {
+        Run(exchange, next, 0);
+    }
+};
+
+///
+/// The stages an AuthenticatingProxy runs besides timing, recording and
+/// digest authentication, which it always runs.  By default a request is
+/// sent once, nothing is cached, and there are no stages of the caller's.
+///
+///     ProxyOptions options;
+///     options.retry = RetryStage(3);
+///     options.cache = CacheStage(256, std::chrono::seconds(5));
+///     AuthenticatingProxy proxy(options);
+///
+/// The classes that run requests on threads of their own, such as
+/// Exporter and BatchWriter, take ProxyOptions for the proxies they make.
+/// Their copies of a CacheStage share one cache, and their proxies share
+/// one client per host through connections.
+///
+struct ProxyOptions {
+    std::vector<StageFunction> stages;  /*!< Run first, outermost first */
+    OptionalStage<RetryStage> retry;
+    OptionalStage<CacheStage> cache;
+    ConnectionPool connections;         /*!< The clients the proxies send with */
+};
+
+#endif	/* PIPELINE_HPP */
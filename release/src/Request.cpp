@@ -8,4 +8,340 @@
 
 #include "Request.hpp"
 
+#include <chrono>
+#include <codecvt>
+#include <locale>
+#include <thread>
+#include <sys/stat.h>
+#include <cpprest/filestream.h>
+#include <cpprest/producerconsumerstream.h>
+#include <cpprest/rawptrstream.h>
+#include "Logger.hpp"
 
+using namespace web;
+
+const NoPayload NO_PAYLOAD = NoPayload();
+
+namespace {
+
+///
+/// Sets a streamed body, with a Content-Length when the length is known
+/// and chunked otherwise.
+///
+void SetStreamBody(http::http_request& request, const Concurrency::streams::istream& stream,
+    const int64_t& length, const char* content_type)
+{
+  if (length >= 0) {
+    request.set_body(stream, (utility::size64_t)length, content_type);
+  } else {
+    request.set_body(stream, content_type);
+  }
+}
+
+// How far a streamed body's writer may get ahead of the client, and how
+// long it waits at a time for the client to catch up.
+const size_t HIGH_WATER_MARK = 1 << 20;
+const std::chrono::milliseconds DRAIN_WAIT(1);
+
+///
+/// Adds to a streamed body's buffer, first waiting while the client is more
+/// than HIGH_WATER_MARK behind, so the body is never held whole.  Once the
+/// client stops reading, which the transport signals by closing the read
+/// side, the rest of the body is dropped.
+///
+void PutBounded(Concurrency::streams::producer_consumer_buffer<uint8_t>& buffer,
+    const char* data, const size_t& size)
+{
+  while (buffer.can_read() && buffer.in_avail() > HIGH_WATER_MARK) {
+    std::this_thread::sleep_for(DRAIN_WAIT);
+  }
+  if (buffer.can_read()) {
+    buffer.putn_nocopy((const uint8_t*)data, size).wait();
+  }
+}
+
+///
+/// Sets a body that write fills through a libxml2 output buffer on another
+/// thread, while the client drains it, as JsonBodyWriter's is.
+///
+pplx::task<void> AttachXml(http::http_request& request, const char* content_type,
+    const std::function<void(const XmlSink& sink)>& write)
+{
+  Concurrency::streams::producer_consumer_buffer<uint8_t> buffer;
+  SetStreamBody(request, buffer.create_istream(), -1, content_type);
+  return pplx::create_task([buffer, write]() mutable {
+    try {
+      write([&buffer](const char* data, const size_t& size) {
+        PutBounded(buffer, data, size);
+      });
+      buffer.close(std::ios_base::out).wait();
+    } catch (const std::exception& e) {
+      MLLOG(LogLevel::SEVERE).Message("Could not write the request body")
+          .Field("error", e.what());
+      buffer.close(std::ios_base::out, std::current_exception()).wait();
+    }
+  });
+}
+
+}
+
+const bool PayloadTraits<NoPayload>::BUFFERED;
+const bool PayloadTraits<NoPayload>::REPLAYABLE;
+const bool PayloadTraits<RawPayload>::BUFFERED;
+const bool PayloadTraits<RawPayload>::REPLAYABLE;
+const bool PayloadTraits<std::string>::BUFFERED;
+const bool PayloadTraits<std::string>::REPLAYABLE;
+const bool PayloadTraits<std::wstring>::BUFFERED;
+const bool PayloadTraits<std::wstring>::REPLAYABLE;
+const bool PayloadTraits<web::json::value>::BUFFERED;
+const bool PayloadTraits<web::json::value>::REPLAYABLE;
+const bool PayloadTraits<xmlDocPtr>::BUFFERED;
+const bool PayloadTraits<xmlDocPtr>::REPLAYABLE;
+const bool PayloadTraits<FilePayload>::BUFFERED;
+const bool PayloadTraits<FilePayload>::REPLAYABLE;
+const bool PayloadTraits<StreamPayload>::BUFFERED;
+const bool PayloadTraits<StreamPayload>::REPLAYABLE;
+const bool PayloadTraits<JsonBodyWriter>::BUFFERED;
+const bool PayloadTraits<JsonBodyWriter>::REPLAYABLE;
+const bool PayloadTraits<XmlBodyWriter>::BUFFERED;
+const bool PayloadTraits<XmlBodyWriter>::REPLAYABLE;
+
+const char* MethodName(const RequestMethod& method) {
+  switch (method) {
+    case RequestMethod::GET: return "GET";
+    case RequestMethod::POST: return "POST";
+    case RequestMethod::PUT: return "PUT";
+    case RequestMethod::PATCH: return "PATCH";
+    case RequestMethod::DEL: return "DELETE";
+    case RequestMethod::HEAD: return "HEAD";
+  }
+  return "GET";
+}
+
+RawPayload::RawPayload(const uint8_t* data, const size_t& size) : data(data), size(size) {
+
+}
+
+FilePayload::FilePayload(const std::string& path) : path(path) {
+
+}
+
+StreamPayload::StreamPayload(const Concurrency::streams::istream& stream, const int64_t& length) :
+    stream(stream), length(length)
+{
+
+}
+
+const char* PayloadTraits<NoPayload>::ContentType(void) {
+  return "";
+}
+
+int64_t PayloadTraits<NoPayload>::Length(const NoPayload& payload) {
+  return 0;
+}
+
+pplx::task<void> PayloadTraits<NoPayload>::Attach(http::http_request& request,
+    const NoPayload& payload)
+{
+  return pplx::task_from_result();
+}
+
+std::string PayloadTraits<NoPayload>::Recorded(const NoPayload& payload) {
+  return std::string();
+}
+
+const char* PayloadTraits<RawPayload>::ContentType(void) {
+  return "application/octet-stream";
+}
+
+int64_t PayloadTraits<RawPayload>::Length(const RawPayload& payload) {
+  return (int64_t)payload.size;
+}
+
+pplx::task<void> PayloadTraits<RawPayload>::Attach(http::http_request& request,
+    const RawPayload& payload)
+{
+  // Read in place; the caller's buffer outlives the request.
+  Concurrency::streams::rawptr_buffer<uint8_t> buffer(payload.data, payload.size);
+  SetStreamBody(request, buffer.create_istream(), Length(payload), ContentType());
+  return pplx::task_from_result();
+}
+
+std::string PayloadTraits<RawPayload>::Recorded(const RawPayload& payload) {
+  return std::string((const char*)payload.data, payload.size);
+}
+
+const char* PayloadTraits<std::string>::ContentType(void) {
+  return "application/octet-stream";
+}
+
+const std::string& PayloadTraits<std::string>::Serialize(const std::string& payload,
+    std::string& scratch)
+{
+  return payload;
+}
+
+const char* PayloadTraits<std::wstring>::ContentType(void) {
+  return "text/plain; charset=utf-8";
+}
+
+const std::string& PayloadTraits<std::wstring>::Serialize(const std::wstring& payload,
+    std::string& scratch)
+{
+#ifdef _WIN32
+  std::wstring_convert<std::codecvt_utf8_utf16<wchar_t> > convert;
+#else
+  std::wstring_convert<std::codecvt_utf8<wchar_t> > convert;
+#endif
+  scratch = convert.to_bytes(payload);
+  return scratch;
+}
+
+const char* PayloadTraits<web::json::value>::ContentType(void) {
+  return "application/json";
+}
+
+const std::string& PayloadTraits<web::json::value>::Serialize(const web::json::value& payload,
+    std::string& scratch)
+{
+  scratch = payload.serialize();
+  return scratch;
+}
+
+const char* PayloadTraits<xmlDocPtr>::ContentType(void) {
+  return "application/xml";
+}
+
+int64_t PayloadTraits<xmlDocPtr>::Length(const xmlDocPtr& payload) {
+  return -1;
+}
+
+pplx::task<void> PayloadTraits<xmlDocPtr>::Attach(http::http_request& request,
+    const xmlDocPtr& payload)
+{
+  return AttachXml(request, ContentType(), [&payload](const XmlSink& sink) {
+    XmlOutput::WriteDocument(payload, sink);
+  });
+}
+
+std::string PayloadTraits<xmlDocPtr>::Recorded(const xmlDocPtr& payload) {
+  std::string body;
+  XmlOutput::WriteDocument(payload, [&body](const char* data, const size_t& size) {
+    body.append(data, size);
+  });
+  return body;
+}
+
+const char* PayloadTraits<FilePayload>::ContentType(void) {
+  return "application/octet-stream";
+}
+
+int64_t PayloadTraits<FilePayload>::Length(const FilePayload& payload) {
+  struct stat info;
+  if (stat(payload.path.c_str(), &info) != 0) {
+    return -1;
+  }
+  return (int64_t)info.st_size;
+}
+
+pplx::task<void> PayloadTraits<FilePayload>::Attach(http::http_request& request,
+    const FilePayload& payload)
+{
+  // Opened afresh for each attempt, since a challenged request has already
+  // read the stream.
+  Concurrency::streams::istream file =
+      Concurrency::streams::file_stream<uint8_t>::open_istream(payload.path).get();
+  SetStreamBody(request, file, Length(payload), ContentType());
+  return pplx::task_from_result();
+}
+
+std::string PayloadTraits<FilePayload>::Recorded(const FilePayload& payload) {
+  return std::string();
+}
+
+const char* PayloadTraits<StreamPayload>::ContentType(void) {
+  return "application/octet-stream";
+}
+
+int64_t PayloadTraits<StreamPayload>::Length(const StreamPayload& payload) {
+  return payload.length;
+}
+
+pplx::task<void> PayloadTraits<StreamPayload>::Attach(http::http_request& request,
+    const StreamPayload& payload)
+{
+  SetStreamBody(request, payload.stream, Length(payload), ContentType());
+  return pplx::task_from_result();
+}
+
+std::string PayloadTraits<StreamPayload>::Recorded(const StreamPayload& payload) {
+  return std::string();
+}
+
+const char* PayloadTraits<JsonBodyWriter>::ContentType(void) {
+  return "application/json";
+}
+
+int64_t PayloadTraits<JsonBodyWriter>::Length(const JsonBodyWriter& payload) {
+  return -1;
+}
+
+pplx::task<void> PayloadTraits<JsonBodyWriter>::Attach(http::http_request& request,
+    const JsonBodyWriter& payload)
+{
+  // Each attempt gets a fresh buffer that a task fills while the client
+  // drains it, keeping no more than HIGH_WATER_MARK ahead.  The proxy waits
+  // for the task before returning, since it uses the writer, which belongs
+  // to the caller.
+  Concurrency::streams::producer_consumer_buffer<uint8_t> buffer;
+  SetStreamBody(request, buffer.create_istream(), Length(payload), ContentType());
+  return pplx::create_task([buffer, &payload]() mutable {
+    try {
+      JsonWriter writer([&buffer](const char* data, const size_t& size) {
+        PutBounded(buffer, data, size);
+      });
+      payload(writer);
+      writer.Flush();
+      if (!writer.Complete()) {
+        throw JsonWriteException("The request body is not a complete JSON document");
+      }
+      buffer.close(std::ios_base::out).wait();
+    } catch (const std::exception& e) {
+      MLLOG(LogLevel::SEVERE).Message("Could not write the request body")
+          .Field("error", e.what());
+      buffer.close(std::ios_base::out, std::current_exception()).wait();
+    }
+  });
+}
+
+std::string PayloadTraits<JsonBodyWriter>::Recorded(const JsonBodyWriter& payload) {
+  std::string body;
+  JsonWriter writer(body);
+  payload(writer);
+  writer.Flush();
+  return body;
+}
+
+const char* PayloadTraits<XmlBodyWriter>::ContentType(void) {
+  return "application/xml";
+}
+
+int64_t PayloadTraits<XmlBodyWriter>::Length(const XmlBodyWriter& payload) {
+  return -1;
+}
+
+pplx::task<void> PayloadTraits<XmlBodyWriter>::Attach(http::http_request& request,
+    const XmlBodyWriter& payload)
+{
+  return AttachXml(request, ContentType(), [&payload](const XmlSink& sink) {
+    XmlOutput::WriteBody(payload, sink);
+  });
+}
+
+std::string PayloadTraits<XmlBodyWriter>::Recorded(const XmlBodyWriter& payload) {
+  std::string body;
+  XmlOutput::WriteBody(payload, [&body](const char* data, const size_t& size) {
+    body.append(data, size);
+  });
+  return body;
+}
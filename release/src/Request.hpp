@@ -9,13 +9,291 @@
 #ifndef __MARKLOGIC_REQUEST__
 #define __MARKLOGIC_REQUEST__
 
+#include <cstdint>
+#include <string>
+#include <cpprest/http_client.h>
+#include <libxml/tree.h>
+#include "JsonWriter.hpp"
+#include "Types.hpp"
+#include "XmlStream.hpp"
+
+///
+/// The HTTP methods a Request can use.  DEL, as in cpprest, since DELETE is
+/// a macro on Windows.
+///
+enum class RequestMethod { GET, POST, PUT, PATCH, DEL, HEAD };
+
+///
+/// Returns the method as it goes on the request line.
+///
+/// \param method The method
+/// \return The name ("DELETE" for DEL)
+///
+const char* MethodName(const RequestMethod& method);
+
+///
+/// The payload of a request without a body, such as a GET or DELETE.
+///
+struct NoPayload {
+};
+
+///
+/// The payload for requests without a body.
+///
+extern const NoPayload NO_PAYLOAD;
+
+///
+/// Raw bytes that belong to the caller, sent from where they are without
+/// a copy.
+///
+struct RawPayload {
+    const uint8_t* data;
+    size_t size;
+
+    RawPayload(const uint8_t* data, const size_t& size);
+};
+
+///
+/// A file streamed from disk, opened again for each attempt so it is never
+/// held in memory.
+///
+struct FilePayload {
+    std::string path;
+
+    explicit FilePayload(const std::string& path);
+};
+
+///
+/// A stream that can be read only once.  It is sent once: a proxy that has
+/// not been challenged yet collects the challenge with a HEAD first.
+///
+struct StreamPayload {
+    Concurrency::streams::istream stream;
+    int64_t length;     /*!< Bytes to send, or -1 to send chunked until the end */
+
+    StreamPayload(const Concurrency::streams::istream& stream, const int64_t& length = -1);
+};
+
+///
+/// How a payload type goes on the wire.  Each type a Request can carry has
+/// a specialization with:
+///
+///     static const bool BUFFERED;     // Serialize once, send the bytes
+///     static const bool REPLAYABLE;   // Can be sent again after a challenge
+///     static const char* ContentType(void);
+///
+/// and, when BUFFERED,
+///
+///     static const std::string& Serialize(const T& payload, std::string& scratch);
+///
+/// returning the bytes to send, from the payload or written to scratch, or
+/// otherwise
+///
+///     static int64_t Length(const T& payload);   // -1 if not known up front
+///     static pplx::task<void> Attach(web::http::http_request& request, const T& payload);
+///     static std::string Recorded(const T& payload);
+///
+/// where Attach sets the body on each attempt, with a Content-Length from
+/// Length or chunked when it is -1, and returns a task that ends once the
+/// body is written, and Recorded gives the TrafficRecorder a copy.  Length
+/// must be cheap: a payload that has to be written out to be measured is
+/// sent chunked.
+/// Everything is resolved when AuthenticatingProxy::Send is instantiated, so
+/// a custom type streams through its own Attach without a virtual call.
+///
+template<typename T>
+struct PayloadTraits {
+    static_assert(sizeof(T) == 0, "Specialize PayloadTraits<T> to send T as a request body");
+};
+
+template<>
+struct PayloadTraits<NoPayload> {
+    static const bool BUFFERED = false;
+    static const bool REPLAYABLE = true;
+    static const char* ContentType(void);
+    static int64_t Length(const NoPayload& payload);
+    static pplx::task<void> Attach(web::http::http_request& request, const NoPayload& payload);
+    static std::string Recorded(const NoPayload& payload);
+};
+
+template<>
+struct PayloadTraits<RawPayload> {
+    static const bool BUFFERED = false;
+    static const bool REPLAYABLE = true;
+    static const char* ContentType(void);
+    static int64_t Length(const RawPayload& payload);
+    static pplx::task<void> Attach(web::http::http_request& request, const RawPayload& payload);
+    static std::string Recorded(const RawPayload& payload);
+};
+
+///
+/// A std::string is sent as raw bytes, without a copy of its own.
+///
+template<>
+struct PayloadTraits<std::string> {
+    static const bool BUFFERED = true;
+    static const bool REPLAYABLE = true;
+    static const char* ContentType(void);
+    static const std::string& Serialize(const std::string& payload, std::string& scratch);
+};
+
+template<>
+struct PayloadTraits<std::wstring> {
+    static const bool BUFFERED = true;
+    static const bool REPLAYABLE = true;
+    static const char* ContentType(void);
+    static const std::string& Serialize(const std::wstring& payload, std::string& scratch);
+};
+
+template<>
+struct PayloadTraits<web::json::value> {
+    static const bool BUFFERED = true;
+    static const bool REPLAYABLE = true;
+    static const char* ContentType(void);
+    static const std::string& Serialize(const web::json::value& payload, std::string& scratch);
+};
+
+///
+/// A document serialized through a libxml2 output buffer as it is sent,
+/// without first being dumped to a string, with chunked transfer encoding.
+/// A null document sends an empty body.
+///
+template<>
+struct PayloadTraits<xmlDocPtr> {
+    static const bool BUFFERED = false;
+    static const bool REPLAYABLE = true;
+    static const char* ContentType(void);
+    static int64_t Length(const xmlDocPtr& payload);
+    static pplx::task<void> Attach(web::http::http_request& request, const xmlDocPtr& payload);
+    static std::string Recorded(const xmlDocPtr& payload);
+};
+
+template<>
+struct PayloadTraits<FilePayload> {
+    static const bool BUFFERED = false;
+    static const bool REPLAYABLE = true;
+    static const char* ContentType(void);
+    static int64_t Length(const FilePayload& payload);
+    static pplx::task<void> Attach(web::http::http_request& request, const FilePayload& payload);
+    static std::string Recorded(const FilePayload& payload);
+};
+
+template<>
+struct PayloadTraits<StreamPayload> {
+    static const bool BUFFERED = false;
+    static const bool REPLAYABLE = false;
+    static const char* ContentType(void);
+    static int64_t Length(const StreamPayload& payload);
+    static pplx::task<void> Attach(web::http::http_request& request, const StreamPayload& payload);
+    static std::string Recorded(const StreamPayload& payload);
+};
+
+///
+/// A JSON body written as it is sent, with chunked transfer encoding.  The
+/// writer runs on another thread, waiting whenever it is a megabyte ahead
+/// of the client, and is called again if the request is challenged; if it
+/// throws, or leaves the document incomplete, the request is abandoned.
+///
+template<>
+struct PayloadTraits<JsonBodyWriter> {
+    static const bool BUFFERED = false;
+    static const bool REPLAYABLE = true;
+    static const char* ContentType(void);
+    static int64_t Length(const JsonBodyWriter& payload);
+    static pplx::task<void> Attach(web::http::http_request& request, const JsonBodyWriter& payload);
+    static std::string Recorded(const JsonBodyWriter& payload);
+};
+
+///
+/// An XML body written with a libxml2 text writer as it is sent, as a
+/// JsonBodyWriter is.
+///
+template<>
+struct PayloadTraits<XmlBodyWriter> {
+    static const bool BUFFERED = false;
+    static const bool REPLAYABLE = true;
+    static const char* ContentType(void);
+    static int64_t Length(const XmlBodyWriter& payload);
+    static pplx::task<void> Attach(web::http::http_request& request, const XmlBodyWriter& payload);
+    static std::string Recorded(const XmlBodyWriter& payload);
+};
+
+///
+/// One request for AuthenticatingProxy::Send: a method, a path, headers
+/// and a payload of any type with PayloadTraits.
+///
+///     web::json::value query = ...;
+///     Response response = proxy.Send(host,
+///         Request<web::json::value>(RequestMethod::POST, "/v1/search", query));
+///     Response page = proxy.Send(host,
+///         Request<NoPayload>(RequestMethod::GET, "/v1/search?q=cat", NO_PAYLOAD));
+///
+/// The payload and headers are borrowed, not copied, and must outlive the
+/// request, so temporaries are refused.  A Content-Type header replaces the
+/// payload's own.
+///
 template<typename T>
 class Request {
     private:
-        T _payload;
-    
+        RequestMethod _method;
+        std::string _path;
+        const T& _payload;
+        const header_t& _headers;
+
+        static const header_t& NoHeaders(void) {
+            static const header_t none;
+            return none;
+        }
+
     public:
-        
+        ///
+        /// Constructor
+        ///
+        /// \param method The method
+        /// \param path The path to invoke ("/v1/documents?uri=/foo/bar.xml")
+        /// \param payload The body
+        ///
+        Request(const RequestMethod& method, const std::string& path, const T& payload) :
+                _method(method), _path(path), _payload(payload), _headers(NoHeaders()) {
+        }
+
+        ///
+        /// Constructor
+        ///
+        /// \param method The method
+        /// \param path The path to invoke ("/v1/documents?uri=/foo/bar.xml")
+        /// \param payload The body
+        /// \param headers The HTTP headers to include
+        ///
+        Request(const RequestMethod& method, const std::string& path, const T& payload,
+                const header_t& headers) : _method(method), _path(path), _payload(payload),
+                _headers(headers) {
+        }
+
+        // Temporaries would be gone before the request is sent.
+        Request(const RequestMethod& method, const std::string& path, T&& payload) = delete;
+        Request(const RequestMethod& method, const std::string& path, T&& payload,
+                const header_t& headers) = delete;
+        Request(const RequestMethod& method, const std::string& path, const T& payload,
+                header_t&& headers) = delete;
+        Request(const RequestMethod& method, const std::string& path, T&& payload,
+                header_t&& headers) = delete;
+
+        RequestMethod Method(void) const {
+            return _method;
+        }
+
+        const std::string& Path(void) const {
+            return _path;
+        }
+
+        const T& Payload(void) const {
+            return _payload;
+        }
+
+        const header_t& Headers(void) const {
+            return _headers;
+        }
 };
 
 #endif /* __MARKLOGIC_REQUEST__ */
@@ -7,7 +7,9 @@
 //
 
 #include <algorithm>
+#include <cctype>
 #include <boost/regex.hpp>
+#include <libxml/parser.h>
 
 #include "ResponseCodes.hpp"
 #include "Response.hpp"
@@ -36,6 +38,12 @@ ResponseType Response::ParseContentTypeHeader(const std::string& content) {
   return result;
 }
 
+Response::Response() : _response_code((ResponseCodes)0),
+    _response_type(ResponseType::BINARY)
+{
+
+}
+
 void Response::SetResponseCode(const ResponseCodes& code) {
   _response_code = code;    
 }
@@ -70,6 +78,18 @@ header_t Response::GetResponseHeaders(void) const {
     return _headers;
 }
 
+std::string Response::Header(const std::string& name) const {
+    for (auto& header : _headers) {
+      if (header.first.size() == name.size() &&
+          std::equal(name.begin(), name.end(), header.first.begin(), [](char a, char b) {
+            return std::tolower((unsigned char)a) == std::tolower((unsigned char)b);
+          })) {
+        return header.second;
+      }
+    }
+    return std::string();
+}
+
 ResponseType Response::ResponseType(void) const {
     return ResponseType::TEXT;
 }
@@ -78,7 +98,12 @@ ResponseType Response::ResponseType(void) const {
  * Read up to max size bytes into the response, starting at offset.
  */
 size_t Response::Read(void* buffer, const size_t& max_size, const size_t off) {
-    return 0;
+    if (off >= _body.size()) {
+      return 0;
+    }
+    size_t count = std::min(max_size, _body.size() - off);
+    std::copy(_body.data() + off, _body.data() + off + count, (char*)buffer);
+    return count;
 }
 
 /*
@@ -86,24 +111,58 @@ size_t Response::Read(void* buffer, const size_t& max_size, const size_t off) {
  * if the response is not a string or string based.
  */
 std::wstring Response::String() const {
-    return L"";
+    return std::wstring(_body.begin(), _body.end());
 }
 
 /*
- * Tries to return the response as an XML.  Throws ResponseTypeException if it's
- * not XML.
+ * Parses the body into a libxml2 document the first time it is asked for.
+ * Entities are not expanded and nothing is fetched from the network.
  */
 xmlDocPtr Response::Xml() const {
-    return nullptr;
+    if (!_xml && !_body.empty() && _response_type == ResponseType::XML) {
+      xmlDocPtr document = xmlReadMemory(_body.data(), (int)_body.size(), nullptr, nullptr,
+          XML_PARSE_NONET | XML_PARSE_NOERROR | XML_PARSE_NOWARNING);
+      if (document != nullptr) {
+        _xml.reset(document, xmlFreeDoc);
+      }
+    }
+    return _xml.get();
 }
 
 /*
  * Guess what this does.
  */
 web::json::value Response::Json() const {
+    if (_json.is_null() && !_body.empty() && _response_type == ResponseType::JSON) {
+      try {
+        _json = web::json::value::parse(_body);
+      } catch (const std::exception& e) {
+        // Left null, as it was when the body could not be extracted.
+      }
+    }
     return _json;
 }
 
 void Response::SetJson(const web::json::value& json) {
   _json = json;
 }
+
+JsonView Response::View(void) const {
+  // A copied response shares the document but not the body it indexes,
+  // so the document is only used for the body it was built on.
+  if (!_document || _document->Data() != _body.data() || _document->Size() != _body.size()) {
+    _document = std::make_shared<JsonDocument>(_body.data(), _body.size());
+  }
+  return _document->Root();
+}
+
+const std::string& Response::Body(void) const {
+  return _body;
+}
+
+void Response::SetBody(std::string body) {
+  _body = std::move(body);
+  _json = web::json::value();
+  _document.reset();
+  _xml.reset();
+}
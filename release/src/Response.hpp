@@ -10,10 +10,12 @@
 #define __Scratch__Response__
 
 #include <cstdint>
+#include <memory>
 #include <cpprest/json.h>
 #include <cpprest/http_client.h>
 #include <libxml2/libxml/tree.h>
 
+#include "JsonView.hpp"
 #include "ResponseCodes.hpp"
 #include "Types.hpp"
 
@@ -29,7 +31,10 @@ class Response {
     ResponseCodes _response_code; /*!< The response code 200/400/404, etc */
     ResponseType  _response_type; /*!< The response type text,xml,binary, etc. */
     header_t      _headers;       /*!< The response headers */
-    web::json::value _json;
+    mutable web::json::value _json;   /*!< Parsed from the body when first asked for */
+    mutable std::shared_ptr<JsonDocument> _document; /*!< Indexes the body for View */
+    mutable std::shared_ptr<xmlDoc> _xml;   /*!< Parsed from the body when first asked for */
+    std::string   _body;          /*!< The raw body */
     
     ///
     /// Parses the content type header to guess the content type of the
@@ -39,8 +44,11 @@ class Response {
     ResponseType ParseContentTypeHeader(const std::string& content);
 public:
     ///
-    /// Constructor
+    /// Constructor.  The response code is 0 and the type BINARY until a
+    /// response is received.
     ///
+    Response();
+
     ResponseType ResponseType(void) const;
     
     ///
@@ -96,6 +104,15 @@ public:
     /// \return The HTTP response headers
     ///
     header_t GetResponseHeaders(void) const;
+
+    ///
+    /// Returns one response header, matching the name in any case, without
+    /// copying the others.
+    ///
+    /// \param name The header name ("Content-Type")
+    /// \return The value, empty if the header was not sent
+    ///
+    std::string Header(const std::string& name) const;
     
     
     ///
@@ -116,23 +133,60 @@ public:
     std::wstring String() const;
     
     ///
-    /// For XML responses, returns a document using the libxml2 library.
+    /// For XML responses, returns a document using the libxml2 library.  The
+    /// body is parsed the first time this is called.  The document belongs
+    /// to the response, and is shared with its copies; do not free it.  To
+    /// read a large body without building a tree, use an XmlReader over
+    /// Body, or AuthenticatingProxy::Stream.
     ///
-    /// \return The response document
+    /// \return The response document, null if the body is not XML
     ///
     xmlDocPtr Xml() const;
     
     ///
     /// For JSON  responses, returns the document using the Casablanca JSON
-    /// object represenation.
+    /// object represenation.  The body is parsed the first time this is
+    /// called; View is much cheaper when only some fields are wanted.
     ///
-    /// \return The JSON object
+    /// \return The JSON object, null if the body is not JSON
     ///
     web::json::value Json() const;
     
     void SetJson(const web::json::value& json);
+
+    ///
+    /// Returns a read only view of a JSON body, indexed in place the first
+    /// time it is asked for, without building a web::json::value.  The view
+    /// points into this response, which must outlive it and must not be
+    /// given a new body while it is used.  Neither View nor Json may be
+    /// called from two threads at once.  Throws JsonParseException if the
+    /// body is not JSON.
+    ///
+    ///     Response response = proxy.Get(host, "/v1/search?format=json");
+    ///     uint64_t total = response.View()["total"].Unsigned();
+    ///
+    /// \return The top level value
+    ///
+    JsonView View(void) const;
+
+    ///
+    /// Returns the raw response body.
+    ///
+    /// \return The body
+    ///
+    const std::string& Body(void) const;
+
+    ///
+    /// Sets the raw response body.  This is normally set when the response
+    /// is received.
+    ///
+    /// \param body The body, moved from
+    ///
+    void SetBody(std::string body);
     
     friend class ResponseTest;
+    friend class HotPathBench;
+    friend class AllocationBudgetTest;
 };
 
 #endif /* defined(__Scratch__Response__) */
@@ -0,0 +1,124 @@
+/*
+ * File:   RingBuffer.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef RINGBUFFER_HPP
+#define	RINGBUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+///
+/// Bounded lock free multi-producer, multi-consumer queue.
+///
+/// Every slot carries a sequence number that tells producers and consumers
+/// whose turn it is, so pushing and popping are a single compare and swap on
+/// the shared position plus a store to the slot.  When the buffer is full
+/// TryPush fails rather than blocking; callers on the request path are
+/// expected to count the drop and carry on.
+///
+/// T must be default constructible and copy assignable.  Keep it small and
+/// free of heap allocations if it is pushed from a hot path.
+///
+template<typename T>
+class RingBuffer {
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t _mask;
+    char _pad0[64];
+    std::atomic<size_t> _enqueue_pos;
+    char _pad1[64];
+    std::atomic<size_t> _dequeue_pos;
+    char _pad2[64];
+
+    RingBuffer(const RingBuffer& orig);
+    RingBuffer& operator=(const RingBuffer& orig);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param capacity The number of slots, rounded up to a power of two
+    ///
+    explicit RingBuffer(size_t capacity) : _enqueue_pos(0), _dequeue_pos(0) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _cells.reset(new Cell[size]);
+        _mask = size - 1;
+        for (size_t i = 0; i < size; i++) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ///
+    /// Returns the number of slots.
+    ///
+    /// \return The capacity
+    ///
+    size_t Capacity(void) const {
+        return _mask + 1;
+    }
+
+    ///
+    /// Adds a value if there is room.
+    ///
+    /// \param value The value to copy in
+    /// \return False if the buffer was full
+    ///
+    bool TryPush(const T& value) {
+        size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = _cells[pos & _mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            if (diff == 0) {
+                if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    ///
+    /// Removes the oldest value if there is one.
+    ///
+    /// \param value Receives the value
+    /// \return False if the buffer was empty
+    ///
+    bool TryPop(T& value) {
+        size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = _cells[pos & _mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = cell.data;
+                    cell.sequence.store(pos + _mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+#endif	/* RINGBUFFER_HPP */
@@ -0,0 +1,384 @@
+/*
+ * File:   Search.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Search.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cpprest/http_client.h>
+
+#include "AuthenticatingProxy.hpp"
+#include "JsonScanner.hpp"
+#include "Logger.hpp"
+
+const uint64_t UNKNOWN_PAGE = UINT64_MAX;
+const std::string SEARCH_NAMESPACE = "http://marklogic.com/appservices/search";
+
+namespace {
+
+void ReadStringField(JsonScanner& scanner, std::string& value) {
+  if (scanner.Peek() == JsonToken::STRING) {
+    scanner.ReadString(value);
+  } else {
+    scanner.Skip();
+  }
+}
+
+template<typename T>
+void ReadNumberField(JsonScanner& scanner, T& value) {
+  if (scanner.Peek() == JsonToken::NUMBER) {
+    value = (T)scanner.ReadNumber();
+  } else {
+    scanner.Skip();
+  }
+}
+
+void ParseResult(JsonScanner& scanner, SearchResult& result) {
+  std::string key;
+  scanner.BeginObject();
+  while (scanner.NextMember(key)) {
+    if (key == "index") {
+      ReadNumberField(scanner, result.index);
+    } else if (key == "uri") {
+      ReadStringField(scanner, result.uri);
+    } else if (key == "path") {
+      ReadStringField(scanner, result.path);
+    } else if (key == "href") {
+      ReadStringField(scanner, result.href);
+    } else if (key == "mimetype") {
+      ReadStringField(scanner, result.mimetype);
+    } else if (key == "format") {
+      ReadStringField(scanner, result.format);
+    } else if (key == "score") {
+      ReadNumberField(scanner, result.score);
+    } else if (key == "confidence") {
+      ReadNumberField(scanner, result.confidence);
+    } else if (key == "fitness") {
+      ReadNumberField(scanner, result.fitness);
+    } else {
+      scanner.Skip();
+    }
+  }
+}
+
+uint64_t ReadUnsigned(const XmlReader& reader, const char* name) {
+  return (uint64_t)std::strtoull(reader.Attribute(name).c_str(), nullptr, 10);
+}
+
+double ReadDouble(const XmlReader& reader, const char* name) {
+  return std::strtod(reader.Attribute(name).c_str(), nullptr);
+}
+
+}
+
+SearchResult::SearchResult() : index(0), score(0.0), confidence(0.0), fitness(0.0) {
+
+}
+
+SearchPage::SearchPage() : total(0), start(0), page_length(0) {
+
+}
+
+void SearchPage::Parse(const std::string& body, SearchPage& page) {
+  page = SearchPage();
+
+  JsonScanner scanner(body.data(), body.size());
+  std::string key;
+  scanner.BeginObject();
+  while (scanner.NextMember(key)) {
+    if (key == "total") {
+      ReadNumberField(scanner, page.total);
+    } else if (key == "start") {
+      ReadNumberField(scanner, page.start);
+    } else if (key == "page-length") {
+      ReadNumberField(scanner, page.page_length);
+    } else if (key == "results" && scanner.Peek() == JsonToken::ARRAY) {
+      page.results.reserve((size_t)page.page_length);
+      scanner.BeginArray();
+      while (scanner.NextElement()) {
+        page.results.push_back(SearchResult());
+        ParseResult(scanner, page.results.back());
+      }
+    } else {
+      scanner.Skip();
+    }
+  }
+}
+
+XmlSearchReader::XmlSearchReader(XmlReader& reader) : _reader(reader), _total(0), _start(0),
+    _page_length(0), _done(false)
+{
+  if (!_reader.NextElement() || _reader.Name() != "response" ||
+      _reader.NamespaceUri() != SEARCH_NAMESPACE) {
+    throw XmlParseException("Expected a search response");
+  }
+  _total = ReadUnsigned(_reader, "total");
+  _start = ReadUnsigned(_reader, "start");
+  _page_length = ReadUnsigned(_reader, "page-length");
+  _done = _reader.Empty();
+}
+
+uint64_t XmlSearchReader::Total(void) const {
+  return _total;
+}
+
+uint64_t XmlSearchReader::Start(void) const {
+  return _start;
+}
+
+uint64_t XmlSearchReader::PageLength(void) const {
+  return _page_length;
+}
+
+bool XmlSearchReader::Next(SearchResult& result) {
+  while (!_done && _reader.Next()) {
+    XmlNodeType type = _reader.Type();
+    if (type == XmlNodeType::END_ELEMENT && _reader.Depth() == 0) {
+      break;
+    } else if (type != XmlNodeType::ELEMENT) {
+      continue;
+    }
+
+    bool found = _reader.Name() == "result" && _reader.NamespaceUri() == SEARCH_NAMESPACE;
+    if (found) {
+      result = SearchResult();
+      result.index = ReadUnsigned(_reader, "index");
+      result.uri = _reader.Attribute("uri");
+      result.path = _reader.Attribute("path");
+      result.href = _reader.Attribute("href");
+      result.mimetype = _reader.Attribute("mimetype");
+      result.format = _reader.Attribute("format");
+      result.score = ReadDouble(_reader, "score");
+      result.confidence = ReadDouble(_reader, "confidence");
+      result.fitness = ReadDouble(_reader, "fitness");
+    }
+    // Past the snippets, or whatever else it is.
+    _reader.Skip();
+    if (found) {
+      return true;
+    }
+  }
+  _done = true;
+  return false;
+}
+
+SearchException::SearchException(const std::string& message) : _message(message) {
+
+}
+
+const char* SearchException::what() const throw() {
+  return _message.c_str();
+}
+
+SearchQuery::SearchQuery() : _timestamp(0) {
+
+}
+
+SearchQuery& SearchQuery::Text(const std::string& text) {
+  _text = text;
+  return *this;
+}
+
+SearchQuery& SearchQuery::Structured(const web::json::value& query) {
+  _structured = query;
+  return *this;
+}
+
+SearchQuery& SearchQuery::Options(const web::json::value& options) {
+  _options = options;
+  return *this;
+}
+
+SearchQuery& SearchQuery::OptionsName(const std::string& name) {
+  _options_name = name;
+  return *this;
+}
+
+SearchQuery& SearchQuery::Collection(const std::string& collection) {
+  _collection = collection;
+  return *this;
+}
+
+SearchQuery& SearchQuery::Directory(const std::string& directory) {
+  _directory = directory;
+  return *this;
+}
+
+SearchQuery& SearchQuery::Forest(const std::string& forest) {
+  _forest = forest;
+  return *this;
+}
+
+SearchQuery& SearchQuery::Timestamp(const uint64_t& timestamp) {
+  _timestamp = timestamp;
+  return *this;
+}
+
+std::string SearchQuery::Path(const uint64_t& start, const uint64_t& page_length) const {
+  std::string path = "/v1/search?format=json&start=" + std::to_string(start) +
+      "&pageLength=" + std::to_string(page_length);
+  if (!_options_name.empty()) {
+    path += "&options=" + web::uri::encode_data_string(_options_name);
+  }
+  if (!_collection.empty()) {
+    path += "&collection=" + web::uri::encode_data_string(_collection);
+  }
+  if (!_directory.empty()) {
+    path += "&directory=" + web::uri::encode_data_string(_directory);
+  }
+  if (!_forest.empty()) {
+    path += "&forest-name=" + web::uri::encode_data_string(_forest);
+  }
+  if (_timestamp != 0) {
+    path += "&timestamp=" + std::to_string(_timestamp);
+  }
+  return path;
+}
+
+web::json::value SearchQuery::Body(void) const {
+  web::json::value search = web::json::value::object();
+  if (!_text.empty()) {
+    search["qtext"] = web::json::value::string(_text);
+  }
+  if (!_structured.is_null()) {
+    search["query"] = _structured;
+  }
+  if (!_options.is_null()) {
+    search["options"] = _options;
+  }
+
+  web::json::value body = web::json::value::object();
+  body["search"] = search;
+  return body;
+}
+
+SearchResults::SearchResults(const std::string& host, const Credentials& credentials,
+    const SearchQuery& query, const uint64_t& page_length, const unsigned& prefetch,
+    const ProxyOptions& proxy) : _host(host), _query(query),
+    _page_length(page_length > 0 ? page_length : 1), _prefetch(prefetch > 0 ? prefetch : 1),
+    _proxy(proxy), _next_page(0), _last_page(UNKNOWN_PAGE),
+    _total_known(false), _total(0), _stopping(false), _position(0), _done(false)
+{
+  for (unsigned worker = 0; worker < _prefetch; worker++) {
+    _fetchers.push_back(std::thread(&SearchResults::FetchLoop, this, worker,
+        credentials.Fork()));
+  }
+}
+
+SearchResults::~SearchResults() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+  }
+  _changed.notify_all();
+  for (auto& fetcher : _fetchers) {
+    fetcher.join();
+  }
+}
+
+void SearchResults::FetchLoop(const unsigned worker, Credentials credentials) {
+  AuthenticatingProxy proxy(_proxy);
+  proxy.AddCredentials(credentials);
+  web::json::value body = _query.Body();
+
+  // Worker w fetches pages w, w + prefetch, w + 2 * prefetch, ... but never
+  // more than prefetch pages past the one being read.
+  for (uint64_t page = worker; ; page += _prefetch) {
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _changed.wait(lock, [this, page]() {
+        return _stopping || !_error.empty() || page > _last_page ||
+            page < _next_page + _prefetch;
+      });
+      if (_stopping || !_error.empty() || page > _last_page) {
+        return;
+      }
+    }
+
+    Response response = proxy.Post(_host, _query.Path(page * _page_length + 1, _page_length),
+        body);
+    SearchPage parsed;
+    std::string error;
+    if (response.GetResponseCode() != ResponseCodes::OK) {
+      error = "Search request failed with status " +
+          std::to_string((int)response.GetResponseCode());
+    } else {
+      try {
+        SearchPage::Parse(response.Body(), parsed);
+      } catch (const std::exception& e) {
+        error = std::string("Could not parse search results: ") + e.what();
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!error.empty()) {
+        MLLOG(LogLevel::SEVERE).Message("Search page failed")
+            .Field("start", page * _page_length + 1).Field("error", error);
+        if (_error.empty()) {
+          _error = error;
+        }
+      } else {
+        if (!_total_known) {
+          _total_known = true;
+          _total = parsed.total;
+          _last_page = std::min(_last_page, _total == 0 ? 0 : (_total - 1) / _page_length);
+        }
+        // Filtered searches can return fewer results than the total
+        // promised, so a short page ends the scan early.
+        if (parsed.results.size() < _page_length) {
+          _last_page = std::min(_last_page, page);
+        }
+        _pages[page] = std::move(parsed);
+      }
+    }
+    _changed.notify_all();
+  }
+}
+
+bool SearchResults::Advance(void) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _changed.wait(lock, [this]() {
+    return !_error.empty() || _next_page > _last_page || _pages.count(_next_page) > 0;
+  });
+  if (!_error.empty()) {
+    throw SearchException(_error);
+  }
+  if (_next_page > _last_page) {
+    return false;
+  }
+
+  std::map<uint64_t, SearchPage>::iterator found = _pages.find(_next_page);
+  _current = std::move(found->second);
+  _pages.erase(found);
+  _next_page++;
+  _position = 0;
+  lock.unlock();
+  _changed.notify_all();
+  return true;
+}
+
+bool SearchResults::Next(SearchResult& result) {
+  while (_position >= _current.results.size()) {
+    if (_done || !Advance()) {
+      _done = true;
+      return false;
+    }
+  }
+  result = std::move(_current.results[_position++]);
+  return true;
+}
+
+uint64_t SearchResults::Total(void) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _changed.wait(lock, [this]() {
+    return _total_known || !_error.empty();
+  });
+  if (!_total_known) {
+    throw SearchException(_error);
+  }
+  return _total;
+}
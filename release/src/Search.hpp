@@ -0,0 +1,297 @@
+/*
+ * File:   Search.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SEARCH_HPP
+#define	SEARCH_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cpprest/json.h>
+
+#include "Credentials.hpp"
+#include "Pipeline.hpp"
+#include "XmlStream.hpp"
+
+///
+/// One hit from /v1/search.
+///
+struct SearchResult {
+    uint64_t    index;      /*!< 1 based position in the full result set */
+    std::string uri;
+    std::string path;
+    std::string href;
+    std::string mimetype;
+    std::string format;
+    double      score;
+    double      confidence;
+    double      fitness;
+
+    SearchResult();
+};
+
+///
+/// One page of a /v1/search response.  Matches, snippets, facets and metrics
+/// are skipped.
+///
+struct SearchPage {
+    uint64_t total;         /*!< Matching documents; an estimate for unfiltered searches */
+    uint64_t start;
+    uint64_t page_length;
+    std::vector<SearchResult> results;
+
+    SearchPage();
+
+    ///
+    /// Parses a JSON search response in a single pass, without building a
+    /// web::json::value.  Throws JsonParseException if the text is not JSON.
+    ///
+    /// \param body The response body
+    /// \param page Filled in with the page
+    ///
+    static void Parse(const std::string& body, SearchPage& page);
+};
+
+///
+/// Reads an XML search response (format=xml) one result at a time from an
+/// XmlReader, so a page of any size is read in constant memory when the
+/// reader is on a stream, as from AuthenticatingProxy::Stream.  Snippets,
+/// facets and metrics are skipped.
+///
+///     XmlReader reader(body);
+///     XmlSearchReader results(reader);
+///     SearchResult result;
+///     while (results.Next(result)) {
+///         ...
+///     }
+///
+class XmlSearchReader {
+    XmlReader& _reader;
+    uint64_t _total;
+    uint64_t _start;
+    uint64_t _page_length;
+    bool _done;
+
+    XmlSearchReader(const XmlSearchReader& orig);
+    XmlSearchReader& operator=(const XmlSearchReader& orig);
+public:
+    ///
+    /// Constructor.  Reads up to the response element, throwing
+    /// XmlParseException if the document is not a search response.
+    ///
+    /// \param reader The reader, at the start of the document
+    ///
+    explicit XmlSearchReader(XmlReader& reader);
+
+    uint64_t Total(void) const;
+    uint64_t Start(void) const;
+    uint64_t PageLength(void) const;
+
+    ///
+    /// Reads the next result.  Throws XmlParseException if the XML is
+    /// malformed.
+    ///
+    /// \param result Set to the result
+    /// \return False when there are no more results
+    ///
+    bool Next(SearchResult& result);
+};
+
+///
+/// Thrown when a search request fails.
+///
+class SearchException : public std::exception {
+    std::string _message;
+public:
+    explicit SearchException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// A search to run with SearchResults: a string query, a structured query,
+/// or both combined, plus optional query options and scope.  Sent as a
+/// combined query to POST /v1/search.
+///
+class SearchQuery {
+    std::string _text;
+    web::json::value _structured;
+    web::json::value _options;
+    std::string _options_name;
+    std::string _collection;
+    std::string _directory;
+    std::string _forest;
+    uint64_t _timestamp;
+public:
+    SearchQuery();
+
+    ///
+    /// Sets the string query ("cat AND dog").
+    ///
+    /// \param text The query text
+    /// \return This query
+    ///
+    SearchQuery& Text(const std::string& text);
+
+    ///
+    /// Sets the structured query, the value of its "query" property.
+    ///
+    /// \param query The structured query
+    /// \return This query
+    ///
+    SearchQuery& Structured(const web::json::value& query);
+
+    ///
+    /// Sets query options to send along with the query.
+    ///
+    /// \param options The value of the "options" property
+    /// \return This query
+    ///
+    SearchQuery& Options(const web::json::value& options);
+
+    ///
+    /// Names persistent query options installed on the server.
+    ///
+    /// \param name The options name
+    /// \return This query
+    ///
+    SearchQuery& OptionsName(const std::string& name);
+
+    ///
+    /// Limits the search to a collection.
+    ///
+    /// \param collection The collection URI
+    /// \return This query
+    ///
+    SearchQuery& Collection(const std::string& collection);
+
+    ///
+    /// Limits the search to a directory.
+    ///
+    /// \param directory The directory URI, ending in '/'
+    /// \return This query
+    ///
+    SearchQuery& Directory(const std::string& directory);
+
+    ///
+    /// Limits the search to the documents in one forest.
+    ///
+    /// \param forest The forest name
+    /// \return This query
+    ///
+    SearchQuery& Forest(const std::string& forest);
+
+    ///
+    /// Runs the search at a point in time, as returned in the
+    /// ML-Effective-Timestamp header, so every page sees the same database
+    /// state however long the scan takes.
+    ///
+    /// \param timestamp The timestamp, 0 for the latest state
+    /// \return This query
+    ///
+    SearchQuery& Timestamp(const uint64_t& timestamp);
+
+    ///
+    /// Returns the request path for one page.
+    ///
+    /// \param start The 1 based index of the first result
+    /// \param page_length The number of results
+    /// \return The path and query string
+    ///
+    std::string Path(const uint64_t& start, const uint64_t& page_length) const;
+
+    ///
+    /// Returns the combined query to POST.
+    ///
+    /// \return The body
+    ///
+    web::json::value Body(void) const;
+};
+
+///
+/// A lazy iterator over every result of a search.  Pages are fetched by
+/// background threads, each with its own AuthenticatingProxy, up to
+/// prefetch pages ahead of the one being read, so the next pages are
+/// already on their way while the caller works through the current one.
+///
+///     SearchResults results(host, proxy.GetCredentials(),
+///                           SearchQuery().Directory("/orders/"), 500, 4);
+///     SearchResult result;
+///     while (results.Next(result)) {
+///         ...
+///     }
+///
+/// Destroying the iterator part way through stops the fetchers once any
+/// request already in flight completes.
+///
+class SearchResults {
+    std::string _host;
+    SearchQuery _query;
+    uint64_t _page_length;
+    unsigned _prefetch;
+    ProxyOptions _proxy;
+
+    std::mutex _mutex;
+    std::condition_variable _changed;
+    std::map<uint64_t, SearchPage> _pages;  /*!< Fetched pages not yet read */
+    uint64_t _next_page;                    /*!< The page Next reads after the current one */
+    uint64_t _last_page;                    /*!< Known once the first response arrives */
+    bool _total_known;
+    uint64_t _total;
+    bool _stopping;
+    std::string _error;
+    std::vector<std::thread> _fetchers;
+
+    SearchPage _current;
+    size_t _position;
+    bool _done;
+
+    SearchResults(const SearchResults& orig);
+    SearchResults& operator=(const SearchResults& orig);
+
+    void FetchLoop(const unsigned worker, Credentials credentials);
+    bool Advance(void);
+public:
+    ///
+    /// Constructor.  Starts fetching straight away.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param credentials The credentials; each fetcher uses a Fork of them
+    /// \param query The search
+    /// \param page_length The results per request
+    /// \param prefetch How many pages may be fetched ahead, and the number
+    ///        of fetcher threads
+    /// \param proxy The stages of the fetchers' proxies
+    ///
+    SearchResults(const std::string& host, const Credentials& credentials,
+                  const SearchQuery& query, const uint64_t& page_length = 10,
+                  const unsigned& prefetch = 2, const ProxyOptions& proxy = ProxyOptions());
+    ~SearchResults();
+
+    ///
+    /// Returns the next result, waiting for its page if needed.  Throws
+    /// SearchException if a page could not be fetched.
+    ///
+    /// \param result Set to the result
+    /// \return False when there are no more results
+    ///
+    bool Next(SearchResult& result);
+
+    ///
+    /// Returns the total reported by the server, waiting for the first page
+    /// if needed.
+    ///
+    /// \return The total
+    ///
+    uint64_t Total(void);
+};
+
+#endif	/* SEARCH_HPP */
@@ -0,0 +1,375 @@
+/*
+ * File:   Sparql.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Sparql.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <cpprest/http_client.h>
+
+#include "AuthenticatingProxy.hpp"
+#include "Logger.hpp"
+
+namespace {
+
+std::string RunQuery(AuthenticatingProxy& proxy, const std::string& host,
+    const std::string& query, const std::string& default_graph)
+{
+  std::string path = "/v1/graphs/sparql";
+  if (!default_graph.empty()) {
+    path += "?default-graph-uri=" + web::uri::encode_data_string(default_graph);
+  }
+
+  header_t headers;
+  headers["Content-Type"] = "application/sparql-query";
+  headers["Accept"] = "application/sparql-results+json";
+  Response response = proxy.Post(host, path, (const uint8_t*)query.data(), query.size(),
+      headers);
+  if (response.GetResponseCode() != ResponseCodes::OK) {
+    throw SparqlException("SPARQL query failed with status " +
+        std::to_string((int)response.GetResponseCode()) + ": " +
+        response.Body().substr(0, 200));
+  }
+
+  return response.Body();
+}
+
+///
+/// Counts the statements in a chunk of N-Triples or N-Quads: the lines
+/// that are neither blank nor comments.
+///
+uint64_t CountStatements(const char* data, const size_t& size, bool& line_start) {
+  uint64_t count = 0;
+  for (size_t i = 0; i < size; i++) {
+    char c = data[i];
+    if (c == '\n') {
+      line_start = true;
+    } else if (line_start && c != ' ' && c != '\t' && c != '\r') {
+      if (c != '#') {
+        count++;
+      }
+      line_start = false;
+    }
+  }
+  return count;
+}
+
+///
+/// Reads a line based file through, counting its statements, and returns
+/// whether it may name a blank node.  A "_:" in an IRI or a literal counts
+/// as one, which costs no more than the file going in one request.
+///
+bool ScanLines(std::istream& in, std::vector<char>& buffer, uint64_t& statements) {
+  bool blank = false;
+  bool line_start = true;
+  char last = '\0';
+  while (in) {
+    in.read(buffer.data(), (std::streamsize)buffer.size());
+    size_t read = (size_t)in.gcount();
+    if (read == 0) {
+      break;
+    }
+    statements += CountStatements(buffer.data(), read, line_start);
+    if (!blank) {
+      blank = last == '_' && buffer[0] == ':';
+      for (size_t i = 1; i < read && !blank; i++) {
+        blank = buffer[i - 1] == '_' && buffer[i] == ':';
+      }
+    }
+    last = buffer[read - 1];
+  }
+  return blank;
+}
+
+}
+
+SparqlTerm::SparqlTerm() : bound(false) {
+
+}
+
+SparqlException::SparqlException(const std::string& message) : _message(message) {
+
+}
+
+const char* SparqlException::what() const throw() {
+  return _message.c_str();
+}
+
+SparqlResults::SparqlResults(AuthenticatingProxy& proxy, const std::string& host,
+    const std::string& query, const std::string& default_graph) :
+    _body(RunQuery(proxy, host, query, default_graph)), _scanner(_body.data(), _body.size()),
+    _in_bindings(false), _has_boolean(false), _boolean(false)
+{
+  _scanner.BeginObject();
+  ReadRoot();
+}
+
+SparqlResults::SparqlResults(std::string body) : _body(std::move(body)),
+    _scanner(_body.data(), _body.size()), _in_bindings(false), _has_boolean(false),
+    _boolean(false)
+{
+  _scanner.BeginObject();
+  ReadRoot();
+}
+
+void SparqlResults::ReadRoot(void) {
+  std::string key;
+  while (_scanner.NextMember(key)) {
+    if (key == "head" && _scanner.Peek() == JsonToken::OBJECT) {
+      ReadHead();
+    } else if (key == "boolean" && _scanner.Peek() == JsonToken::BOOLEAN) {
+      _has_boolean = true;
+      _boolean = _scanner.ReadBoolean();
+    } else if (key == "results" && _scanner.Peek() == JsonToken::OBJECT) {
+      _scanner.BeginObject();
+      if (ReadResults()) {
+        // Paused at the first row; Next carries on from here.
+        return;
+      }
+    } else {
+      _scanner.Skip();
+    }
+  }
+}
+
+bool SparqlResults::ReadResults(void) {
+  std::string key;
+  while (_scanner.NextMember(key)) {
+    if (key == "bindings" && _scanner.Peek() == JsonToken::ARRAY) {
+      _scanner.BeginArray();
+      _in_bindings = true;
+      return true;
+    }
+    _scanner.Skip();
+  }
+  return false;
+}
+
+void SparqlResults::ReadHead(void) {
+  std::string key;
+  _scanner.BeginObject();
+  while (_scanner.NextMember(key)) {
+    if (key == "vars" && _scanner.Peek() == JsonToken::ARRAY) {
+      _scanner.BeginArray();
+      while (_scanner.NextElement()) {
+        Column(_scanner.ReadString());
+      }
+    } else {
+      _scanner.Skip();
+    }
+  }
+}
+
+size_t SparqlResults::Column(const std::string& variable) {
+  for (size_t i = 0; i < _variables.size(); i++) {
+    if (_variables[i] == variable) {
+      return i;
+    }
+  }
+  _variables.push_back(variable);
+  return _variables.size() - 1;
+}
+
+void SparqlResults::ReadTerm(SparqlTerm& term) {
+  std::string key;
+  term.bound = true;
+  _scanner.BeginObject();
+  while (_scanner.NextMember(key)) {
+    if (key == "type") {
+      _scanner.ReadString(term.type);
+    } else if (key == "value") {
+      _scanner.ReadString(term.value);
+    } else if (key == "datatype") {
+      _scanner.ReadString(term.datatype);
+    } else if (key == "xml:lang") {
+      _scanner.ReadString(term.language);
+    } else {
+      _scanner.Skip();
+    }
+  }
+}
+
+const std::vector<std::string>& SparqlResults::Variables(void) const {
+  return _variables;
+}
+
+bool SparqlResults::Next(SparqlRow& row) {
+  while (_in_bindings) {
+    if (!_scanner.NextElement()) {
+      _in_bindings = false;
+      if (!ReadResults()) {
+        ReadRoot();
+      }
+      continue;
+    }
+
+    row.assign(_variables.size(), SparqlTerm());
+    std::string variable;
+    _scanner.BeginObject();
+    while (_scanner.NextMember(variable)) {
+      size_t column = Column(variable);
+      if (column >= row.size()) {
+        row.resize(column + 1);
+      }
+      ReadTerm(row[column]);
+    }
+    return true;
+  }
+  return false;
+}
+
+bool SparqlResults::HasBoolean(void) const {
+  return _has_boolean;
+}
+
+bool SparqlResults::Boolean(void) const {
+  return _boolean;
+}
+
+GraphLoadSummary::GraphLoadSummary() : bytes(0), statements(0), requests(0) {
+
+}
+
+GraphLoader::GraphLoader(AuthenticatingProxy& proxy, const std::string& host,
+    const size_t& chunk_bytes) : _proxy(proxy), _host(host),
+    _chunk_bytes(chunk_bytes > 0 ? chunk_bytes : 1)
+{
+
+}
+
+std::string GraphLoader::GraphsPath(const std::string& graph, const RdfFormat& format) {
+  if (!graph.empty()) {
+    return "/v1/graphs?graph=" + web::uri::encode_data_string(graph);
+  }
+  // Quads name their own graphs; triples go to the default graph.
+  return format == RdfFormat::NQUADS ? "/v1/graphs" : "/v1/graphs?default";
+}
+
+std::string GraphLoader::ContentType(const RdfFormat& format) {
+  switch (format) {
+    case RdfFormat::NQUADS:
+      return "application/n-quads";
+    case RdfFormat::TURTLE:
+      return "text/turtle";
+    default:
+      return "application/n-triples";
+  }
+}
+
+void GraphLoader::Send(const std::string& path, const std::string& content_type,
+    const char* data, const size_t& size, GraphLoadSummary& summary)
+{
+  header_t headers;
+  headers["Content-Type"] = content_type;
+  Response response = _proxy.Post(_host, path, (const uint8_t*)data, size, headers);
+  ResponseCodes code = response.GetResponseCode();
+  if (code != ResponseCodes::NO_CONTENT && code != ResponseCodes::CREATED &&
+      code != ResponseCodes::OK) {
+    throw SparqlException("Graph load failed with status " + std::to_string((int)code) +
+        " after " + std::to_string(summary.bytes) + " bytes: " + response.Body().substr(0, 200));
+  }
+  summary.bytes += size;
+  summary.requests++;
+}
+
+void GraphLoader::SendFile(const std::string& path, const std::string& content_type,
+    const std::string& file_path, GraphLoadSummary& summary)
+{
+  std::ifstream in(file_path.c_str(), std::ios::binary | std::ios::ate);
+  uint64_t size = (uint64_t)in.tellg();
+  in.close();
+
+  // A cheap query first, so the file is not sent once just to be
+  // challenged for credentials.
+  if (!_proxy.GetCredentials().Authenticating()) {
+    SparqlResults ask(_proxy, _host, "ASK {}");
+  }
+
+  header_t headers;
+  headers["Content-Type"] = content_type;
+  Response response = _proxy.PostFile(_host, path, file_path, headers);
+  ResponseCodes code = response.GetResponseCode();
+  if (code != ResponseCodes::NO_CONTENT && code != ResponseCodes::CREATED &&
+      code != ResponseCodes::OK) {
+    throw SparqlException("Graph load failed with status " + std::to_string((int)code) +
+        ": " + response.Body().substr(0, 200));
+  }
+  summary.bytes = size;
+  summary.requests = 1;
+}
+
+GraphLoadSummary GraphLoader::LoadFile(const std::string& file_path, const RdfFormat& format,
+    const std::string& graph)
+{
+  std::ifstream in(file_path.c_str(), std::ios::binary);
+  if (!in) {
+    throw SparqlException("Could not open " + file_path);
+  }
+
+  GraphLoadSummary summary;
+  std::string path = GraphsPath(graph, format);
+  std::string content_type = ContentType(format);
+
+  if (format == RdfFormat::TURTLE) {
+    in.close();
+    SendFile(path, content_type, file_path, summary);
+    return summary;
+  }
+
+  // The server scopes blank node labels to a request, so a file that uses
+  // them goes whole, or _:b1 in two chunks would be two nodes.
+  std::vector<char> buffer(_chunk_bytes);
+  uint64_t statements = 0;
+  if (ScanLines(in, buffer, statements)) {
+    in.close();
+    SendFile(path, content_type, file_path, summary);
+    summary.statements = statements;
+    MLLOG(LogLevel::FINE).Message("Graph loaded in one request, for its blank nodes")
+        .Field("file", file_path).Field("statements", summary.statements);
+    return summary;
+  }
+  in.clear();
+  in.seekg(0);
+
+  // Fill the buffer, send the whole lines in it, and carry the partial
+  // last line over to the next chunk.  A line longer than the buffer grows
+  // it.
+  size_t filled = 0;
+  bool done = false;
+  while (!done) {
+    in.read(buffer.data() + filled, (std::streamsize)(buffer.size() - filled));
+    filled += (size_t)in.gcount();
+    done = !in;
+
+    size_t end = filled;
+    if (!done) {
+      const char* last = nullptr;
+      for (size_t i = filled; i > 0; i--) {
+        if (buffer[i - 1] == '\n') {
+          last = buffer.data() + i - 1;
+          break;
+        }
+      }
+      if (last == nullptr) {
+        buffer.resize(buffer.size() * 2);
+        continue;
+      }
+      end = (size_t)(last - buffer.data()) + 1;
+    }
+
+    if (end > 0) {
+      Send(path, content_type, buffer.data(), end, summary);
+      bool line_start = true;
+      summary.statements += CountStatements(buffer.data(), end, line_start);
+    }
+    std::memmove(buffer.data(), buffer.data() + end, filled - end);
+    filled -= end;
+  }
+
+  MLLOG(LogLevel::FINE).Message("Graph loaded").Field("file", file_path)
+      .Field("statements", summary.statements).Field("requests", summary.requests);
+  return summary;
+}
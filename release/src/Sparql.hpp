@@ -0,0 +1,218 @@
+/*
+ * File:   Sparql.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SPARQL_HPP
+#define	SPARQL_HPP
+
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "JsonScanner.hpp"
+
+class AuthenticatingProxy;
+
+///
+/// One value in a SPARQL result row.
+///
+struct SparqlTerm {
+    bool        bound;      /*!< False if the variable has no value in this row */
+    std::string type;       /*!< "uri", "literal" or "bnode" */
+    std::string value;
+    std::string datatype;   /*!< For typed literals */
+    std::string language;   /*!< For language tagged literals */
+
+    SparqlTerm();
+};
+
+///
+/// A result row, one term per variable in the order of
+/// SparqlResults::Variables.
+///
+typedef std::vector<SparqlTerm> SparqlRow;
+
+///
+/// Thrown when a SPARQL request fails.
+///
+class SparqlException : public std::exception {
+    std::string _message;
+public:
+    explicit SparqlException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// The results of a SPARQL SELECT or ASK query, read from
+/// application/sparql-results+json one row at a time.
+///
+/// Rows are decoded as Next is called, straight from the response text,
+/// so a large result set costs the text and one row rather than a tree of
+/// every binding.
+///
+///     SparqlResults results(proxy, host,
+///         "SELECT ?doc ?source WHERE { ?doc <http://www.w3.org/ns/prov#wasDerivedFrom> ?source }");
+///     SparqlRow row;
+///     while (results.Next(row)) {
+///         std::cout << row[0].value << " <- " << row[1].value << std::endl;
+///     }
+///
+class SparqlResults {
+    std::string _body;
+    JsonScanner _scanner;
+    std::vector<std::string> _variables;
+    bool _in_bindings;      /*!< The scanner is inside results.bindings */
+    bool _has_boolean;
+    bool _boolean;
+
+    SparqlResults(const SparqlResults& orig);
+    SparqlResults& operator=(const SparqlResults& orig);
+
+    void ReadRoot(void);
+    bool ReadResults(void);
+    void ReadHead(void);
+    void ReadTerm(SparqlTerm& term);
+    size_t Column(const std::string& variable);
+public:
+    ///
+    /// Runs a query with POST /v1/graphs/sparql.  Throws SparqlException if
+    /// the server refuses it.
+    ///
+    /// \param proxy The proxy to send the request through
+    /// \param host The server ("http://localhost:8000")
+    /// \param query The SPARQL query
+    /// \param default_graph The graph to query, empty for all graphs
+    ///
+    SparqlResults(AuthenticatingProxy& proxy, const std::string& host,
+                  const std::string& query,
+                  const std::string& default_graph = std::string());
+
+    ///
+    /// Reads results already fetched.
+    ///
+    /// \param body The application/sparql-results+json text, moved from
+    ///
+    explicit SparqlResults(std::string body);
+
+    ///
+    /// Returns the variable names, without the '?'.  Variables first seen
+    /// in a binding, when the server sends the head last, are added as rows
+    /// are read.
+    ///
+    /// \return The names
+    ///
+    const std::vector<std::string>& Variables(void) const;
+
+    ///
+    /// Returns the next row.  Throws JsonParseException if the text is not
+    /// a SPARQL results document.
+    ///
+    /// \param row Set to the row
+    /// \return False when there are no more rows
+    ///
+    bool Next(SparqlRow& row);
+
+    ///
+    /// Returns true for the result of an ASK query.
+    ///
+    /// \return True if Boolean is set
+    ///
+    bool HasBoolean(void) const;
+
+    ///
+    /// Returns the result of an ASK query.
+    ///
+    /// \return The answer
+    ///
+    bool Boolean(void) const;
+};
+
+///
+/// Serializations the GraphLoader can send.
+///
+enum class RdfFormat { NTRIPLES, NQUADS, TURTLE };
+
+///
+/// What a GraphLoader sent.
+///
+struct GraphLoadSummary {
+    uint64_t bytes;
+    uint64_t statements;    /*!< Lines sent for N-Triples and N-Quads; 0 for Turtle */
+    uint64_t requests;
+
+    GraphLoadSummary();
+};
+
+///
+/// Loads RDF files into the triple store with the graph store protocol,
+/// POST /v1/graphs, merging into what is already there.
+///
+/// N-Triples and N-Quads are line based, so they are sent in chunks of
+/// whole lines of about chunk_bytes each; only one chunk is in memory at a
+/// time, and a failure part way through says how much was loaded.  The
+/// server scopes blank node labels to a request, so a file that has any
+/// ("_:b1") is instead streamed in one request, as is Turtle, which cannot
+/// be split safely because prefixes and statements span lines.  Finding
+/// out reads a line based file once before it is sent.
+///
+///     GraphLoader loader(proxy, "http://localhost:8000");
+///     loader.LoadFile("provenance.nt", RdfFormat::NTRIPLES, "http://example.org/prov");
+///
+class GraphLoader {
+    AuthenticatingProxy& _proxy;
+    std::string _host;
+    size_t _chunk_bytes;
+
+    GraphLoader(const GraphLoader& orig);
+    GraphLoader& operator=(const GraphLoader& orig);
+
+    void Send(const std::string& path, const std::string& content_type,
+              const char* data, const size_t& size, GraphLoadSummary& summary);
+    void SendFile(const std::string& path, const std::string& content_type,
+                  const std::string& file_path, GraphLoadSummary& summary);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param proxy The proxy to send requests through
+    /// \param host The server ("http://localhost:8000")
+    /// \param chunk_bytes The target request size for line based formats
+    ///
+    GraphLoader(AuthenticatingProxy& proxy, const std::string& host,
+                const size_t& chunk_bytes = 4 * 1024 * 1024);
+
+    ///
+    /// Loads a file.  Throws SparqlException if the file cannot be read or
+    /// a request fails.
+    ///
+    /// \param file_path The file
+    /// \param format Its serialization
+    /// \param graph The graph to merge into; empty for the default graph,
+    ///        or for N-Quads, the graphs named in the file
+    /// \return The summary
+    ///
+    GraphLoadSummary LoadFile(const std::string& file_path, const RdfFormat& format,
+                              const std::string& graph = std::string());
+
+    ///
+    /// Returns the graph store path for a graph.
+    ///
+    /// \param graph The graph URI, empty for the default graph
+    /// \param format The serialization being sent
+    /// \return The path and query string
+    ///
+    static std::string GraphsPath(const std::string& graph, const RdfFormat& format);
+
+    ///
+    /// Returns the MIME type of a serialization.
+    ///
+    /// \param format The serialization
+    /// \return The type ("application/n-triples")
+    ///
+    static std::string ContentType(const RdfFormat& format);
+};
+
+#endif	/* SPARQL_HPP */
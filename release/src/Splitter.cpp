@@ -0,0 +1,595 @@
+/*
+ * File:   Splitter.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Splitter.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPLITTER_SSE2
+#endif
+
+#include "JsonScanner.hpp"
+#include "Logger.hpp"
+
+namespace {
+
+const size_t MAX_FAILURES = 100;
+const char* LINE_FIELD = "line";
+
+void AppendJsonString(std::string& out, const std::string& text) {
+  out.push_back('"');
+  for (char c : text) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          char escape[8];
+          std::snprintf(escape, sizeof(escape), "\\u%04x", (unsigned)c);
+          out += escape;
+        } else {
+          out.push_back(c);
+        }
+    }
+  }
+  out.push_back('"');
+}
+
+bool IsBlank(const char* begin, const char* end) {
+  for (; begin < end; begin++) {
+    if (*begin != ' ' && *begin != '\t' && *begin != '\r') {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+SplitException::SplitException(const std::string& message) : _message(message) {
+
+}
+
+const char* SplitException::what() const throw() {
+  return _message.c_str();
+}
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path) : _data(nullptr), _size(0), _file(nullptr),
+    _mapping(nullptr)
+{
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+      FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw SplitException("Could not open " + path);
+  }
+  LARGE_INTEGER size;
+  GetFileSizeEx(file, &size);
+  _file = file;
+  _size = (size_t)size.QuadPart;
+  if (_size == 0) {
+    return;
+  }
+  _mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  _data = _mapping ? (const char*)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (!_data) {
+    if (_mapping) {
+      CloseHandle(_mapping);
+    }
+    CloseHandle(file);
+    throw SplitException("Could not map " + path);
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (_data) {
+    UnmapViewOfFile(_data);
+  }
+  if (_mapping) {
+    CloseHandle(_mapping);
+  }
+  CloseHandle(_file);
+}
+
+void MappedFile::Release(const size_t& offset, const size_t& length) const {
+  // Windows trims the working set of a mapped file by itself.
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) : _data(nullptr), _size(0) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw SplitException("Could not open " + path + ": " + std::strerror(errno));
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw SplitException("Could not stat " + path + ": " + std::strerror(errno));
+  }
+  _size = (size_t)info.st_size;
+  if (_size > 0) {
+    void* mapped = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+      close(fd);
+      throw SplitException("Could not map " + path + ": " + std::strerror(errno));
+    }
+    _data = (const char*)mapped;
+    madvise(mapped, _size, MADV_SEQUENTIAL);
+  }
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (_data) {
+    munmap((void*)_data, _size);
+  }
+}
+
+void MappedFile::Release(const size_t& offset, const size_t& length) const {
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  size_t first = (offset + page - 1) / page * page;
+  size_t last = (offset + length) / page * page;
+  if (_data && last > first) {
+    madvise((void*)(_data + first), last - first, MADV_DONTNEED);
+  }
+}
+
+#endif
+
+const char* MappedFile::Data(void) const {
+  return _data;
+}
+
+size_t MappedFile::Size(void) const {
+  return _size;
+}
+
+SplitOptions::SplitOptions() : format(RecordFormat::NDJSON), uri_template("/{line}.json"),
+    delimiter(','), quoted_newlines(false), chunk_bytes(16 * 1024 * 1024), threads(4)
+{
+
+}
+
+SplitSummary::SplitSummary() : records(0), bytes(0), failed(0), batches(0) {
+
+}
+
+Splitter::Splitter(const std::string& host, const Credentials& credentials,
+    const SplitOptions& options) : _host(host), _credentials(credentials), _options(options),
+    _numbered(false), _next(0), _records(0), _bytes(0), _failed(0)
+{
+  if (_options.threads == 0) {
+    _options.threads = 1;
+  }
+  if (_options.chunk_bytes == 0) {
+    _options.chunk_bytes = 1;
+  }
+}
+
+const char* Splitter::FindNewline(const char* begin, const char* end) {
+  // Every mainstream C library vectorises memchr, with wider registers
+  // than the SSE2 baseline used for counting below.
+  const void* found = begin < end ? std::memchr(begin, '\n', (size_t)(end - begin)) : nullptr;
+  return found ? (const char*)found : end;
+}
+
+uint64_t Splitter::CountNewlines(const char* begin, const char* end) {
+  uint64_t count = 0;
+#ifdef SPLITTER_SSE2
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i zero = _mm_setzero_si128();
+  while (end - begin >= 16) {
+    // Each match subtracts -1 from its byte's counter; the counters are
+    // summed before any can pass 255.
+    size_t blocks = std::min<size_t>((size_t)(end - begin) / 16, 255);
+    __m128i counters = zero;
+    for (size_t i = 0; i < blocks; i++, begin += 16) {
+      __m128i bytes = _mm_loadu_si128((const __m128i*)begin);
+      counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(bytes, newline));
+    }
+    __m128i sums = _mm_sad_epu8(counters, zero);
+    count += (uint64_t)_mm_cvtsi128_si32(sums) +
+        (uint64_t)_mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+  }
+#endif
+  for (; begin < end; begin++) {
+    count += *begin == '\n' ? 1 : 0;
+  }
+  return count;
+}
+
+const char* Splitter::ParseCsv(const char* begin, const char* end, const char& delimiter,
+    std::vector<std::string>& fields)
+{
+  fields.clear();
+  fields.push_back(std::string());
+  const char* pos = begin;
+  while (pos < end) {
+    std::string& field = fields.back();
+    if (*pos == '"' && field.empty()) {
+      // A quoted field runs to the next quote not doubled, newlines and
+      // delimiters included.
+      for (pos++; pos < end; pos++) {
+        if (*pos == '"') {
+          if (pos + 1 < end && pos[1] == '"') {
+            field.push_back('"');
+            pos++;
+          } else {
+            pos++;
+            break;
+          }
+        } else {
+          field.push_back(*pos);
+        }
+      }
+      continue;
+    }
+    if (*pos == delimiter) {
+      fields.push_back(std::string());
+    } else if (*pos == '\n') {
+      return pos + 1;
+    } else if (*pos != '\r' || pos + 1 >= end || pos[1] != '\n') {
+      field.push_back(*pos);
+    }
+    pos++;
+  }
+  return end;
+}
+
+void Splitter::ParseTemplate(void) {
+  _uri.clear();
+  _numbered = false;
+  const std::string& text = _options.uri_template;
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t open = text.find('{', pos);
+    size_t close = open == std::string::npos ? std::string::npos : text.find('}', open);
+    if (close == std::string::npos) {
+      _uri.push_back(UriPart{text.substr(pos), false});
+      break;
+    }
+    if (open > pos) {
+      _uri.push_back(UriPart{text.substr(pos, open - pos), false});
+    }
+    std::string name = text.substr(open + 1, close - open - 1);
+    _numbered = _numbered || name == LINE_FIELD;
+    _uri.push_back(UriPart{name, true});
+    pos = close + 1;
+  }
+}
+
+bool Splitter::NdjsonUri(const char* begin, const char* end, const uint64_t& line,
+    std::string& uri, std::string& error) const
+{
+  std::vector<std::string> values(_uri.size());
+  std::vector<bool> seen(_uri.size(), false);
+  size_t wanted = 0;
+  for (auto& part : _uri) {
+    wanted += part.field && part.text != LINE_FIELD ? 1 : 0;
+  }
+
+  if (wanted > 0) {
+    try {
+      JsonScanner scanner(begin, (size_t)(end - begin));
+      std::string key;
+      std::string value;
+      scanner.BeginObject();
+      size_t found = 0;
+      while (found < wanted && scanner.NextMember(key)) {
+        bool read = false;
+        for (size_t i = 0; i < _uri.size(); i++) {
+          if (!_uri[i].field || seen[i] || _uri[i].text != key) {
+            continue;
+          }
+          if (!read) {
+            switch (scanner.Peek()) {
+              case JsonToken::STRING:
+                scanner.ReadString(value);
+                break;
+              case JsonToken::NUMBER:
+                scanner.ReadNumber(value);
+                break;
+              case JsonToken::BOOLEAN:
+                value = scanner.ReadBoolean() ? "true" : "false";
+                break;
+              case JsonToken::END:
+                error = "The record ends after \"" + key + "\"";
+                return false;
+              default:
+                error = "\"" + key + "\" is not a string, number or boolean";
+                return false;
+            }
+            read = true;
+          }
+          values[i] = value;
+          seen[i] = true;
+          found++;
+        }
+        if (!read) {
+          scanner.Skip();
+        }
+      }
+      for (size_t i = 0; i < _uri.size() && found < wanted; i++) {
+        if (_uri[i].field && _uri[i].text != LINE_FIELD && !seen[i]) {
+          error = "No \"" + _uri[i].text + "\" member";
+          return false;
+        }
+      }
+    } catch (const JsonParseException& e) {
+      error = e.what();
+      return false;
+    }
+  }
+
+  uri.clear();
+  for (size_t i = 0; i < _uri.size(); i++) {
+    if (!_uri[i].field) {
+      uri += _uri[i].text;
+    } else if (_uri[i].text == LINE_FIELD) {
+      uri += std::to_string(line);
+    } else {
+      uri += values[i];
+    }
+  }
+  return true;
+}
+
+std::string Splitter::CsvUri(const std::vector<std::string>& fields, const uint64_t& line) const {
+  std::string uri;
+  for (size_t i = 0; i < _uri.size(); i++) {
+    if (!_uri[i].field) {
+      uri += _uri[i].text;
+    } else if (_uri_columns[i] < 0) {
+      uri += std::to_string(line);
+    } else {
+      uri += fields[(size_t)_uri_columns[i]];
+    }
+  }
+  return uri;
+}
+
+void Splitter::Fail(const uint64_t& offset, const std::string& error) {
+  _failed++;
+  std::lock_guard<std::mutex> lock(_failures_mutex);
+  if (_failures.size() < MAX_FAILURES) {
+    _failures.push_back(std::make_pair(offset, error));
+  }
+}
+
+void Splitter::Work(const MappedFile& file, const std::vector<size_t>& bounds,
+    const std::vector<uint64_t>& lines, BatchWriter& writer)
+{
+  struct Written {
+    uint64_t offset;
+    size_t size;
+    std::future<WriteResult> result;
+  };
+
+  // Results are collected as they come back rather than all at the end, so
+  // a file of millions of records holds at most a queue's worth.
+  std::deque<Written> pending;
+  size_t window = std::max<size_t>(_options.batch.queue_capacity, 1);
+  auto settle = [this, &pending]() {
+    Written& written = pending.front();
+    WriteResult result = written.result.get();
+    if (result.written) {
+      _records++;
+      _bytes += written.size;
+    } else {
+      Fail(written.offset, result.error.empty() ? "Status " + std::to_string(result.status) :
+          result.error);
+    }
+    pending.pop_front();
+  };
+
+  const char* data = file.Data();
+  std::vector<std::string> fields;
+  std::string uri;
+  std::string error;
+  for (size_t chunk = _next++; chunk + 1 < bounds.size(); chunk = _next++) {
+    const char* pos = data + bounds[chunk];
+    const char* end = data + bounds[chunk + 1];
+    uint64_t line = lines.empty() ? 0 : lines[chunk];
+
+    while (pos < end) {
+      uint64_t offset = (uint64_t)(pos - data);
+      std::string body;
+      const char* next;
+      if (_options.format == RecordFormat::NDJSON) {
+        const char* newline = FindNewline(pos, end);
+        next = newline == end ? end : newline + 1;
+        const char* last = newline;
+        while (last > pos && (last[-1] == '\r' || last[-1] == ' ' || last[-1] == '\t')) {
+          last--;
+        }
+        if (IsBlank(pos, last)) {
+          pos = next;
+          line++;
+          continue;
+        }
+        if (!NdjsonUri(pos, last, line, uri, error)) {
+          Fail(offset, error);
+          pos = next;
+          line++;
+          continue;
+        }
+        body.assign(pos, last);
+        line++;
+      } else {
+        next = ParseCsv(pos, end, _options.delimiter, fields);
+        uint64_t record_line = line;
+        line += _options.quoted_newlines ? CountNewlines(pos, next) : 1;
+        if (fields.size() == 1 && IsBlank(pos, next - (next > pos && next[-1] == '\n' ? 1 : 0))) {
+          pos = next;
+          continue;
+        }
+        if (fields.size() != _columns.size()) {
+          Fail(offset, "Expected " + std::to_string(_columns.size()) + " fields, found " +
+              std::to_string(fields.size()));
+          pos = next;
+          continue;
+        }
+        uri = CsvUri(fields, record_line);
+        body.push_back('{');
+        for (size_t i = 0; i < fields.size(); i++) {
+          if (i > 0) {
+            body.push_back(',');
+          }
+          AppendJsonString(body, _columns[i]);
+          body.push_back(':');
+          AppendJsonString(body, fields[i]);
+        }
+        body.push_back('}');
+      }
+
+      size_t size = body.size();
+      pending.push_back(Written{offset, size, writer.Write(uri, std::move(body))});
+      if (pending.size() > window) {
+        settle();
+      }
+      pos = next;
+    }
+    file.Release(bounds[chunk], bounds[chunk + 1] - bounds[chunk]);
+  }
+
+  while (!pending.empty()) {
+    settle();
+  }
+}
+
+SplitSummary Splitter::Run(const std::string& path) {
+  MappedFile file(path);
+  ParseTemplate();
+  const char* data = file.Data();
+  size_t size = file.Size();
+
+  size_t start = 0;
+  if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+    start = 3;
+  }
+
+  _columns.clear();
+  _uri_columns.assign(_uri.size(), -1);
+  if (_options.format == RecordFormat::CSV) {
+    if (start < size) {
+      start = (size_t)(ParseCsv(data + start, data + size, _options.delimiter, _columns) - data);
+    }
+    for (size_t i = 0; i < _uri.size(); i++) {
+      if (!_uri[i].field || _uri[i].text == LINE_FIELD) {
+        continue;
+      }
+      std::vector<std::string>::const_iterator column =
+          std::find(_columns.begin(), _columns.end(), _uri[i].text);
+      if (column == _columns.end()) {
+        throw SplitException("The header of " + path + " has no \"" + _uri[i].text + "\" column");
+      }
+      _uri_columns[i] = (int)(column - _columns.begin());
+    }
+  }
+
+  // Cut the file into chunks, each ending just after a newline.
+  std::vector<size_t> bounds(1, start);
+  if (_options.format != RecordFormat::CSV || !_options.quoted_newlines) {
+    while (bounds.back() + _options.chunk_bytes < size) {
+      const char* newline = FindNewline(data + bounds.back() + _options.chunk_bytes - 1,
+          data + size);
+      if (newline == data + size) {
+        break;
+      }
+      bounds.push_back((size_t)(newline - data) + 1);
+    }
+  }
+  if (bounds.back() < size) {
+    bounds.push_back(size);
+  }
+  size_t chunks = bounds.size() - 1;
+  unsigned threads = (unsigned)std::min<size_t>(_options.threads, std::max<size_t>(chunks, 1));
+
+  // {line} needs the number of lines before each chunk, so count them
+  // first; at memory speed, this costs far less than the parsing.
+  std::vector<uint64_t> lines;
+  if (_numbered && chunks > 0) {
+    std::vector<uint64_t> counts(chunks);
+    std::vector<std::thread> counters;
+    _next = 0;
+    for (unsigned i = 0; i < threads; i++) {
+      counters.push_back(std::thread([this, &counts, &bounds, data, chunks]() {
+        for (size_t chunk = _next++; chunk < chunks; chunk = _next++) {
+          counts[chunk] = CountNewlines(data + bounds[chunk], data + bounds[chunk + 1]);
+        }
+      }));
+    }
+    for (auto& counter : counters) {
+      counter.join();
+    }
+    lines.resize(chunks);
+    lines[0] = 1 + CountNewlines(data, data + start);
+    for (size_t chunk = 1; chunk < chunks; chunk++) {
+      lines[chunk] = lines[chunk - 1] + counts[chunk - 1];
+    }
+  }
+
+  _next = 0;
+  _records = 0;
+  _bytes = 0;
+  _failed = 0;
+  _failures.clear();
+
+  BatchWriter writer(_host, _credentials, _options.batch);
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < threads && chunks > 0; i++) {
+    workers.push_back(std::thread(&Splitter::Work, this, std::cref(file), std::cref(bounds),
+        std::cref(lines), std::ref(writer)));
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  writer.Close();
+
+  SplitSummary summary;
+  summary.records = _records;
+  summary.bytes = _bytes;
+  summary.failed = _failed;
+  summary.batches = writer.Batches();
+  summary.failures = _failures;
+  if (summary.failed > 0) {
+    MLLOG(LogLevel::WARNING).Message("Records not loaded").Field("file", path)
+        .Field("failed", summary.failed);
+  }
+  return summary;
+}
@@ -0,0 +1,227 @@
+/*
+ * File:   Splitter.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SPLITTER_HPP
+#define	SPLITTER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BatchWriter.hpp"
+#include "Credentials.hpp"
+
+///
+/// Thrown when a file cannot be split.
+///
+class SplitException : public std::exception {
+    std::string _message;
+public:
+    explicit SplitException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// A file mapped read only into memory.  Pages are read from disk as they
+/// are touched and may be dropped again once released, so a file much
+/// larger than memory can be walked end to end.
+///
+class MappedFile {
+    const char* _data;
+    size_t _size;
+#ifdef _WIN32
+    void* _file;
+    void* _mapping;
+#endif
+
+    MappedFile(const MappedFile& orig);
+    MappedFile& operator=(const MappedFile& orig);
+public:
+    ///
+    /// Constructor.  Throws SplitException if the file cannot be mapped.
+    ///
+    /// \param path The file
+    ///
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    ///
+    /// Returns the start of the file.
+    ///
+    /// \return The data, null for an empty file
+    ///
+    const char* Data(void) const;
+
+    ///
+    /// Returns the length of the file.
+    ///
+    /// \return The size in bytes
+    ///
+    size_t Size(void) const;
+
+    ///
+    /// Tells the system a range will not be read again, so its pages can be
+    /// reclaimed.  Only whole pages inside the range are released.
+    ///
+    /// \param offset The start of the range
+    /// \param length Its length
+    ///
+    void Release(const size_t& offset, const size_t& length) const;
+};
+
+///
+/// The record syntax of a file to split.
+///
+enum class RecordFormat {
+    NDJSON,     /*!< A JSON document per line */
+    CSV         /*!< A header line of column names, then a row per line */
+};
+
+///
+/// How a Splitter turns records into documents.
+///
+struct SplitOptions {
+    RecordFormat format;
+    ///
+    /// The document URI.  "{name}" is replaced by the record's top level
+    /// member or column of that name, and "{line}" by the line of the file
+    /// the record starts on, counting from 1: "/orders/{id}.json".
+    ///
+    std::string uri_template;
+    char delimiter;             /*!< The CSV column separator */
+    bool quoted_newlines;       /*!< CSV fields may hold newlines; read on one thread */
+    size_t chunk_bytes;         /*!< The size of the ranges parsed in parallel */
+    unsigned threads;           /*!< Parsing threads */
+    BatchWriterOptions batch;   /*!< How the documents are written */
+
+    SplitOptions();
+};
+
+///
+/// What a Splitter did.
+///
+struct SplitSummary {
+    uint64_t records;       /*!< Documents written */
+    uint64_t bytes;         /*!< Their total size */
+    uint64_t failed;        /*!< Records that could not be read or written */
+    uint64_t batches;       /*!< Multi-document writes sent */
+    std::vector<std::pair<uint64_t, std::string> > failures;   /*!< Byte offset and error, the first 100 */
+
+    SplitSummary();
+};
+
+///
+/// Loads a large newline delimited JSON or CSV file as a document per
+/// record.
+///
+///     SplitOptions options;
+///     options.format = RecordFormat::CSV;
+///     options.uri_template = "/customers/{customer_id}.json";
+///     Splitter splitter(host, proxy.GetCredentials(), options);
+///     SplitSummary summary = splitter.Run("customers.csv");
+///
+/// The file is mapped, not read, and cut into chunks of about chunk_bytes,
+/// each moved on to the next newline so no record is split.  Parsing
+/// threads take a chunk at a time and find the records in it with a
+/// vectorised newline search.  Each record goes to a BatchWriter, whose
+/// flushers send multi-document writes while the parsers carry on; when
+/// the network falls behind the writer's queue fills and the parsers wait,
+/// so memory stays bounded however large the file is.
+///
+/// An NDJSON line is sent as it is.  A CSV row becomes a JSON object of
+/// strings keyed by the header's column names.  CSV fields may be quoted,
+/// with "" for a quote; a quoted field holding a newline cannot be found
+/// by a search for newlines from the middle of the file, so such files
+/// must set quoted_newlines, which parses on one thread.
+///
+class Splitter {
+    struct UriPart {
+        std::string text;   /*!< Literal text, or the field name */
+        bool field;
+    };
+
+    std::string _host;
+    Credentials _credentials;
+    SplitOptions _options;
+    std::vector<UriPart> _uri;
+    bool _numbered;                         /*!< The template uses {line} */
+    std::vector<std::string> _columns;      /*!< The CSV header */
+    std::vector<int> _uri_columns;          /*!< For each UriPart, its CSV column or -1 */
+
+    std::atomic<size_t> _next;
+    std::atomic<uint64_t> _records;
+    std::atomic<uint64_t> _bytes;
+    std::atomic<uint64_t> _failed;
+    std::mutex _failures_mutex;
+    std::vector<std::pair<uint64_t, std::string> > _failures;
+
+    Splitter(const Splitter& orig);
+    Splitter& operator=(const Splitter& orig);
+
+    void ParseTemplate(void);
+    void Work(const MappedFile& file, const std::vector<size_t>& bounds,
+              const std::vector<uint64_t>& lines, BatchWriter& writer);
+    bool NdjsonUri(const char* begin, const char* end, const uint64_t& line,
+                   std::string& uri, std::string& error) const;
+    std::string CsvUri(const std::vector<std::string>& fields, const uint64_t& line) const;
+    void Fail(const uint64_t& offset, const std::string& error);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param credentials The credentials, used by the BatchWriter
+    /// \param options The format and URI template
+    ///
+    Splitter(const std::string& host, const Credentials& credentials,
+             const SplitOptions& options);
+
+    ///
+    /// Loads a file, returning once every record has been written or has
+    /// failed.  Throws SplitException if the file cannot be mapped, or the
+    /// template names a column the CSV header does not have.
+    ///
+    /// \param path The file
+    /// \return The summary
+    ///
+    SplitSummary Run(const std::string& path);
+
+    ///
+    /// Returns the first newline in a range.
+    ///
+    /// \param begin The start of the range
+    /// \param end Its end
+    /// \return The newline, or end if there is none
+    ///
+    static const char* FindNewline(const char* begin, const char* end);
+
+    ///
+    /// Returns the number of newlines in a range.
+    ///
+    /// \param begin The start of the range
+    /// \param end Its end
+    /// \return The count
+    ///
+    static uint64_t CountNewlines(const char* begin, const char* end);
+
+    ///
+    /// Reads one CSV record.
+    ///
+    /// \param begin The start of the record
+    /// \param end The end of the text
+    /// \param delimiter The column separator
+    /// \param fields Set to the record's fields, unquoted
+    /// \return Just past the record's newline, or end
+    ///
+    static const char* ParseCsv(const char* begin, const char* end, const char& delimiter,
+                                std::vector<std::string>& fields);
+};
+
+#endif	/* SPLITTER_HPP */
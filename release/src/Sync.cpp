@@ -0,0 +1,547 @@
+/*
+ * File:   Sync.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Sync.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <thread>
+#include <sys/stat.h>
+#include <cpprest/http_client.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "AuthenticatingProxy.hpp"
+#include "Export.hpp"
+#include "JsonScanner.hpp"
+#include "Logger.hpp"
+#include "MLCrypto.hpp"
+#include "Multipart.hpp"
+#include "Response.hpp"
+#include "Search.hpp"
+#include "Splitter.hpp"
+
+namespace {
+
+const char* UPLOAD_MANIFEST_HEADER = "# mlcpp upload manifest 1";
+const char* DOWNLOAD_STATE_HEADER = "# mlcpp download mark 1";
+const char* PROPERTY_NAMESPACE = "http://marklogic.com/xdmp/property";
+
+///
+/// Replaces target with source, in one step where the platform allows.
+///
+bool ReplaceFile(const std::string& source, const std::string& target) {
+#ifdef _WIN32
+  return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return std::rename(source.c_str(), target.c_str()) == 0;
+#endif
+}
+
+}
+
+SyncException::SyncException(const std::string& message) : _message(message) {
+
+}
+
+const char* SyncException::what() const throw() {
+  return _message.c_str();
+}
+
+UploadSyncOptions::UploadSyncOptions() : hash_key("mlcpp-hash"), verify_unchanged(false),
+    lookup_batch(250), workers(4)
+{
+
+}
+
+UploadSyncSummary::UploadSyncSummary() : uploaded(0), unchanged(0), failed(0), bytes(0),
+    hashed(0), lookups(0)
+{
+
+}
+
+UploadSync::UploadSync(const std::string& host, const Credentials& credentials,
+    const UploadSyncOptions& options) : _host(host), _credentials(credentials),
+    _options(options), _next(0), _hashed(0), _lookups(0), _bytes(0)
+{
+  if (_options.workers == 0) {
+    _options.workers = 1;
+  }
+  if (_options.lookup_batch == 0) {
+    _options.lookup_batch = 1;
+  }
+}
+
+void UploadSync::Add(const std::string& uri, const std::string& path,
+    const std::string& content_type)
+{
+  Item item;
+  item.uri = uri;
+  item.path = path;
+  item.content_type = content_type;
+  item.size = 0;
+  item.modified = 0;
+  item.state = State::LOOKUP;
+  _items.push_back(std::move(item));
+}
+
+std::string UploadSync::MetadataPath(const std::vector<std::string>& uris) {
+  std::string path = "/v1/documents?category=metadata-values&format=json";
+  for (auto& uri : uris) {
+    path += "&uri=" + web::uri::encode_data_string(uri);
+  }
+  return path;
+}
+
+void UploadSync::LoadManifest(void) {
+  _manifest.clear();
+  if (_options.manifest_path.empty()) {
+    return;
+  }
+  std::ifstream in(_options.manifest_path.c_str());
+  if (!in) {
+    return;
+  }
+
+  std::string line;
+  if (!std::getline(in, line) || line != UPLOAD_MANIFEST_HEADER) {
+    throw SyncException(_options.manifest_path + " is not an upload manifest");
+  }
+  // hash size modified uri, the URI last since it may hold spaces
+  while (std::getline(in, line)) {
+    std::istringstream fields(line);
+    ManifestEntry entry;
+    std::string uri;
+    if (!(fields >> entry.hash >> entry.size >> entry.modified) || fields.get() != ' ' ||
+        !std::getline(fields, uri) || uri.empty()) {
+      throw SyncException(_options.manifest_path + " has a malformed line: " + line);
+    }
+    _manifest[uri] = entry;
+  }
+}
+
+void UploadSync::SaveManifest(void) const {
+  if (_options.manifest_path.empty()) {
+    return;
+  }
+
+  std::map<std::string, ManifestEntry> manifest = _manifest;
+  for (auto& item : _items) {
+    if (item.state == State::UNCHANGED || item.state == State::UPLOADED) {
+      ManifestEntry& entry = manifest[item.uri];
+      entry.hash = item.hash;
+      entry.size = item.size;
+      entry.modified = item.modified;
+    } else {
+      manifest.erase(item.uri);
+    }
+  }
+
+  // Written beside the old one and moved over it, so a crash leaves one
+  // or the other whole.
+  std::string temporary = _options.manifest_path + ".tmp";
+  {
+    std::ofstream out(temporary.c_str(), std::ios::trunc);
+    out << UPLOAD_MANIFEST_HEADER << '\n';
+    for (auto& entry : manifest) {
+      out << entry.second.hash << ' ' << entry.second.size << ' ' << entry.second.modified
+          << ' ' << entry.first << '\n';
+    }
+    out.flush();
+    if (!out) {
+      throw SyncException("Could not write " + temporary);
+    }
+  }
+  if (!ReplaceFile(temporary, _options.manifest_path)) {
+    throw SyncException("Could not replace " + _options.manifest_path);
+  }
+}
+
+void UploadSync::Hash(void) {
+  MLCrypto crypto;
+  for (size_t i = _next++; i < _items.size(); i = _next++) {
+    Item& item = _items[i];
+    struct stat info;
+    if (stat(item.path.c_str(), &info) != 0) {
+      item.state = State::FAILED;
+      item.error = "Could not stat " + item.path;
+      continue;
+    }
+    item.size = (uint64_t)info.st_size;
+    item.modified = (int64_t)info.st_mtime;
+
+    std::map<std::string, ManifestEntry>::const_iterator entry = _manifest.find(item.uri);
+    bool known = entry != _manifest.end();
+    if (known && entry->second.size == item.size && entry->second.modified == item.modified) {
+      item.hash = entry->second.hash;
+    } else {
+      try {
+        MappedFile file(item.path);
+        uint64_t hash = crypto.FastHash((const uint8_t*)file.Data(), file.Size());
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)hash);
+        item.hash = hex;
+        _hashed++;
+      } catch (const SplitException& e) {
+        item.state = State::FAILED;
+        item.error = e.what();
+        continue;
+      }
+    }
+
+    // Touched but not changed counts as unchanged too.
+    bool unchanged = known && entry->second.hash == item.hash;
+    item.state = unchanged && !_options.verify_unchanged ? State::UNCHANGED : State::LOOKUP;
+  }
+}
+
+void UploadSync::Lookup(const std::vector<Item*>& pending, Credentials credentials) {
+  AuthenticatingProxy proxy(_options.proxy);
+  proxy.AddCredentials(credentials);
+  header_t headers;
+  headers["Accept"] = "multipart/mixed";
+
+  size_t batches = (pending.size() + _options.lookup_batch - 1) / _options.lookup_batch;
+  std::vector<std::string> uris;
+  for (size_t batch = _next++; batch < batches; batch = _next++) {
+    size_t begin = batch * _options.lookup_batch;
+    size_t end = std::min(pending.size(), begin + _options.lookup_batch);
+    uris.clear();
+    for (size_t i = begin; i < end; i++) {
+      uris.push_back(pending[i]->uri);
+    }
+
+    // A missing document has no part and is uploaded; so is everything
+    // in a batch the server would not answer, which is never wrong.
+    std::map<std::string, std::string> stored;
+    Response response = proxy.Get(_host, MetadataPath(uris), headers);
+    _lookups++;
+    if (response.GetResponseCode() == ResponseCodes::OK) {
+      try {
+        MultipartReader reader(response.Body(), MultipartReader::Boundary(
+            response.Header("Content-Type")));
+        MultipartPart part;
+        std::string key;
+        while (reader.Next(part)) {
+          JsonScanner scanner(part.data, part.size);
+          scanner.BeginObject();
+          while (scanner.NextMember(key)) {
+            if (key != "metadataValues") {
+              scanner.Skip();
+              continue;
+            }
+            scanner.BeginObject();
+            while (scanner.NextMember(key)) {
+              if (key == _options.hash_key && scanner.Peek() == JsonToken::STRING) {
+                stored[part.Filename()] = scanner.ReadString();
+              } else {
+                scanner.Skip();
+              }
+            }
+          }
+        }
+      } catch (const std::exception& e) {
+        MLLOG(LogLevel::WARNING).Message("Could not read stored hashes").Field("error", e.what());
+        stored.clear();
+      }
+    } else if (response.GetResponseCode() != ResponseCodes::NO_CONTENT) {
+      MLLOG(LogLevel::WARNING).Message("Could not read stored hashes")
+          .Field("status", (int)response.GetResponseCode());
+    }
+
+    for (size_t i = begin; i < end; i++) {
+      std::map<std::string, std::string>::const_iterator found = stored.find(pending[i]->uri);
+      bool same = found != stored.end() && found->second == pending[i]->hash;
+      pending[i]->state = same ? State::UNCHANGED : State::CHANGED;
+    }
+  }
+}
+
+void UploadSync::Upload(const std::vector<Item*>& changed, BatchWriter& writer) {
+  std::deque<std::pair<Item*, std::future<WriteResult> > > pending;
+  size_t window = std::max<size_t>(_options.batch.queue_capacity, 1);
+  auto settle = [this, &pending]() {
+    Item* item = pending.front().first;
+    WriteResult result = pending.front().second.get();
+    if (result.written) {
+      item->state = State::UPLOADED;
+      _bytes += item->size;
+    } else {
+      item->state = State::FAILED;
+      item->error = result.error.empty() ? "Status " + std::to_string(result.status) :
+          result.error;
+    }
+    pending.pop_front();
+  };
+
+  for (size_t i = _next++; i < changed.size(); i = _next++) {
+    Item* item = changed[i];
+    std::string body;
+    try {
+      MappedFile file(item->path);
+      body.assign(file.Data() ? file.Data() : "", file.Size());
+    } catch (const SplitException& e) {
+      item->state = State::FAILED;
+      item->error = e.what();
+      continue;
+    }
+    std::string metadata = "{\"metadataValues\":{\"" + _options.hash_key + "\":\"" +
+        item->hash + "\"}}";
+    pending.push_back(std::make_pair(item, writer.Write(item->uri, std::move(body),
+        item->content_type, metadata)));
+    if (pending.size() > window) {
+      settle();
+    }
+  }
+  while (!pending.empty()) {
+    settle();
+  }
+}
+
+UploadSyncSummary UploadSync::Run(void) {
+  LoadManifest();
+  _hashed = 0;
+  _lookups = 0;
+  _bytes = 0;
+
+  unsigned workers = (unsigned)std::min<size_t>(_options.workers,
+      std::max<size_t>(_items.size(), 1));
+  std::vector<std::thread> threads;
+  _next = 0;
+  for (unsigned i = 0; i < workers; i++) {
+    threads.push_back(std::thread(&UploadSync::Hash, this));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  std::vector<Item*> pending;
+  for (auto& item : _items) {
+    if (item.state == State::LOOKUP) {
+      pending.push_back(&item);
+    }
+  }
+  _next = 0;
+  for (unsigned i = 0; i < workers && !pending.empty(); i++) {
+    threads.push_back(std::thread(&UploadSync::Lookup, this, std::cref(pending),
+        _credentials.Fork()));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  std::vector<Item*> changed;
+  for (auto& item : _items) {
+    if (item.state == State::CHANGED) {
+      changed.push_back(&item);
+    }
+  }
+  if (!changed.empty()) {
+    BatchWriter writer(_host, _credentials, _options.batch);
+    _next = 0;
+    for (unsigned i = 0; i < workers; i++) {
+      threads.push_back(std::thread(&UploadSync::Upload, this, std::cref(changed),
+          std::ref(writer)));
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    writer.Close();
+  }
+
+  UploadSyncSummary summary;
+  for (auto& item : _items) {
+    if (item.state == State::UPLOADED) {
+      summary.uploaded++;
+    } else if (item.state == State::UNCHANGED) {
+      summary.unchanged++;
+    } else {
+      summary.failed++;
+      summary.failures.push_back(std::make_pair(item.uri, item.error));
+    }
+  }
+  summary.bytes = _bytes;
+  summary.hashed = _hashed;
+  summary.lookups = _lookups;
+  if (summary.failed > 0) {
+    MLLOG(LogLevel::WARNING).Message("Documents not uploaded").Field("failed", summary.failed);
+  }
+
+  SaveManifest();
+  _items.clear();
+  return summary;
+}
+
+DownloadSyncOptions::DownloadSyncOptions() : source(ChangeSource::LAST_MODIFIED), workers(4),
+    batch_size(100), page_length(1000)
+{
+
+}
+
+DownloadSyncSummary::DownloadSyncSummary() : timestamp(0), downloaded(0), bytes(0), skipped(0) {
+
+}
+
+DownloadSync::DownloadSync(const std::string& host, const Credentials& credentials,
+    const DownloadSyncOptions& options) : _host(host), _credentials(credentials),
+    _options(options)
+{
+  if (_options.workers == 0) {
+    _options.workers = 1;
+  }
+}
+
+web::json::value DownloadSync::ChangedQuery(const DownloadSyncOptions& options,
+    const std::string& since)
+{
+  if (options.source == ChangeSource::COLLECTION) {
+    web::json::value uris = web::json::value::array(1);
+    uris[0] = web::json::value::string(options.changed_collection);
+    web::json::value collection = web::json::value::object();
+    collection["uri"] = uris;
+    web::json::value query = web::json::value::object();
+    query["collection-query"] = collection;
+    return query;
+  }
+  if (since.empty()) {
+    return web::json::value::null();
+  }
+
+  web::json::value values = web::json::value::array(1);
+  values[0] = web::json::value::string(since);
+  web::json::value element = web::json::value::object();
+  element["name"] = web::json::value::string("last-modified");
+  element["ns"] = web::json::value::string(PROPERTY_NAMESPACE);
+  web::json::value range = web::json::value::object();
+  range["type"] = web::json::value::string("xs:dateTime");
+  range["element"] = element;
+  range["fragment-scope"] = web::json::value::string("properties");
+  range["range-operator"] = web::json::value::string("GE");
+  range["value"] = values;
+  web::json::value query = web::json::value::object();
+  query["range-query"] = range;
+  return query;
+}
+
+std::string DownloadSync::DateTimeFromHttpDate(const std::string& date) {
+  static const char* MONTHS[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug",
+      "Sep", "Oct", "Nov", "Dec" };
+  int day, year, hour, minute, second;
+  char month[4];
+  char zone[4];
+  if (std::sscanf(date.c_str(), "%*3s, %2d %3s %4d %2d:%2d:%2d %3s", &day, month, &year,
+      &hour, &minute, &second, zone) != 7 || std::string(zone) != "GMT") {
+    return std::string();
+  }
+  for (int i = 0; i < 12; i++) {
+    if (std::string(month) == MONTHS[i]) {
+      char text[32];
+      std::snprintf(text, sizeof(text), "%04d-%02d-%02dT%02d:%02d:%02dZ", year, i + 1, day,
+          hour, minute, second);
+      return text;
+    }
+  }
+  return std::string();
+}
+
+std::string DownloadSync::LoadMark(void) const {
+  if (_options.state_path.empty()) {
+    return std::string();
+  }
+  std::ifstream in(_options.state_path.c_str());
+  if (!in) {
+    return std::string();
+  }
+
+  std::string header;
+  std::string mark;
+  if (!std::getline(in, header) || header != DOWNLOAD_STATE_HEADER ||
+      !std::getline(in, mark) || mark.empty()) {
+    throw SyncException(_options.state_path + " is not a download state file");
+  }
+  return mark;
+}
+
+void DownloadSync::SaveMark(const std::string& mark) const {
+  if (_options.state_path.empty()) {
+    return;
+  }
+
+  std::string temporary = _options.state_path + ".tmp";
+  {
+    std::ofstream out(temporary.c_str(), std::ios::trunc);
+    out << DOWNLOAD_STATE_HEADER << '\n' << mark << '\n';
+    out.flush();
+    if (!out) {
+      throw SyncException("Could not write " + temporary);
+    }
+  }
+  if (!ReplaceFile(temporary, _options.state_path)) {
+    throw SyncException("Could not replace " + _options.state_path);
+  }
+}
+
+std::string DownloadSync::CaptureMark(void) const {
+  AuthenticatingProxy proxy(_options.proxy);
+  proxy.AddCredentials(_credentials);
+  SearchQuery scope;
+  scope.Collection(_options.collection).Directory(_options.directory);
+  Response response = proxy.Get(_host, scope.Path(1, 0));
+  if (response.GetResponseCode() != ResponseCodes::OK) {
+    throw SyncException("Could not read the server clock, status " +
+        std::to_string((int)response.GetResponseCode()));
+  }
+
+  std::string mark = DateTimeFromHttpDate(response.Header("Date"));
+  if (mark.empty()) {
+    throw SyncException("The server sent no usable Date header: \"" +
+        response.Header("Date") + "\"");
+  }
+  return mark;
+}
+
+DownloadSyncSummary DownloadSync::Run(void) {
+  DownloadSyncSummary summary;
+  summary.since = LoadMark();
+  // Taken before the snapshot, so nothing written after the snapshot can
+  // be older than the mark.
+  summary.mark = CaptureMark();
+
+  ExportOptions options;
+  options.collection = _options.collection;
+  options.directory = _options.directory;
+  options.query = ChangedQuery(_options, summary.since);
+  options.partitions = _options.workers;
+  options.batch_size = _options.batch_size;
+  options.page_length = _options.page_length;
+  options.output_directory = _options.mirror_directory;
+  options.replace_files = true;
+  options.proxy = _options.proxy;
+
+  try {
+    Exporter exporter(_host, _credentials, options);
+    ExportSummary exported = exporter.Run();
+    summary.timestamp = exported.timestamp;
+    summary.downloaded = exported.documents;
+    summary.bytes = exported.bytes;
+    summary.skipped = exported.skipped;
+  } catch (const ExportException& e) {
+    throw SyncException(std::string("Documents not downloaded: ") + e.what());
+  }
+
+  SaveMark(summary.mark);
+  MLLOG(LogLevel::INFO).Message("Download sync").Field("since", summary.since)
+      .Field("mark", summary.mark).Field("downloaded", summary.downloaded);
+  return summary;
+}
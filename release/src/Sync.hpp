@@ -0,0 +1,294 @@
+/*
+ * File:   Sync.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SYNC_HPP
+#define	SYNC_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cpprest/json.h>
+
+#include "BatchWriter.hpp"
+#include "Credentials.hpp"
+#include "Pipeline.hpp"
+
+class AuthenticatingProxy;
+
+///
+/// Thrown when a sync cannot start or cannot record what it did.
+///
+class SyncException : public std::exception {
+    std::string _message;
+public:
+    explicit SyncException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// Settings for an UploadSync.
+///
+struct UploadSyncOptions {
+    std::string manifest_path;  /*!< What the last run uploaded; empty for none */
+    std::string hash_key;       /*!< The metadata value holding each document's hash */
+    bool verify_unchanged;      /*!< Ask the server about files the manifest says are unchanged */
+    size_t lookup_batch;        /*!< URIs per bulk metadata read */
+    unsigned workers;           /*!< Threads hashing files and reading metadata */
+    BatchWriterOptions batch;   /*!< How changed documents are written */
+    ProxyOptions proxy;         /*!< For the metadata reads; batch.proxy is for writes */
+
+    UploadSyncOptions();
+};
+
+///
+/// What an UploadSync did.
+///
+struct UploadSyncSummary {
+    uint64_t uploaded;
+    uint64_t unchanged;     /*!< Skipped, because their hash matched */
+    uint64_t failed;
+    uint64_t bytes;         /*!< Uploaded */
+    uint64_t hashed;        /*!< Files read to hash them */
+    uint64_t lookups;       /*!< Bulk metadata reads */
+    std::vector<std::pair<std::string, std::string> > failures;  /*!< URI and error */
+
+    UploadSyncSummary();
+};
+
+///
+/// Uploads only the documents that have changed.
+///
+///     UploadSyncOptions options;
+///     options.manifest_path = "orders.manifest";
+///     UploadSync sync(host, proxy.GetCredentials(), options);
+///     for (auto& file : files) {
+///         sync.Add("/orders/" + file, "/data/orders/" + file);
+///     }
+///     UploadSyncSummary summary = sync.Run();
+///
+/// Every document is written with a hash of its content (MLCrypto's fast
+/// hash) in a metadata value, hash_key.  A run hashes each file and reads
+/// the stored hashes back, a lookup_batch of URIs per
+/// GET /v1/documents?category=metadata-values, and uploads only those that
+/// differ or are missing, as multi-document writes through a BatchWriter.
+/// The server's ETags cannot stand in for the hash: they are version
+/// numbers that change on every update, not a digest of the content.
+///
+/// The manifest records each URI's hash with its file's size and
+/// modification time.  A file whose size and time still match is not read
+/// again, and, unless verify_unchanged is set, not looked up either, so a
+/// re-sync of a mostly unchanged corpus costs a stat per file.  The
+/// manifest is replaced atomically when the run ends; a document that
+/// failed is left out so the next run tries it again.
+///
+/// Uploads replace the document's metadata values with the hash.
+///
+class UploadSync {
+    enum class State { LOOKUP, UNCHANGED, CHANGED, UPLOADED, FAILED };
+
+    struct Item {
+        std::string uri;
+        std::string path;
+        std::string content_type;
+        uint64_t size;
+        int64_t modified;
+        std::string hash;
+        State state;
+        std::string error;
+    };
+
+    struct ManifestEntry {
+        std::string hash;
+        uint64_t size;
+        int64_t modified;
+    };
+
+    std::string _host;
+    Credentials _credentials;
+    UploadSyncOptions _options;
+    std::vector<Item> _items;
+    std::map<std::string, ManifestEntry> _manifest;
+
+    std::atomic<size_t> _next;
+    std::atomic<uint64_t> _hashed;
+    std::atomic<uint64_t> _lookups;
+    std::atomic<uint64_t> _bytes;
+
+    UploadSync(const UploadSync& orig);
+    UploadSync& operator=(const UploadSync& orig);
+
+    void LoadManifest(void);
+    void SaveManifest(void) const;
+    void Hash(void);
+    void Lookup(const std::vector<Item*>& pending, Credentials credentials);
+    void Upload(const std::vector<Item*>& changed, BatchWriter& writer);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param credentials The credentials; each worker uses a Fork of them
+    /// \param options The manifest and batch sizes
+    ///
+    UploadSync(const std::string& host, const Credentials& credentials,
+               const UploadSyncOptions& options = UploadSyncOptions());
+
+    ///
+    /// Adds a file to the sync.
+    ///
+    /// \param uri The document URI
+    /// \param path The file holding the document
+    /// \param content_type Its media type
+    ///
+    void Add(const std::string& uri, const std::string& path,
+             const std::string& content_type = "application/json");
+
+    ///
+    /// Uploads the changed documents and saves the manifest.  Throws
+    /// SyncException if the manifest cannot be read or written; a document
+    /// that cannot be read or uploaded is recorded in the summary.  The
+    /// files added are cleared.
+    ///
+    /// \return The summary
+    ///
+    UploadSyncSummary Run(void);
+
+    ///
+    /// Returns the path of a bulk metadata read.
+    ///
+    /// \param uris The document URIs
+    /// \return The path and query string
+    ///
+    static std::string MetadataPath(const std::vector<std::string>& uris);
+};
+
+///
+/// How a DownloadSync finds the documents that changed.
+///
+enum class ChangeSource {
+    LAST_MODIFIED,  /*!< Documents whose last-modified property is at or after the mark */
+    COLLECTION      /*!< Every document in changed_collection */
+};
+
+///
+/// Settings for a DownloadSync.
+///
+struct DownloadSyncOptions {
+    std::string mirror_directory;   /*!< Documents are written here, by URI */
+    std::string state_path;         /*!< Holds the high-water mark between runs */
+    ChangeSource source;
+    std::string collection;         /*!< Mirror this collection... */
+    std::string directory;          /*!< ...and/or this directory */
+    std::string changed_collection; /*!< The collection COLLECTION reads */
+    unsigned workers;               /*!< Parallel bulk reads */
+    size_t batch_size;              /*!< Documents per bulk read */
+    uint64_t page_length;           /*!< URIs per search page while listing */
+    ProxyOptions proxy;             /*!< For every request */
+
+    DownloadSyncOptions();
+};
+
+///
+/// What a DownloadSync did.
+///
+struct DownloadSyncSummary {
+    std::string since;      /*!< The mark the run started from, empty for a full sync */
+    std::string mark;       /*!< The mark recorded for the next run */
+    uint64_t timestamp;     /*!< The point in time the documents were read at */
+    uint64_t downloaded;
+    uint64_t bytes;
+    uint64_t skipped;       /*!< URIs that could not be used as paths */
+
+    DownloadSyncSummary();
+};
+
+///
+/// Downloads only the documents that changed since the last run into a
+/// local mirror directory.
+///
+///     DownloadSyncOptions options;
+///     options.directory = "/orders/";
+///     options.mirror_directory = "/var/cache/orders";
+///     options.state_path = "/var/cache/orders.mark";
+///     DownloadSync sync(host, proxy.GetCredentials(), options);
+///     DownloadSyncSummary summary = sync.Run();
+///
+/// The high-water mark is the server's clock, an xs:dateTime taken from
+/// the Date header of a request made before the snapshot is read, so a
+/// document updated while the sync runs is either in this run or in the
+/// next one; some are in both, which is harmless.  With LAST_MODIFIED the
+/// changed documents are found with a range query on the last-modified
+/// property, which needs "maintain last modified" on the database and an
+/// xs:dateTime element range index on prop:last-modified.  With COLLECTION
+/// the application adds what changed to changed_collection, and removes it
+/// once it has been mirrored everywhere; the mark is recorded but not used.
+/// Without a state file every document in scope is downloaded.
+///
+/// The documents are read as an Exporter reads them: pinned to one server
+/// timestamp, in parallel bulk reads by workers threads.  Each file is
+/// written beside its target and renamed over it, and the state file is
+/// replaced the same way, and only once every document has been written;
+/// a failed run throws and leaves the mark where it was.  Deletions are
+/// not seen: a deleted document leaves no last-modified property behind.
+///
+class DownloadSync {
+    std::string _host;
+    Credentials _credentials;
+    DownloadSyncOptions _options;
+
+    DownloadSync(const DownloadSync& orig);
+    DownloadSync& operator=(const DownloadSync& orig);
+
+    std::string LoadMark(void) const;
+    void SaveMark(const std::string& mark) const;
+    std::string CaptureMark(void) const;
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param credentials The credentials; each worker uses a Fork of them
+    /// \param options What to mirror, where, and the state file
+    ///
+    DownloadSync(const std::string& host, const Credentials& credentials,
+                 const DownloadSyncOptions& options);
+
+    ///
+    /// Downloads the changed documents and records the new mark.  Throws
+    /// SyncException if the state file cannot be read or written, or if
+    /// any request fails.
+    ///
+    /// \return The summary
+    ///
+    DownloadSyncSummary Run(void);
+
+    ///
+    /// Returns the structured query that selects the changed documents.
+    ///
+    /// \param options The change source and collection
+    /// \param since The last mark, empty for everything
+    /// \return The query, null when there is nothing to filter on
+    ///
+    static web::json::value ChangedQuery(const DownloadSyncOptions& options,
+                                         const std::string& since);
+
+    ///
+    /// Converts an HTTP date ("Mon, 19 Oct 2026 02:12:31 GMT") to an
+    /// xs:dateTime ("2026-10-19T02:12:31Z").
+    ///
+    /// \param date The HTTP date
+    /// \return The dateTime, empty if the date cannot be read
+    ///
+    static std::string DateTimeFromHttpDate(const std::string& date);
+};
+
+#endif	/* SYNC_HPP */
@@ -0,0 +1,408 @@
+/*
+ * File:   Tracer.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Tracer.hpp"
+
+#ifdef MLCPLUSPLUS_TRACING
+
+#include <cstring>
+#include <iomanip>
+#include <random>
+
+namespace {
+
+const uint32_t SPAN_KIND_INTERNAL = 1;
+const uint32_t SPAN_KIND_CLIENT = 3;
+
+thread_local SpanContext current_span;
+
+const char* PhaseName(const TracePhase& phase) {
+  switch (phase) {
+    case TracePhase::AUTH_CHALLENGE:
+      return "auth challenge";
+    case TracePhase::CONNECT:
+      return "connect";
+    case TracePhase::SEND:
+      return "send";
+    case TracePhase::RECEIVE:
+      return "receive";
+    case TracePhase::PARSE:
+      return "parse";
+  }
+  return "unknown";
+}
+
+uint32_t ThreadId(void) {
+  static std::atomic<uint32_t> next(1);
+  thread_local uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+  return id;
+}
+
+void CopyTruncated(char* dest, const size_t& size, const char* src) {
+  std::strncpy(dest, src, size - 1);
+  dest[size - 1] = '\0';
+}
+
+void WriteHex(std::ostream& os, const uint64_t& value) {
+  os << std::hex << std::setfill('0') << std::setw(16) << value << std::dec;
+}
+
+void WriteEscaped(std::ostream& os, const char* text) {
+  for (const char* c = text; *c != '\0'; c++) {
+    switch (*c) {
+      case '"':  os << "\\\""; break;
+      case '\\': os << "\\\\"; break;
+      case '\n': os << "\\n"; break;
+      case '\r': os << "\\r"; break;
+      case '\t': os << "\\t"; break;
+      default:
+        if ((unsigned char)*c < 0x20) {
+          os << "\\u" << std::hex << std::setfill('0') << std::setw(4)
+             << (int)(unsigned char)*c << std::dec;
+        } else {
+          os << *c;
+        }
+    }
+  }
+}
+
+}
+
+SpanRecord::SpanRecord() : parent_id(0), start_ns(0), end_ns(0), thread_id(0),
+    kind(SPAN_KIND_INTERNAL)
+{
+  name[0] = '\0';
+  detail[0] = '\0';
+}
+
+Tracer::Tracer() : _active(false), _dropped(0), _buffer(nullptr),
+    _format(TraceFormat::CHROME), _first_event(true), _interval(1000),
+    _stopping(false)
+{
+
+}
+
+Tracer::~Tracer() {
+  Stop();
+  delete _buffer;
+}
+
+Tracer* Tracer::Instance(void) {
+  static Tracer instance;
+  return &instance;
+}
+
+bool Tracer::Start(const std::string& file_path, const TraceFormat& format,
+    const uint32_t& flush_interval_ms, const size_t& capacity)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_active.load()) {
+    return false;
+  }
+
+  _out.open(file_path.c_str(), std::ios::out | std::ios::trunc);
+  if (!_out) {
+    return false;
+  }
+
+  // The buffer outlives Stop() so a late Submit never sees it freed.
+  if (_buffer == nullptr) {
+    _buffer = new RingBuffer<SpanRecord>(capacity);
+  } else {
+    SpanRecord stale;
+    while (_buffer->TryPop(stale)) {
+      ;
+    }
+  }
+
+  _format = format;
+  _first_event = true;
+  _interval = std::chrono::milliseconds(flush_interval_ms);
+  _stopping = false;
+  _dropped.store(0);
+
+  if (_format == TraceFormat::CHROME) {
+    _out << "[" << std::endl;
+  }
+
+  _active.store(true, std::memory_order_release);
+  _flusher = std::thread(&Tracer::FlushLoop, this);
+  return true;
+}
+
+void Tracer::Stop(void) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_active.load()) {
+      return;
+    }
+    _active.store(false, std::memory_order_release);
+    _stopping = true;
+  }
+  _wake.notify_all();
+  _flusher.join();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  Drain();
+  if (_format == TraceFormat::CHROME) {
+    _out << std::endl << "]" << std::endl;
+  }
+  _out.close();
+}
+
+void Tracer::Flush(void) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_out.is_open()) {
+    Drain();
+  }
+}
+
+bool Tracer::Active(void) const {
+  return _active.load(std::memory_order_relaxed);
+}
+
+uint64_t Tracer::Dropped(void) const {
+  return _dropped.load(std::memory_order_relaxed);
+}
+
+void Tracer::Submit(const SpanRecord& record) {
+  if (!Active() || !_buffer->TryPush(record)) {
+    _dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+SpanContext Tracer::Current(void) {
+  return current_span;
+}
+
+uint64_t Tracer::NowNanos(void) {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+uint64_t Tracer::NewId(void) {
+  thread_local uint64_t state = 0;
+  if (state == 0) {
+    std::random_device device;
+    state = ((uint64_t)device() << 32) ^ device() ^ NowNanos();
+    state |= 1;
+  }
+
+  // xorshift64*
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  uint64_t id = state * UINT64_C(2685821657736338717);
+  return id == 0 ? 1 : id;
+}
+
+void Tracer::FlushLoop(void) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (!_stopping) {
+    _wake.wait_for(lock, _interval);
+    Drain();
+  }
+}
+
+void Tracer::Drain(void) {
+  SpanRecord record;
+
+  if (_format == TraceFormat::CHROME) {
+    while (_buffer->TryPop(record)) {
+      Write(record);
+    }
+  } else {
+    bool any = false;
+    while (_buffer->TryPop(record)) {
+      if (!any) {
+        _out << "{\"resourceSpans\":[{\"resource\":{\"attributes\":[{\"key\":"
+             << "\"service.name\",\"value\":{\"stringValue\":\"mlcplusplus\"}}]},"
+             << "\"scopeSpans\":[{\"scope\":{\"name\":\"mlcplusplus\"},\"spans\":[";
+        _first_event = true;
+        any = true;
+      }
+      Write(record);
+    }
+    if (any) {
+      _out << "]}]}]}" << std::endl;
+    }
+  }
+  _out.flush();
+}
+
+void Tracer::Write(const SpanRecord& record) {
+  // OTLP batches are one line each, Chrome events get a line each.
+  if (!_first_event) {
+    _out << (_format == TraceFormat::CHROME ? ",\n" : ",");
+  }
+  _first_event = false;
+
+  if (_format == TraceFormat::CHROME) {
+    _out << "{\"name\":\"";
+    WriteEscaped(_out, record.name);
+    _out << "\",\"cat\":\"mlcplusplus\",\"ph\":\"X\""
+         << ",\"ts\":" << record.start_ns / 1000 << "." << std::setfill('0')
+         << std::setw(3) << record.start_ns % 1000
+         << ",\"dur\":" << (record.end_ns - record.start_ns) / 1000 << "."
+         << std::setw(3) << (record.end_ns - record.start_ns) % 1000
+         << ",\"pid\":1,\"tid\":" << record.thread_id
+         << ",\"args\":{\"trace_id\":\"";
+    WriteHex(_out, record.context.trace_hi);
+    WriteHex(_out, record.context.trace_lo);
+    _out << "\",\"span_id\":\"";
+    WriteHex(_out, record.context.span_id);
+    _out << "\",\"parent_id\":\"";
+    WriteHex(_out, record.parent_id);
+    _out << "\",\"detail\":\"";
+    WriteEscaped(_out, record.detail);
+    _out << "\"}}";
+  } else {
+    _out << "{\"traceId\":\"";
+    WriteHex(_out, record.context.trace_hi);
+    WriteHex(_out, record.context.trace_lo);
+    _out << "\",\"spanId\":\"";
+    WriteHex(_out, record.context.span_id);
+    _out << "\"";
+    if (record.parent_id != 0) {
+      _out << ",\"parentSpanId\":\"";
+      WriteHex(_out, record.parent_id);
+      _out << "\"";
+    }
+    _out << ",\"name\":\"";
+    WriteEscaped(_out, record.name);
+    _out << "\",\"kind\":" << record.kind
+         << ",\"startTimeUnixNano\":\"" << record.start_ns << "\""
+         << ",\"endTimeUnixNano\":\"" << record.end_ns << "\"";
+    if (record.detail[0] != '\0') {
+      _out << ",\"attributes\":[{\"key\":\"mlcplusplus.detail\",\"value\":{\"stringValue\":\"";
+      WriteEscaped(_out, record.detail);
+      _out << "\"}}]";
+    }
+    _out << "}";
+  }
+}
+
+Span::Span(const char* name) : _recording(false) {
+  Open(name, Tracer::Current());
+}
+
+Span::Span(const char* name, const SpanContext& parent) : _recording(false) {
+  Open(name, parent);
+}
+
+void Span::Open(const char* name, const SpanContext& parent) {
+  _recording = Tracer::Instance()->Active();
+  if (!_recording) {
+    return;
+  }
+
+  CopyTruncated(_record.name, sizeof(_record.name), name);
+  if (parent.Valid()) {
+    _record.context.trace_hi = parent.trace_hi;
+    _record.context.trace_lo = parent.trace_lo;
+    _record.parent_id = parent.span_id;
+  } else {
+    _record.context.trace_hi = Tracer::NewId();
+    _record.context.trace_lo = Tracer::NewId();
+  }
+  _record.context.span_id = Tracer::NewId();
+  _record.thread_id = ThreadId();
+  _record.start_ns = Tracer::NowNanos();
+
+  _previous = current_span;
+  current_span = _record.context;
+}
+
+Span::~Span() {
+  if (_recording) {
+    _record.end_ns = Tracer::NowNanos();
+    current_span = _previous;
+    Tracer::Instance()->Submit(_record);
+  }
+}
+
+SpanContext Span::Context(void) const {
+  return _record.context;
+}
+
+RequestTrace::RequestTrace(const char* method, const std::string& path) :
+    _recording(Tracer::Instance()->Active())
+{
+  for (int i = 0; i < PHASE_COUNT; i++) {
+    _phase_ids[i] = 0;
+    _phase_starts[i] = 0;
+  }
+  if (!_recording) {
+    return;
+  }
+
+  SpanContext parent = Tracer::Current();
+  CopyTruncated(_root.name, sizeof(_root.name), method);
+  CopyTruncated(_root.detail, sizeof(_root.detail), path.c_str());
+  if (parent.Valid()) {
+    _root.context.trace_hi = parent.trace_hi;
+    _root.context.trace_lo = parent.trace_lo;
+    _root.parent_id = parent.span_id;
+  } else {
+    _root.context.trace_hi = Tracer::NewId();
+    _root.context.trace_lo = Tracer::NewId();
+  }
+  _root.context.span_id = Tracer::NewId();
+  _root.thread_id = ThreadId();
+  _root.kind = SPAN_KIND_CLIENT;
+  _root.start_ns = Tracer::NowNanos();
+}
+
+RequestTrace::~RequestTrace() {
+  if (!_recording) {
+    return;
+  }
+
+  // Anything left open was cut short by an exception.
+  End(TracePhase::CONNECT);
+  End(TracePhase::SEND);
+  End(TracePhase::RECEIVE);
+  End(TracePhase::PARSE);
+  End(TracePhase::AUTH_CHALLENGE);
+
+  _root.end_ns = Tracer::NowNanos();
+  Tracer::Instance()->Submit(_root);
+}
+
+void RequestTrace::Begin(const TracePhase& phase) {
+  if (!_recording) {
+    return;
+  }
+
+  int index = (int)phase;
+  _phase_ids[index] = Tracer::NewId();
+  _phase_starts[index] = Tracer::NowNanos();
+}
+
+void RequestTrace::End(const TracePhase& phase) {
+  int index = (int)phase;
+  if (!_recording || _phase_ids[index] == 0) {
+    return;
+  }
+
+  uint64_t challenge = _phase_ids[(int)TracePhase::AUTH_CHALLENGE];
+
+  SpanRecord record;
+  CopyTruncated(record.name, sizeof(record.name), PhaseName(phase));
+  record.context.trace_hi = _root.context.trace_hi;
+  record.context.trace_lo = _root.context.trace_lo;
+  record.context.span_id = _phase_ids[index];
+  record.parent_id = (phase != TracePhase::AUTH_CHALLENGE && challenge != 0) ?
+      challenge : _root.context.span_id;
+  record.thread_id = _root.thread_id;
+  record.start_ns = _phase_starts[index];
+  record.end_ns = Tracer::NowNanos();
+  Tracer::Instance()->Submit(record);
+
+  _phase_ids[index] = 0;
+}
+
+#endif /* MLCPLUSPLUS_TRACING */
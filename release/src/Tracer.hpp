@@ -0,0 +1,293 @@
+/*
+ * File:   Tracer.hpp
+ *
+ * Created on October 19, 2026
+ *
+ * Request tracing.  Only compiled in when the library is configured with
+ * cmake -DMLCPLUSPLUS_TRACING=ON, which records the setting in the installed
+ * MLCPlusPlusConfig.h so that applications see the same classes as the
+ * library.  Without it Tracer, Span and RequestTrace are empty inline
+ * classes and every call compiles away.
+ */
+
+#ifndef TRACER_HPP
+#define	TRACER_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "MLCPlusPlusConfig.h"
+
+///
+/// Identifies a span and the trace it belongs to.  Pass one to a Span on
+/// another thread to continue a trace there.
+///
+struct SpanContext {
+    uint64_t trace_hi;  /*!< High half of the 128 bit trace id */
+    uint64_t trace_lo;  /*!< Low half of the 128 bit trace id */
+    uint64_t span_id;   /*!< The span id, 0 when there is no span */
+
+    SpanContext() : trace_hi(0), trace_lo(0), span_id(0) { }
+
+    bool Valid(void) const { return span_id != 0; }
+};
+
+///
+/// The file format the tracer writes.
+///
+enum class TraceFormat {
+    CHROME,     /*!< Chrome trace event JSON, load in chrome://tracing */
+    OTLP_JSON   /*!< OTLP/JSON, one ExportTraceServiceRequest per line */
+};
+
+///
+/// The stages of a proxied request that get their own span.
+///
+enum class TracePhase { AUTH_CHALLENGE, CONNECT, SEND, RECEIVE, PARSE };
+
+#ifdef MLCPLUSPLUS_TRACING
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "RingBuffer.hpp"
+
+///
+/// A finished span as it sits in the ring buffer.  Fixed size so that
+/// submitting one never allocates.
+///
+struct SpanRecord {
+    SpanContext context;
+    uint64_t    parent_id;
+    uint64_t    start_ns;   /*!< Unix epoch nanoseconds */
+    uint64_t    end_ns;     /*!< Unix epoch nanoseconds */
+    uint32_t    thread_id;
+    uint32_t    kind;       /*!< OTLP span kind */
+    char        name[32];
+    char        detail[96];
+
+    SpanRecord();
+};
+
+///
+/// Collects spans and periodically writes them to a local file.
+///
+/// Spans are pushed into a lock free ring buffer by whichever thread
+/// finishes them; a background thread drains the buffer to disk.  If the
+/// buffer fills up between flushes spans are dropped and counted rather than
+/// blocking the request.
+///
+class Tracer {
+    std::atomic<bool> _active;
+    std::atomic<uint64_t> _dropped;
+    RingBuffer<SpanRecord>* _buffer;
+    std::ofstream _out;
+    TraceFormat _format;
+    bool _first_event;
+    std::chrono::milliseconds _interval;
+    std::thread _flusher;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    bool _stopping;
+
+    Tracer();
+    Tracer(const Tracer& orig);
+    Tracer& operator=(const Tracer& orig);
+
+    void Drain(void);
+    void Write(const SpanRecord& record);
+    void FlushLoop(void);
+public:
+    ~Tracer();
+
+    ///
+    /// Returns the process wide tracer.
+    ///
+    /// \return The tracer
+    ///
+    static Tracer* Instance(void);
+
+    ///
+    /// Starts recording spans.
+    ///
+    /// \param file_path The file to write, truncated if it exists
+    /// \param format The output format
+    /// \param flush_interval_ms How often the buffer is written out
+    /// \param capacity The number of spans the buffer holds between flushes
+    /// \return False if already started or the file could not be opened
+    ///
+    bool Start(const std::string& file_path,
+               const TraceFormat& format = TraceFormat::CHROME,
+               const uint32_t& flush_interval_ms = 1000,
+               const size_t& capacity = 65536);
+
+    ///
+    /// Stops recording, writes anything still buffered and closes the file.
+    ///
+    void Stop(void);
+
+    ///
+    /// Writes everything buffered so far without waiting for the interval.
+    ///
+    void Flush(void);
+
+    ///
+    /// Returns whether spans are being recorded.
+    ///
+    /// \return True if started
+    ///
+    bool Active(void) const;
+
+    ///
+    /// Returns the number of spans dropped because the buffer was full.
+    ///
+    /// \return The number of dropped spans
+    ///
+    uint64_t Dropped(void) const;
+
+    ///
+    /// Queues a finished span.
+    ///
+    /// \param record The span
+    ///
+    void Submit(const SpanRecord& record);
+
+    ///
+    /// Returns the innermost open span on the calling thread, or an invalid
+    /// context if there is none.
+    ///
+    /// \return The current span
+    ///
+    static SpanContext Current(void);
+
+    ///
+    /// Returns the wall clock time used for span timestamps.
+    ///
+    /// \return Nanoseconds since the Unix epoch
+    ///
+    static uint64_t NowNanos(void);
+
+    ///
+    /// Returns a random, non-zero span or trace id.
+    ///
+    /// \return The id
+    ///
+    static uint64_t NewId(void);
+};
+
+///
+/// A span around a block of user code.  Spans nest on a thread: proxy calls
+/// made while a Span is open become its children.
+///
+class Span {
+    SpanRecord _record;
+    SpanContext _previous;
+    bool _recording;
+
+    Span(const Span& orig);
+    Span& operator=(const Span& orig);
+
+    void Open(const char* name, const SpanContext& parent);
+public:
+    ///
+    /// Opens a span as a child of the current span on this thread, or as the
+    /// root of a new trace.
+    ///
+    /// \param name The span name (truncated to 31 characters)
+    ///
+    explicit Span(const char* name);
+
+    ///
+    /// Opens a span with an explicit parent, usually captured on another
+    /// thread with Tracer::Current().
+    ///
+    /// \param name The span name (truncated to 31 characters)
+    /// \param parent The parent span
+    ///
+    Span(const char* name, const SpanContext& parent);
+    ~Span();
+
+    ///
+    /// Returns this span's context.
+    ///
+    /// \return The context
+    ///
+    SpanContext Context(void) const;
+};
+
+///
+/// The spans for one proxied request: a root span for the call and a child
+/// for each phase.  Not tied to a thread, so it can be captured by the
+/// continuations that complete the request.
+///
+class RequestTrace {
+    static const int PHASE_COUNT = 5;
+
+    bool _recording;
+    SpanRecord _root;
+    uint64_t _phase_ids[PHASE_COUNT];
+    uint64_t _phase_starts[PHASE_COUNT];
+
+    RequestTrace(const RequestTrace& orig);
+    RequestTrace& operator=(const RequestTrace& orig);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param method The HTTP method
+    /// \param path The request path
+    ///
+    RequestTrace(const char* method, const std::string& path);
+    ~RequestTrace();
+
+    ///
+    /// Opens the span for a phase.  Phases opened while AUTH_CHALLENGE is
+    /// open are its children.
+    ///
+    /// \param phase The phase
+    ///
+    void Begin(const TracePhase& phase);
+
+    ///
+    /// Closes the span for a phase, if it is open.
+    ///
+    /// \param phase The phase
+    ///
+    void End(const TracePhase& phase);
+};
+
+#else
+
+class Tracer {
+public:
+    static Tracer* Instance(void) { static Tracer instance; return &instance; }
+    bool Start(const std::string&, const TraceFormat& = TraceFormat::CHROME,
+               const uint32_t& = 1000, const size_t& = 65536) { return false; }
+    void Stop(void) { }
+    void Flush(void) { }
+    bool Active(void) const { return false; }
+    uint64_t Dropped(void) const { return 0; }
+    static SpanContext Current(void) { return SpanContext(); }
+};
+
+class Span {
+public:
+    explicit Span(const char*) { }
+    Span(const char*, const SpanContext&) { }
+    SpanContext Context(void) const { return SpanContext(); }
+};
+
+class RequestTrace {
+public:
+    RequestTrace(const char*, const std::string&) { }
+    void Begin(const TracePhase&) { }
+    void End(const TracePhase&) { }
+};
+
+#endif /* MLCPLUSPLUS_TRACING */
+
+#endif	/* TRACER_HPP */
@@ -0,0 +1,263 @@
+/*
+ * File:   TrafficRecorder.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "TrafficRecorder.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <stdexcept>
+
+#include "MLCrypto.hpp"
+
+const char TRAFFIC_MAGIC[4] = { 'M', 'L', 'T', 'R' };
+const std::string RECORDED_AUTHORIZATION_HEADER = "Authorization";
+
+namespace {
+
+void WriteInt(std::ostream& os, uint64_t value, const int& bytes) {
+  char buffer[8];
+  for (int i = 0; i < bytes; i++) {
+    buffer[i] = (char)(value & 0xff);
+    value >>= 8;
+  }
+  os.write(buffer, bytes);
+}
+
+void WriteString(std::ostream& os, const std::string& value) {
+  WriteInt(os, value.size(), 4);
+  os.write(value.data(), (std::streamsize)value.size());
+}
+
+bool ReadInt(std::istream& is, uint64_t& value, const int& bytes) {
+  unsigned char buffer[8];
+  if (!is.read((char*)buffer, bytes)) {
+    return false;
+  }
+  value = 0;
+  for (int i = bytes - 1; i >= 0; i--) {
+    value = (value << 8) | buffer[i];
+  }
+  return true;
+}
+
+bool ReadString(std::istream& is, std::string& value) {
+  uint64_t length = 0;
+  if (!ReadInt(is, length, 4)) {
+    return false;
+  }
+  value.resize(length);
+  return length == 0 || is.read(&value[0], (std::streamsize)length);
+}
+
+}
+
+TrafficRecord::TrafficRecord() : offset_ns(0), duration_ns(0), status(0),
+    body_kind(TrafficBodies::NONE), body_length(0)
+{
+
+}
+
+TrafficRecorder::TrafficRecorder() : _active(false), _bodies(TrafficBodies::HASH),
+    _started_ns(0), _records(0)
+{
+
+}
+
+TrafficRecorder* TrafficRecorder::Instance(void) {
+  static TrafficRecorder instance;
+  return &instance;
+}
+
+bool TrafficRecorder::Start(const std::string& file_path, const TrafficBodies& bodies) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_active.load()) {
+    return false;
+  }
+
+  _out.open(file_path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!_out) {
+    return false;
+  }
+
+  _out.write(TRAFFIC_MAGIC, sizeof(TRAFFIC_MAGIC));
+  WriteInt(_out, VERSION, 4);
+  _bodies = bodies;
+  _started_ns = NowNanos();
+  _records = 0;
+  _active.store(true);
+  return true;
+}
+
+void TrafficRecorder::Stop(void) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_active.load()) {
+    return;
+  }
+  _active.store(false);
+  _out.close();
+}
+
+TrafficBodies TrafficRecorder::Bodies(void) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _bodies;
+}
+
+uint64_t TrafficRecorder::Records(void) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _records;
+}
+
+uint64_t TrafficRecorder::StartedNanos(void) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _started_ns;
+}
+
+void TrafficRecorder::Write(const TrafficRecord& record) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_active.load()) {
+    return;
+  }
+
+  WriteInt(_out, record.offset_ns, 8);
+  WriteInt(_out, record.duration_ns, 8);
+  WriteInt(_out, record.status, 2);
+  WriteString(_out, record.method);
+  WriteString(_out, record.path);
+  WriteInt(_out, record.headers.size(), 2);
+  for (auto& header : record.headers) {
+    WriteString(_out, header.first);
+    WriteString(_out, header.second);
+  }
+  WriteInt(_out, (uint64_t)record.body_kind, 1);
+  WriteInt(_out, record.body_length, 8);
+  if (record.body_kind != TrafficBodies::NONE) {
+    WriteString(_out, record.body);
+  }
+  _records++;
+}
+
+uint64_t TrafficRecorder::NowNanos(void) {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TrafficReader::TrafficReader(const std::string& file_path) : _version(0) {
+  _in.open(file_path.c_str(), std::ios::in | std::ios::binary);
+  if (!_in) {
+    throw std::runtime_error("Cannot open traffic log " + file_path);
+  }
+
+  char magic[sizeof(TRAFFIC_MAGIC)];
+  uint64_t version = 0;
+  if (!_in.read(magic, sizeof(magic)) ||
+      std::string(magic, sizeof(magic)) != std::string(TRAFFIC_MAGIC, sizeof(TRAFFIC_MAGIC)) ||
+      !ReadInt(_in, version, 4)) {
+    throw std::runtime_error(file_path + " is not a traffic log");
+  }
+  if (version > TrafficRecorder::VERSION) {
+    throw std::runtime_error(file_path + " was written by a newer version");
+  }
+  _version = (uint32_t)version;
+}
+
+bool TrafficReader::Next(TrafficRecord& record) {
+  uint64_t value = 0;
+  if (!ReadInt(_in, record.offset_ns, 8)) {
+    return false;
+  }
+
+  bool complete = ReadInt(_in, record.duration_ns, 8) && ReadInt(_in, value, 2);
+  record.status = (uint16_t)value;
+  complete = complete && ReadString(_in, record.method) && ReadString(_in, record.path) &&
+      ReadInt(_in, value, 2);
+
+  record.headers.clear();
+  for (uint64_t i = 0; complete && i < value; i++) {
+    std::string key;
+    complete = ReadString(_in, key) && ReadString(_in, record.headers[key]);
+  }
+
+  complete = complete && ReadInt(_in, value, 1) && ReadInt(_in, record.body_length, 8);
+  record.body_kind = (TrafficBodies)value;
+  record.body.clear();
+  if (complete && record.body_kind != TrafficBodies::NONE) {
+    complete = ReadString(_in, record.body);
+  }
+
+  if (!complete) {
+    throw std::runtime_error("Truncated traffic log");
+  }
+  return true;
+}
+
+RecordedRequest::RecordedRequest(const char* method, const std::string& path,
+    const header_t& headers) : _recording(TrafficRecorder::Instance()->Active()),
+    _start_ns(0)
+{
+  if (!_recording) {
+    return;
+  }
+
+  _start_ns = TrafficRecorder::NowNanos();
+  _record.method = method;
+  _record.path = path;
+  _record.headers = headers;
+  // Header names are case insensitive, so "authorization" is a credential too.
+  for (header_t::iterator header = _record.headers.begin(); header != _record.headers.end(); ) {
+    if (header->first.size() == RECORDED_AUTHORIZATION_HEADER.size() &&
+        std::equal(header->first.begin(), header->first.end(),
+            RECORDED_AUTHORIZATION_HEADER.begin(), [](char a, char b) {
+          return std::tolower((unsigned char)a) == std::tolower((unsigned char)b);
+        })) {
+      header = _record.headers.erase(header);
+    } else {
+      ++header;
+    }
+  }
+}
+
+RecordedRequest::~RecordedRequest() {
+  if (!_recording) {
+    return;
+  }
+
+  TrafficRecorder* recorder = TrafficRecorder::Instance();
+  uint64_t now = TrafficRecorder::NowNanos();
+  uint64_t started = recorder->StartedNanos();
+  _record.offset_ns = _start_ns > started ? _start_ns - started : 0;
+  _record.duration_ns = now - _start_ns;
+  recorder->Write(_record);
+}
+
+void RecordedRequest::Body(const std::string& body) {
+  if (!_recording) {
+    return;
+  }
+
+  _record.body_length = body.size();
+  _record.body_kind = TrafficRecorder::Instance()->Bodies();
+  if (_record.body_kind == TrafficBodies::FULL) {
+    _record.body = body;
+  } else if (_record.body_kind == TrafficBodies::HASH) {
+    MLCrypto crypto;
+    _record.body = crypto.Md5(body);
+  }
+}
+
+void RecordedRequest::BodyLength(const uint64_t& length) {
+  if (!_recording) {
+    return;
+  }
+
+  _record.body_length = length;
+  _record.body_kind = TrafficBodies::NONE;
+  _record.body.clear();
+}
+
+void RecordedRequest::Status(const ResponseCodes& code) {
+  _record.status = (uint16_t)code;
+}
@@ -0,0 +1,218 @@
+/*
+ * File:   TrafficRecorder.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef TRAFFICRECORDER_HPP
+#define	TRAFFICRECORDER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#include "ResponseCodes.hpp"
+#include "Types.hpp"
+
+///
+/// How much of each request body the recorder keeps.
+///
+enum class TrafficBodies {
+    NONE,   /*!< Length only */
+    HASH,   /*!< Length and MD5, for spotting repeated payloads */
+    FULL    /*!< The whole body */
+};
+
+///
+/// One request as the recorder saw it.
+///
+struct TrafficRecord {
+    uint64_t      offset_ns;    /*!< Start time, from when recording started */
+    uint64_t      duration_ns;  /*!< Time until the response was parsed */
+    uint16_t      status;       /*!< The HTTP status, 0 if the request failed */
+    std::string   method;
+    std::string   path;
+    header_t      headers;      /*!< Caller supplied headers, without Authorization */
+    TrafficBodies body_kind;
+    uint64_t      body_length;
+    std::string   body;         /*!< The MD5 for HASH, the body for FULL */
+
+    TrafficRecord();
+};
+
+///
+/// Records the requests made through AuthenticatingProxy to a compact binary
+/// log, so a production access pattern can be replayed offline with
+/// mlcppreplay.  Off until Start is called; while off the cost to a request
+/// is one atomic load.
+///
+/// The log is a "MLTR" magic and a version number followed by one record per
+/// request.  Integers are little endian and strings are a 32 bit length
+/// followed by the bytes.  Authorization headers are never written.
+///
+class TrafficRecorder {
+    std::atomic<bool> _active;
+    mutable std::mutex _mutex;
+    std::ofstream _out;
+    TrafficBodies _bodies;
+    uint64_t _started_ns;
+    uint64_t _records;
+
+    TrafficRecorder();
+    TrafficRecorder(const TrafficRecorder& orig);
+    TrafficRecorder& operator=(const TrafficRecorder& orig);
+public:
+    static const uint32_t VERSION = 1;
+
+    ///
+    /// Returns the process wide recorder.
+    ///
+    /// \return The recorder
+    ///
+    static TrafficRecorder* Instance(void);
+
+    ///
+    /// Starts recording.
+    ///
+    /// \param file_path The log to write, truncated if it exists
+    /// \param bodies How much of each body to keep
+    /// \return False if already started or the file could not be opened
+    ///
+    bool Start(const std::string& file_path, const TrafficBodies& bodies = TrafficBodies::HASH);
+
+    ///
+    /// Stops recording and closes the log.
+    ///
+    void Stop(void);
+
+    ///
+    /// Returns whether requests are being recorded.
+    ///
+    /// \return True if started
+    ///
+    bool Active(void) const {
+        return _active.load(std::memory_order_relaxed);
+    }
+
+    ///
+    /// Returns how much of each body is kept.
+    ///
+    /// \return The setting passed to Start
+    ///
+    TrafficBodies Bodies(void) const;
+
+    ///
+    /// Returns the number of records written since Start.
+    ///
+    /// \return The count
+    ///
+    uint64_t Records(void) const;
+
+    ///
+    /// Returns the time recording started.
+    ///
+    /// \return Steady clock nanoseconds
+    ///
+    uint64_t StartedNanos(void) const;
+
+    ///
+    /// Appends a record to the log.
+    ///
+    /// \param record The record
+    ///
+    void Write(const TrafficRecord& record);
+
+    ///
+    /// Returns the steady clock used for record timing.
+    ///
+    /// \return Nanoseconds
+    ///
+    static uint64_t NowNanos(void);
+};
+
+///
+/// Reads a log written by TrafficRecorder, one record at a time.
+///
+class TrafficReader {
+    std::ifstream _in;
+    uint32_t _version;
+public:
+    ///
+    /// Opens a log.  Throws std::runtime_error if the file cannot be read or
+    /// is not a traffic log.
+    ///
+    /// \param file_path The log
+    ///
+    explicit TrafficReader(const std::string& file_path);
+
+    ///
+    /// Reads the next record.
+    ///
+    /// \param record Filled in with the record
+    /// \return False at the end of the log
+    ///
+    bool Next(TrafficRecord& record);
+};
+
+///
+/// Captures one proxy request for the TrafficRecorder.  Does nothing unless
+/// the recorder is active.
+///
+class RecordedRequest {
+    bool _recording;
+    uint64_t _start_ns;
+    TrafficRecord _record;
+
+    RecordedRequest(const RecordedRequest& orig);
+    RecordedRequest& operator=(const RecordedRequest& orig);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param method The HTTP method
+    /// \param path The path and query
+    /// \param headers The caller supplied headers
+    ///
+    RecordedRequest(const char* method, const std::string& path, const header_t& headers);
+
+    ///
+    /// Writes the record.
+    ///
+    ~RecordedRequest();
+
+    ///
+    /// Returns whether the request is being recorded, so callers can skip
+    /// serializing a body that will not be kept.
+    ///
+    /// \return True if recording
+    ///
+    bool Recording(void) const {
+        return _recording;
+    }
+
+    ///
+    /// Records the body that was sent.
+    ///
+    /// \param body The serialized body
+    ///
+    void Body(const std::string& body);
+
+    ///
+    /// Records the length of a body whose bytes are not at hand, such as a
+    /// file streamed from disk.  Replay sends a body of that length.
+    ///
+    /// \param length The length in bytes
+    ///
+    void BodyLength(const uint64_t& length);
+
+    ///
+    /// Records the response status.
+    ///
+    /// \param code The status
+    ///
+    void Status(const ResponseCodes& code);
+};
+
+#endif	/* TRAFFICRECORDER_HPP */
@@ -0,0 +1,160 @@
+/*
+ * File:   Transaction.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Transaction.hpp"
+
+#include <cpprest/http_client.h>
+
+#include "AuthenticatingProxy.hpp"
+#include "Logger.hpp"
+
+const std::string HOST_ID_COOKIE = "HostId";
+
+TransactionException::TransactionException(const std::string& message) : _message(message) {
+
+}
+
+const char* TransactionException::what() const throw() {
+  return _message.c_str();
+}
+
+Transaction::Transaction(AuthenticatingProxy& proxy, const std::string& host,
+    const std::string& name, const uint32_t& time_limit) :
+    _proxy(new AuthenticatingProxy(proxy.Dedicated())), _host(host), _open(false)
+{
+  std::string path = "/v1/transactions";
+  std::string separator = "?";
+  if (!name.empty()) {
+    path += separator + "name=" + web::uri::encode_data_string(name);
+    separator = "&";
+  }
+  if (time_limit > 0) {
+    path += separator + "timeLimit=" + std::to_string(time_limit);
+  }
+
+  Response response = _proxy->Post(_host, path, web::json::value::object());
+  ResponseCodes code = response.GetResponseCode();
+  if (code != ResponseCodes::SEE_OTHER && code != ResponseCodes::OK &&
+      code != ResponseCodes::CREATED) {
+    throw TransactionException("Could not start a transaction, status " +
+        std::to_string((int)code));
+  }
+
+  // The txid is the last segment of the Location, /v1/transactions/{txid}.
+  std::string location = response.Header("Location");
+  size_t slash = location.rfind('/');
+  if (slash != std::string::npos) {
+    _id = location.substr(slash + 1);
+  }
+  if (_id.empty()) {
+    throw TransactionException("The server did not return a transaction id");
+  }
+
+  std::string cookie = response.Header("Set-Cookie");
+  size_t found = cookie.find(HOST_ID_COOKIE + "=");
+  if (found != std::string::npos) {
+    found += HOST_ID_COOKIE.size() + 1;
+    _host_id = cookie.substr(found, cookie.find_first_of(";,", found) - found);
+  }
+
+  _open = true;
+  MLLOG(LogLevel::FINE).Message("Transaction started").Field("txid", _id)
+      .Field("host", _host);
+}
+
+Transaction::~Transaction() {
+  if (!_open) {
+    return;
+  }
+  try {
+    Abandon();
+  } catch (const std::exception& e) {
+    MLLOG(LogLevel::WARNING).Message("Could not abandon the transaction; the server will "
+        "when its time limit expires").Field("txid", _id).Field("error", e.what());
+  }
+}
+
+const std::string& Transaction::Id(void) const {
+  return _id;
+}
+
+bool Transaction::Open(void) const {
+  return _open;
+}
+
+header_t Transaction::WithAffinity(const header_t& headers) const {
+  header_t result = headers;
+  if (!_host_id.empty()) {
+    std::string& cookie = result["Cookie"];
+    cookie += (cookie.empty() ? "" : "; ") + HOST_ID_COOKIE + "=" + _host_id;
+  }
+  return result;
+}
+
+Response Transaction::Get(const std::string& path, const header_t& headers) {
+  if (!_open) {
+    throw TransactionException("Transaction " + _id + " is not open");
+  }
+  return _proxy->Get(_host, WithTxid(path, _id), WithAffinity(headers));
+}
+
+Response Transaction::Post(const std::string& path, const web::json::value& body,
+    const header_t& headers)
+{
+  if (!_open) {
+    throw TransactionException("Transaction " + _id + " is not open");
+  }
+  return _proxy->Post(_host, WithTxid(path, _id), body, WithAffinity(headers));
+}
+
+Response Transaction::Put(const std::string& path, const web::json::value& body,
+    const header_t& headers)
+{
+  if (!_open) {
+    throw TransactionException("Transaction " + _id + " is not open");
+  }
+  return _proxy->Put(_host, WithTxid(path, _id), body, WithAffinity(headers));
+}
+
+Response Transaction::Delete(const std::string& path, const header_t& headers) {
+  if (!_open) {
+    throw TransactionException("Transaction " + _id + " is not open");
+  }
+  return _proxy->Delete(_host, WithTxid(path, _id), WithAffinity(headers));
+}
+
+void Transaction::Finish(const std::string& result) {
+  if (!_open) {
+    throw TransactionException("Transaction " + _id + " is not open");
+  }
+
+  Response response = _proxy->Post(_host, "/v1/transactions/" +
+      web::uri::encode_data_string(_id) + "?result=" + result, web::json::value::object(),
+      WithAffinity(header_t()));
+  ResponseCodes code = response.GetResponseCode();
+  if (code != ResponseCodes::NO_CONTENT && code != ResponseCodes::OK) {
+    // Left open, so the destructor still abandons it after a failed commit.
+    throw TransactionException("Could not " + result + " transaction " + _id +
+        ", status " + std::to_string((int)code));
+  }
+
+  _open = false;
+  MLLOG(LogLevel::FINE).Message("Transaction finished").Field("txid", _id)
+      .Field("result", result);
+}
+
+void Transaction::Commit(void) {
+  Finish("commit");
+}
+
+void Transaction::Abandon(void) {
+  Finish("rollback");
+}
+
+std::string Transaction::WithTxid(const std::string& path, const std::string& id) {
+  return path + (path.find('?') == std::string::npos ? "?" : "&") + "txid=" +
+      web::uri::encode_data_string(id);
+}
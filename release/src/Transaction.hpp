@@ -0,0 +1,163 @@
+/*
+ * File:   Transaction.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef TRANSACTION_HPP
+#define	TRANSACTION_HPP
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+
+#include <cpprest/json.h>
+
+#include "Response.hpp"
+#include "Types.hpp"
+
+class AuthenticatingProxy;
+
+///
+/// Thrown when a transaction cannot be started, committed or used.
+///
+class TransactionException : public std::exception {
+    std::string _message;
+public:
+    explicit TransactionException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// A multi-statement transaction, started with POST /v1/transactions.
+///
+/// Requests made through the transaction carry its txid, so their updates
+/// are only seen by the transaction until Commit.  MarkLogic keeps a
+/// transaction on the host that started it, so every request goes to the
+/// host given here and sends back the HostId cookie the server set, which
+/// load balancers in front of a cluster use to route to that host.  The
+/// requests go through a dedicated copy of the proxy, so they share one
+/// connection for the transaction's lifetime.  A transaction still open
+/// when it goes out of scope is abandoned.
+///
+///     {
+///         Transaction txn(proxy, "http://localhost:8000");
+///         for (auto& order : orders) {
+///             txn.Put("/v1/documents?uri=" + order.uri, order.json);
+///         }
+///         txn.Commit();
+///     }   // Abandoned here instead if a Put threw
+///
+/// Batching many writes into one transaction pays for one commit instead
+/// of one per document.  A transaction is for use by one thread at a time.
+///
+class Transaction {
+    std::unique_ptr<AuthenticatingProxy> _proxy;    /*!< A dedicated copy of the caller's */
+    std::string _host;
+    std::string _id;
+    std::string _host_id;   /*!< The HostId cookie, if the server sent one */
+    bool _open;
+
+    Transaction(const Transaction& orig);
+    Transaction& operator=(const Transaction& orig);
+
+    header_t WithAffinity(const header_t& headers) const;
+    void Finish(const std::string& result);
+public:
+    ///
+    /// Starts a transaction.  Throws TransactionException if the server
+    /// does not.
+    ///
+    /// \param proxy The proxy whose stages and credentials to use
+    /// \param host The server ("http://localhost:8000")
+    /// \param name An optional name, shown in the server's status pages
+    /// \param time_limit Seconds before the server abandons the
+    ///        transaction, 0 for the server's default
+    ///
+    Transaction(AuthenticatingProxy& proxy, const std::string& host,
+                const std::string& name = std::string(),
+                const uint32_t& time_limit = 0);
+
+    ///
+    /// Destructor.  Abandons the transaction if it is still open.
+    ///
+    ~Transaction();
+
+    ///
+    /// Returns the transaction id.
+    ///
+    /// \return The txid
+    ///
+    const std::string& Id(void) const;
+
+    ///
+    /// Returns true until the transaction is committed or abandoned.
+    ///
+    /// \return True if open
+    ///
+    bool Open(void) const;
+
+    ///
+    /// Invokes a GET inside the transaction.
+    ///
+    /// \param path The path ("/v1/documents?uri=/foo/bar.json")
+    /// \param headers The HTTP headers to include
+    /// \return The Response
+    ///
+    Response Get(const std::string& path, const header_t& headers = header_t());
+
+    ///
+    /// Invokes a POST inside the transaction.
+    ///
+    /// \param path The path
+    /// \param body The body
+    /// \param headers The HTTP headers to include
+    /// \return The Response
+    ///
+    Response Post(const std::string& path, const web::json::value& body,
+                  const header_t& headers = header_t());
+
+    ///
+    /// Invokes a PUT inside the transaction.
+    ///
+    /// \param path The path
+    /// \param body The body
+    /// \param headers The HTTP headers to include
+    /// \return The Response
+    ///
+    Response Put(const std::string& path, const web::json::value& body,
+                 const header_t& headers = header_t());
+
+    ///
+    /// Invokes a DELETE inside the transaction.
+    ///
+    /// \param path The path
+    /// \param headers The HTTP headers to include
+    /// \return The Response
+    ///
+    Response Delete(const std::string& path, const header_t& headers = header_t());
+
+    ///
+    /// Commits the transaction.  Throws TransactionException if it is not
+    /// open or the server refuses.
+    ///
+    void Commit(void);
+
+    ///
+    /// Abandons (rolls back) the transaction.  Throws TransactionException
+    /// if it is not open or the server refuses.
+    ///
+    void Abandon(void);
+
+    ///
+    /// Adds a txid parameter to a request path.
+    ///
+    /// \param path The path, with or without a query string
+    /// \param id The txid
+    /// \return The path with the parameter
+    ///
+    static std::string WithTxid(const std::string& path, const std::string& id);
+};
+
+#endif	/* TRANSACTION_HPP */
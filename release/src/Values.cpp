@@ -0,0 +1,379 @@
+/*
+ * File:   Values.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "Values.hpp"
+
+#include <algorithm>
+#include <cpprest/http_client.h>
+
+#include "AuthenticatingProxy.hpp"
+#include "JsonScanner.hpp"
+#include "Logger.hpp"
+
+const uint64_t UNKNOWN_LAST_PAGE = UINT64_MAX;
+
+namespace {
+
+///
+/// Reads a value as text.  Values may be bare scalars or, in some server
+/// versions, objects of the form {"type": "xs:int", "_value": "2"}.
+///
+void ReadValue(JsonScanner& scanner, std::string& value) {
+  value.clear();
+  switch (scanner.Peek()) {
+    case JsonToken::STRING:
+      scanner.ReadString(value);
+      break;
+    case JsonToken::NUMBER:
+      scanner.ReadNumber(value);
+      break;
+    case JsonToken::BOOLEAN:
+      value = scanner.ReadBoolean() ? "true" : "false";
+      break;
+    case JsonToken::NULL_VALUE:
+      scanner.ReadNull();
+      break;
+    case JsonToken::OBJECT: {
+      std::string key;
+      scanner.BeginObject();
+      while (scanner.NextMember(key)) {
+        if (key == "_value") {
+          ReadValue(scanner, value);
+        } else {
+          scanner.Skip();
+        }
+      }
+      break;
+    }
+    default:
+      scanner.Skip();
+  }
+}
+
+void ReadFrequency(JsonScanner& scanner, uint64_t& frequency) {
+  if (scanner.Peek() == JsonToken::NUMBER) {
+    frequency = (uint64_t)scanner.ReadNumber();
+  } else {
+    scanner.Skip();
+  }
+}
+
+///
+/// Reads {"frequency": 1, "_value": "x"} from a values response.
+///
+void ParseDistinctValue(JsonScanner& scanner, ValuesTuple& tuple) {
+  tuple.values.resize(1);
+  if (scanner.Peek() != JsonToken::OBJECT) {
+    ReadValue(scanner, tuple.values[0]);
+    return;
+  }
+
+  std::string key;
+  scanner.BeginObject();
+  while (scanner.NextMember(key)) {
+    if (key == "frequency") {
+      ReadFrequency(scanner, tuple.frequency);
+    } else if (key == "_value") {
+      ReadValue(scanner, tuple.values[0]);
+    } else {
+      scanner.Skip();
+    }
+  }
+}
+
+///
+/// Reads {"frequency": 1, "distinct-value": ["x", 2]} from a tuples response.
+///
+void ParseTuple(JsonScanner& scanner, ValuesTuple& tuple) {
+  std::string key;
+  scanner.BeginObject();
+  while (scanner.NextMember(key)) {
+    if (key == "frequency") {
+      ReadFrequency(scanner, tuple.frequency);
+    } else if (key == "distinct-value" && scanner.Peek() == JsonToken::ARRAY) {
+      scanner.BeginArray();
+      while (scanner.NextElement()) {
+        tuple.values.push_back(std::string());
+        ReadValue(scanner, tuple.values.back());
+      }
+    } else {
+      scanner.Skip();
+    }
+  }
+}
+
+web::json::value RangeSpec(const std::string& property, const std::string& type) {
+  web::json::value range = web::json::value::object();
+  range["type"] = web::json::value::string(type);
+  range["json-property"] = web::json::value::string(property);
+  if (type == "xs:string") {
+    range["collation"] = web::json::value::string("http://marklogic.com/collation/");
+  }
+  return range;
+}
+
+}
+
+ValuesTuple::ValuesTuple() : frequency(0) {
+
+}
+
+void ValuesPage::Parse(const std::string& body, ValuesPage& page) {
+  page = ValuesPage();
+
+  JsonScanner scanner(body.data(), body.size());
+  std::string key;
+  scanner.BeginObject();
+  while (scanner.NextMember(key)) {
+    if (key != "values-response" || scanner.Peek() != JsonToken::OBJECT) {
+      scanner.Skip();
+      continue;
+    }
+
+    scanner.BeginObject();
+    while (scanner.NextMember(key)) {
+      if (key == "name") {
+        ReadValue(scanner, page.name);
+      } else if (key == "type") {
+        ReadValue(scanner, page.type);
+      } else if (key == "distinct-value" && scanner.Peek() == JsonToken::ARRAY) {
+        scanner.BeginArray();
+        while (scanner.NextElement()) {
+          page.tuples.push_back(ValuesTuple());
+          ParseDistinctValue(scanner, page.tuples.back());
+        }
+      } else if (key == "tuple" && scanner.Peek() == JsonToken::ARRAY) {
+        scanner.BeginArray();
+        while (scanner.NextElement()) {
+          page.tuples.push_back(ValuesTuple());
+          ParseTuple(scanner, page.tuples.back());
+        }
+      } else {
+        scanner.Skip();
+      }
+    }
+  }
+}
+
+ValuesException::ValuesException(const std::string& message) : _message(message) {
+
+}
+
+const char* ValuesException::what() const throw() {
+  return _message.c_str();
+}
+
+ValuesQuery::ValuesQuery(const std::string& name) : _name(name), _timestamp(0) {
+
+}
+
+ValuesQuery& ValuesQuery::Text(const std::string& text) {
+  _text = text;
+  return *this;
+}
+
+ValuesQuery& ValuesQuery::Structured(const web::json::value& query) {
+  _structured = query;
+  return *this;
+}
+
+ValuesQuery& ValuesQuery::Options(const web::json::value& options) {
+  _options = options;
+  return *this;
+}
+
+ValuesQuery& ValuesQuery::OptionsName(const std::string& name) {
+  _options_name = name;
+  return *this;
+}
+
+ValuesQuery& ValuesQuery::Timestamp(const uint64_t& timestamp) {
+  _timestamp = timestamp;
+  return *this;
+}
+
+std::string ValuesQuery::Path(const uint64_t& start, const uint64_t& page_length) const {
+  std::string path = "/v1/values/" + web::uri::encode_data_string(_name) +
+      "?format=json&start=" + std::to_string(start) + "&pageLength=" +
+      std::to_string(page_length);
+  if (!_options_name.empty()) {
+    path += "&options=" + web::uri::encode_data_string(_options_name);
+  }
+  if (_timestamp != 0) {
+    path += "&timestamp=" + std::to_string(_timestamp);
+  }
+  return path;
+}
+
+web::json::value ValuesQuery::Body(void) const {
+  web::json::value search = web::json::value::object();
+  if (!_text.empty()) {
+    search["qtext"] = web::json::value::string(_text);
+  }
+  if (!_structured.is_null()) {
+    search["query"] = _structured;
+  }
+  if (!_options.is_null()) {
+    search["options"] = _options;
+  }
+
+  web::json::value body = web::json::value::object();
+  body["search"] = search;
+  return body;
+}
+
+web::json::value ValuesQuery::UriLexicon(const std::string& name) {
+  web::json::value definition = web::json::value::object();
+  definition["name"] = web::json::value::string(name);
+  definition["uri"] = web::json::value::null();
+
+  web::json::value options = web::json::value::object();
+  options["values"] = web::json::value::array();
+  options["values"][0] = definition;
+  return options;
+}
+
+web::json::value ValuesQuery::RangeIndex(const std::string& name, const std::string& property,
+    const std::string& type)
+{
+  web::json::value definition = web::json::value::object();
+  definition["name"] = web::json::value::string(name);
+  definition["range"] = RangeSpec(property, type);
+
+  web::json::value options = web::json::value::object();
+  options["values"] = web::json::value::array();
+  options["values"][0] = definition;
+  return options;
+}
+
+web::json::value ValuesQuery::CoOccurrence(const std::string& name,
+    const std::vector<std::pair<std::string, std::string> >& properties)
+{
+  web::json::value definition = web::json::value::object();
+  definition["name"] = web::json::value::string(name);
+  definition["range"] = web::json::value::array();
+  for (size_t i = 0; i < properties.size(); i++) {
+    definition["range"][i] = RangeSpec(properties[i].first, properties[i].second);
+  }
+
+  web::json::value options = web::json::value::object();
+  options["tuples"] = web::json::value::array();
+  options["tuples"][0] = definition;
+  return options;
+}
+
+ValuesResults::ValuesResults(const std::string& host, const Credentials& credentials,
+    const ValuesQuery& query, const uint64_t& page_length, const unsigned& workers,
+    const ProxyOptions& proxy) : _host(host), _query(query),
+    _page_length(page_length > 0 ? page_length : 1), _workers(workers > 0 ? workers : 1),
+    _proxy(proxy), _next_page(0), _last_page(UNKNOWN_LAST_PAGE),
+    _stopping(false), _position(0), _done(false)
+{
+  for (unsigned worker = 0; worker < _workers; worker++) {
+    _fetchers.push_back(std::thread(&ValuesResults::FetchLoop, this, worker,
+        credentials.Fork()));
+  }
+}
+
+ValuesResults::~ValuesResults() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+  }
+  _changed.notify_all();
+  for (auto& fetcher : _fetchers) {
+    fetcher.join();
+  }
+}
+
+void ValuesResults::FetchLoop(const unsigned worker, Credentials credentials) {
+  AuthenticatingProxy proxy(_proxy);
+  proxy.AddCredentials(credentials);
+  web::json::value body = _query.Body();
+
+  // Worker w fetches pages w, w + workers, ... but never more than workers
+  // pages past the one being read, which bounds the memory held.
+  for (uint64_t page = worker; ; page += _workers) {
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _changed.wait(lock, [this, page]() {
+        return _stopping || !_error.empty() || page > _last_page ||
+            page < _next_page + _workers;
+      });
+      if (_stopping || !_error.empty() || page > _last_page) {
+        return;
+      }
+    }
+
+    Response response = proxy.Post(_host, _query.Path(page * _page_length + 1, _page_length),
+        body);
+    ValuesPage parsed;
+    std::string error;
+    if (response.GetResponseCode() == ResponseCodes::NO_CONTENT) {
+      // The server answers 204 when a page is past the last value.
+    } else if (response.GetResponseCode() != ResponseCodes::OK) {
+      error = "Values request failed with status " +
+          std::to_string((int)response.GetResponseCode());
+    } else {
+      try {
+        ValuesPage::Parse(response.Body(), parsed);
+      } catch (const std::exception& e) {
+        error = std::string("Could not parse values: ") + e.what();
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!error.empty()) {
+        MLLOG(LogLevel::SEVERE).Message("Values page failed")
+            .Field("start", page * _page_length + 1).Field("error", error);
+        if (_error.empty()) {
+          _error = error;
+        }
+      } else {
+        // There is no total, so the first short page ends the scan.
+        if (parsed.tuples.size() < _page_length) {
+          _last_page = std::min(_last_page, page);
+        }
+        _pages[page] = std::move(parsed);
+      }
+    }
+    _changed.notify_all();
+  }
+}
+
+bool ValuesResults::Advance(void) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _changed.wait(lock, [this]() {
+    return !_error.empty() || _next_page > _last_page || _pages.count(_next_page) > 0;
+  });
+  if (!_error.empty()) {
+    throw ValuesException(_error);
+  }
+  if (_next_page > _last_page) {
+    return false;
+  }
+
+  std::map<uint64_t, ValuesPage>::iterator found = _pages.find(_next_page);
+  _current = std::move(found->second);
+  _pages.erase(found);
+  _next_page++;
+  _position = 0;
+  lock.unlock();
+  _changed.notify_all();
+  return true;
+}
+
+bool ValuesResults::Next(ValuesTuple& tuple) {
+  while (_position >= _current.tuples.size()) {
+    if (_done || !Advance()) {
+      _done = true;
+      return false;
+    }
+  }
+  tuple = std::move(_current.tuples[_position++]);
+  return true;
+}
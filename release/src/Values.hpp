@@ -0,0 +1,248 @@
+/*
+ * File:   Values.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef VALUES_HPP
+#define	VALUES_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <cpprest/json.h>
+
+#include "Credentials.hpp"
+#include "Pipeline.hpp"
+
+///
+/// One entry from /v1/values: a single value from a values lexicon, or one
+/// co-occurrence from a tuples lexicon.
+///
+struct ValuesTuple {
+    uint64_t frequency;                 /*!< Fragments the value (or tuple) occurs in */
+    std::vector<std::string> values;    /*!< One value, or one per tuple member; numbers as written */
+
+    ValuesTuple();
+};
+
+///
+/// One page of a /v1/values response.
+///
+struct ValuesPage {
+    std::string name;                   /*!< The values or tuples definition */
+    std::string type;                   /*!< "xs:string", ... or "tuples" */
+    std::vector<ValuesTuple> tuples;
+
+    ///
+    /// Parses a JSON values response in a single pass.  Throws
+    /// JsonParseException if the text is not JSON.
+    ///
+    /// \param body The response body
+    /// \param page Filled in with the page
+    ///
+    static void Parse(const std::string& body, ValuesPage& page);
+};
+
+///
+/// Thrown when a values request fails.
+///
+class ValuesException : public std::exception {
+    std::string _message;
+public:
+    explicit ValuesException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// A request for the values or tuples named by a query options definition,
+/// optionally limited to the documents matching a query.  Sent as a
+/// combined query to POST /v1/values/{name}.
+///
+///     ValuesQuery query("uris");
+///     query.Options(ValuesQuery::UriLexicon("uris")).Text("status:open");
+///
+class ValuesQuery {
+    std::string _name;
+    std::string _text;
+    web::json::value _structured;
+    web::json::value _options;
+    std::string _options_name;
+    uint64_t _timestamp;
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param name The values or tuples definition to read
+    ///
+    explicit ValuesQuery(const std::string& name);
+
+    ///
+    /// Limits the values to documents matching a string query.
+    ///
+    /// \param text The query text
+    /// \return This query
+    ///
+    ValuesQuery& Text(const std::string& text);
+
+    ///
+    /// Limits the values to documents matching a structured query.
+    ///
+    /// \param query The structured query
+    /// \return This query
+    ///
+    ValuesQuery& Structured(const web::json::value& query);
+
+    ///
+    /// Sets the query options that define the values or tuples.
+    ///
+    /// \param options The value of the "options" property
+    /// \return This query
+    ///
+    ValuesQuery& Options(const web::json::value& options);
+
+    ///
+    /// Names persistent query options installed on the server instead.
+    ///
+    /// \param name The options name
+    /// \return This query
+    ///
+    ValuesQuery& OptionsName(const std::string& name);
+
+    ///
+    /// Reads the lexicon at a point in time, so every page sees the same
+    /// values however long the scan takes.
+    ///
+    /// \param timestamp The timestamp, 0 for the latest state
+    /// \return This query
+    ///
+    ValuesQuery& Timestamp(const uint64_t& timestamp);
+
+    ///
+    /// Returns the request path for one page.
+    ///
+    /// \param start The 1 based index of the first value
+    /// \param page_length The number of values
+    /// \return The path and query string
+    ///
+    std::string Path(const uint64_t& start, const uint64_t& page_length) const;
+
+    ///
+    /// Returns the combined query to POST.
+    ///
+    /// \return The body
+    ///
+    web::json::value Body(void) const;
+
+    ///
+    /// Returns options defining the URI lexicon as a values definition.
+    /// The lexicon must be enabled on the database.
+    ///
+    /// \param name The definition's name
+    /// \return The options
+    ///
+    static web::json::value UriLexicon(const std::string& name);
+
+    ///
+    /// Returns options defining a JSON property range index as a values
+    /// definition.
+    ///
+    /// \param name The definition's name
+    /// \param property The indexed JSON property
+    /// \param type The index type ("xs:string", "xs:int", ...); strings use
+    ///        the default collation
+    /// \return The options
+    ///
+    static web::json::value RangeIndex(const std::string& name, const std::string& property,
+                                       const std::string& type = "xs:string");
+
+    ///
+    /// Returns options defining a co-occurrence of JSON property range
+    /// indexes as a tuples definition.
+    ///
+    /// \param name The definition's name
+    /// \param properties The indexed properties and their types, in order
+    /// \return The options
+    ///
+    static web::json::value CoOccurrence(const std::string& name,
+        const std::vector<std::pair<std::string, std::string> >& properties);
+};
+
+///
+/// A lazy iterator over every value of a lexicon.  Pages are fetched by
+/// background workers, each with its own AuthenticatingProxy: worker w
+/// reads pages w, w + workers, w + 2 * workers, ... so the value space is
+/// split between them, and no more than workers pages are held at once
+/// however large the lexicon is.
+///
+///     ValuesResults uris(host, proxy.GetCredentials(),
+///                        ValuesQuery("uris").Options(ValuesQuery::UriLexicon("uris")),
+///                        10000, 4);
+///     ValuesTuple tuple;
+///     while (uris.Next(tuple)) {
+///         Reconcile(tuple.values[0]);
+///     }
+///
+/// Each page is requested by its start offset, which the server must skip
+/// to; for very large lexicons pass a timestamp so the offsets stay stable.
+///
+class ValuesResults {
+    std::string _host;
+    ValuesQuery _query;
+    uint64_t _page_length;
+    unsigned _workers;
+    ProxyOptions _proxy;
+
+    std::mutex _mutex;
+    std::condition_variable _changed;
+    std::map<uint64_t, ValuesPage> _pages;  /*!< Fetched pages not yet read */
+    uint64_t _next_page;                    /*!< The page Next reads after the current one */
+    uint64_t _last_page;                    /*!< Known once a short page arrives */
+    bool _stopping;
+    std::string _error;
+    std::vector<std::thread> _fetchers;
+
+    ValuesPage _current;
+    size_t _position;
+    bool _done;
+
+    ValuesResults(const ValuesResults& orig);
+    ValuesResults& operator=(const ValuesResults& orig);
+
+    void FetchLoop(const unsigned worker, Credentials credentials);
+    bool Advance(void);
+public:
+    ///
+    /// Constructor.  Starts fetching straight away.
+    ///
+    /// \param host The server ("http://localhost:8000")
+    /// \param credentials The credentials; each worker uses a Fork of them
+    /// \param query The values to read
+    /// \param page_length The values per request
+    /// \param workers The number of worker threads, and of pages that may
+    ///        be fetched ahead
+    /// \param proxy The stages of the workers' proxies
+    ///
+    ValuesResults(const std::string& host, const Credentials& credentials,
+                  const ValuesQuery& query, const uint64_t& page_length = 1000,
+                  const unsigned& workers = 2, const ProxyOptions& proxy = ProxyOptions());
+    ~ValuesResults();
+
+    ///
+    /// Returns the next value, waiting for its page if needed.  Throws
+    /// ValuesException if a page could not be fetched.
+    ///
+    /// \param tuple Set to the value
+    /// \return False when there are no more values
+    ///
+    bool Next(ValuesTuple& tuple);
+};
+
+#endif	/* VALUES_HPP */
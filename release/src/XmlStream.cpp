@@ -0,0 +1,271 @@
+/*
+ * File:   XmlStream.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "XmlStream.hpp"
+
+namespace {
+
+///
+/// Where an output buffer writes, and why it stopped if it did.
+///
+struct Output {
+  const XmlSink& sink;
+  std::string error;
+
+  explicit Output(const XmlSink& sink) : sink(sink) {
+  }
+};
+
+int WriteOutput(void* context, const char* data, int size) {
+  Output* output = (Output*)context;
+  try {
+    output->sink(data, (size_t)size);
+    return size;
+  } catch (const std::exception& e) {
+    output->error = e.what();
+    return -1;
+  }
+}
+
+int CloseOutput(void* context) {
+  return 0;
+}
+
+xmlOutputBufferPtr CreateOutput(Output& output) {
+  xmlOutputBufferPtr buffer = xmlOutputBufferCreateIO(WriteOutput, CloseOutput, &output, nullptr);
+  if (buffer == nullptr) {
+    throw XmlWriteException("Could not create an XML output buffer");
+  }
+  return buffer;
+}
+
+void Fail(const Output& output) {
+  throw XmlWriteException(output.error.empty() ? std::string("Could not write XML") :
+      "Could not write XML: " + output.error);
+}
+
+std::string Copy(const xmlChar* text) {
+  return text == nullptr ? std::string() : std::string((const char*)text);
+}
+
+///
+/// Copies text that libxml2 allocated, and frees it.
+///
+std::string Take(xmlChar* text) {
+  std::string copy = Copy(text);
+  if (text != nullptr) {
+    xmlFree(text);
+  }
+  return copy;
+}
+
+}
+
+XmlParseException::XmlParseException(const std::string& message) : _message(message) {
+
+}
+
+const char* XmlParseException::what() const throw() {
+  return _message.c_str();
+}
+
+XmlWriteException::XmlWriteException(const std::string& message) : _message(message) {
+
+}
+
+const char* XmlWriteException::what() const throw() {
+  return _message.c_str();
+}
+
+void XmlOutput::WriteDocument(const xmlDocPtr& document, const XmlSink& sink) {
+  if (document == nullptr) {
+    return;
+  }
+  Output output(sink);
+  if (xmlSaveFormatFileTo(CreateOutput(output), document, "UTF-8", 0) < 0) {
+    Fail(output);
+  }
+}
+
+void XmlOutput::WriteBody(const XmlBodyWriter& write, const XmlSink& sink) {
+  Output output(sink);
+  xmlOutputBufferPtr buffer = CreateOutput(output);
+  xmlTextWriterPtr writer = xmlNewTextWriter(buffer);
+  if (writer == nullptr) {
+    xmlOutputBufferClose(buffer);
+    throw XmlWriteException("Could not create an XML writer");
+  }
+
+  int result = xmlTextWriterStartDocument(writer, nullptr, "UTF-8", nullptr);
+  try {
+    write(writer);
+  } catch (...) {
+    xmlFreeTextWriter(writer);
+    throw;
+  }
+  if (result >= 0) {
+    result = xmlTextWriterEndDocument(writer);
+  }
+  // Flushes what is left, so the sink can still fail here.
+  xmlFreeTextWriter(writer);
+  if (result < 0 || !output.error.empty()) {
+    Fail(output);
+  }
+}
+
+XmlReader::XmlReader(const char* data, const size_t& size) : _reader(nullptr), _held(false) {
+  _reader = xmlReaderForMemory(data, (int)size, nullptr, nullptr, XML_PARSE_NONET);
+  Open();
+}
+
+XmlReader::XmlReader(const XmlSource& source) : _source(source), _reader(nullptr), _held(false) {
+  _reader = xmlReaderForIO(ReadSource, CloseSource, this, nullptr, nullptr, XML_PARSE_NONET);
+  Open();
+}
+
+XmlReader::XmlReader(const Concurrency::streams::istream& stream) : _reader(nullptr),
+    _held(false)
+{
+  Concurrency::streams::streambuf<uint8_t> buffer = stream.streambuf();
+  _source = [buffer](char* data, const size_t& size) mutable {
+    return buffer.getn((uint8_t*)data, size).get();
+  };
+  _reader = xmlReaderForIO(ReadSource, CloseSource, this, nullptr, nullptr, XML_PARSE_NONET);
+  Open();
+}
+
+XmlReader::~XmlReader() {
+  if (_reader != nullptr) {
+    xmlFreeTextReader(_reader);
+  }
+}
+
+void XmlReader::Open(void) {
+  if (_reader == nullptr) {
+    throw XmlParseException(_error.empty() ? std::string("Could not start reading XML") : _error);
+  }
+  xmlTextReaderSetErrorHandler(_reader, ReportError, this);
+}
+
+bool XmlReader::Advance(const int& result) {
+  if (result < 0) {
+    throw XmlParseException(_error.empty() ? std::string("Malformed XML") : _error);
+  }
+  return result == 1;
+}
+
+int XmlReader::ReadSource(void* context, char* buffer, int size) {
+  XmlReader* reader = (XmlReader*)context;
+  try {
+    return (int)reader->_source(buffer, (size_t)size);
+  } catch (const std::exception& e) {
+    reader->_error = std::string("Could not read XML: ") + e.what();
+    return -1;
+  }
+}
+
+int XmlReader::CloseSource(void* context) {
+  return 0;
+}
+
+void XmlReader::ReportError(void* context, const char* message, xmlParserSeverities severity,
+    xmlTextReaderLocatorPtr locator)
+{
+  XmlReader* reader = (XmlReader*)context;
+  if (!reader->_error.empty() || severity == XML_PARSER_SEVERITY_WARNING ||
+      severity == XML_PARSER_SEVERITY_VALIDITY_WARNING) {
+    return;
+  }
+  reader->_error = message == nullptr ? "Malformed XML" : message;
+  while (!reader->_error.empty() && (reader->_error.back() == '\n' || reader->_error.back() == ' ')) {
+    reader->_error.pop_back();
+  }
+  if (locator != nullptr) {
+    reader->_error += " at line " + std::to_string(xmlTextReaderLocatorLineNumber(locator));
+  }
+}
+
+bool XmlReader::Next(void) {
+  if (_held) {
+    _held = false;
+    return Type() != XmlNodeType::NONE;
+  }
+  return Advance(xmlTextReaderRead(_reader));
+}
+
+bool XmlReader::NextElement(void) {
+  while (Next()) {
+    if (Type() == XmlNodeType::ELEMENT) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool XmlReader::Skip(void) {
+  _held = Advance(xmlTextReaderNext(_reader));
+  return _held;
+}
+
+XmlNodeType XmlReader::Type(void) const {
+  switch (xmlTextReaderNodeType(_reader)) {
+    case XML_READER_TYPE_NONE: return XmlNodeType::NONE;
+    case XML_READER_TYPE_ELEMENT: return XmlNodeType::ELEMENT;
+    case XML_READER_TYPE_END_ELEMENT: return XmlNodeType::END_ELEMENT;
+    case XML_READER_TYPE_TEXT: return XmlNodeType::TEXT;
+    case XML_READER_TYPE_CDATA: return XmlNodeType::CDATA;
+    case XML_READER_TYPE_WHITESPACE:
+    case XML_READER_TYPE_SIGNIFICANT_WHITESPACE: return XmlNodeType::WHITESPACE;
+    case XML_READER_TYPE_COMMENT: return XmlNodeType::COMMENT;
+    default: return XmlNodeType::OTHER;
+  }
+}
+
+std::string XmlReader::Name(void) const {
+  return Copy(xmlTextReaderConstLocalName(_reader));
+}
+
+std::string XmlReader::NamespaceUri(void) const {
+  return Copy(xmlTextReaderConstNamespaceUri(_reader));
+}
+
+int XmlReader::Depth(void) const {
+  return xmlTextReaderDepth(_reader);
+}
+
+bool XmlReader::Empty(void) const {
+  return xmlTextReaderIsEmptyElement(_reader) == 1;
+}
+
+std::string XmlReader::Value(void) const {
+  return Copy(xmlTextReaderConstValue(_reader));
+}
+
+std::string XmlReader::Attribute(const std::string& name) const {
+  return Take(xmlTextReaderGetAttribute(_reader, BAD_CAST name.c_str()));
+}
+
+std::string XmlReader::Text(void) {
+  return Take(xmlTextReaderReadString(_reader));
+}
+
+xmlDocPtr XmlReader::Subtree(void) {
+  if (Type() != XmlNodeType::ELEMENT) {
+    throw XmlParseException("The reader is not on an element");
+  }
+  xmlNodePtr node = xmlTextReaderExpand(_reader);
+  if (node == nullptr) {
+    Advance(-1);
+  }
+  xmlDocPtr document = xmlNewDoc(BAD_CAST "1.0");
+  xmlNodePtr copy = xmlDocCopyNode(node, document, 1);
+  if (copy == nullptr) {
+    xmlFreeDoc(document);
+    throw XmlParseException("Could not copy the element");
+  }
+  xmlDocSetRootElement(document, copy);
+  return document;
+}
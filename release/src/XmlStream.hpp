@@ -0,0 +1,238 @@
+/*
+ * File:   XmlStream.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef XMLSTREAM_HPP
+#define	XMLSTREAM_HPP
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <cpprest/http_client.h>
+#include <libxml/tree.h>
+#include <libxml/xmlreader.h>
+#include <libxml/xmlwriter.h>
+
+///
+/// Receives XML as it is written, a piece at a time.
+///
+typedef std::function<void(const char* data, const size_t& size)> XmlSink;
+
+///
+/// Writes an XML body with a libxml2 text writer as it is sent.  The
+/// document is started before it is called, and ended, closing any open
+/// elements, after.
+///
+///     XmlBodyWriter write = [&orders](xmlTextWriterPtr writer) {
+///         xmlTextWriterStartElement(writer, BAD_CAST "orders");
+///         for (auto& order : orders) {
+///             xmlTextWriterWriteElement(writer, BAD_CAST "id", BAD_CAST order.id.c_str());
+///         }
+///     };
+///     proxy.Send(host, Request<XmlBodyWriter>(RequestMethod::PUT, path, write));
+///
+typedef std::function<void(xmlTextWriterPtr writer)> XmlBodyWriter;
+
+///
+/// Thrown when XML cannot be read.
+///
+class XmlParseException : public std::exception {
+    std::string _message;
+public:
+    explicit XmlParseException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// Thrown when XML cannot be written.
+///
+class XmlWriteException : public std::exception {
+    std::string _message;
+public:
+    explicit XmlWriteException(const std::string& message);
+    virtual const char* what() const throw() override;
+};
+
+///
+/// Serializes XML through a libxml2 output buffer into a sink, so it is
+/// never held whole.
+///
+class XmlOutput {
+public:
+    ///
+    /// Writes a document, in UTF-8 with an XML declaration.  Writes nothing
+    /// for a null document.  Throws XmlWriteException if libxml2 fails or
+    /// the sink throws.
+    ///
+    /// \param document The document
+    /// \param sink Receives the text
+    ///
+    static void WriteDocument(const xmlDocPtr& document, const XmlSink& sink);
+
+    ///
+    /// Writes the document that write produces.  Throws XmlWriteException
+    /// if libxml2 fails or the sink throws, and passes on what write throws.
+    ///
+    /// \param write Writes the body
+    /// \param sink Receives the text
+    ///
+    static void WriteBody(const XmlBodyWriter& write, const XmlSink& sink);
+};
+
+///
+/// The kinds of node an XmlReader stops on.
+///
+enum class XmlNodeType { NONE, ELEMENT, END_ELEMENT, TEXT, CDATA, WHITESPACE, COMMENT, OTHER };
+
+///
+/// Supplies XML to an XmlReader: fills up to size bytes of buffer and
+/// returns how many it filled, 0 at the end.
+///
+typedef std::function<size_t(char* buffer, const size_t& size)> XmlSource;
+
+///
+/// A pull parser over XML, built on the libxml2 text reader.  It holds the
+/// node it is on and little else, so however large the document, memory
+/// stays flat when it is read from a stream.  Where a DOM is handier for a
+/// piece of it, Subtree copies out the element the reader is on.
+///
+///     XmlReader reader(response.Body().data(), response.Body().size());
+///     while (reader.NextElement()) {
+///         if (reader.Name() == "result") {
+///             uris.push_back(reader.Attribute("uri"));
+///         }
+///     }
+///
+/// Names are local names; NamespaceUri gives the namespace.  Entities are
+/// not expanded and nothing is fetched from the network.
+///
+class XmlReader {
+    XmlSource _source;
+    xmlTextReaderPtr _reader;
+    std::string _error;         /*!< The first error libxml2 reported */
+    bool _held;                 /*!< Skip has moved to the node Next returns */
+
+    XmlReader(const XmlReader& orig);
+    XmlReader& operator=(const XmlReader& orig);
+
+    void Open(void);
+    bool Advance(const int& result);
+
+    static int ReadSource(void* context, char* buffer, int size);
+    static int CloseSource(void* context);
+    static void ReportError(void* context, const char* message, xmlParserSeverities severity,
+                            xmlTextReaderLocatorPtr locator);
+public:
+    ///
+    /// Constructor for XML in memory, which is read in place and must
+    /// outlive the reader.
+    ///
+    /// \param data The text
+    /// \param size Its length in bytes
+    ///
+    XmlReader(const char* data, const size_t& size);
+
+    ///
+    /// Constructor for XML read a piece at a time.
+    ///
+    /// \param source Supplies the text
+    ///
+    explicit XmlReader(const XmlSource& source);
+
+    ///
+    /// Constructor for XML read from a stream, such as the body given to
+    /// AuthenticatingProxy::Stream.
+    ///
+    /// \param stream The stream
+    ///
+    explicit XmlReader(const Concurrency::streams::istream& stream);
+
+    virtual ~XmlReader();
+
+    ///
+    /// Moves to the next node in document order.  Throws XmlParseException
+    /// if the XML is malformed.
+    ///
+    /// \return False at the end of the document
+    ///
+    bool Next(void);
+
+    ///
+    /// Moves to the next start tag.
+    ///
+    /// \return False at the end of the document
+    ///
+    bool NextElement(void);
+
+    ///
+    /// Moves past the element the reader is on and everything in it.  The
+    /// next call to Next or NextElement starts from the node after its end
+    /// tag, so a loop over NextElement does not miss a sibling.
+    ///
+    /// \return False at the end of the document
+    ///
+    bool Skip(void);
+
+    XmlNodeType Type(void) const;
+
+    ///
+    /// Returns the local name of the element the reader is on.
+    ///
+    /// \return The name, without a prefix
+    ///
+    std::string Name(void) const;
+
+    std::string NamespaceUri(void) const;
+
+    ///
+    /// Returns how deep the node is; the root element is 0.
+    ///
+    /// \return The depth
+    ///
+    int Depth(void) const;
+
+    ///
+    /// Returns whether the element the reader is on is written <a/>, in
+    /// which case no END_ELEMENT follows it.
+    ///
+    /// \return Whether it is empty
+    ///
+    bool Empty(void) const;
+
+    ///
+    /// Returns the text of a text, CDATA, whitespace or comment node.
+    ///
+    /// \return The text
+    ///
+    std::string Value(void) const;
+
+    ///
+    /// Returns an attribute of the element the reader is on.
+    ///
+    /// \param name The attribute's name as written ("xml:lang")
+    /// \return The value, empty if it is not there
+    ///
+    std::string Attribute(const std::string& name) const;
+
+    ///
+    /// Returns all the text in the element the reader is on, leaving the
+    /// reader where it is.
+    ///
+    /// \return The text
+    ///
+    std::string Text(void);
+
+    ///
+    /// Copies the element the reader is on, and everything in it, into a
+    /// document of its own, leaving the reader where it is.  Call Skip to
+    /// move past it.
+    ///
+    /// \return The document, which the caller frees with xmlFreeDoc
+    ///
+    xmlDocPtr Subtree(void);
+};
+
+#endif	/* XMLSTREAM_HPP */
@@ -0,0 +1,184 @@
+/*
+ * File:   AllocationBudgetTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <string>
+#include "AllocationBudgetTest.hpp"
+#include "AllocationCounter.hpp"
+#include "Credentials.hpp"
+#include "Pipeline.hpp"
+#include "Response.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(AllocationBudgetTest);
+
+namespace {
+
+// Allocations per operation.  Each is a little above what the code does
+// today with libstdc++; lower them when an optimization lands.
+const uint64_t SIGNING_BUDGET = 16;         // Credentials::Authenticate
+const uint64_t CHALLENGE_BUDGET = 4;        // ParseWWWAthenticateHeader
+const uint64_t CONTENT_TYPE_BUDGET = 2;     // ParseContentTypeHeader
+const uint64_t HEADERS_BUDGET = 3;          // SetResponseHeaders, per header
+const uint64_t REQUEST_BUDGET = 16;         // Added by the proxy's stages, per GET
+
+const uint64_t ROUNDS = 100;
+
+const std::string CHALLENGE = "Digest realm=\"public\", qop=\"auth\", "
+    "nonce=\"4d8c3f1e2b7a9d6c0e5f8a1b3c7d9e2f\", opaque=\"a9f3c1d7e5b2f4a6\"";
+const std::string PATH = "/v1/documents?uri=/document/test.json";
+
+///
+/// A last stage that answers the way MarkLogic does, without the network:
+/// a challenge to an unsigned request and a small JSON document to a
+/// signed one.
+///
+class CannedServer {
+  std::shared_ptr<header_t> _headers;
+  std::shared_ptr<std::string> _body;
+public:
+  CannedServer() : _headers(new header_t()), _body(new std::string("{\"id\":1,\"name\":\"test\"}")) {
+    header_t& headers = *_headers;
+    headers["Content-type"] = "application/json; charset=UTF-8";
+    headers["Content-Length"] = std::to_string(_body->size());
+    headers["Server"] = "MarkLogic";
+    headers["ETag"] = "\"14063455472381110\"";
+    headers["vnd.marklogic.document-format"] = "json";
+  }
+
+  template<typename Next>
+  void Handle(Exchange& exchange, Next& next) {
+    if (exchange.authorization.empty()) {
+      exchange.response.SetResponseCode(ResponseCodes::UNAUTHORIZED);
+      exchange.response.SetResponseHeaders(header_t({ { "WWW-Authenticate", CHALLENGE } }));
+      return;
+    }
+    exchange.response.SetResponseCode(ResponseCodes::OK);
+    exchange.response.SetResponseHeaders(*_headers);
+    exchange.response.SetBody(*_body);
+  }
+};
+
+///
+/// Stands in for DigestAuthStage with an Authorization header that needs
+/// no signing, so that a pipeline of it and a CannedServer does only the
+/// work every request does whatever its stages.
+///
+class Presigned {
+public:
+  template<typename Next>
+  void Handle(Exchange& exchange, Next& next) {
+    exchange.authorization = "Digest";
+    next.Handle(exchange);
+  }
+};
+
+///
+/// Counts the allocations of a steady state GET through a pipeline.
+///
+template<typename P>
+uint64_t RequestAllocations(P& pipeline) {
+  const std::string host = "http://localhost:8000";
+  Request<NoPayload> request(RequestMethod::GET, PATH, NO_PAYLOAD);
+
+  // The first request takes the digest challenge; the rest are signed up
+  // front, which is the steady state being budgeted.
+  pipeline.Send(host, request);
+
+  AllocationScope scope;
+  for (uint64_t i = 0; i < ROUNDS; i++) {
+    Response response = pipeline.Send(host, request);
+    CPPUNIT_ASSERT(response.GetResponseCode() == ResponseCodes::OK);
+  }
+  return scope.ThreadAllocations();
+}
+
+}
+
+AllocationBudgetTest::AllocationBudgetTest() {
+}
+
+AllocationBudgetTest::AllocationBudgetTest(const AllocationBudgetTest& orig) {
+}
+
+AllocationBudgetTest::~AllocationBudgetTest() {
+}
+
+void AllocationBudgetTest::TestCounter() {
+  AllocationScope scope;
+  char* volatile buffer = new char[100];
+  delete[] buffer;
+
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, scope.ThreadAllocations());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)100, scope.ThreadBytes());
+  CPPUNIT_ASSERT(scope.Allocations() >= 1);
+
+  scope.Reset();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, scope.ThreadAllocations());
+}
+
+void AllocationBudgetTest::TestSigningBudget() {
+  Credentials credentials("admin", "admin", "0a4f113b9e7c2d5f", 0);
+  credentials.ParseWWWAthenticateHeader(CHALLENGE);
+  credentials.Authenticate("GET", PATH);
+
+  AllocationScope scope;
+  for (uint64_t i = 0; i < ROUNDS; i++) {
+    credentials.Authenticate("GET", PATH);
+  }
+  CPPUNIT_ASSERT(scope.ThreadAllocations() <= SIGNING_BUDGET * ROUNDS);
+}
+
+void AllocationBudgetTest::TestHeaderParsingBudget() {
+  Credentials credentials("admin", "admin", "0a4f113b9e7c2d5f", 0);
+  credentials.ParseWWWAthenticateHeader(CHALLENGE);
+
+  AllocationScope scope;
+  for (uint64_t i = 0; i < ROUNDS; i++) {
+    credentials.ParseWWWAthenticateHeader(CHALLENGE);
+  }
+  CPPUNIT_ASSERT(scope.ThreadAllocations() <= CHALLENGE_BUDGET * ROUNDS);
+
+  Response response;
+  const std::string content_type = "application/json; charset=UTF-8";
+  scope.Reset();
+  for (uint64_t i = 0; i < ROUNDS; i++) {
+    response.ParseContentTypeHeader(content_type);
+  }
+  CPPUNIT_ASSERT(scope.ThreadAllocations() <= CONTENT_TYPE_BUDGET * ROUNDS);
+
+  web::http::http_headers headers;
+  headers["Content-type"] = content_type;
+  headers["Content-Length"] = "1024";
+  headers["Server"] = "MarkLogic";
+  headers["Connection"] = "Keep-Alive";
+  headers["Keep-Alive"] = "timeout=5";
+  headers["ETag"] = "\"14063455472381110\"";
+  headers["vnd.marklogic.document-format"] = "json";
+  response.SetResponseHeaders(headers);
+
+  scope.Reset();
+  for (uint64_t i = 0; i < ROUNDS; i++) {
+    response.SetResponseHeaders(headers);
+  }
+  CPPUNIT_ASSERT(scope.ThreadAllocations() <= HEADERS_BUDGET * 7 * ROUNDS);
+  CPPUNIT_ASSERT(response.GetResponseType() == ResponseType::JSON);
+}
+
+void AllocationBudgetTest::TestRequestBudget() {
+  // The stages AuthenticatingProxy sends through, in front of a canned
+  // server.  The transport is left out: what cpprest allocates depends on
+  // its version and its thread pool, and is not this library's to budget.
+  // So is what the Exchange and its Response allocate, such as their
+  // web::json::value, which is counted without the stages and taken off.
+  Pipeline<TimingStage, RecordStage, DigestAuthStage, CannedServer> pipeline(TimingStage(),
+      RecordStage(), DigestAuthStage(Credentials("admin", "admin", "0a4f113b9e7c2d5f", 0)),
+      CannedServer());
+  Pipeline<Presigned, CannedServer> bare;
+
+  uint64_t staged = RequestAllocations(pipeline);
+  uint64_t unstaged = RequestAllocations(bare);
+  CPPUNIT_ASSERT(staged >= unstaged);
+  CPPUNIT_ASSERT(staged - unstaged <= REQUEST_BUDGET * ROUNDS);
+}
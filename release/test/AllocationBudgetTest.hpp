@@ -0,0 +1,38 @@
+/*
+ * File:   AllocationBudgetTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef ALLOCATIONBUDGETTEST_HPP
+#define	ALLOCATIONBUDGETTEST_HPP
+
+///
+/// Puts a ceiling on the heap allocations made by the per-request code
+/// paths, so a change that adds copies fails the build instead of quietly
+/// slowing every request.
+///
+class AllocationBudgetTest : public CppUnit::TestCase {
+public:
+    AllocationBudgetTest();
+    AllocationBudgetTest(const AllocationBudgetTest& orig);
+    virtual ~AllocationBudgetTest();
+
+    void TestCounter();
+    void TestSigningBudget();
+    void TestHeaderParsingBudget();
+    void TestRequestBudget();
+private:
+    CPPUNIT_TEST_SUITE(AllocationBudgetTest);
+    CPPUNIT_TEST(TestCounter);
+    CPPUNIT_TEST(TestSigningBudget);
+    CPPUNIT_TEST(TestHeaderParsingBudget);
+    CPPUNIT_TEST(TestRequestBudget);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* ALLOCATIONBUDGETTEST_HPP */
@@ -0,0 +1,110 @@
+/*
+ * File:   AllocationCounter.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> allocations(0);
+std::atomic<uint64_t> bytes(0);
+
+// Plain integers, so there is no thread_local constructor to run from
+// inside operator new.
+thread_local uint64_t thread_allocations = 0;
+thread_local uint64_t thread_bytes = 0;
+
+void* CountedAllocate(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  bytes.fetch_add(size, std::memory_order_relaxed);
+  thread_allocations++;
+  thread_bytes += size;
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+}
+
+uint64_t AllocationCounter::Allocations(void) {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationCounter::Bytes(void) {
+  return bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationCounter::ThreadAllocations(void) {
+  return thread_allocations;
+}
+
+uint64_t AllocationCounter::ThreadBytes(void) {
+  return thread_bytes;
+}
+
+AllocationScope::AllocationScope() {
+  Reset();
+}
+
+void AllocationScope::Reset(void) {
+  _allocations = AllocationCounter::Allocations();
+  _bytes = AllocationCounter::Bytes();
+  _thread_allocations = AllocationCounter::ThreadAllocations();
+  _thread_bytes = AllocationCounter::ThreadBytes();
+}
+
+uint64_t AllocationScope::Allocations(void) const {
+  return AllocationCounter::Allocations() - _allocations;
+}
+
+uint64_t AllocationScope::Bytes(void) const {
+  return AllocationCounter::Bytes() - _bytes;
+}
+
+uint64_t AllocationScope::ThreadAllocations(void) const {
+  return AllocationCounter::ThreadAllocations() - _thread_allocations;
+}
+
+uint64_t AllocationScope::ThreadBytes(void) const {
+  return AllocationCounter::ThreadBytes() - _thread_bytes;
+}
+
+void* operator new(std::size_t size) {
+  void* memory = CountedAllocate(size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+  std::free(memory);
+}
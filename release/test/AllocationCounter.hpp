@@ -0,0 +1,82 @@
+/*
+ * File:   AllocationCounter.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef ALLOCATIONCOUNTER_HPP
+#define	ALLOCATIONCOUNTER_HPP
+
+#include <cstdint>
+
+///
+/// Heap allocation counts, for tests and benchmarks.  Linking
+/// AllocationCounter.cpp into an executable replaces the global operator new
+/// and delete with versions that count every allocation before handing off
+/// to malloc and free.  Counts are kept both for the whole process and for
+/// each thread.
+///
+class AllocationCounter {
+public:
+    ///
+    /// Returns the number of allocations made by every thread since the
+    /// process started.
+    ///
+    /// \return The count
+    ///
+    static uint64_t Allocations(void);
+
+    ///
+    /// Returns the number of bytes allocated by every thread since the
+    /// process started.
+    ///
+    /// \return The byte count
+    ///
+    static uint64_t Bytes(void);
+
+    ///
+    /// Returns the number of allocations made by the calling thread.
+    ///
+    /// \return The count
+    ///
+    static uint64_t ThreadAllocations(void);
+
+    ///
+    /// Returns the number of bytes allocated by the calling thread.
+    ///
+    /// \return The byte count
+    ///
+    static uint64_t ThreadBytes(void);
+};
+
+///
+/// Counts the allocations made while it is in scope:
+///
+///     AllocationScope scope;
+///     credentials.Authenticate("GET", path);
+///     CPPUNIT_ASSERT(scope.ThreadAllocations() <= 16);
+///
+/// Use the Thread counts for work done on the calling thread.  Use the
+/// process counts when the work is handed to other threads, such as a
+/// request that runs on the cpprest thread pool.
+///
+class AllocationScope {
+    uint64_t _allocations;
+    uint64_t _bytes;
+    uint64_t _thread_allocations;
+    uint64_t _thread_bytes;
+public:
+    AllocationScope();
+
+    ///
+    /// Starts counting again from zero.
+    ///
+    void Reset(void);
+
+    uint64_t Allocations(void) const;
+    uint64_t Bytes(void) const;
+    uint64_t ThreadAllocations(void) const;
+    uint64_t ThreadBytes(void) const;
+};
+
+#endif	/* ALLOCATIONCOUNTER_HPP */
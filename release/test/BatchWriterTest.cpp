@@ -0,0 +1,236 @@
+/*
+ * File:   BatchWriterTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BatchWriterTest.hpp"
+#include "BatchWriter.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BatchWriterTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8390";
+
+std::string Document(const int& i) {
+  return "{\"id\":" + std::to_string(i) + ",\"status\":\"open\"}";
+}
+
+}
+
+BatchWriterTest::BatchWriterTest() {
+
+}
+
+BatchWriterTest::BatchWriterTest(const BatchWriterTest& orig) {
+
+}
+
+BatchWriterTest::~BatchWriterTest() {
+
+}
+
+void BatchWriterTest::TestBatching() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  BatchWriterOptions options;
+  options.max_documents = 50;
+  BatchWriter writer(ADDRESS, Credentials(config.username, config.password), options);
+
+  std::vector<std::thread> producers;
+  std::vector<std::vector<std::future<WriteResult> > > results(8);
+  for (int t = 0; t < 8; t++) {
+    producers.push_back(std::thread([&writer, &results, t]() {
+      for (int i = 0; i < 125; i++) {
+        int id = t * 125 + i;
+        results[t].push_back(writer.Write("/orders/" + std::to_string(id) + ".json",
+            Document(id)));
+      }
+    }));
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  for (auto& thread_results : results) {
+    for (auto& result : thread_results) {
+      WriteResult written = result.get();
+      CPPUNIT_ASSERT(written.written);
+      CPPUNIT_ASSERT_EQUAL(200, written.status);
+    }
+  }
+
+  CPPUNIT_ASSERT_EQUAL((size_t)1000, server.DocumentCount());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1000, writer.Completed());
+  CPPUNIT_ASSERT_EQUAL(server.BulkWrites(), writer.Batches());
+  CPPUNIT_ASSERT(writer.Batches() >= 20);
+  CPPUNIT_ASSERT(writer.Batches() < 200);
+  server.Stop();
+}
+
+void BatchWriterTest::TestDelay() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  BatchWriterOptions options;
+  options.max_documents = 1000;
+  options.max_delay_ms = 50;
+  options.flushers = 1;
+  BatchWriter writer(ADDRESS, Credentials(config.username, config.password), options);
+
+  std::future<WriteResult> first = writer.Write("/orders/1.json", Document(1));
+  std::future<WriteResult> second = writer.Write("/orders/2.json", Document(2));
+  std::future<WriteResult> third = writer.Write("/orders/3.json", Document(3));
+
+  // Well short of the count, so only the delay sends the batch.
+  CPPUNIT_ASSERT(third.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+  CPPUNIT_ASSERT(first.get().written);
+  CPPUNIT_ASSERT(second.get().written);
+  CPPUNIT_ASSERT(third.get().written);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, writer.Batches());
+  CPPUNIT_ASSERT_EQUAL((size_t)3, server.DocumentCount());
+  server.Stop();
+}
+
+void BatchWriterTest::TestFlush() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  BatchWriterOptions options;
+  options.max_documents = 1000;
+  options.max_delay_ms = 600000;
+  BatchWriter writer(ADDRESS, Credentials(config.username, config.password), options);
+
+  for (int i = 0; i < 5; i++) {
+    writer.Write("/orders/" + std::to_string(i) + ".json", Document(i));
+  }
+  writer.Flush();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)5, writer.Completed());
+  CPPUNIT_ASSERT_EQUAL((size_t)5, server.DocumentCount());
+
+  // Nothing queued returns at once.
+  writer.Flush();
+  server.Stop();
+}
+
+void BatchWriterTest::TestBackpressure() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  config.latency_us = 2000;
+  StubServer server(config);
+  server.Start();
+
+  BatchWriterOptions options;
+  options.max_documents = 2;
+  options.queue_capacity = 4;
+  options.flushers = 1;
+  BatchWriter writer(ADDRESS, Credentials(config.username, config.password), options);
+
+  std::vector<std::future<WriteResult> > results;
+  for (int i = 0; i < 100; i++) {
+    results.push_back(writer.Write("/orders/" + std::to_string(i) + ".json", Document(i)));
+  }
+  for (auto& result : results) {
+    CPPUNIT_ASSERT(result.get().written);
+  }
+  CPPUNIT_ASSERT(writer.Batches() >= 50);
+  CPPUNIT_ASSERT_EQUAL((size_t)100, server.DocumentCount());
+  server.Stop();
+}
+
+void BatchWriterTest::TestFailure() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  BatchWriterOptions options;
+  options.max_documents = 1;
+  options.flushers = 1;
+  BatchWriter writer(ADDRESS, Credentials(config.username, config.password), options);
+
+  WriteResult failed = writer.Write("", Document(1)).get();
+  CPPUNIT_ASSERT(!failed.written);
+  CPPUNIT_ASSERT_EQUAL(400, failed.status);
+  CPPUNIT_ASSERT(failed.error.find("RESTAPI-INVALIDREQ") != std::string::npos);
+
+  // A quote or a line break would end the part's headers early, so the
+  // write is refused without being sent.
+  uint64_t requests = server.Requests();
+  WriteResult refused = writer.Write("/orders/\"1\".json", Document(1)).get();
+  CPPUNIT_ASSERT(!refused.written);
+  CPPUNIT_ASSERT_EQUAL(0, refused.status);
+  CPPUNIT_ASSERT(!writer.Write("/orders/1.json\r\nX-Injected: 1", Document(1)).get().written);
+  CPPUNIT_ASSERT_EQUAL(requests, server.Requests());
+  CPPUNIT_ASSERT(writer.Write("/orders/1.json", Document(1)).get().written);
+  server.Stop();
+}
+
+void BatchWriterTest::TestClose() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  BatchWriterOptions options;
+  options.max_delay_ms = 600000;
+  BatchWriter writer(ADDRESS, Credentials(config.username, config.password), options);
+  std::future<WriteResult> queued = writer.Write("/orders/1.json", Document(1));
+  writer.Close();
+  CPPUNIT_ASSERT(queued.get().written);
+
+  WriteResult late = writer.Write("/orders/2.json", Document(2)).get();
+  CPPUNIT_ASSERT(!late.written);
+  CPPUNIT_ASSERT_EQUAL(0, late.status);
+  CPPUNIT_ASSERT_EQUAL((size_t)1, server.DocumentCount());
+  server.Stop();
+}
+
+void BatchWriterTest::TestCloseWhileWriting() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  // Every write racing Close either goes out or is refused; none is left
+  // waiting.
+  for (int round = 0; round < 20; round++) {
+    BatchWriterOptions options;
+    options.max_delay_ms = 1;
+    BatchWriter writer(ADDRESS, Credentials(config.username, config.password), options);
+    std::vector<std::vector<std::future<WriteResult> > > results(4);
+    std::vector<std::thread> writers;
+    for (size_t t = 0; t < results.size(); t++) {
+      writers.push_back(std::thread([&writer, &results, t]() {
+        for (int i = 0; i < 200; i++) {
+          results[t].push_back(writer.Write("/orders/" + std::to_string(i) + ".json",
+              Document(i)));
+        }
+      }));
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(round * 50));
+    writer.Close();
+    for (auto& thread : writers) {
+      thread.join();
+    }
+    for (auto& written : results) {
+      for (auto& result : written) {
+        CPPUNIT_ASSERT(result.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+      }
+    }
+  }
+  server.Stop();
+}
@@ -0,0 +1,39 @@
+/*
+ * File:   BatchWriterTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef BATCHWRITERTEST_HPP
+#define	BATCHWRITERTEST_HPP
+
+class BatchWriterTest : public CppUnit::TestCase {
+public:
+    BatchWriterTest();
+    BatchWriterTest(const BatchWriterTest& orig);
+    virtual ~BatchWriterTest();
+
+    void TestBatching();
+    void TestDelay();
+    void TestFlush();
+    void TestBackpressure();
+    void TestFailure();
+    void TestClose();
+    void TestCloseWhileWriting();
+private:
+    CPPUNIT_TEST_SUITE(BatchWriterTest);
+    CPPUNIT_TEST(TestBatching);
+    CPPUNIT_TEST(TestDelay);
+    CPPUNIT_TEST(TestFlush);
+    CPPUNIT_TEST(TestBackpressure);
+    CPPUNIT_TEST(TestFailure);
+    CPPUNIT_TEST(TestClose);
+    CPPUNIT_TEST(TestCloseWhileWriting);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* BATCHWRITERTEST_HPP */
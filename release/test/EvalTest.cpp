@@ -0,0 +1,206 @@
+/*
+ * File:   EvalTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <string>
+#include "EvalTest.hpp"
+#include "Eval.hpp"
+#include "AuthenticatingProxy.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(EvalTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8392";
+
+// Trimmed from a MarkLogic 8 response to POST /v1/eval.
+const std::string ITEMS =
+    "\r\n--a1b2c3\r\n"
+    "Content-Type: text/plain\r\n"
+    "X-Primitive: integer\r\n\r\n"
+    "42\r\n"
+    "--a1b2c3\r\n"
+    "Content-Type: application/json\r\n"
+    "X-Primitive: map\r\n\r\n"
+    "{\"open\":12}\r\n"
+    "--a1b2c3\r\n"
+    "Content-Type: application/xml\r\n"
+    "X-Primitive: element()\r\n"
+    "X-Path: /order/status\r\n\r\n"
+    "<status>open</status>\r\n"
+    "--a1b2c3--\r\n";
+
+}
+
+EvalTest::EvalTest() {
+
+}
+
+EvalTest::EvalTest(const EvalTest& orig) {
+
+}
+
+EvalTest::~EvalTest() {
+
+}
+
+void EvalTest::TestCallPaths() {
+  EvalCall eval = EvalCall::XQuery("cts:uris()");
+  CPPUNIT_ASSERT_EQUAL(std::string("POST"), eval.Method());
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/eval"), eval.Path());
+  CPPUNIT_ASSERT_EQUAL(std::string("xquery=cts%3Auris%28%29"), eval.RequestBody());
+  CPPUNIT_ASSERT_EQUAL(std::string("application/x-www-form-urlencoded"), eval.ContentType());
+
+  eval.Database("Documents").Txid("8273");
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/eval?database=Documents&txid=8273"), eval.Path());
+
+  EvalCall invoke = EvalCall::Invoke("/ext/summarize.sjs");
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/invoke"), invoke.Path());
+  CPPUNIT_ASSERT_EQUAL(std::string("module=%2Fext%2Fsummarize.sjs"), invoke.RequestBody());
+
+  EvalCall resource = EvalCall::Resource("order summary", "PUT");
+  resource.Body("{}", "application/json");
+  CPPUNIT_ASSERT_EQUAL(std::string("PUT"), resource.Method());
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/resources/order%20summary"), resource.Path());
+  CPPUNIT_ASSERT_EQUAL(std::string("{}"), resource.RequestBody());
+  CPPUNIT_ASSERT_EQUAL(std::string("application/json"), resource.ContentType());
+}
+
+void EvalTest::TestReadItems() {
+  EvalResults results(ITEMS, "multipart/mixed; boundary=a1b2c3");
+  EvalItem item;
+  CPPUNIT_ASSERT(results.Next(item));
+  CPPUNIT_ASSERT_EQUAL(std::string("text/plain"), item.content_type);
+  CPPUNIT_ASSERT_EQUAL(std::string("integer"), item.primitive);
+  CPPUNIT_ASSERT_EQUAL(std::string("42"), item.Content());
+
+  CPPUNIT_ASSERT(results.Next(item));
+  CPPUNIT_ASSERT_EQUAL(std::string("map"), item.primitive);
+  CPPUNIT_ASSERT_EQUAL(std::string("{\"open\":12}"), item.Content());
+  CPPUNIT_ASSERT(item.path.empty());
+
+  CPPUNIT_ASSERT(results.Next(item));
+  CPPUNIT_ASSERT_EQUAL(std::string("application/xml"), item.content_type);
+  CPPUNIT_ASSERT_EQUAL(std::string("/order/status"), item.path);
+  CPPUNIT_ASSERT_EQUAL(std::string("<status>open</status>"), item.Content());
+
+  CPPUNIT_ASSERT(!results.Next(item));
+  CPPUNIT_ASSERT(!results.Next(item));
+
+  EvalResults empty("", "");
+  CPPUNIT_ASSERT(!empty.Next(item));
+}
+
+void EvalTest::TestSingleDocument() {
+  EvalResults results("{\"total\":3}", "application/json; charset=utf-8");
+  EvalItem item;
+  CPPUNIT_ASSERT(results.Next(item));
+  CPPUNIT_ASSERT_EQUAL(std::string("application/json; charset=utf-8"), item.content_type);
+  CPPUNIT_ASSERT_EQUAL(std::string("{\"total\":3}"), item.Content());
+  CPPUNIT_ASSERT(!results.Next(item));
+}
+
+void EvalTest::TestEval() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Seed(250);
+  server.Start();
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+
+  EvalResults uris(proxy, ADDRESS, EvalCall::XQuery("cts:uris()"));
+  EvalItem item;
+  size_t count = 0;
+  while (uris.Next(item)) {
+    CPPUNIT_ASSERT_EQUAL(std::string("anyURI"), item.primitive);
+    CPPUNIT_ASSERT_EQUAL(std::string("/bench/"), item.Content().substr(0, 7));
+    count++;
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t)250, count);
+
+  EvalCall call = EvalCall::JavaScript("var limit, prefix, verbose; [prefix, limit, verbose]");
+  call.Variable("prefix", "/orders/a&b=c").Variable("limit", web::json::value(10))
+      .Variable("verbose", web::json::value(true));
+  EvalResults echo(proxy, ADDRESS, call);
+  CPPUNIT_ASSERT(echo.Next(item));
+  CPPUNIT_ASSERT_EQUAL(std::string("integer"), item.primitive);
+  CPPUNIT_ASSERT_EQUAL(std::string("10"), item.Content());
+  CPPUNIT_ASSERT(echo.Next(item));
+  CPPUNIT_ASSERT_EQUAL(std::string("string"), item.primitive);
+  CPPUNIT_ASSERT_EQUAL(std::string("/orders/a&b=c"), item.Content());
+  CPPUNIT_ASSERT(echo.Next(item));
+  CPPUNIT_ASSERT_EQUAL(std::string("boolean"), item.primitive);
+  CPPUNIT_ASSERT_EQUAL(std::string("true"), item.Content());
+  CPPUNIT_ASSERT(!echo.Next(item));
+
+  EvalResults none(proxy, ADDRESS, EvalCall::XQuery("()"));
+  CPPUNIT_ASSERT(!none.Next(item));
+  server.Stop();
+}
+
+void EvalTest::TestInvoke() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+
+  EvalCall call = EvalCall::Invoke("/echo.sjs");
+  call.Variable("order", web::json::value::parse("{\"id\":7}"));
+  EvalResults results(proxy, ADDRESS, call);
+  EvalItem item;
+  CPPUNIT_ASSERT(results.Next(item));
+  CPPUNIT_ASSERT_EQUAL(std::string("application/json"), item.content_type);
+  CPPUNIT_ASSERT_EQUAL(std::string("map"), item.primitive);
+  CPPUNIT_ASSERT_EQUAL(std::string("{\"id\":7}"), item.Content());
+  CPPUNIT_ASSERT(!results.Next(item));
+
+  try {
+    EvalResults missing(proxy, ADDRESS, EvalCall::Invoke("/missing.sjs"));
+    CPPUNIT_FAIL("Expected an EvalException");
+  } catch (const EvalException& e) {
+    CPPUNIT_ASSERT(std::string(e.what()).find("XDMP-MODNOTFOUND") != std::string::npos);
+  }
+  server.Stop();
+}
+
+void EvalTest::TestResources() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+
+  EvalCall get = EvalCall::Resource("summary");
+  get.Variable("status", "open").Variable("limit", web::json::value(5));
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/resources/summary?rs:status=open&rs:limit=5"),
+      get.Path());
+  EvalResults params(proxy, ADDRESS, get);
+  EvalItem item;
+  CPPUNIT_ASSERT(params.Next(item));
+  CPPUNIT_ASSERT_EQUAL(std::string("limit=5"), item.Content());
+  CPPUNIT_ASSERT(params.Next(item));
+  CPPUNIT_ASSERT_EQUAL(std::string("status=open"), item.Content());
+  CPPUNIT_ASSERT(!params.Next(item));
+
+  EvalCall put = EvalCall::Resource("summary", "PUT");
+  put.Body("<summary/>", "application/xml");
+  EvalResults echoed(proxy, ADDRESS, put);
+  CPPUNIT_ASSERT(echoed.Next(item));
+  CPPUNIT_ASSERT_EQUAL(std::string("application/xml"), item.content_type);
+  CPPUNIT_ASSERT_EQUAL(std::string("<summary/>"), item.Content());
+  CPPUNIT_ASSERT(!echoed.Next(item));
+
+  EvalResults deleted(proxy, ADDRESS, EvalCall::Resource("summary", "DELETE"));
+  CPPUNIT_ASSERT(!deleted.Next(item));
+  server.Stop();
+}
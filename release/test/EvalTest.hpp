@@ -0,0 +1,37 @@
+/*
+ * File:   EvalTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef EVALTEST_HPP
+#define	EVALTEST_HPP
+
+class EvalTest : public CppUnit::TestCase {
+public:
+    EvalTest();
+    EvalTest(const EvalTest& orig);
+    virtual ~EvalTest();
+
+    void TestCallPaths();
+    void TestReadItems();
+    void TestSingleDocument();
+    void TestEval();
+    void TestInvoke();
+    void TestResources();
+private:
+    CPPUNIT_TEST_SUITE(EvalTest);
+    CPPUNIT_TEST(TestCallPaths);
+    CPPUNIT_TEST(TestReadItems);
+    CPPUNIT_TEST(TestSingleDocument);
+    CPPUNIT_TEST(TestEval);
+    CPPUNIT_TEST(TestInvoke);
+    CPPUNIT_TEST(TestResources);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* EVALTEST_HPP */
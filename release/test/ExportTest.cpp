@@ -0,0 +1,138 @@
+/*
+ * File:   ExportTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include "ExportTest.hpp"
+#include "Export.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ExportTest);
+
+namespace {
+
+const std::string EXPORT_DIRECTORY = "mlcpptest-export";
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream in(path.c_str(), std::ios::binary);
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  return contents.str();
+}
+
+///
+/// Checks and removes what an export of Seed(count) wrote.
+///
+void CheckAndRemove(const size_t& count, const std::string& document) {
+  for (size_t i = 0; i < count; i++) {
+    std::string path = EXPORT_DIRECTORY + "/bench/" + std::to_string(i) + ".json";
+    CPPUNIT_ASSERT_EQUAL(document, ReadFile(path));
+    std::remove(path.c_str());
+  }
+  rmdir((EXPORT_DIRECTORY + "/bench").c_str());
+  rmdir(EXPORT_DIRECTORY.c_str());
+}
+
+}
+
+ExportTest::ExportTest() {
+
+}
+
+ExportTest::ExportTest(const ExportTest& orig) {
+
+}
+
+ExportTest::~ExportTest() {
+
+}
+
+void ExportTest::TestPaths() {
+  CPPUNIT_ASSERT_EQUAL(std::string("out/orders/1.json"),
+      Exporter::OutputPath("out/", "/orders/1.json"));
+  CPPUNIT_ASSERT_EQUAL(std::string("out/1.json"), Exporter::OutputPath("out", "1.json"));
+  CPPUNIT_ASSERT_EQUAL(std::string("out/a..b/c"), Exporter::OutputPath("out", "/a..b/c"));
+  CPPUNIT_ASSERT_EQUAL(std::string(), Exporter::OutputPath("out", "/../etc/passwd"));
+  CPPUNIT_ASSERT_EQUAL(std::string(), Exporter::OutputPath("out", "a/.."));
+  CPPUNIT_ASSERT_EQUAL(std::string(), Exporter::OutputPath("out", "a\\..\\b"));
+  CPPUNIT_ASSERT_EQUAL(std::string(), Exporter::OutputPath("out", ""));
+
+  std::vector<std::string> uris;
+  uris.push_back("/a.json");
+  uris.push_back("/b c.json");
+  std::string path = Exporter::BulkReadPath(uris, 1234);
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/documents?category=content&timestamp=1234&uri="),
+      path.substr(0, 50));
+  CPPUNIT_ASSERT_EQUAL((size_t)2, (size_t)std::count(path.begin(), path.end(), '&') - 1);
+  CPPUNIT_ASSERT(path.find(' ') == std::string::npos);
+}
+
+void ExportTest::TestUriRangeExport() {
+  StubServerConfig config;
+  config.address = "http://127.0.0.1:8396";
+  config.document_bytes = 300;
+  StubServer server(config);
+  server.Seed(53);
+  server.Start();
+
+  ExportOptions options;
+  options.directory = "/bench/";
+  options.partitions = 3;
+  options.batch_size = 7;
+  options.page_length = 10;
+  options.output_directory = EXPORT_DIRECTORY;
+  Exporter exporter(config.address, Credentials(config.username, config.password), options);
+  uint64_t timestamp = exporter.CaptureTimestamp();
+  CPPUNIT_ASSERT(timestamp != 0);
+
+  // The snapshot is taken once; later writes do not move it.
+  server.Store("/bench/0.json", StubServer::MakeDocument(300));
+  ExportSummary summary = exporter.Run();
+  server.Stop();
+
+  CPPUNIT_ASSERT_EQUAL(timestamp, summary.timestamp);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)53, summary.documents);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)(53 * 300), summary.bytes);
+  CPPUNIT_ASSERT_EQUAL((size_t)3, summary.partition_documents.size());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)18, summary.partition_documents[0]);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)18, summary.partition_documents[1]);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)17, summary.partition_documents[2]);
+
+  CheckAndRemove(53, StubServer::MakeDocument(300));
+}
+
+void ExportTest::TestForestExport() {
+  StubServerConfig config;
+  config.address = "http://127.0.0.1:8396";
+  config.forests = 3;
+  StubServer server(config);
+  server.Seed(40);
+  server.Start();
+
+  ExportOptions options;
+  options.partitioning = ExportPartitioning::FOREST;
+  options.forests.push_back("Forest-0");
+  options.forests.push_back("Forest-1");
+  options.forests.push_back("Forest-2");
+  options.batch_size = 6;
+  options.page_length = 5;
+  options.output_directory = EXPORT_DIRECTORY;
+  Exporter exporter(config.address, Credentials(config.username, config.password), options);
+  ExportSummary summary = exporter.Run();
+  server.Stop();
+
+  CPPUNIT_ASSERT_EQUAL((uint64_t)40, summary.documents);
+  uint64_t sum = 0;
+  for (size_t i = 0; i < summary.partition_documents.size(); i++) {
+    sum += summary.partition_documents[i];
+  }
+  CPPUNIT_ASSERT_EQUAL((uint64_t)40, sum);
+  CheckAndRemove(40, StubServer::MakeDocument(config.document_bytes));
+}
@@ -0,0 +1,31 @@
+/*
+ * File:   ExportTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef EXPORTTEST_HPP
+#define	EXPORTTEST_HPP
+
+class ExportTest : public CppUnit::TestCase {
+public:
+    ExportTest();
+    ExportTest(const ExportTest& orig);
+    virtual ~ExportTest();
+
+    void TestPaths();
+    void TestUriRangeExport();
+    void TestForestExport();
+private:
+    CPPUNIT_TEST_SUITE(ExportTest);
+    CPPUNIT_TEST(TestPaths);
+    CPPUNIT_TEST(TestUriRangeExport);
+    CPPUNIT_TEST(TestForestExport);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* EXPORTTEST_HPP */
@@ -0,0 +1,228 @@
+/*
+ * File:   IngestTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "IngestTest.hpp"
+#include "Ingest.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(IngestTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8389";
+const std::string INGEST_DIRECTORY = "mlcpptest-ingest";
+const std::string CHECKPOINT = "mlcpptest-ingest.ckpt";
+
+void WriteFile(const std::string& path, const std::string& contents) {
+  std::ofstream out(path.c_str(), std::ios::binary);
+  out << contents;
+}
+
+///
+/// Writes a tree of files, a few levels deep and lopsided, and returns
+/// their paths and total size.
+///
+std::vector<std::string> MakeTree(uint64_t& bytes) {
+  std::vector<std::string> files;
+  bytes = 0;
+  mkdir(INGEST_DIRECTORY.c_str(), 0755);
+  mkdir((INGEST_DIRECTORY + "/2014").c_str(), 0755);
+  mkdir((INGEST_DIRECTORY + "/2014/06").c_str(), 0755);
+  mkdir((INGEST_DIRECTORY + "/empty").c_str(), 0755);
+  for (int i = 0; i < 5; i++) {
+    files.push_back(INGEST_DIRECTORY + "/" + std::to_string(i) + ".xml");
+  }
+  for (int i = 0; i < 10; i++) {
+    files.push_back(INGEST_DIRECTORY + "/2014/" + std::to_string(i) + ".json");
+  }
+  for (int i = 0; i < 25; i++) {
+    files.push_back(INGEST_DIRECTORY + "/2014/06/" + std::to_string(i) + ".txt");
+  }
+  for (size_t i = 0; i < files.size(); i++) {
+    std::string contents = "{\"id\":" + std::to_string(i) + "}";
+    WriteFile(files[i], contents);
+    bytes += contents.size();
+  }
+  return files;
+}
+
+void RemoveTree(const std::vector<std::string>& files) {
+  for (auto& file : files) {
+    std::remove(file.c_str());
+  }
+  rmdir((INGEST_DIRECTORY + "/2014/06").c_str());
+  rmdir((INGEST_DIRECTORY + "/2014").c_str());
+  rmdir((INGEST_DIRECTORY + "/empty").c_str());
+  rmdir(INGEST_DIRECTORY.c_str());
+  std::remove(CHECKPOINT.c_str());
+}
+
+}
+
+IngestTest::IngestTest() {
+
+}
+
+IngestTest::IngestTest(const IngestTest& orig) {
+
+}
+
+IngestTest::~IngestTest() {
+
+}
+
+void IngestTest::TestUris() {
+  CPPUNIT_ASSERT_EQUAL(std::string("/orders/2014/1.json"),
+      Ingester::UriFor("/orders/", "2014/1.json"));
+  CPPUNIT_ASSERT_EQUAL(std::string("/orders/1.json"), Ingester::UriFor("/orders/", "/1.json"));
+  CPPUNIT_ASSERT_EQUAL(std::string("1.json"), Ingester::UriFor("", "1.json"));
+
+  IngestOptions options;
+  CPPUNIT_ASSERT_EQUAL(std::string("application/json"),
+      Ingester::ContentType(options, "2014/1.json"));
+  CPPUNIT_ASSERT_EQUAL(std::string("application/xml"), Ingester::ContentType(options, "A.XML"));
+  CPPUNIT_ASSERT_EQUAL(std::string("application/octet-stream"),
+      Ingester::ContentType(options, "v1.2/README"));
+  options.content_types["md"] = "text/markdown";
+  CPPUNIT_ASSERT_EQUAL(std::string("text/markdown"), Ingester::ContentType(options, "a.md"));
+}
+
+void IngestTest::TestCheckpointKey() {
+  uint64_t key = Ingester::CheckpointKey("2014/1.json", 100, 1400000000);
+  CPPUNIT_ASSERT_EQUAL(key, Ingester::CheckpointKey("2014/1.json", 100, 1400000000));
+  CPPUNIT_ASSERT(key != Ingester::CheckpointKey("2014/2.json", 100, 1400000000));
+  CPPUNIT_ASSERT(key != Ingester::CheckpointKey("2014/1.json", 101, 1400000000));
+  CPPUNIT_ASSERT(key != Ingester::CheckpointKey("2014/1.json", 100, 1400000001));
+}
+
+void IngestTest::TestLoad() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  uint64_t bytes = 0;
+  std::vector<std::string> files = MakeTree(bytes);
+
+  IngestOptions options;
+  options.input_directory = INGEST_DIRECTORY;
+  options.uri_prefix = "/ingest/";
+  options.collections.push_back("orders");
+  options.directory_collections = true;
+  options.threads = 4;
+  options.progress_interval_ms = 10;
+  Ingester ingester(ADDRESS, Credentials(config.username, config.password), options);
+
+  uint64_t reports = 0;
+  IngestSummary summary = ingester.Run([&reports](const IngestProgress& progress) {
+    reports++;
+  });
+  RemoveTree(files);
+
+  CPPUNIT_ASSERT(summary.failures.empty());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)files.size(), summary.totals.files);
+  CPPUNIT_ASSERT_EQUAL(bytes, summary.totals.bytes);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, summary.totals.skipped);
+  CPPUNIT_ASSERT_EQUAL(files.size(), server.DocumentCount());
+  CPPUNIT_ASSERT(reports >= 1);
+  server.Stop();
+}
+
+void IngestTest::TestResume() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  uint64_t bytes = 0;
+  std::vector<std::string> files = MakeTree(bytes);
+  std::remove(CHECKPOINT.c_str());
+
+  IngestOptions options;
+  options.input_directory = INGEST_DIRECTORY;
+  options.checkpoint_path = CHECKPOINT;
+  options.threads = 3;
+  Credentials credentials(config.username, config.password);
+
+  IngestSummary first = Ingester(ADDRESS, credentials, options).Run();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)files.size(), first.totals.files);
+
+  // Nothing has changed, so nothing is sent.
+  uint64_t requests = server.Requests();
+  IngestSummary second = Ingester(ADDRESS, credentials, options).Run();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, second.totals.files);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)files.size(), second.totals.skipped);
+  CPPUNIT_ASSERT_EQUAL(requests, server.Requests());
+
+  // A file that changed size is sent again.
+  WriteFile(files[7], "{\"id\":7,\"changed\":true}");
+  IngestSummary third = Ingester(ADDRESS, credentials, options).Run();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, third.totals.files);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)files.size() - 1, third.totals.skipped);
+
+  RemoveTree(files);
+  server.Stop();
+}
+
+void IngestTest::TestTornCheckpoint() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  uint64_t bytes = 0;
+  std::vector<std::string> files = MakeTree(bytes);
+  std::remove(CHECKPOINT.c_str());
+
+  IngestOptions options;
+  options.input_directory = INGEST_DIRECTORY;
+  options.checkpoint_path = CHECKPOINT;
+  options.threads = 3;
+  Credentials credentials(config.username, config.password);
+  Ingester(ADDRESS, credentials, options).Run();
+
+  // Cut the last key short, as a crash in the middle of writing it would.
+  struct stat info;
+  stat(CHECKPOINT.c_str(), &info);
+  CPPUNIT_ASSERT_EQUAL((off_t)(8 + 8 * files.size()), info.st_size);
+  CPPUNIT_ASSERT_EQUAL(0, truncate(CHECKPOINT.c_str(), info.st_size - 3));
+
+  IngestSummary resumed = Ingester(ADDRESS, credentials, options).Run();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, resumed.totals.files);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)files.size() - 1, resumed.totals.skipped);
+  stat(CHECKPOINT.c_str(), &info);
+  CPPUNIT_ASSERT_EQUAL((off_t)(8 + 8 * files.size()), info.st_size);
+
+  // Every key lines up again, so a second resume sends nothing.
+  IngestSummary again = Ingester(ADDRESS, credentials, options).Run();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, again.totals.files);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)files.size(), again.totals.skipped);
+
+  RemoveTree(files);
+  server.Stop();
+}
+
+void IngestTest::TestBadInput() {
+  IngestOptions options;
+  options.input_directory = INGEST_DIRECTORY + "-missing";
+  Ingester missing(ADDRESS, Credentials("user", "password"), options);
+  CPPUNIT_ASSERT_THROW(missing.Run(), IngestException);
+
+  uint64_t bytes = 0;
+  std::vector<std::string> files = MakeTree(bytes);
+  WriteFile(CHECKPOINT, "not a checkpoint");
+  options.input_directory = INGEST_DIRECTORY;
+  options.checkpoint_path = CHECKPOINT;
+  Ingester corrupt(ADDRESS, Credentials("user", "password"), options);
+  CPPUNIT_ASSERT_THROW(corrupt.Run(), IngestException);
+  RemoveTree(files);
+}
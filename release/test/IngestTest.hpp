@@ -0,0 +1,37 @@
+/*
+ * File:   IngestTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef INGESTTEST_HPP
+#define	INGESTTEST_HPP
+
+class IngestTest : public CppUnit::TestCase {
+public:
+    IngestTest();
+    IngestTest(const IngestTest& orig);
+    virtual ~IngestTest();
+
+    void TestUris();
+    void TestCheckpointKey();
+    void TestLoad();
+    void TestResume();
+    void TestTornCheckpoint();
+    void TestBadInput();
+private:
+    CPPUNIT_TEST_SUITE(IngestTest);
+    CPPUNIT_TEST(TestUris);
+    CPPUNIT_TEST(TestCheckpointKey);
+    CPPUNIT_TEST(TestLoad);
+    CPPUNIT_TEST(TestResume);
+    CPPUNIT_TEST(TestTornCheckpoint);
+    CPPUNIT_TEST(TestBadInput);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* INGESTTEST_HPP */
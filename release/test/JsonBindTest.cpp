@@ -0,0 +1,200 @@
+/*
+ * File:   JsonBindTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "JsonBindTest.hpp"
+#include "JsonBind.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(JsonBindTest);
+
+namespace {
+
+struct Address {
+    std::string city;
+    std::string zip;
+};
+
+struct Person {
+    std::string name;
+    int age;
+    double height;
+    bool active;
+    Address address;
+    std::vector<std::string> tags;
+    std::map<std::string, int64_t> counts;
+
+    Person() : age(-1), height(0.0), active(false) {
+    }
+};
+
+struct Widths {
+    int8_t small;
+    uint16_t medium;
+    int64_t large;
+    uint64_t huge;
+
+    Widths() : small(0), medium(0), large(0), huge(0) {
+    }
+};
+
+struct Hit {
+    std::string uri;
+    double score;
+
+    Hit() : score(0.0) {
+    }
+};
+
+}
+
+template<> struct JsonBinding<Address> {
+    template<typename Fields>
+    static void Bind(Fields& fields, Address& address) {
+        fields("city", address.city);
+        fields("zip", address.zip);
+    }
+};
+
+template<> struct JsonBinding<Person> {
+    template<typename Fields>
+    static void Bind(Fields& fields, Person& person) {
+        fields("name", person.name);
+        fields("age", person.age);
+        fields("height", person.height);
+        fields("active", person.active);
+        fields("address", person.address);
+        fields("tags", person.tags);
+        fields("counts", person.counts);
+    }
+};
+
+template<> struct JsonBinding<Widths> {
+    template<typename Fields>
+    static void Bind(Fields& fields, Widths& widths) {
+        fields("small", widths.small);
+        fields("medium", widths.medium);
+        fields("large", widths.large);
+        fields("huge", widths.huge);
+    }
+};
+
+template<> struct JsonBinding<Hit> {
+    template<typename Fields>
+    static void Bind(Fields& fields, Hit& hit) {
+        fields("uri", hit.uri);
+        fields("score", hit.score);
+    }
+};
+
+JsonBindTest::JsonBindTest() {
+}
+
+JsonBindTest::JsonBindTest(const JsonBindTest& orig) {
+}
+
+JsonBindTest::~JsonBindTest() {
+}
+
+void JsonBindTest::TestDocument() {
+  const std::string body = "{\"unknown\":{\"deep\":[1,{\"name\":\"no\"}]},"
+      "\"name\":\"Ada \\\"L\\\"\", \"age\":36, \"height\":1.65, \"active\":true,"
+      "\"address\":{\"city\":\"London\",\"country\":\"UK\",\"zip\":null},"
+      "\"tags\":[\"math\",null,\"poetry\"], \"counts\":{\"a\":1,\"b\":-2},"
+      "\"notes\":\"skipped\"}";
+  Person person;
+  person.address.zip = "unchanged";
+  JsonBind::Decode(body, person);
+  CPPUNIT_ASSERT_EQUAL(std::string("Ada \"L\""), person.name);
+  CPPUNIT_ASSERT_EQUAL(36, person.age);
+  CPPUNIT_ASSERT_EQUAL(1.65, person.height);
+  CPPUNIT_ASSERT(person.active);
+  CPPUNIT_ASSERT_EQUAL(std::string("London"), person.address.city);
+  CPPUNIT_ASSERT_EQUAL(std::string("unchanged"), person.address.zip);
+  CPPUNIT_ASSERT_EQUAL((size_t)3, person.tags.size());
+  CPPUNIT_ASSERT(person.tags[1].empty());
+  CPPUNIT_ASSERT_EQUAL(std::string("poetry"), person.tags[2]);
+  CPPUNIT_ASSERT_EQUAL((int64_t)-2, person.counts["b"]);
+
+  // Missing members leave their fields alone.
+  Person partial;
+  JsonBind::Decode("{\"name\":\"Bo\"}", partial);
+  CPPUNIT_ASSERT_EQUAL(-1, partial.age);
+
+  std::vector<Person> people;
+  JsonBind::Decode("[{\"name\":\"a\"},{\"name\":\"b\",\"age\":2}]", people);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, people.size());
+  CPPUNIT_ASSERT_EQUAL(2, people[1].age);
+}
+
+void JsonBindTest::TestIntegers() {
+  Widths widths;
+  JsonBind::Decode("{\"small\":-128,\"medium\":65535,\"large\":-9223372036854775808,"
+      "\"huge\":18446744073709551615}", widths);
+  CPPUNIT_ASSERT_EQUAL((int8_t)-128, widths.small);
+  CPPUNIT_ASSERT_EQUAL((uint16_t)65535, widths.medium);
+  CPPUNIT_ASSERT_EQUAL(INT64_MIN, widths.large);
+  CPPUNIT_ASSERT_EQUAL(UINT64_MAX, widths.huge);
+
+  JsonBind::Decode("{\"small\":-0,\"large\":9223372036854775807}", widths);
+  CPPUNIT_ASSERT_EQUAL((int8_t)0, widths.small);
+  CPPUNIT_ASSERT_EQUAL(INT64_MAX, widths.large);
+
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"small\":128}", widths), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"small\":-129}", widths), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"medium\":-1}", widths), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"medium\":65536}", widths), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"huge\":18446744073709551616}", widths),
+      JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"large\":1.5}", widths), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"large\":1e3}", widths), JsonParseException);
+}
+
+void JsonBindTest::TestMismatch() {
+  Person person;
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"age\":\"36\"}", person), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"name\":36}", person), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"active\":1}", person), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"tags\":\"math\"}", person), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"address\":[]}", person), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("[]", person), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"name\":\"x\"} {}", person), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("{\"name\":\"x\"", person), JsonParseException);
+  CPPUNIT_ASSERT_THROW(JsonBind::Decode("", person), JsonParseException);
+}
+
+void JsonBindTest::TestSearchPage() {
+  // Documents returned with transform-results raw, and with
+  // extract-document-data, where the document can follow other members.
+  const std::string raw = "{\"total\":2,\"start\":1,\"page-length\":10,\"results\":["
+      "{\"index\":1,\"uri\":\"/1.json\",\"content\":{\"uri\":\"/inside/1\",\"score\":7}},"
+      "{\"index\":2,\"matches\":[{\"path\":\"x\"}],\"extracted\":{\"kind\":\"array\","
+      "\"content\":[{\"uri\":\"/inside/2\"},{\"uri\":\"ignored\"}]},\"uri\":\"/2.json\"}],"
+      "\"facets\":{}}";
+  TypedSearchPage<Hit> page;
+  JsonBind::DecodeSearchPage(raw, page);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, page.total);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)10, page.page_length);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, page.results.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("/inside/1"), page.results[0].uri);
+  CPPUNIT_ASSERT_EQUAL(7.0, page.results[0].score);
+  CPPUNIT_ASSERT_EQUAL(std::string("/inside/2"), page.results[1].uri);
+
+  // Without documents each result is read as it is.
+  const std::string plain = "{\"total\":1,\"results\":[{\"index\":1,\"uri\":\"/a.json\","
+      "\"score\":42.5,\"confidence\":0.5,\"matches\":[{\"match-text\":[\"a\"]}]}]}";
+  JsonBind::DecodeSearchPage(plain, page);
+  CPPUNIT_ASSERT_EQUAL((size_t)1, page.results.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("/a.json"), page.results[0].uri);
+  CPPUNIT_ASSERT_EQUAL(42.5, page.results[0].score);
+
+  JsonBind::DecodeSearchPage("{\"total\":0,\"results\":[]}", page);
+  CPPUNIT_ASSERT(page.results.empty());
+  CPPUNIT_ASSERT_THROW(JsonBind::DecodeSearchPage("{\"results\":[{\"uri\":1}]}", page),
+      JsonParseException);
+}
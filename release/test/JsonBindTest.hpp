@@ -0,0 +1,33 @@
+/*
+ * File:   JsonBindTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef JSONBINDTEST_HPP
+#define	JSONBINDTEST_HPP
+
+class JsonBindTest : public CppUnit::TestCase {
+public:
+    JsonBindTest();
+    JsonBindTest(const JsonBindTest& orig);
+    virtual ~JsonBindTest();
+
+    void TestDocument();
+    void TestIntegers();
+    void TestMismatch();
+    void TestSearchPage();
+private:
+    CPPUNIT_TEST_SUITE(JsonBindTest);
+    CPPUNIT_TEST(TestDocument);
+    CPPUNIT_TEST(TestIntegers);
+    CPPUNIT_TEST(TestMismatch);
+    CPPUNIT_TEST(TestSearchPage);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* JSONBINDTEST_HPP */
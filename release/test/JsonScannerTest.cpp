@@ -0,0 +1,138 @@
+/*
+ * File:   JsonScannerTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <string>
+#include "JsonScannerTest.hpp"
+#include "JsonScanner.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(JsonScannerTest);
+
+JsonScannerTest::JsonScannerTest() {
+}
+
+JsonScannerTest::JsonScannerTest(const JsonScannerTest& orig) {
+}
+
+JsonScannerTest::~JsonScannerTest() {
+}
+
+void JsonScannerTest::TestScalars() {
+  const std::string text = " [\"text\", -12.5e1, 42, true, false, null] ";
+  JsonScanner scanner(text.data(), text.size());
+
+  CPPUNIT_ASSERT(scanner.Peek() == JsonToken::ARRAY);
+  scanner.BeginArray();
+  CPPUNIT_ASSERT(scanner.NextElement());
+  CPPUNIT_ASSERT(scanner.Peek() == JsonToken::STRING);
+  CPPUNIT_ASSERT_EQUAL(std::string("text"), scanner.ReadString());
+  CPPUNIT_ASSERT(scanner.NextElement());
+  CPPUNIT_ASSERT(scanner.Peek() == JsonToken::NUMBER);
+  CPPUNIT_ASSERT_EQUAL(-125.0, scanner.ReadNumber());
+  CPPUNIT_ASSERT(scanner.NextElement());
+  CPPUNIT_ASSERT_EQUAL(42.0, scanner.ReadNumber());
+  CPPUNIT_ASSERT(scanner.NextElement());
+  CPPUNIT_ASSERT(scanner.Peek() == JsonToken::BOOLEAN);
+  CPPUNIT_ASSERT(scanner.ReadBoolean());
+  CPPUNIT_ASSERT(scanner.NextElement());
+  CPPUNIT_ASSERT(!scanner.ReadBoolean());
+  CPPUNIT_ASSERT(scanner.NextElement());
+  CPPUNIT_ASSERT(scanner.Peek() == JsonToken::NULL_VALUE);
+  scanner.ReadNull();
+  CPPUNIT_ASSERT(!scanner.NextElement());
+  CPPUNIT_ASSERT(scanner.Peek() == JsonToken::END);
+
+  // Too big for a double to hold exactly.
+  const std::string big = " 9007199254740993,";
+  JsonScanner exact(big.data(), big.size());
+  std::string number;
+  exact.ReadNumber(number);
+  CPPUNIT_ASSERT_EQUAL(std::string("9007199254740993"), number);
+}
+
+void JsonScannerTest::TestContainers() {
+  const std::string text = "{\"a\":{},\"b\":[],\"c\":{\"d\":[1,[2]]}}";
+  JsonScanner scanner(text.data(), text.size());
+  std::string key;
+
+  scanner.BeginObject();
+  CPPUNIT_ASSERT(scanner.NextMember(key));
+  CPPUNIT_ASSERT_EQUAL(std::string("a"), key);
+  scanner.BeginObject();
+  CPPUNIT_ASSERT(!scanner.NextMember(key));
+
+  CPPUNIT_ASSERT(scanner.NextMember(key));
+  CPPUNIT_ASSERT_EQUAL(std::string("b"), key);
+  scanner.BeginArray();
+  CPPUNIT_ASSERT(!scanner.NextElement());
+
+  CPPUNIT_ASSERT(scanner.NextMember(key));
+  CPPUNIT_ASSERT_EQUAL(std::string("c"), key);
+  scanner.BeginObject();
+  CPPUNIT_ASSERT(scanner.NextMember(key));
+  CPPUNIT_ASSERT_EQUAL(std::string("d"), key);
+  scanner.BeginArray();
+  CPPUNIT_ASSERT(scanner.NextElement());
+  CPPUNIT_ASSERT_EQUAL(1.0, scanner.ReadNumber());
+  CPPUNIT_ASSERT(scanner.NextElement());
+  scanner.BeginArray();
+  CPPUNIT_ASSERT(scanner.NextElement());
+  CPPUNIT_ASSERT_EQUAL(2.0, scanner.ReadNumber());
+  CPPUNIT_ASSERT(!scanner.NextElement());
+  CPPUNIT_ASSERT(!scanner.NextElement());
+  CPPUNIT_ASSERT(!scanner.NextMember(key));
+  CPPUNIT_ASSERT(!scanner.NextMember(key));
+  CPPUNIT_ASSERT_EQUAL(text.size(), scanner.Offset());
+}
+
+void JsonScannerTest::TestEscapes() {
+  const std::string text = "\"q\\\"b\\\\s\\/n\\nt\\t \\u00e9 \\u20ac \\ud83d\\ude00\"";
+  JsonScanner scanner(text.data(), text.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("q\"b\\s/n\nt\t \xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80"),
+      scanner.ReadString());
+}
+
+void JsonScannerTest::TestSkip() {
+  const std::string text = "{\"skip\":{\"x\":[1,{\"y\":\"]}\\\"\"}],\"z\":null},"
+      "\"s\":\"a\\\"b\",\"n\":-1.5,\"keep\":7}";
+  JsonScanner scanner(text.data(), text.size());
+  std::string key;
+  double keep = 0.0;
+
+  scanner.BeginObject();
+  while (scanner.NextMember(key)) {
+    if (key == "keep") {
+      keep = scanner.ReadNumber();
+    } else {
+      scanner.Skip();
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL(7.0, keep);
+}
+
+void JsonScannerTest::TestMalformed() {
+  const std::string missing_colon = "{\"a\" 1}";
+  JsonScanner first(missing_colon.data(), missing_colon.size());
+  std::string key;
+  first.BeginObject();
+  CPPUNIT_ASSERT_THROW(first.NextMember(key), JsonParseException);
+
+  const std::string unterminated = "[\"abc";
+  JsonScanner second(unterminated.data(), unterminated.size());
+  second.BeginArray();
+  CPPUNIT_ASSERT(second.NextElement());
+  CPPUNIT_ASSERT_THROW(second.ReadString(), JsonParseException);
+
+  const std::string missing_comma = "[1 2]";
+  JsonScanner third(missing_comma.data(), missing_comma.size());
+  third.BeginArray();
+  CPPUNIT_ASSERT(third.NextElement());
+  third.ReadNumber();
+  CPPUNIT_ASSERT_THROW(third.NextElement(), JsonParseException);
+
+  const std::string not_a_number = "-x";
+  JsonScanner fourth(not_a_number.data(), not_a_number.size());
+  CPPUNIT_ASSERT_THROW(fourth.ReadNumber(), JsonParseException);
+}
@@ -0,0 +1,35 @@
+/*
+ * File:   JsonScannerTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef JSONSCANNERTEST_HPP
+#define	JSONSCANNERTEST_HPP
+
+class JsonScannerTest : public CppUnit::TestCase {
+public:
+    JsonScannerTest();
+    JsonScannerTest(const JsonScannerTest& orig);
+    virtual ~JsonScannerTest();
+
+    void TestScalars();
+    void TestContainers();
+    void TestEscapes();
+    void TestSkip();
+    void TestMalformed();
+private:
+    CPPUNIT_TEST_SUITE(JsonScannerTest);
+    CPPUNIT_TEST(TestScalars);
+    CPPUNIT_TEST(TestContainers);
+    CPPUNIT_TEST(TestEscapes);
+    CPPUNIT_TEST(TestSkip);
+    CPPUNIT_TEST(TestMalformed);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* JSONSCANNERTEST_HPP */
@@ -0,0 +1,179 @@
+/*
+ * File:   JsonViewTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "JsonViewTest.hpp"
+#include "JsonView.hpp"
+#include "Response.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(JsonViewTest);
+
+namespace {
+
+///
+/// The first pass, a character at a time: quotes that no odd run of
+/// backslashes escapes, and structural characters between strings.
+///
+std::vector<uint32_t> ExpectedStructurals(const std::string& text) {
+  std::vector<uint32_t> positions;
+  bool in_string = false;
+  size_t backslashes = 0;
+  for (size_t i = 0; i < text.size(); i++) {
+    bool escaped = backslashes % 2 == 1;
+    backslashes = text[i] == '\\' ? backslashes + 1 : 0;
+    if (text[i] == '"' && !escaped) {
+      in_string = !in_string;
+      positions.push_back((uint32_t)i);
+    } else if (!in_string && std::strchr("{}[]:,", text[i]) != nullptr && text[i] != '\0') {
+      positions.push_back((uint32_t)i);
+    }
+  }
+  return positions;
+}
+
+const std::string PAGE = "{\"total\":2, \"results\":[\n"
+    "  {\"uri\":\"/a\\\"b.json\",\"score\":1.5,\"tags\":[]},\n"
+    "  {\"uri\":\"/c.json\",\"n\":-9223372036854775808,\"ok\":true,\"x\":null}\n"
+    "], \"empty\":{}, \"k\\u0041\":\"caf\\u00e9\"}";
+
+}
+
+JsonViewTest::JsonViewTest() {
+}
+
+JsonViewTest::JsonViewTest(const JsonViewTest& orig) {
+}
+
+JsonViewTest::~JsonViewTest() {
+}
+
+void JsonViewTest::TestStructurals() {
+  // Random texts of the characters that matter, long enough for escapes and
+  // strings to cross the 64 byte blocks.
+  std::mt19937 random(7);
+  const char alphabet[] = "\"\\{}[]:, a\n";
+  std::vector<uint32_t> positions;
+  for (int test = 0; test < 20000; test++) {
+    std::string text;
+    size_t length = random() % 300;
+    for (size_t i = 0; i < length; i++) {
+      text.push_back(alphabet[random() % (sizeof(alphabet) - 1)]);
+    }
+    JsonDocument::Structurals(text.data(), text.size(), positions);
+    CPPUNIT_ASSERT_MESSAGE(text, ExpectedStructurals(text) == positions);
+  }
+}
+
+void JsonViewTest::TestNavigation() {
+  JsonDocument document(PAGE.data(), PAGE.size());
+  JsonView page = document.Root();
+  CPPUNIT_ASSERT(page.Type() == JsonToken::OBJECT);
+  CPPUNIT_ASSERT_EQUAL((size_t)4, page.Size());
+
+  std::vector<std::string> uris;
+  for (JsonView result = page["results"].Child(); result.Exists(); result = result.Sibling()) {
+    uris.push_back(result["uri"].String());
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t)2, uris.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("/a\"b.json"), uris[0]);
+  CPPUNIT_ASSERT_EQUAL(std::string("/c.json"), uris[1]);
+
+  std::vector<std::string> keys;
+  for (JsonView member = page.Child(); member.Exists(); member = member.Sibling()) {
+    keys.push_back(member.Key().to_string());
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t)4, keys.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("results"), keys[1]);
+  CPPUNIT_ASSERT_EQUAL(std::string("k\\u0041"), keys[3]);
+
+  // Escaped keys are decoded to be compared.
+  CPPUNIT_ASSERT_EQUAL(std::string("caf\xc3\xa9"), page["kA"].String());
+  CPPUNIT_ASSERT(!page["kA"].Plain());
+  CPPUNIT_ASSERT(page["results"][1]["uri"].Plain());
+
+  CPPUNIT_ASSERT_EQUAL(std::string("{}"), page["empty"].Raw().to_string());
+  CPPUNIT_ASSERT(!page["empty"].Child().Exists());
+  CPPUNIT_ASSERT(!page["results"][0]["tags"].Child().Exists());
+  CPPUNIT_ASSERT(!page["missing"].Exists());
+  CPPUNIT_ASSERT(!page["missing"]["deeper"][3].Exists());
+  CPPUNIT_ASSERT(!page["results"][2].Exists());
+  CPPUNIT_ASSERT(page["results"]["uri"].Type() == JsonToken::END);
+}
+
+void JsonViewTest::TestScalars() {
+  JsonDocument document(PAGE.data(), PAGE.size());
+  JsonView second = document.Root()["results"][1];
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, document.Root()["total"].Unsigned());
+  CPPUNIT_ASSERT_EQUAL(1.5, document.Root()["results"][0]["score"].Number());
+  CPPUNIT_ASSERT_EQUAL(INT64_MIN, second["n"].Integer());
+  CPPUNIT_ASSERT(second["ok"].Boolean());
+  CPPUNIT_ASSERT(second["x"].IsNull());
+
+  CPPUNIT_ASSERT_THROW(second["n"].Unsigned(), JsonParseException);
+  CPPUNIT_ASSERT_THROW(second["uri"].Number(), JsonParseException);
+  CPPUNIT_ASSERT_THROW(second["ok"].String(), JsonParseException);
+  CPPUNIT_ASSERT_THROW(second["missing"].Boolean(), JsonParseException);
+
+  const std::string numbers = "[18446744073709551615, 18446744073709551616, 1e3, 1.5.5]";
+  JsonDocument parsed(numbers.data(), numbers.size());
+  JsonView array = parsed.Root();
+  CPPUNIT_ASSERT_EQUAL(UINT64_MAX, array[0].Unsigned());
+  CPPUNIT_ASSERT_THROW(array[0].Integer(), JsonParseException);
+  CPPUNIT_ASSERT_THROW(array[1].Unsigned(), JsonParseException);
+  CPPUNIT_ASSERT_EQUAL(1000.0, array[2].Number());
+  CPPUNIT_ASSERT_THROW(array[2].Integer(), JsonParseException);
+  // Only the characters are checked until the number is read.
+  CPPUNIT_ASSERT(array[3].Type() == JsonToken::NUMBER);
+  CPPUNIT_ASSERT_THROW(array[3].Number(), JsonParseException);
+}
+
+void JsonViewTest::TestMalformed() {
+  const char* malformed[] = { "", "  ", "[1,]", "{\"a\":1,}", "[1 2]", "{\"a\" 1}", "[tru]",
+      "\"abc", "[1]x", "{1:2}", "[", "[[]", "nul", "{\"a\":}", "]", "{\"a\":1]", "[\"\\\"]" };
+  for (auto text : malformed) {
+    bool thrown = false;
+    try {
+      JsonDocument document(text, std::strlen(text));
+    } catch (const JsonParseException& e) {
+      thrown = true;
+    }
+    CPPUNIT_ASSERT_MESSAGE(text, thrown);
+  }
+
+  const char* wellformed[] = { "1", " \"x\" ", "[]", "{}", "[[[]],{}]", "true", "-1.5e3",
+      "[\"\\\\\",\"\\\"\"]", "{\"a\":{\"b\":[null]}}" };
+  for (auto text : wellformed) {
+    JsonDocument document(text, std::strlen(text));
+    CPPUNIT_ASSERT(document.Root().Exists());
+  }
+}
+
+void JsonViewTest::TestResponse() {
+  Response response;
+  response.SetResponseType(ResponseType::JSON);
+  response.SetBody(PAGE);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, response.View()["total"].Unsigned());
+  // The index is built once and reused.
+  CPPUNIT_ASSERT(response.View()["results"].Raw().data() ==
+      response.View()["results"].Raw().data());
+
+  // A copy indexes its own body.
+  Response copy = response;
+  CPPUNIT_ASSERT(copy.View()["results"].Raw().data() != response.View()["results"].Raw().data());
+  CPPUNIT_ASSERT_EQUAL(std::string("/c.json"), copy.View()["results"][1]["uri"].String());
+
+  response.SetBody("{\"total\":7}");
+  CPPUNIT_ASSERT_EQUAL((uint64_t)7, response.View()["total"].Unsigned());
+  CPPUNIT_ASSERT(!response.Json().is_null());
+
+  response.SetBody("not json");
+  CPPUNIT_ASSERT_THROW(response.View(), JsonParseException);
+  CPPUNIT_ASSERT(response.Json().is_null());
+}
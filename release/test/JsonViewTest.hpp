@@ -0,0 +1,35 @@
+/*
+ * File:   JsonViewTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef JSONVIEWTEST_HPP
+#define	JSONVIEWTEST_HPP
+
+class JsonViewTest : public CppUnit::TestCase {
+public:
+    JsonViewTest();
+    JsonViewTest(const JsonViewTest& orig);
+    virtual ~JsonViewTest();
+
+    void TestStructurals();
+    void TestNavigation();
+    void TestScalars();
+    void TestMalformed();
+    void TestResponse();
+private:
+    CPPUNIT_TEST_SUITE(JsonViewTest);
+    CPPUNIT_TEST(TestStructurals);
+    CPPUNIT_TEST(TestNavigation);
+    CPPUNIT_TEST(TestScalars);
+    CPPUNIT_TEST(TestMalformed);
+    CPPUNIT_TEST(TestResponse);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* JSONVIEWTEST_HPP */
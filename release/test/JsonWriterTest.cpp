@@ -0,0 +1,188 @@
+/*
+ * File:   JsonWriterTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include "JsonWriterTest.hpp"
+#include "AuthenticatingProxy.hpp"
+#include "JsonScanner.hpp"
+#include "JsonWriter.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(JsonWriterTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8386";
+
+}
+
+JsonWriterTest::JsonWriterTest() {
+}
+
+JsonWriterTest::JsonWriterTest(const JsonWriterTest& orig) {
+}
+
+JsonWriterTest::~JsonWriterTest() {
+}
+
+void JsonWriterTest::TestContainers() {
+  std::string text;
+  {
+    JsonWriter writer(text);
+    writer.BeginObject();
+    writer.Key("name").String("orders");
+    writer.Key("empty").BeginObject().EndObject();
+    writer.Key("items").BeginArray();
+    writer.Integer(1).BeginArray().EndArray().Boolean(false).Null();
+    writer.BeginObject().Key("a").Boolean(true).Key("b").Raw("[1,2]", 5).EndObject();
+    writer.EndArray();
+    writer.EndObject();
+    CPPUNIT_ASSERT(writer.Complete());
+    CPPUNIT_ASSERT_EQUAL((uint64_t)75, writer.Bytes());
+  }
+  CPPUNIT_ASSERT_EQUAL(std::string("{\"name\":\"orders\",\"empty\":{},\"items\":"
+      "[1,[],false,null,{\"a\":true,\"b\":[1,2]}]}"), text);
+  CPPUNIT_ASSERT_EQUAL((size_t)75, text.size());
+}
+
+void JsonWriterTest::TestEscapes() {
+  std::string text;
+  {
+    JsonWriter writer(text);
+    std::string value("quote \" slash \\ \b\f\n\r\t \x01\x1f caf\xc3\xa9 </");
+    value.push_back('\0');
+    writer.BeginObject().Key("k\"ey").String(value).EndObject();
+  }
+  CPPUNIT_ASSERT_EQUAL(std::string("{\"k\\\"ey\":\"quote \\\" slash \\\\ \\b\\f\\n\\r\\t "
+      "\\u0001\\u001f caf\xc3\xa9 </\\u0000\"}"), text);
+
+  // What the writer escapes, the scanner reads back.
+  JsonScanner scanner(text.data(), text.size());
+  std::string key;
+  scanner.BeginObject();
+  CPPUNIT_ASSERT(scanner.NextMember(key));
+  CPPUNIT_ASSERT_EQUAL(std::string("k\"ey"), key);
+  std::string expected("quote \" slash \\ \b\f\n\r\t \x01\x1f caf\xc3\xa9 </");
+  expected.push_back('\0');
+  CPPUNIT_ASSERT_EQUAL(expected, scanner.ReadString());
+}
+
+void JsonWriterTest::TestNumbers() {
+  std::string text;
+  {
+    JsonWriter writer(text);
+    writer.BeginArray();
+    writer.Integer(std::numeric_limits<int64_t>::min());
+    writer.Unsigned(std::numeric_limits<uint64_t>::max());
+    writer.Number(0.1).Number(-2.5).Number(1e300).Number(3.0).Number(1.0 / 3.0);
+    writer.EndArray();
+  }
+  CPPUNIT_ASSERT_EQUAL(std::string("[-9223372036854775808,18446744073709551615,0.1,-2.5,"
+      "1e+300,3,0.33333333333333331]"), text);
+
+  JsonScanner scanner(text.data(), text.size());
+  scanner.BeginArray();
+  for (int i = 0; i < 6; i++) {
+    CPPUNIT_ASSERT(scanner.NextElement());
+    scanner.Skip();
+  }
+  CPPUNIT_ASSERT(scanner.NextElement());
+  CPPUNIT_ASSERT_EQUAL(1.0 / 3.0, scanner.ReadNumber());
+
+  JsonWriter writer(text);
+  CPPUNIT_ASSERT_THROW(writer.Number(std::numeric_limits<double>::quiet_NaN()),
+      JsonWriteException);
+  CPPUNIT_ASSERT_THROW(writer.Number(std::numeric_limits<double>::infinity()),
+      JsonWriteException);
+}
+
+void JsonWriterTest::TestMisuse() {
+  std::string text;
+  JsonWriter object(text);
+  object.BeginObject();
+  CPPUNIT_ASSERT_THROW(object.String("no key"), JsonWriteException);
+  CPPUNIT_ASSERT_THROW(object.EndArray(), JsonWriteException);
+  object.Key("a");
+  CPPUNIT_ASSERT_THROW(object.Key("b"), JsonWriteException);
+  CPPUNIT_ASSERT_THROW(object.EndObject(), JsonWriteException);
+  object.Null().EndObject();
+  CPPUNIT_ASSERT(object.Complete());
+  CPPUNIT_ASSERT_THROW(object.Null(), JsonWriteException);
+
+  JsonWriter array(text);
+  array.BeginArray();
+  CPPUNIT_ASSERT_THROW(array.Key("a"), JsonWriteException);
+  CPPUNIT_ASSERT_THROW(array.EndObject(), JsonWriteException);
+  CPPUNIT_ASSERT(!array.Complete());
+}
+
+void JsonWriterTest::TestBuffering() {
+  std::vector<size_t> calls;
+  std::string text;
+  {
+    JsonWriter writer([&calls, &text](const char* data, const size_t& size) {
+      calls.push_back(size);
+      text.append(data, size);
+    }, 16);
+    writer.BeginArray();
+    for (int i = 0; i < 10; i++) {
+      writer.String("value");
+    }
+    CPPUNIT_ASSERT(!calls.empty());
+    writer.String(std::string(40, 'x'));
+    writer.EndArray();
+  }
+  // Small values are gathered; a run longer than the buffer goes straight
+  // to the sink.
+  for (auto& size : calls) {
+    CPPUNIT_ASSERT(size <= 16 || size == 40);
+  }
+  std::string expected = "[";
+  for (int i = 0; i < 10; i++) {
+    expected += "\"value\",";
+  }
+  expected += "\"" + std::string(40, 'x') + "\"]";
+  CPPUNIT_ASSERT_EQUAL(expected, text);
+}
+
+void JsonWriterTest::TestStreamingPut() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+  unsigned calls = 0;
+  Response response = proxy.Put(ADDRESS, "/v1/documents?uri=/stream.json",
+      [&calls](JsonWriter& writer) {
+    calls++;
+    writer.BeginObject().Key("items").BeginArray();
+    for (int i = 0; i < 10000; i++) {
+      writer.Integer(i);
+    }
+    writer.EndArray().EndObject();
+  });
+  CPPUNIT_ASSERT(ResponseCodes::CREATED == response.GetResponseCode());
+  // Once to be challenged, once to be written.
+  CPPUNIT_ASSERT_EQUAL(2u, calls);
+
+  response = proxy.Get(ADDRESS, "/v1/documents?uri=/stream.json");
+  web::json::value stored = response.Json();
+  CPPUNIT_ASSERT_EQUAL(9999, stored["items"][9999].as_integer());
+
+  // A body that is not finished is not sent.
+  response = proxy.Post(ADDRESS, "/v1/documents?extension=json", [](JsonWriter& writer) {
+    writer.BeginObject().Key("partial");
+  });
+  CPPUNIT_ASSERT(ResponseCodes::CREATED != response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, server.DocumentCount());
+
+  server.Stop();
+}
@@ -0,0 +1,37 @@
+/*
+ * File:   JsonWriterTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef JSONWRITERTEST_HPP
+#define	JSONWRITERTEST_HPP
+
+class JsonWriterTest : public CppUnit::TestCase {
+public:
+    JsonWriterTest();
+    JsonWriterTest(const JsonWriterTest& orig);
+    virtual ~JsonWriterTest();
+
+    void TestContainers();
+    void TestEscapes();
+    void TestNumbers();
+    void TestMisuse();
+    void TestBuffering();
+    void TestStreamingPut();
+private:
+    CPPUNIT_TEST_SUITE(JsonWriterTest);
+    CPPUNIT_TEST(TestContainers);
+    CPPUNIT_TEST(TestEscapes);
+    CPPUNIT_TEST(TestNumbers);
+    CPPUNIT_TEST(TestMisuse);
+    CPPUNIT_TEST(TestBuffering);
+    CPPUNIT_TEST(TestStreamingPut);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* JSONWRITERTEST_HPP */
@@ -0,0 +1,98 @@
+/*
+ * File:   LatencyHistogramTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LatencyHistogramTest.hpp"
+#include "LatencyHistogram.hpp"
+#include "LatencyRegistry.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LatencyHistogramTest);
+
+LatencyHistogramTest::LatencyHistogramTest() {
+}
+
+LatencyHistogramTest::LatencyHistogramTest(const LatencyHistogramTest& orig) {
+}
+
+LatencyHistogramTest::~LatencyHistogramTest() {
+}
+
+void LatencyHistogramTest::TestBucketPrecision() {
+  uint32_t previous = 0;
+  for (uint64_t value = 0; value < 1000000; value += 7) {
+    uint32_t index = LatencyHistogram::BucketIndex(value);
+    uint64_t bucket = LatencyHistogram::BucketValue(index);
+
+    CPPUNIT_ASSERT(index >= previous);
+    CPPUNIT_ASSERT(bucket >= value);
+    CPPUNIT_ASSERT(bucket - value <= value / 64 + 1);
+    previous = index;
+  }
+
+  CPPUNIT_ASSERT(LatencyHistogram::BucketIndex(UINT64_MAX) < LatencyHistogram::BUCKET_COUNT);
+}
+
+void LatencyHistogramTest::TestPercentiles() {
+  LatencyHistogram histogram;
+  for (uint64_t i = 1; i <= 10000; i++) {
+    histogram.Record(i * 1000);
+  }
+
+  LatencySnapshot snapshot = histogram.Snapshot();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)10000, snapshot.Count());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)10000000, snapshot.Max());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(5000000.0, (double)snapshot.Percentile(50.0), 80000.0);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(9900000.0, (double)snapshot.Percentile(99.0), 160000.0);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(9990000.0, (double)snapshot.Percentile(99.9), 160000.0);
+
+  histogram.Reset();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, histogram.Snapshot().Count());
+}
+
+void LatencyHistogramTest::TestMergeAcrossThreads() {
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 8; t++) {
+    threads.push_back(std::thread([&histogram, t]() {
+      for (uint64_t i = 0; i < 1000; i++) {
+        histogram.Record(100 + t);
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  LatencySnapshot snapshot = histogram.Snapshot();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)8000, snapshot.Count());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)107, snapshot.Max());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)100, snapshot.Percentile(0.0));
+}
+
+void LatencyHistogramTest::TestEndpointTemplate() {
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/documents"),
+      LatencyRegistry::EndpointTemplate("/v1/documents?uri=/document/test.json"));
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/search"),
+      LatencyRegistry::EndpointTemplate("/v1/search"));
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/transactions/*"),
+      LatencyRegistry::EndpointTemplate("/v1/transactions/8711921934"));
+
+  LatencyHistogram& first = LatencyRegistry::Instance()->Histogram("GET", "/v1/documents?uri=/a.json");
+  LatencyHistogram& second = LatencyRegistry::Instance()->Histogram("GET", "/v1/documents?uri=/b.json");
+  CPPUNIT_ASSERT(&first == &second);
+  CPPUNIT_ASSERT(&first != &LatencyRegistry::Instance()->Histogram("PUT", "/v1/documents?uri=/a.json"));
+  CPPUNIT_ASSERT(&first != &LatencyRegistry::Instance()->Histogram("GET", "/v1/documents/a.json"));
+  CPPUNIT_ASSERT(&first == &LatencyRegistry::Instance()->Histogram("GET", "/v1/documents"));
+
+  // Methods without a slot of their own go to the registry each time.
+  LatencyHistogram& options = LatencyRegistry::Instance()->Histogram("OPTIONS", "/v1/search");
+  CPPUNIT_ASSERT(&options == &LatencyRegistry::Instance()->Histogram("OPTIONS", "/v1/search?q=a"));
+  CPPUNIT_ASSERT(LatencyRegistry::Instance()->Snapshot().count("OPTIONS /v1/search") == 1);
+}
@@ -0,0 +1,33 @@
+/*
+ * File:   LatencyHistogramTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef LATENCYHISTOGRAMTEST_HPP
+#define	LATENCYHISTOGRAMTEST_HPP
+
+class LatencyHistogramTest : public CppUnit::TestCase {
+public:
+    LatencyHistogramTest();
+    LatencyHistogramTest(const LatencyHistogramTest& orig);
+    virtual ~LatencyHistogramTest();
+
+    void TestBucketPrecision();
+    void TestPercentiles();
+    void TestMergeAcrossThreads();
+    void TestEndpointTemplate();
+private:
+    CPPUNIT_TEST_SUITE(LatencyHistogramTest);
+    CPPUNIT_TEST(TestBucketPrecision);
+    CPPUNIT_TEST(TestPercentiles);
+    CPPUNIT_TEST(TestMergeAcrossThreads);
+    CPPUNIT_TEST(TestEndpointTemplate);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* LATENCYHISTOGRAMTEST_HPP */
@@ -0,0 +1,121 @@
+/*
+ * File:   LoggerTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "LoggerTest.hpp"
+#include "Logger.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LoggerTest);
+
+namespace {
+
+class CaptureSink : public LogSink {
+public:
+    std::mutex mutex;
+    std::vector<LogRecord> records;
+
+    virtual void Write(const LogRecord& record) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        records.push_back(record);
+    }
+};
+
+std::shared_ptr<CaptureSink> capture;
+LogLevel saved_level;
+
+}
+
+LoggerTest::LoggerTest() {
+}
+
+LoggerTest::LoggerTest(const LoggerTest& orig) {
+}
+
+LoggerTest::~LoggerTest() {
+}
+
+void LoggerTest::setUp() {
+  saved_level = Logger::Instance()->Level();
+  capture.reset(new CaptureSink());
+  Logger::Instance()->SetSink(capture);
+}
+
+void LoggerTest::tearDown() {
+  Logger::Instance()->SetLevel(saved_level);
+}
+
+void LoggerTest::TestLevelFilter() {
+  Logger::Instance()->SetLevel(LogLevel::WARNING);
+
+  int built = 0;
+  MLLOG(LogLevel::FINE).Message("filtered").Field("count", ++built);
+  MLLOG(LogLevel::SEVERE).Message("kept");
+
+  CPPUNIT_ASSERT_EQUAL(0, built);
+  CPPUNIT_ASSERT_EQUAL((size_t)1, capture->records.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("kept"), std::string(capture->records[0].message));
+
+  Logger::Instance()->SetLevel(LogLevel::OFF);
+  MLLOG(LogLevel::SEVERE).Message("off");
+  CPPUNIT_ASSERT_EQUAL((size_t)1, capture->records.size());
+}
+
+void LoggerTest::TestFields() {
+  Logger::Instance()->SetLevel(LogLevel::TRACE);
+
+  MLLOG(LogLevel::INFO).Message("Request failed")
+      .Field("method", "GET")
+      .Field("path", std::string("/v1/documents"))
+      .Field("status", 401);
+
+  CPPUNIT_ASSERT_EQUAL((size_t)1, capture->records.size());
+  const LogRecord& record = capture->records[0];
+  CPPUNIT_ASSERT(LogLevel::INFO == record.level);
+  CPPUNIT_ASSERT_EQUAL(3, record.field_count);
+  CPPUNIT_ASSERT_EQUAL(std::string("method"), std::string(record.fields[0].key));
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/documents"), std::string(record.fields[1].value));
+  CPPUNIT_ASSERT_EQUAL(std::string("401"), std::string(record.fields[2].value));
+}
+
+void LoggerTest::TestAsyncSink() {
+  Logger::Instance()->SetLevel(LogLevel::TRACE);
+  std::shared_ptr<AsyncLogSink> async(new AsyncLogSink(capture, 16, 60000));
+  Logger::Instance()->SetSink(async);
+
+  for (int i = 0; i < 20; i++) {
+    MLLOG(LogLevel::INFO).Message("burst").Field("i", i);
+  }
+  CPPUNIT_ASSERT_EQUAL((uint64_t)4, async->Dropped());
+
+  Logger::Instance()->Flush();
+  CPPUNIT_ASSERT_EQUAL((size_t)16, capture->records.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("0"), std::string(capture->records[0].fields[0].value));
+}
+
+void LoggerTest::TestFormat() {
+  LogRecord record;
+  record.level = LogLevel::SEVERE;
+  record.timestamp_ns = 1404817260123000000ULL;
+  record.thread_id = 3;
+  std::string message = "Request failed";
+  message.copy(record.message, message.size());
+  record.message[message.size()] = '\0';
+  record.field_count = 1;
+  record.fields[0].key = "error";
+  std::string error = "connection \"reset\"";
+  error.copy(record.fields[0].value, error.size());
+  record.fields[0].value[error.size()] = '\0';
+
+  std::ostringstream os;
+  StreamLogSink::Format(os, record);
+  CPPUNIT_ASSERT_EQUAL(
+      std::string("2014-07-08T11:01:00.123Z SEVERE [3] Request failed error=\"connection \\\"reset\\\"\""),
+      os.str());
+}
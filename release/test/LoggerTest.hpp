@@ -0,0 +1,36 @@
+/*
+ * File:   LoggerTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef LOGGERTEST_HPP
+#define	LOGGERTEST_HPP
+
+class LoggerTest : public CppUnit::TestCase {
+public:
+    LoggerTest();
+    LoggerTest(const LoggerTest& orig);
+    virtual ~LoggerTest();
+
+    void setUp();
+    void tearDown();
+
+    void TestLevelFilter();
+    void TestFields();
+    void TestAsyncSink();
+    void TestFormat();
+private:
+    CPPUNIT_TEST_SUITE(LoggerTest);
+    CPPUNIT_TEST(TestLevelFilter);
+    CPPUNIT_TEST(TestFields);
+    CPPUNIT_TEST(TestAsyncSink);
+    CPPUNIT_TEST(TestFormat);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* LOGGERTEST_HPP */
@@ -43,3 +43,23 @@ void MLCryptoTest::TestMd5() {
   
   CPPUNIT_ASSERT_EQUAL(expected, crypto.Md5("test"));
 }
+
+void MLCryptoTest::TestFastHash() {
+  MLCrypto crypto;
+
+  // Reference values from the xxHash library's XXH64
+  CPPUNIT_ASSERT_EQUAL(std::string("ef46db3751d8e999"), crypto.FastHash(""));
+  CPPUNIT_ASSERT_EQUAL(std::string("44bc2cf5ad770999"), crypto.FastHash("abc"));
+  CPPUNIT_ASSERT_EQUAL(std::string("4fdcca5ddb678139"), crypto.FastHash("test"));
+
+  // Long enough for the four lane loop, with every tail length after it
+  std::string bytes;
+  for (int i = 0; i < 4 * 256; i++) {
+    bytes.push_back((char)(i % 256));
+  }
+  bytes += "xxx";
+  const uint8_t* data = (const uint8_t*)bytes.data();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0xc95d3dce57f86693ULL, crypto.FastHash(data, bytes.size()));
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0xd93fa2dfee5c24c9ULL, crypto.FastHash(data, 37));
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0x85a55723f775214eULL, crypto.FastHash(data, bytes.size(), 7));
+}
@@ -20,11 +20,13 @@ public:
     
     void TestToHex();
     void TestMd5();
+    void TestFastHash();
 private:
 
     CPPUNIT_TEST_SUITE(MLCryptoTest);
     CPPUNIT_TEST(TestToHex);
     CPPUNIT_TEST(TestMd5);
+    CPPUNIT_TEST(TestFastHash);
     CPPUNIT_TEST_SUITE_END();
 };
 
@@ -0,0 +1,101 @@
+/*
+ * File:   MultipartTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <string>
+#include "MultipartTest.hpp"
+#include "Multipart.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MultipartTest);
+
+namespace {
+
+// The shape of a MarkLogic 9 response to
+// GET /v1/documents?uri=/a.json&uri=/b.xml with Accept: multipart/mixed.
+const std::string BULK =
+    "--ML_BOUNDARY_7\r\n"
+    "Content-Type: application/json\r\n"
+    "Content-Disposition: attachment; filename=\"/a.json\"; category=content; format=json\r\n"
+    "Content-Length: 13\r\n"
+    "vnd.marklogic.document-format: json\r\n"
+    "\r\n"
+    "{\"a\":\"--ML\"}\n"
+    "\r\n"
+    "--ML_BOUNDARY_7\r\n"
+    "Content-Type: application/xml\r\n"
+    "Content-Disposition: attachment; filename=\"/b.xml\"; category=content; format=xml\r\n"
+    "\r\n"
+    "<b>\r\n</b>"
+    "\r\n"
+    "--ML_BOUNDARY_7--\r\n";
+
+}
+
+MultipartTest::MultipartTest() {
+
+}
+
+MultipartTest::MultipartTest(const MultipartTest& orig) {
+
+}
+
+MultipartTest::~MultipartTest() {
+
+}
+
+void MultipartTest::TestBulkRead() {
+  MultipartReader reader(BULK, "ML_BOUNDARY_7");
+  MultipartPart part;
+
+  CPPUNIT_ASSERT(reader.Next(part));
+  CPPUNIT_ASSERT_EQUAL(std::string("/a.json"), part.Filename());
+  CPPUNIT_ASSERT_EQUAL(std::string("application/json"), part.Header("Content-Type"));
+  CPPUNIT_ASSERT_EQUAL(std::string("json"), part.Header("VND.MARKLOGIC.DOCUMENT-FORMAT"));
+  CPPUNIT_ASSERT_EQUAL(std::string("{\"a\":\"--ML\"}\n"), part.Content());
+  CPPUNIT_ASSERT_EQUAL((size_t)13, part.size);
+
+  CPPUNIT_ASSERT(reader.Next(part));
+  CPPUNIT_ASSERT_EQUAL(std::string("/b.xml"), part.Filename());
+  CPPUNIT_ASSERT_EQUAL(std::string("<b>\r\n</b>"), part.Content());
+  CPPUNIT_ASSERT_EQUAL(std::string(), part.Header("Content-Length"));
+
+  CPPUNIT_ASSERT(!reader.Next(part));
+  CPPUNIT_ASSERT(!reader.Next(part));
+}
+
+void MultipartTest::TestParameters() {
+  CPPUNIT_ASSERT_EQUAL(std::string("ML_BOUNDARY_7"),
+      MultipartReader::Boundary("multipart/mixed; boundary=ML_BOUNDARY_7"));
+  CPPUNIT_ASSERT_EQUAL(std::string("a b"),
+      MultipartReader::Boundary("multipart/mixed; Boundary=\"a b\"; charset=utf-8"));
+  CPPUNIT_ASSERT_EQUAL(std::string(), MultipartReader::Boundary("application/json"));
+
+  std::string disposition = "attachment; myfilename=\"no\"; filename=/c.txt; format=text";
+  CPPUNIT_ASSERT_EQUAL(std::string("/c.txt"),
+      MultipartReader::Parameter(disposition, "filename"));
+  CPPUNIT_ASSERT_EQUAL(std::string("text"), MultipartReader::Parameter(disposition, "format"));
+}
+
+void MultipartTest::TestEmpty() {
+  std::string body = "--X--\r\n";
+  MultipartReader reader(body, "X");
+  MultipartPart part;
+  CPPUNIT_ASSERT(!reader.Next(part));
+}
+
+void MultipartTest::TestMalformed() {
+  CPPUNIT_ASSERT_THROW(MultipartReader(BULK, ""), MultipartException);
+  CPPUNIT_ASSERT_THROW(MultipartReader(BULK, "OTHER"), MultipartException);
+
+  std::string truncated = BULK.substr(0, BULK.size() - 25);
+  MultipartReader reader(truncated, "ML_BOUNDARY_7");
+  MultipartPart part;
+  CPPUNIT_ASSERT(reader.Next(part));
+  CPPUNIT_ASSERT_THROW(reader.Next(part), MultipartException);
+
+  std::string bad_header = "--X\r\nNo colon here\r\n\r\nbody\r\n--X--";
+  MultipartReader bad(bad_header, "X");
+  CPPUNIT_ASSERT_THROW(bad.Next(part), MultipartException);
+}
@@ -0,0 +1,33 @@
+/*
+ * File:   MultipartTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef MULTIPARTTEST_HPP
+#define	MULTIPARTTEST_HPP
+
+class MultipartTest : public CppUnit::TestCase {
+public:
+    MultipartTest();
+    MultipartTest(const MultipartTest& orig);
+    virtual ~MultipartTest();
+
+    void TestBulkRead();
+    void TestParameters();
+    void TestEmpty();
+    void TestMalformed();
+private:
+    CPPUNIT_TEST_SUITE(MultipartTest);
+    CPPUNIT_TEST(TestBulkRead);
+    CPPUNIT_TEST(TestParameters);
+    CPPUNIT_TEST(TestEmpty);
+    CPPUNIT_TEST(TestMalformed);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* MULTIPARTTEST_HPP */
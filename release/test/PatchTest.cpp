@@ -0,0 +1,116 @@
+/*
+ * File:   PatchTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <string>
+#include <vector>
+#include "PatchTest.hpp"
+#include "Patch.hpp"
+#include "AuthenticatingProxy.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PatchTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8391";
+
+}
+
+PatchTest::PatchTest() {
+
+}
+
+PatchTest::PatchTest(const PatchTest& orig) {
+
+}
+
+PatchTest::~PatchTest() {
+
+}
+
+void PatchTest::TestJsonPatch() {
+  PatchBuilder patch;
+  CPPUNIT_ASSERT_EQUAL(std::string("{\"patch\":[]}"), patch.Body());
+
+  patch.Insert("/history", PatchPosition::LAST_CHILD, "{\"shipped\":\"2014-06-01\"}")
+       .Replace("/status", patch.Quote("shipped"), "?")
+       .Delete("/pending")
+       .ReplaceInsert("total", "/order", PatchPosition::FIRST_CHILD, "12.5");
+  CPPUNIT_ASSERT_EQUAL((size_t)4, patch.Operations());
+  CPPUNIT_ASSERT_EQUAL(std::string("application/json"), patch.ContentType());
+  CPPUNIT_ASSERT_EQUAL(std::string("{\"patch\":["
+      "{\"insert\":{\"context\":\"/history\",\"position\":\"last-child\","
+      "\"content\":{\"shipped\":\"2014-06-01\"}}},"
+      "{\"replace\":{\"select\":\"/status\",\"cardinality\":\"?\",\"content\":\"shipped\"}},"
+      "{\"delete\":{\"select\":\"/pending\"}},"
+      "{\"replace-insert\":{\"select\":\"total\",\"context\":\"/order\","
+      "\"position\":\"first-child\",\"content\":12.5}}]}"), patch.Body());
+}
+
+void PatchTest::TestXmlPatch() {
+  PatchBuilder patch(PatchFormat::XML);
+  patch.Insert("/order/item[@sku=\"A&B\"]", PatchPosition::AFTER, "<item sku=\"C\"/>")
+       .Replace("/order/status", "<status>shipped</status>")
+       .Delete("/order/pending", "?");
+  CPPUNIT_ASSERT_EQUAL(std::string("application/xml"), patch.ContentType());
+  CPPUNIT_ASSERT_EQUAL(std::string(
+      "<rapi:patch xmlns:rapi=\"http://marklogic.com/rest-api\">"
+      "<rapi:insert context=\"/order/item[@sku=&quot;A&amp;B&quot;]\" position=\"after\">"
+      "<item sku=\"C\"/></rapi:insert>"
+      "<rapi:replace select=\"/order/status\"><status>shipped</status></rapi:replace>"
+      "<rapi:delete select=\"/order/pending\" cardinality=\"?\"/>"
+      "</rapi:patch>"), patch.Body());
+}
+
+void PatchTest::TestQuote() {
+  PatchBuilder json;
+  CPPUNIT_ASSERT_EQUAL(std::string("\"say \\\"hi\\\"\\n\\\\ \\u0001\""),
+      json.Quote("say \"hi\"\n\\ \x01"));
+  PatchBuilder xml(PatchFormat::XML);
+  CPPUNIT_ASSERT_EQUAL(std::string("a &lt;b&gt; &amp; c"), xml.Quote("a <b> & c"));
+}
+
+void PatchTest::TestPath() {
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/documents?uri=%2Forders%2F1.json"),
+      PatchBuilder::Path("/orders/1.json"));
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/documents?uri=%2Forders%2F1.json&category=metadata"),
+      PatchBuilder::Path("/orders/1.json", true));
+}
+
+void PatchTest::TestPatcher() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Seed(40);
+  server.Start();
+
+  Patcher patcher(ADDRESS, Credentials(config.username, config.password), 4);
+  PatchBuilder patch;
+  patch.Replace("/status", patch.Quote("shipped"));
+  for (int i = 0; i < 40; i++) {
+    patcher.Add("/bench/" + std::to_string(i) + ".json", patch);
+  }
+  patcher.Add("/bench/missing.json", patch);
+
+  PatchBuilder metadata;
+  metadata.Insert("/collections", PatchPosition::LAST_CHILD, metadata.Quote("shipped"));
+  patcher.Add("/bench/7.json", metadata, true);
+
+  PatchSummary summary = patcher.Run();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)41, summary.applied);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, summary.failed);
+  CPPUNIT_ASSERT_EQUAL((size_t)1, summary.failures.size());
+  CPPUNIT_ASSERT(summary.failures["/bench/missing.json"].find("404") != std::string::npos);
+
+  std::vector<std::string> applied = server.Patches("/bench/39.json");
+  CPPUNIT_ASSERT_EQUAL((size_t)1, applied.size());
+  CPPUNIT_ASSERT_EQUAL(patch.Body(), applied[0]);
+  CPPUNIT_ASSERT_EQUAL(metadata.Body(), server.Patches("/bench/7.json#metadata")[0]);
+
+  // The queue is emptied by Run.
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, patcher.Run().applied);
+  server.Stop();
+}
@@ -0,0 +1,35 @@
+/*
+ * File:   PatchTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef PATCHTEST_HPP
+#define	PATCHTEST_HPP
+
+class PatchTest : public CppUnit::TestCase {
+public:
+    PatchTest();
+    PatchTest(const PatchTest& orig);
+    virtual ~PatchTest();
+
+    void TestJsonPatch();
+    void TestXmlPatch();
+    void TestQuote();
+    void TestPath();
+    void TestPatcher();
+private:
+    CPPUNIT_TEST_SUITE(PatchTest);
+    CPPUNIT_TEST(TestJsonPatch);
+    CPPUNIT_TEST(TestXmlPatch);
+    CPPUNIT_TEST(TestQuote);
+    CPPUNIT_TEST(TestPath);
+    CPPUNIT_TEST(TestPatcher);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* PATCHTEST_HPP */
@@ -0,0 +1,375 @@
+/*
+ * File:   PipelineTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cpprest/containerstream.h>
+#include "PipelineTest.hpp"
+#include "Pipeline.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PipelineTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8384";
+const std::string HOST = "http://example";
+const std::string CHALLENGE = "Digest realm=\"public\", qop=\"auth\", "
+    "nonce=\"79e3998e2a65a2bbb69c4027708f4bca\", opaque=\"5db0205ddeca8742\"";
+
+///
+/// What a FakeServer answers, and what it was asked.  A response code of
+/// zero fails the request without a response.
+///
+struct Script {
+  std::vector<ResponseCodes> codes;
+  header_t headers;
+  std::string body;
+
+  std::vector<std::string> methods;
+  std::vector<std::string> authorizations;
+  std::vector<bool> bodies;
+  header_t extra_headers;
+  std::mutex mutex;
+};
+
+///
+/// A last stage that answers from a Script instead of calling the
+/// transport.
+///
+class FakeServer {
+  std::shared_ptr<Script> _script;
+public:
+  explicit FakeServer(const std::shared_ptr<Script>& script) : _script(script) {
+  }
+
+  size_t Calls(void) const {
+    return _script->methods.size();
+  }
+
+  template<typename Next>
+  void Handle(Exchange& exchange, Next& next) {
+    Script& script = *_script;
+    std::lock_guard<std::mutex> lock(script.mutex);
+    size_t call = script.methods.size();
+    script.methods.push_back(exchange.method);
+    script.authorizations.push_back(exchange.authorization);
+    script.bodies.push_back(exchange.send_body);
+    script.extra_headers = exchange.extra_headers;
+
+    ResponseCodes code = script.codes[std::min(call, script.codes.size() - 1)];
+    if (code == (ResponseCodes)0) {
+      exchange.error = "Connection refused";
+      return;
+    }
+    exchange.response.SetResponseCode(code);
+    exchange.response.SetResponseHeaders(script.headers);
+    exchange.response.SetBody(script.body);
+  }
+};
+
+Request<NoPayload> Get(const std::string& path) {
+  return Request<NoPayload>(RequestMethod::GET, path, NO_PAYLOAD);
+}
+
+}
+
+PipelineTest::PipelineTest() {
+
+}
+
+PipelineTest::PipelineTest(const PipelineTest& orig) {
+
+}
+
+PipelineTest::~PipelineTest() {
+
+}
+
+void PipelineTest::TestGet() {
+  std::shared_ptr<Script> script(new Script());
+  script->codes.push_back(ResponseCodes::OK);
+  script->body = "{}";
+
+  typedef Pipeline<TimingStage, RecordStage, CacheStage, FakeServer> pipeline_t;
+  TimingStage timing;
+  RecordStage record;
+  CacheStage cache;
+  pipeline_t pipeline(timing, record, cache, FakeServer(script));
+  const pipeline_t& constant = pipeline;
+  CPPUNIT_ASSERT(&pipeline.Get<CacheStage>() == &constant.Get<CacheStage>());
+  CPPUNIT_ASSERT(&pipeline.Get<FakeServer>() == &constant.Get<FakeServer>());
+
+  Response response = pipeline.Send(HOST, Get("/v1/documents?uri=/a.json"));
+  CPPUNIT_ASSERT(ResponseCodes::OK == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL(std::string("{}"), response.Body());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, pipeline.Get<FakeServer>().Calls());
+
+  // A default pipeline has no credentials until they are given to its stage.
+  Pipeline<TimingStage, RecordStage, DigestAuthStage> proxy;
+  CPPUNIT_ASSERT(!proxy.Get<DigestAuthStage>().GetCredentials().Authenticating());
+}
+
+void PipelineTest::TestRetry() {
+  std::shared_ptr<Script> script(new Script());
+  script->codes.push_back(ResponseCodes::SERVICE_UNAVAILABLE);
+  script->codes.push_back(ResponseCodes::SERVICE_UNAVAILABLE);
+  script->codes.push_back(ResponseCodes::OK);
+  Pipeline<RetryStage, FakeServer> pipeline(RetryStage(3, std::chrono::milliseconds(0)),
+      FakeServer(script));
+
+  Response response = pipeline.Send(HOST, Get("/v1/documents?uri=/a.json"));
+  CPPUNIT_ASSERT(ResponseCodes::OK == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL((size_t)3, script->methods.size());
+
+  // Three tries in all, then the last answer stands.
+  script->methods.clear();
+  script->codes.assign(1, ResponseCodes::SERVICE_UNAVAILABLE);
+  response = pipeline.Send(HOST, Get("/v1/documents?uri=/a.json"));
+  CPPUNIT_ASSERT(ResponseCodes::SERVICE_UNAVAILABLE == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL((size_t)3, script->methods.size());
+
+  // No response at all is retried for a GET but not for a POST, which the
+  // server may have acted on.
+  script->methods.clear();
+  script->codes.assign(1, (ResponseCodes)0);
+  pipeline.Send(HOST, Get("/v1/documents?uri=/a.json"));
+  CPPUNIT_ASSERT_EQUAL((size_t)3, script->methods.size());
+  script->methods.clear();
+  const std::string text = "{}";
+  pipeline.Send(HOST, Request<std::string>(RequestMethod::POST, "/v1/documents", text));
+  CPPUNIT_ASSERT_EQUAL((size_t)1, script->methods.size());
+
+  // A stream is gone once sent.
+  script->methods.clear();
+  script->codes.assign(1, ResponseCodes::SERVICE_UNAVAILABLE);
+  Concurrency::streams::container_buffer<std::string> buffer(text);
+  StreamPayload payload(buffer.create_istream(), (int64_t)text.size());
+  response = pipeline.Send(HOST,
+      Request<StreamPayload>(RequestMethod::PUT, "/v1/documents?uri=/a.json", payload));
+  CPPUNIT_ASSERT(ResponseCodes::SERVICE_UNAVAILABLE == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, script->methods.size());
+}
+
+void PipelineTest::TestCache() {
+  std::shared_ptr<Script> script(new Script());
+  script->codes.push_back(ResponseCodes::OK);
+  script->body = "one";
+  Pipeline<CacheStage, FakeServer> pipeline(CacheStage(2, std::chrono::hours(1)),
+      FakeServer(script));
+  CacheStage& cache = pipeline.Get<CacheStage>();
+
+  pipeline.Send(HOST, Get("/a"));
+  script->body = "two";
+  Response response = pipeline.Send(HOST, Get("/a"));
+  CPPUNIT_ASSERT_EQUAL(std::string("one"), response.Body());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, script->methods.size());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, cache.Hits());
+
+  // Different headers are a different response.
+  header_t headers;
+  headers["Accept"] = "application/xml";
+  response = pipeline.Send(HOST, Request<NoPayload>(RequestMethod::GET, "/a", NO_PAYLOAD, headers));
+  CPPUNIT_ASSERT_EQUAL(std::string("two"), response.Body());
+  CPPUNIT_ASSERT_EQUAL((size_t)2, script->methods.size());
+
+  // A PUT drops every variant of its path, and no other path.
+  pipeline.Send(HOST, Get("/ab"));
+  const std::string text = "three";
+  pipeline.Send(HOST, Request<std::string>(RequestMethod::PUT, "/a", text));
+  CPPUNIT_ASSERT_EQUAL((size_t)4, script->methods.size());
+  pipeline.Send(HOST, Get("/ab"));
+  CPPUNIT_ASSERT_EQUAL((size_t)4, script->methods.size());
+  pipeline.Send(HOST, Get("/a"));
+  CPPUNIT_ASSERT_EQUAL((size_t)5, script->methods.size());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, cache.Hits());
+
+  // Full, so /c pushes out /ab, the older of the two.
+  pipeline.Send(HOST, Get("/c"));
+  pipeline.Send(HOST, Get("/ab"));
+  CPPUNIT_ASSERT_EQUAL((size_t)7, script->methods.size());
+
+  // Failures are not kept.
+  cache.Clear();
+  script->codes.assign(1, ResponseCodes::NOT_FOUND);
+  pipeline.Send(HOST, Get("/d"));
+  pipeline.Send(HOST, Get("/d"));
+  CPPUNIT_ASSERT_EQUAL((size_t)9, script->methods.size());
+}
+
+void PipelineTest::TestConditional() {
+  std::shared_ptr<Script> script(new Script());
+  script->codes.push_back(ResponseCodes::OK);
+  script->codes.push_back(ResponseCodes::NOT_MODIFIED);
+  script->headers["ETag"] = "\"v1\"";
+  script->body = "one";
+  Pipeline<CacheStage, FakeServer> pipeline(CacheStage(16, std::chrono::milliseconds(0)),
+      FakeServer(script));
+
+  pipeline.Send(HOST, Get("/a"));
+  CPPUNIT_ASSERT(script->extra_headers.empty());
+  script->body = "";
+  Response response = pipeline.Send(HOST, Get("/a"));
+  CPPUNIT_ASSERT_EQUAL((size_t)2, script->methods.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("\"v1\""), script->extra_headers["If-None-Match"]);
+  CPPUNIT_ASSERT(ResponseCodes::OK == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL(std::string("one"), response.Body());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, pipeline.Get<CacheStage>().Hits());
+}
+
+void PipelineTest::TestDigestAuth() {
+  std::shared_ptr<Script> script(new Script());
+  script->codes.push_back(ResponseCodes::UNAUTHORIZED);
+  script->codes.push_back(ResponseCodes::OK);
+  script->headers["WWW-Authenticate"] = CHALLENGE;
+  Pipeline<DigestAuthStage, FakeServer> pipeline(
+      DigestAuthStage(Credentials("admin", "admin")), FakeServer(script));
+
+  Response response = pipeline.Send(HOST, Get("/v1/documents?uri=/a.json"));
+  CPPUNIT_ASSERT(ResponseCodes::OK == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL((size_t)2, script->methods.size());
+  CPPUNIT_ASSERT(script->authorizations[0].empty());
+  CPPUNIT_ASSERT(script->authorizations[1].find("Digest username=") != std::string::npos);
+
+  // Signed up front from now on.
+  response = pipeline.Send(HOST, Get("/v1/documents?uri=/b.json"));
+  CPPUNIT_ASSERT(ResponseCodes::OK == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL((size_t)3, script->methods.size());
+  CPPUNIT_ASSERT(!script->authorizations[2].empty());
+  CPPUNIT_ASSERT(pipeline.Get<DigestAuthStage>().GetCredentials().Authenticating());
+}
+
+void PipelineTest::TestSendOnce() {
+  std::shared_ptr<Script> script(new Script());
+  script->codes.push_back(ResponseCodes::UNAUTHORIZED);
+  script->codes.push_back(ResponseCodes::CREATED);
+  script->headers["WWW-Authenticate"] = CHALLENGE;
+  Pipeline<DigestAuthStage, FakeServer> pipeline(
+      DigestAuthStage(Credentials("admin", "admin")), FakeServer(script));
+
+  // The challenge comes from a HEAD without the body, so the stream is
+  // sent once, signed.
+  const std::string text = "{}";
+  Concurrency::streams::container_buffer<std::string> buffer(text);
+  StreamPayload payload(buffer.create_istream(), (int64_t)text.size());
+  Response response = pipeline.Send(HOST,
+      Request<StreamPayload>(RequestMethod::PUT, "/v1/documents?uri=/a.json", payload));
+  CPPUNIT_ASSERT(ResponseCodes::CREATED == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL((size_t)2, script->methods.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("HEAD"), script->methods[0]);
+  CPPUNIT_ASSERT(!script->bodies[0]);
+  CPPUNIT_ASSERT_EQUAL(std::string("PUT"), script->methods[1]);
+  CPPUNIT_ASSERT(script->bodies[1]);
+  CPPUNIT_ASSERT(!script->authorizations[1].empty());
+}
+
+void PipelineTest::TestOptionalStages() {
+  std::shared_ptr<Script> script(new Script());
+  script->codes.push_back(ResponseCodes::SERVICE_UNAVAILABLE);
+  script->codes.push_back(ResponseCodes::OK);
+
+  // Off, the retry stage passes the 503 straight back.
+  typedef Pipeline<StageFunctions, OptionalStage<RetryStage>, FakeServer> pipeline_t;
+  StageFunctions none;
+  OptionalStage<RetryStage> off;
+  pipeline_t plain(none, off, FakeServer(script));
+  Response response = plain.Send(HOST, Get("/a"));
+  CPPUNIT_ASSERT(ResponseCodes::SERVICE_UNAVAILABLE == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, script->methods.size());
+
+  // On, with a stage of the caller's in front that adds a header.
+  std::vector<StageFunction> stages;
+  size_t calls = 0;
+  stages.push_back([&calls](Exchange& exchange, const std::function<void(Exchange&)>& send) {
+    calls++;
+    exchange.extra_headers["X-Request-Source"] = "test";
+    send(exchange);
+  });
+  script->methods.clear();
+  StageFunctions tagging(stages);
+  OptionalStage<RetryStage> on(RetryStage(3, std::chrono::milliseconds(0)));
+  pipeline_t retrying(tagging, on, FakeServer(script));
+  response = retrying.Send(HOST, Get("/a"));
+  CPPUNIT_ASSERT(ResponseCodes::OK == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL((size_t)2, script->methods.size());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, calls);
+  CPPUNIT_ASSERT_EQUAL(std::string("test"), script->extra_headers["X-Request-Source"]);
+}
+
+void PipelineTest::TestConcurrentSigning() {
+  std::shared_ptr<Script> script(new Script());
+  script->codes.push_back(ResponseCodes::UNAUTHORIZED);
+  script->codes.push_back(ResponseCodes::OK);
+  script->headers["WWW-Authenticate"] = CHALLENGE;
+  Pipeline<DigestAuthStage, FakeServer> pipeline(
+      DigestAuthStage(Credentials("admin", "admin")), FakeServer(script));
+  pipeline.Send(HOST, Get("/a"));
+
+  // Threads sharing the stage each get a nonce count of their own.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.push_back(std::thread([&pipeline]() {
+      for (int i = 0; i < 50; i++) {
+        pipeline.Send(HOST, Get("/a"));
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::set<std::string> counts;
+  for (size_t i = 2; i < script->authorizations.size(); i++) {
+    const std::string& authorization = script->authorizations[i];
+    size_t nc = authorization.find("nc=");
+    CPPUNIT_ASSERT(nc != std::string::npos);
+    counts.insert(authorization.substr(nc, 11));
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t)200, counts.size());
+}
+
+void PipelineTest::TestConnectionPool() {
+  ConnectionPool pool;
+  std::shared_ptr<web::http::client::http_client> client = pool.Client(HOST);
+  CPPUNIT_ASSERT(client == pool.Client(HOST));
+  CPPUNIT_ASSERT(client != pool.Client("http://otherhost:8000"));
+
+  // Copies, such as those in ProxyOptions, share the clients.
+  ConnectionPool copy(pool);
+  CPPUNIT_ASSERT(client == copy.Client(HOST));
+  CPPUNIT_ASSERT(client != ConnectionPool().Client(HOST));
+}
+
+void PipelineTest::TestServer() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  Pipeline<CacheStage, DigestAuthStage> pipeline(CacheStage(),
+      DigestAuthStage(Credentials(config.username, config.password)));
+  const std::string path = "/v1/documents?uri=/cached.json";
+  const std::string first = "{\"version\":1}";
+  Response response = pipeline.Send(ADDRESS, Request<std::string>(RequestMethod::PUT, path, first));
+  CPPUNIT_ASSERT(ResponseCodes::CREATED == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL(first, pipeline.Send(ADDRESS, Get(path)).Body());
+
+  uint64_t requests = server.Requests();
+  CPPUNIT_ASSERT_EQUAL(first, pipeline.Send(ADDRESS, Get(path)).Body());
+  CPPUNIT_ASSERT_EQUAL(requests, server.Requests());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, pipeline.Get<CacheStage>().Hits());
+
+  const std::string second = "{\"version\":2}";
+  pipeline.Send(ADDRESS, Request<std::string>(RequestMethod::PUT, path, second));
+  CPPUNIT_ASSERT_EQUAL(second, pipeline.Send(ADDRESS, Get(path)).Body());
+  server.Stop();
+}
@@ -0,0 +1,45 @@
+/*
+ * File:   PipelineTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef PIPELINETEST_HPP
+#define	PIPELINETEST_HPP
+
+class PipelineTest : public CppUnit::TestCase {
+public:
+    PipelineTest();
+    PipelineTest(const PipelineTest& orig);
+    virtual ~PipelineTest();
+
+    void TestGet();
+    void TestRetry();
+    void TestCache();
+    void TestConditional();
+    void TestDigestAuth();
+    void TestSendOnce();
+    void TestOptionalStages();
+    void TestConcurrentSigning();
+    void TestConnectionPool();
+    void TestServer();
+private:
+    CPPUNIT_TEST_SUITE(PipelineTest);
+    CPPUNIT_TEST(TestGet);
+    CPPUNIT_TEST(TestRetry);
+    CPPUNIT_TEST(TestCache);
+    CPPUNIT_TEST(TestConditional);
+    CPPUNIT_TEST(TestDigestAuth);
+    CPPUNIT_TEST(TestSendOnce);
+    CPPUNIT_TEST(TestOptionalStages);
+    CPPUNIT_TEST(TestConcurrentSigning);
+    CPPUNIT_TEST(TestConnectionPool);
+    CPPUNIT_TEST(TestServer);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* PIPELINETEST_HPP */
@@ -0,0 +1,179 @@
+/*
+ * File:   RequestTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <cpprest/containerstream.h>
+#include <libxml/parser.h>
+#include "RequestTest.hpp"
+#include "AuthenticatingProxy.hpp"
+#include "Request.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RequestTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8385";
+const std::string FILE_PATH = "mlcpptest-request.json";
+
+}
+
+RequestTest::RequestTest() {
+
+}
+
+RequestTest::RequestTest(const RequestTest& orig) {
+
+}
+
+RequestTest::~RequestTest() {
+
+}
+
+void RequestTest::TestMethodNames() {
+  CPPUNIT_ASSERT_EQUAL(std::string("GET"), std::string(MethodName(RequestMethod::GET)));
+  CPPUNIT_ASSERT_EQUAL(std::string("PATCH"), std::string(MethodName(RequestMethod::PATCH)));
+  CPPUNIT_ASSERT_EQUAL(std::string("DELETE"), std::string(MethodName(RequestMethod::DEL)));
+  CPPUNIT_ASSERT_EQUAL(std::string("HEAD"), std::string(MethodName(RequestMethod::HEAD)));
+}
+
+void RequestTest::TestPayloadTraits() {
+  // A string goes as it is, without a copy.
+  std::string text = "{\"a\":1}";
+  std::string scratch;
+  CPPUNIT_ASSERT(&text == &PayloadTraits<std::string>::Serialize(text, scratch));
+  CPPUNIT_ASSERT(scratch.empty());
+  CPPUNIT_ASSERT_EQUAL((int64_t)7,
+      PayloadTraits<RawPayload>::Length(RawPayload((const uint8_t*)text.data(), text.size())));
+
+  std::wstring wide = L"café";
+  CPPUNIT_ASSERT_EQUAL(std::string("caf\xc3\xa9"),
+      PayloadTraits<std::wstring>::Serialize(wide, scratch));
+
+  // A document is streamed, so its length is not known up front.
+  xmlDocPtr document = xmlReadMemory("<a><b>1</b></a>", 15, "request.xml", "UTF-8", 0);
+  std::string xml = PayloadTraits<xmlDocPtr>::Recorded(document);
+  CPPUNIT_ASSERT(xml.find("<a><b>1</b></a>") != std::string::npos);
+  CPPUNIT_ASSERT(xml.compare(0, 5, "<?xml") == 0);
+  CPPUNIT_ASSERT_EQUAL((int64_t)-1, PayloadTraits<xmlDocPtr>::Length(document));
+  xmlFreeDoc(document);
+  CPPUNIT_ASSERT(PayloadTraits<xmlDocPtr>::Recorded(nullptr).empty());
+  CPPUNIT_ASSERT(!PayloadTraits<xmlDocPtr>::BUFFERED);
+  CPPUNIT_ASSERT_EQUAL(std::string("application/xml"),
+      std::string(PayloadTraits<xmlDocPtr>::ContentType()));
+
+  std::ofstream(FILE_PATH.c_str()) << text;
+  CPPUNIT_ASSERT_EQUAL((int64_t)7, PayloadTraits<FilePayload>::Length(FilePayload(FILE_PATH)));
+  std::remove(FILE_PATH.c_str());
+  CPPUNIT_ASSERT_EQUAL((int64_t)-1, PayloadTraits<FilePayload>::Length(FilePayload(FILE_PATH)));
+
+  CPPUNIT_ASSERT_EQUAL((int64_t)0, PayloadTraits<NoPayload>::Length(NO_PAYLOAD));
+  CPPUNIT_ASSERT_EQUAL((int64_t)-1, PayloadTraits<JsonBodyWriter>::Length(JsonBodyWriter()));
+  CPPUNIT_ASSERT(PayloadTraits<RawPayload>::REPLAYABLE);
+  CPPUNIT_ASSERT(!PayloadTraits<StreamPayload>::REPLAYABLE);
+  CPPUNIT_ASSERT(PayloadTraits<web::json::value>::BUFFERED);
+  CPPUNIT_ASSERT(!PayloadTraits<JsonBodyWriter>::BUFFERED);
+
+  header_t headers;
+  headers["Content-Type"] = "application/json";
+  Request<std::string> request(RequestMethod::POST, "/v1/documents", text, headers);
+  CPPUNIT_ASSERT(&headers == &request.Headers());
+  CPPUNIT_ASSERT(&text == &request.Payload());
+
+  // Temporaries are refused, since the request would outlive them.
+  CPPUNIT_ASSERT((!std::is_constructible<Request<std::string>, RequestMethod, std::string,
+      std::string>::value));
+  CPPUNIT_ASSERT((!std::is_constructible<Request<std::string>, RequestMethod, std::string,
+      const std::string&, header_t>::value));
+  CPPUNIT_ASSERT((std::is_constructible<Request<std::string>, RequestMethod, std::string,
+      const std::string&, const header_t&>::value));
+}
+
+void RequestTest::TestSend() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+  const std::string text = "{\"kind\":\"string\"}";
+  Response response = proxy.Send(ADDRESS,
+      Request<std::string>(RequestMethod::PUT, "/v1/documents?uri=/string.json", text));
+  CPPUNIT_ASSERT(ResponseCodes::CREATED == response.GetResponseCode());
+
+  // The overloads that used to do nothing go the same way.
+  response = proxy.Put(ADDRESS, "/v1/documents?uri=/wide.txt", std::wstring(L"café"));
+  CPPUNIT_ASSERT(ResponseCodes::CREATED == response.GetResponseCode());
+  xmlDocPtr document = xmlReadMemory("<a>1</a>", 8, "request.xml", "UTF-8", 0);
+  response = proxy.Post(ADDRESS, "/v1/documents?extension=xml", document);
+  xmlFreeDoc(document);
+  CPPUNIT_ASSERT(ResponseCodes::CREATED == response.GetResponseCode());
+
+  response = proxy.Send(ADDRESS,
+      Request<NoPayload>(RequestMethod::GET, "/v1/documents?uri=/wide.txt", NO_PAYLOAD));
+  CPPUNIT_ASSERT_EQUAL(std::string("caf\xc3\xa9"), response.Body());
+  response = proxy.Get(ADDRESS, "/v1/documents?uri=/string.json");
+  CPPUNIT_ASSERT_EQUAL(text, response.Body());
+
+  response = proxy.Send(ADDRESS,
+      Request<NoPayload>(RequestMethod::DEL, "/v1/documents?uri=/string.json", NO_PAYLOAD));
+  CPPUNIT_ASSERT(ResponseCodes::NO_CONTENT == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL((size_t)2, server.DocumentCount());
+  server.Stop();
+}
+
+void RequestTest::TestSendOnce() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  // The stream can be read only once, so the challenge is collected with a
+  // HEAD before it is sent.
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+  const std::string text = "{\"kind\":\"stream\"}";
+  Concurrency::streams::container_buffer<std::string> buffer(text);
+  StreamPayload payload(buffer.create_istream(), (int64_t)text.size());
+  Response response = proxy.Send(ADDRESS,
+      Request<StreamPayload>(RequestMethod::PUT, "/v1/documents?uri=/stream.json", payload));
+  CPPUNIT_ASSERT(ResponseCodes::CREATED == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, server.Challenges());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, server.Requests());
+  CPPUNIT_ASSERT_EQUAL(text, proxy.Get(ADDRESS, "/v1/documents?uri=/stream.json").Body());
+  server.Stop();
+}
+
+void RequestTest::TestLargeStreamedBody() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  // Several times what the writer may get ahead of the client, so it has
+  // to wait for the client to catch up.
+  const size_t count = 100000;
+  JsonBodyWriter write = [count](JsonWriter& writer) {
+    writer.BeginArray();
+    for (size_t i = 0; i < count; i++) {
+      writer.String("/documents/" + std::to_string(i) + ".json");
+    }
+    writer.EndArray();
+  };
+  std::string expected = PayloadTraits<JsonBodyWriter>::Recorded(write);
+  CPPUNIT_ASSERT(expected.size() > 2 * 1024 * 1024);
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+  Response response = proxy.Put(ADDRESS, "/v1/documents?uri=/large.json", write);
+  CPPUNIT_ASSERT(ResponseCodes::CREATED == response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL(expected, proxy.Get(ADDRESS, "/v1/documents?uri=/large.json").Body());
+  server.Stop();
+}
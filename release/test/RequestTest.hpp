@@ -0,0 +1,35 @@
+/*
+ * File:   RequestTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef REQUESTTEST_HPP
+#define	REQUESTTEST_HPP
+
+class RequestTest : public CppUnit::TestCase {
+public:
+    RequestTest();
+    RequestTest(const RequestTest& orig);
+    virtual ~RequestTest();
+
+    void TestMethodNames();
+    void TestPayloadTraits();
+    void TestSend();
+    void TestSendOnce();
+    void TestLargeStreamedBody();
+private:
+    CPPUNIT_TEST_SUITE(RequestTest);
+    CPPUNIT_TEST(TestMethodNames);
+    CPPUNIT_TEST(TestPayloadTraits);
+    CPPUNIT_TEST(TestSend);
+    CPPUNIT_TEST(TestSendOnce);
+    CPPUNIT_TEST(TestLargeStreamedBody);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* REQUESTTEST_HPP */
@@ -29,4 +29,16 @@ void ResponseTest::TestParseContentTypeHeader() {
   CPPUNIT_ASSERT_EQUAL(ResponseType::JSON, type);  
 }
 
-
+void ResponseTest::TestHeader() {
+  Response response;
+  CPPUNIT_ASSERT_EQUAL((int)0, (int)response.GetResponseCode());
+  CPPUNIT_ASSERT_EQUAL(std::string(), response.Header("Location"));
+
+  header_t headers;
+  headers["location"] = "/v1/transactions/1234";
+  headers["Content-Type"] = "application/json";
+  response.SetResponseHeaders(headers);
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/transactions/1234"), response.Header("Location"));
+  CPPUNIT_ASSERT_EQUAL(std::string("application/json"), response.Header("content-type"));
+  CPPUNIT_ASSERT_EQUAL(std::string(), response.Header("Content-Typ"));
+}
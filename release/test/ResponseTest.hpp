@@ -19,9 +19,11 @@ public:
     virtual ~ResponseTest();
     
     void TestParseContentTypeHeader();
+    void TestHeader();
 private:
     CPPUNIT_TEST_SUITE(ResponseTest);
     CPPUNIT_TEST(TestParseContentTypeHeader);
+    CPPUNIT_TEST(TestHeader);
     CPPUNIT_TEST_SUITE_END();
 };
 
@@ -0,0 +1,124 @@
+/*
+ * File:   SearchTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <string>
+#include <vector>
+#include "SearchTest.hpp"
+#include "Search.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SearchTest);
+
+namespace {
+
+// Trimmed from a MarkLogic 7 response to POST /v1/search?format=json.
+const std::string PAGE =
+    "{\"snippet-format\":\"snippet\", \"total\":1342, \"start\":11, \"page-length\":2, "
+    "\"results\":[{\"index\":11, \"uri\":\"/orders/1001.json\", "
+    "\"path\":\"fn:doc(\\\"/orders/1001.json\\\")\", \"score\":2048, \"confidence\":0.43, "
+    "\"fitness\":0.77, \"href\":\"/v1/documents?uri=%2Forders%2F1001.json\", "
+    "\"mimetype\":\"application/json\", \"format\":\"json\", "
+    "\"matches\":[{\"path\":\"fn:doc(\\\"/orders/1001.json\\\")/text(\\\"status\\\")\", "
+    "\"match-text\":[{\"highlight\":\"shipped\"}]}]}, "
+    "{\"index\":12, \"uri\":\"/orders/1002.json\", \"score\":1024, \"confidence\":0.3, "
+    "\"fitness\":0.5, \"mimetype\":\"application/json\", \"format\":\"json\", \"matches\":[]}], "
+    "\"qtext\":\"shipped\", \"metrics\":{\"query-resolution-time\":\"PT0.002S\", "
+    "\"total-time\":\"PT0.004S\"}}";
+
+}
+
+SearchTest::SearchTest() {
+}
+
+SearchTest::SearchTest(const SearchTest& orig) {
+}
+
+SearchTest::~SearchTest() {
+}
+
+void SearchTest::TestParsePage() {
+  SearchPage page;
+  SearchPage::Parse(PAGE, page);
+
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1342, page.total);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)11, page.start);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, page.page_length);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, page.results.size());
+
+  const SearchResult& first = page.results[0];
+  CPPUNIT_ASSERT_EQUAL((uint64_t)11, first.index);
+  CPPUNIT_ASSERT_EQUAL(std::string("/orders/1001.json"), first.uri);
+  CPPUNIT_ASSERT_EQUAL(std::string("fn:doc(\"/orders/1001.json\")"), first.path);
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/documents?uri=%2Forders%2F1001.json"), first.href);
+  CPPUNIT_ASSERT_EQUAL(std::string("application/json"), first.mimetype);
+  CPPUNIT_ASSERT_EQUAL(std::string("json"), first.format);
+  CPPUNIT_ASSERT_EQUAL(2048.0, first.score);
+  CPPUNIT_ASSERT_EQUAL(0.43, first.confidence);
+
+  CPPUNIT_ASSERT_EQUAL(std::string("/orders/1002.json"), page.results[1].uri);
+  CPPUNIT_ASSERT(page.results[1].href.empty());
+}
+
+void SearchTest::TestQueryPath() {
+  SearchQuery query;
+  query.Text("shipped").OptionsName("orders").Directory("/orders/");
+  CPPUNIT_ASSERT_EQUAL(
+      std::string("/v1/search?format=json&start=21&pageLength=10&options=orders&directory=")
+      + web::uri::encode_data_string("/orders/"),
+      query.Path(21, 10));
+
+  query.Forest("Documents").Timestamp(16091234567890);
+  CPPUNIT_ASSERT(query.Path(1, 10).find("&forest-name=Documents&timestamp=16091234567890") !=
+      std::string::npos);
+}
+
+void SearchTest::TestScan() {
+  StubServerConfig config;
+  config.address = "http://127.0.0.1:8397";
+  StubServer server(config);
+  server.Seed(95);
+  server.Start();
+
+  {
+    SearchResults results(config.address, Credentials(config.username, config.password),
+        SearchQuery().Directory("/bench/"), 10, 3);
+    CPPUNIT_ASSERT_EQUAL((uint64_t)95, results.Total());
+
+    std::vector<std::string> uris;
+    SearchResult result;
+    while (results.Next(result)) {
+      CPPUNIT_ASSERT_EQUAL((uint64_t)uris.size() + 1, result.index);
+      uris.push_back(result.uri);
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t)95, uris.size());
+    CPPUNIT_ASSERT(!results.Next(result));
+  }
+
+  {
+    // Stopping part way through must not hang or leak the fetchers.
+    SearchResults results(config.address, Credentials(config.username, config.password),
+        SearchQuery(), 5, 4);
+    SearchResult result;
+    CPPUNIT_ASSERT(results.Next(result));
+  }
+
+  server.Stop();
+}
+
+void SearchTest::TestEmpty() {
+  StubServerConfig config;
+  config.address = "http://127.0.0.1:8397";
+  StubServer server(config);
+  server.Start();
+
+  SearchResults results(config.address, Credentials(config.username, config.password),
+      SearchQuery().Text("nothing"), 10, 2);
+  SearchResult result;
+  CPPUNIT_ASSERT(!results.Next(result));
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, results.Total());
+
+  server.Stop();
+}
@@ -0,0 +1,33 @@
+/*
+ * File:   SearchTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef SEARCHTEST_HPP
+#define	SEARCHTEST_HPP
+
+class SearchTest : public CppUnit::TestCase {
+public:
+    SearchTest();
+    SearchTest(const SearchTest& orig);
+    virtual ~SearchTest();
+
+    void TestParsePage();
+    void TestQueryPath();
+    void TestScan();
+    void TestEmpty();
+private:
+    CPPUNIT_TEST_SUITE(SearchTest);
+    CPPUNIT_TEST(TestParsePage);
+    CPPUNIT_TEST(TestQueryPath);
+    CPPUNIT_TEST(TestScan);
+    CPPUNIT_TEST(TestEmpty);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* SEARCHTEST_HPP */
@@ -0,0 +1,211 @@
+/*
+ * File:   SparqlTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "SparqlTest.hpp"
+#include "Sparql.hpp"
+#include "AuthenticatingProxy.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SparqlTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8393";
+const std::string RDF_PATH = "mlcpptest-graph.rdf";
+
+// The example from the SPARQL 1.1 Query Results JSON Format recommendation,
+// trimmed.
+const std::string SELECT =
+    "{\"head\": {\"link\": [\"http://www.w3.org/TR/rdf-sparql-XMLres/example.rq\"], "
+    "\"vars\": [\"x\", \"hpage\", \"name\", \"age\"]}, "
+    "\"results\": {\"bindings\": ["
+    "{\"x\": {\"type\": \"bnode\", \"value\": \"r1\"}, "
+    "\"hpage\": {\"type\": \"uri\", \"value\": \"http://work.example.org/alice/\"}, "
+    "\"name\": {\"type\": \"literal\", \"value\": \"Alice\", \"xml:lang\": \"en\"}, "
+    "\"age\": {\"type\": \"literal\", \"value\": \"30\", "
+    "\"datatype\": \"http://www.w3.org/2001/XMLSchema#integer\"}}, "
+    "{\"x\": {\"type\": \"bnode\", \"value\": \"r2\"}, "
+    "\"name\": {\"type\": \"literal\", \"value\": \"Bob \\\"the builder\\\"\"}}"
+    "]}}";
+
+}
+
+SparqlTest::SparqlTest() {
+
+}
+
+SparqlTest::SparqlTest(const SparqlTest& orig) {
+
+}
+
+SparqlTest::~SparqlTest() {
+
+}
+
+void SparqlTest::TestParseSelect() {
+  SparqlResults results(SELECT);
+  CPPUNIT_ASSERT_EQUAL((size_t)4, results.Variables().size());
+  CPPUNIT_ASSERT_EQUAL(std::string("hpage"), results.Variables()[1]);
+  CPPUNIT_ASSERT(!results.HasBoolean());
+
+  SparqlRow row;
+  CPPUNIT_ASSERT(results.Next(row));
+  CPPUNIT_ASSERT_EQUAL((size_t)4, row.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("bnode"), row[0].type);
+  CPPUNIT_ASSERT_EQUAL(std::string("http://work.example.org/alice/"), row[1].value);
+  CPPUNIT_ASSERT_EQUAL(std::string("en"), row[2].language);
+  CPPUNIT_ASSERT_EQUAL(std::string("http://www.w3.org/2001/XMLSchema#integer"), row[3].datatype);
+
+  CPPUNIT_ASSERT(results.Next(row));
+  CPPUNIT_ASSERT(row[0].bound);
+  CPPUNIT_ASSERT(!row[1].bound);
+  CPPUNIT_ASSERT_EQUAL(std::string("Bob \"the builder\""), row[2].value);
+  CPPUNIT_ASSERT(!row[3].bound);
+
+  CPPUNIT_ASSERT(!results.Next(row));
+  CPPUNIT_ASSERT(!results.Next(row));
+}
+
+void SparqlTest::TestParseAsk() {
+  SparqlResults results("{\"head\": {}, \"boolean\": true}");
+  CPPUNIT_ASSERT(results.HasBoolean());
+  CPPUNIT_ASSERT(results.Boolean());
+  SparqlRow row;
+  CPPUNIT_ASSERT(!results.Next(row));
+}
+
+void SparqlTest::TestHeadLast() {
+  SparqlResults results("{\"results\": {\"bindings\": [{\"b\": {\"type\": \"literal\", "
+      "\"value\": \"2\"}}], \"distinct\": false}, \"head\": {\"vars\": [\"a\", \"b\"]}}");
+  SparqlRow row;
+  CPPUNIT_ASSERT(results.Next(row));
+  CPPUNIT_ASSERT_EQUAL((size_t)1, row.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("2"), row[0].value);
+  CPPUNIT_ASSERT(!results.Next(row));
+
+  // The head, read after the last row, adds the unbound variable.
+  CPPUNIT_ASSERT_EQUAL((size_t)2, results.Variables().size());
+  CPPUNIT_ASSERT_EQUAL(std::string("b"), results.Variables()[0]);
+}
+
+void SparqlTest::TestGraphsPath() {
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/graphs?default"),
+      GraphLoader::GraphsPath("", RdfFormat::NTRIPLES));
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/graphs"), GraphLoader::GraphsPath("", RdfFormat::NQUADS));
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/graphs?graph=") +
+      web::uri::encode_data_string("http://example.org/prov"),
+      GraphLoader::GraphsPath("http://example.org/prov", RdfFormat::TURTLE));
+  CPPUNIT_ASSERT_EQUAL(std::string("application/n-triples"),
+      GraphLoader::ContentType(RdfFormat::NTRIPLES));
+}
+
+void SparqlTest::TestLoadAndQuery() {
+  std::string triples = "# provenance\n\n";
+  for (int i = 0; i < 500; i++) {
+    triples += "<http://example.org/doc/" + std::to_string(i) +
+        "> <http://www.w3.org/ns/prov#wasDerivedFrom> <http://example.org/source/" +
+        std::to_string(i % 7) + "> .\n";
+  }
+  // A line longer than a chunk, and no newline at the end.
+  triples += "<http://example.org/doc/long> <http://example.org/title> \"" +
+      std::string(5000, 'x') + "\" .";
+  {
+    std::ofstream out(RDF_PATH.c_str(), std::ios::binary);
+    out << triples;
+  }
+
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+  GraphLoader loader(proxy, ADDRESS, 4096);
+  GraphLoadSummary summary = loader.LoadFile(RDF_PATH, RdfFormat::NTRIPLES,
+      "http://example.org/prov");
+  std::remove(RDF_PATH.c_str());
+
+  CPPUNIT_ASSERT_EQUAL((uint64_t)501, summary.statements);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)triples.size(), summary.bytes);
+  CPPUNIT_ASSERT(summary.requests > 10);
+  CPPUNIT_ASSERT_EQUAL(summary.requests, server.GraphRequests());
+  CPPUNIT_ASSERT(triples == server.Graph("http://example.org/prov"));
+
+  SparqlResults results(proxy, ADDRESS, "SELECT ?s ?p ?o WHERE { ?s ?p ?o }");
+  SparqlRow row;
+  size_t rows = 0;
+  while (results.Next(row)) {
+    CPPUNIT_ASSERT_EQUAL(std::string("uri"), row[0].type);
+    rows++;
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t)501, rows);
+  server.Stop();
+}
+
+void SparqlTest::TestLoadTurtle() {
+  std::string turtle = "@prefix prov: <http://www.w3.org/ns/prov#> .\n"
+      "<http://example.org/doc/1>\n    prov:wasDerivedFrom <http://example.org/source/1> .\n";
+  {
+    std::ofstream out(RDF_PATH.c_str(), std::ios::binary);
+    out << turtle;
+  }
+
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+  GraphLoader loader(proxy, ADDRESS);
+  GraphLoadSummary summary = loader.LoadFile(RDF_PATH, RdfFormat::TURTLE);
+  std::remove(RDF_PATH.c_str());
+
+  CPPUNIT_ASSERT_EQUAL((uint64_t)turtle.size(), summary.bytes);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, server.GraphRequests());
+  CPPUNIT_ASSERT(turtle == server.Graph(""));
+  // The priming ASK took the challenge, not the file.
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, server.Challenges());
+  CPPUNIT_ASSERT_THROW(loader.LoadFile("mlcpptest-missing.ttl", RdfFormat::TURTLE),
+      SparqlException);
+  server.Stop();
+}
+
+void SparqlTest::TestLoadBlankNodes() {
+  // _:source is one node only if the file goes in one request.
+  std::string triples;
+  for (int i = 0; i < 500; i++) {
+    triples += "<http://example.org/doc/" + std::to_string(i) +
+        "> <http://www.w3.org/ns/prov#wasDerivedFrom> _:source .\n";
+  }
+  triples += "_:source <http://example.org/title> \"Unknown\" .\n";
+  {
+    std::ofstream out(RDF_PATH.c_str(), std::ios::binary);
+    out << triples;
+  }
+
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+  GraphLoader loader(proxy, ADDRESS, 4096);
+  GraphLoadSummary summary = loader.LoadFile(RDF_PATH, RdfFormat::NTRIPLES);
+  std::remove(RDF_PATH.c_str());
+
+  CPPUNIT_ASSERT_EQUAL((uint64_t)501, summary.statements);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)triples.size(), summary.bytes);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, summary.requests);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, server.GraphRequests());
+  CPPUNIT_ASSERT(triples == server.Graph(""));
+  server.Stop();
+}
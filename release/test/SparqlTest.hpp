@@ -0,0 +1,39 @@
+/*
+ * File:   SparqlTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef SPARQLTEST_HPP
+#define	SPARQLTEST_HPP
+
+class SparqlTest : public CppUnit::TestCase {
+public:
+    SparqlTest();
+    SparqlTest(const SparqlTest& orig);
+    virtual ~SparqlTest();
+
+    void TestParseSelect();
+    void TestParseAsk();
+    void TestHeadLast();
+    void TestGraphsPath();
+    void TestLoadAndQuery();
+    void TestLoadTurtle();
+    void TestLoadBlankNodes();
+private:
+    CPPUNIT_TEST_SUITE(SparqlTest);
+    CPPUNIT_TEST(TestParseSelect);
+    CPPUNIT_TEST(TestParseAsk);
+    CPPUNIT_TEST(TestHeadLast);
+    CPPUNIT_TEST(TestGraphsPath);
+    CPPUNIT_TEST(TestLoadAndQuery);
+    CPPUNIT_TEST(TestLoadTurtle);
+    CPPUNIT_TEST(TestLoadBlankNodes);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* SPARQLTEST_HPP */
@@ -0,0 +1,195 @@
+/*
+ * File:   SplitterTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "SplitterTest.hpp"
+#include "Splitter.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SplitterTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8388";
+const std::string SPLIT_FILE = "mlcpptest-split.txt";
+
+void WriteFile(const std::string& path, const std::string& contents) {
+  std::ofstream out(path.c_str(), std::ios::binary);
+  out << contents;
+}
+
+}
+
+SplitterTest::SplitterTest() {
+
+}
+
+SplitterTest::SplitterTest(const SplitterTest& orig) {
+
+}
+
+SplitterTest::~SplitterTest() {
+
+}
+
+void SplitterTest::TestNewlines() {
+  // Long enough for the vector loop to fold its counters more than once,
+  // with newlines bunched, spread out and at the very ends.
+  std::srand(42);
+  std::string text(20000, 'x');
+  for (size_t i = 0; i < text.size(); i++) {
+    if (std::rand() % (i < 5000 ? 3 : 97) == 0) {
+      text[i] = '\n';
+    }
+  }
+  text[0] = '\n';
+  text[text.size() - 1] = '\n';
+
+  for (size_t start = 0; start < 40; start += 7) {
+    for (size_t end = text.size() - 40; end <= text.size(); end += 13) {
+      uint64_t expected = 0;
+      const char* first = nullptr;
+      for (size_t i = start; i < end; i++) {
+        if (text[i] == '\n') {
+          expected++;
+          first = first ? first : text.data() + i;
+        }
+      }
+      CPPUNIT_ASSERT_EQUAL(expected, Splitter::CountNewlines(text.data() + start,
+          text.data() + end));
+      CPPUNIT_ASSERT(first == Splitter::FindNewline(text.data() + start, text.data() + end));
+    }
+  }
+
+  const char* none = "no newline";
+  CPPUNIT_ASSERT(none + 10 == Splitter::FindNewline(none, none + 10));
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, Splitter::CountNewlines(none, none + 10));
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, Splitter::CountNewlines(none, none));
+}
+
+void SplitterTest::TestCsv() {
+  std::string text = "a,\"b,c\",\"say \"\"hi\"\"\"\r\n\"two\nlines\",,x\nlast";
+  const char* end = text.data() + text.size();
+  std::vector<std::string> fields;
+
+  const char* next = Splitter::ParseCsv(text.data(), end, ',', fields);
+  CPPUNIT_ASSERT_EQUAL((size_t)3, fields.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("a"), fields[0]);
+  CPPUNIT_ASSERT_EQUAL(std::string("b,c"), fields[1]);
+  CPPUNIT_ASSERT_EQUAL(std::string("say \"hi\""), fields[2]);
+
+  next = Splitter::ParseCsv(next, end, ',', fields);
+  CPPUNIT_ASSERT_EQUAL((size_t)3, fields.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("two\nlines"), fields[0]);
+  CPPUNIT_ASSERT_EQUAL(std::string(), fields[1]);
+  CPPUNIT_ASSERT_EQUAL(std::string("x"), fields[2]);
+
+  next = Splitter::ParseCsv(next, end, ',', fields);
+  CPPUNIT_ASSERT(next == end);
+  CPPUNIT_ASSERT_EQUAL((size_t)1, fields.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("last"), fields[0]);
+
+  std::string tabs = "1\t\"\"\t3\n";
+  Splitter::ParseCsv(tabs.data(), tabs.data() + tabs.size(), '\t', fields);
+  CPPUNIT_ASSERT_EQUAL((size_t)3, fields.size());
+  CPPUNIT_ASSERT_EQUAL(std::string(), fields[1]);
+}
+
+void SplitterTest::TestNdjson() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  std::string text;
+  for (int i = 0; i < 1000; i++) {
+    text += "{\"name\":\"order " + std::to_string(i) + "\",\"id\":" + std::to_string(i) +
+        ",\"lines\":[1,2,3]}\n";
+    if (i % 100 == 0) {
+      text += "\r\n";
+    }
+  }
+  WriteFile(SPLIT_FILE, text);
+
+  SplitOptions options;
+  options.uri_template = "/orders/{id}.json";
+  options.chunk_bytes = 1024;
+  options.threads = 4;
+  options.batch.max_documents = 50;
+  Splitter splitter(ADDRESS, Credentials(config.username, config.password), options);
+  SplitSummary summary = splitter.Run(SPLIT_FILE);
+  std::remove(SPLIT_FILE.c_str());
+
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1000, summary.records);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, summary.failed);
+  CPPUNIT_ASSERT_EQUAL((size_t)1000, server.DocumentCount());
+  CPPUNIT_ASSERT_EQUAL(server.BulkWrites(), summary.batches);
+  CPPUNIT_ASSERT(summary.batches >= 20);
+  server.Stop();
+}
+
+void SplitterTest::TestCsvFile() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  std::string text = "\xEF\xBB\xBFsku,description\r\n";
+  for (int i = 0; i < 500; i++) {
+    text += "SKU-" + std::to_string(i) + ",\"Widget, size " + std::to_string(i) + "\"\r\n";
+  }
+  WriteFile(SPLIT_FILE, text);
+
+  SplitOptions options;
+  options.format = RecordFormat::CSV;
+  options.uri_template = "/products/{line}-{sku}.json";
+  options.chunk_bytes = 512;
+  options.threads = 3;
+  Credentials credentials(config.username, config.password);
+  SplitSummary summary = Splitter(ADDRESS, credentials, options).Run(SPLIT_FILE);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)500, summary.records);
+  CPPUNIT_ASSERT_EQUAL((size_t)500, server.DocumentCount());
+
+  // The same rows on one thread give the same URIs.
+  options.quoted_newlines = true;
+  summary = Splitter(ADDRESS, credentials, options).Run(SPLIT_FILE);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)500, summary.records);
+  CPPUNIT_ASSERT_EQUAL((size_t)500, server.DocumentCount());
+
+  options.uri_template = "/products/{id}.json";
+  CPPUNIT_ASSERT_THROW(Splitter(ADDRESS, credentials, options).Run(SPLIT_FILE), SplitException);
+  std::remove(SPLIT_FILE.c_str());
+  server.Stop();
+}
+
+void SplitterTest::TestBadRecords() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  WriteFile(SPLIT_FILE, "{\"id\":1}\n{\"id\":\n{\"name\":\"no id\"}\n{\"id\":{}}\n{\"id\":5}");
+
+  SplitOptions options;
+  options.uri_template = "/orders/{id}.json";
+  SplitSummary summary = Splitter(ADDRESS, Credentials(config.username, config.password),
+      options).Run(SPLIT_FILE);
+  std::remove(SPLIT_FILE.c_str());
+
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, summary.records);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)3, summary.failed);
+  CPPUNIT_ASSERT_EQUAL((size_t)3, summary.failures.size());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)9, summary.failures[0].first);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, server.DocumentCount());
+
+  CPPUNIT_ASSERT_THROW(Splitter(ADDRESS, Credentials(), options).Run(SPLIT_FILE + "-missing"),
+      SplitException);
+  server.Stop();
+}
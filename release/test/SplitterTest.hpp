@@ -0,0 +1,35 @@
+/*
+ * File:   SplitterTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef SPLITTERTEST_HPP
+#define	SPLITTERTEST_HPP
+
+class SplitterTest : public CppUnit::TestCase {
+public:
+    SplitterTest();
+    SplitterTest(const SplitterTest& orig);
+    virtual ~SplitterTest();
+
+    void TestNewlines();
+    void TestCsv();
+    void TestNdjson();
+    void TestCsvFile();
+    void TestBadRecords();
+private:
+    CPPUNIT_TEST_SUITE(SplitterTest);
+    CPPUNIT_TEST(TestNewlines);
+    CPPUNIT_TEST(TestCsv);
+    CPPUNIT_TEST(TestNdjson);
+    CPPUNIT_TEST(TestCsvFile);
+    CPPUNIT_TEST(TestBadRecords);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* SPLITTERTEST_HPP */
@@ -0,0 +1,205 @@
+/*
+ * File:   StubDocuments.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "StubServer.hpp"
+
+#include "Multipart.hpp"
+
+using namespace web;
+using namespace web::http;
+
+namespace {
+
+///
+/// Returns every value of a parameter that may repeat, such as uri in a
+/// bulk read; split_query keeps only one.
+///
+std::vector<std::string> QueryValues(const std::string& query, const std::string& key) {
+  std::vector<std::string> values;
+  std::string prefix = key + "=";
+  size_t pos = 0;
+  while (pos <= query.size()) {
+    size_t end = query.find('&', pos);
+    if (end == std::string::npos) {
+      end = query.size();
+    }
+    if (query.compare(pos, prefix.size(), prefix) == 0) {
+      values.push_back(uri::decode(query.substr(pos + prefix.size(),
+          end - pos - prefix.size())));
+    }
+    pos = end + 1;
+  }
+  return values;
+}
+
+}
+
+void StubServer::HandleDocuments(http_request& request, const std::string& path,
+    query_t& query)
+{
+  if (!query["txid"].empty()) {
+    HandleTransactionalDocuments(request, query);
+    return;
+  }
+
+  std::vector<std::string> uris = QueryValues(request.relative_uri().query(), "uri");
+  http_headers::const_iterator accept = request.headers().find("Accept");
+  if (request.method() == methods::GET && (uris.size() > 1 ||
+      (accept != request.headers().end() &&
+       accept->second.find("multipart/mixed") != std::string::npos))) {
+    HandleBulkRead(request, uris, query["category"]);
+    return;
+  }
+
+  std::string doc_uri = query["uri"];
+
+  if (request.method() == methods::GET) {
+    std::string body;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      std::map<std::string, std::string>::const_iterator found = _documents.find(doc_uri);
+      if (found == _documents.end()) {
+        request.reply(status_codes::NotFound);
+        return;
+      }
+      body = found->second;
+    }
+    bool xml = doc_uri.size() > 4 && doc_uri.compare(doc_uri.size() - 4, 4, ".xml") == 0;
+    request.reply(status_codes::OK, body, xml ? "application/xml" : "application/json");
+  } else if (request.method() == methods::PUT) {
+    std::string body = request.extract_string().get();
+    bool created = false;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      created = _documents.find(doc_uri) == _documents.end();
+      _documents[doc_uri] = body;
+      _modified[doc_uri] = _timestamp + 1;
+      _timestamp++;
+    }
+    request.reply(created ? status_codes::Created : status_codes::NoContent);
+  } else if (request.method() == methods::POST &&
+      request.headers().content_type().compare(0, 15, "multipart/mixed") == 0) {
+    HandleBulkWrite(request);
+  } else if (request.method() == methods::POST) {
+    std::string body = request.extract_string().get();
+    std::string extension = query["extension"].empty() ? "json" : query["extension"];
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      doc_uri = query["directory"] + std::to_string(++_next_id) + "." + extension;
+      _documents[doc_uri] = body;
+      _modified[doc_uri] = _timestamp + 1;
+      _timestamp++;
+    }
+    http_response created(status_codes::Created);
+    created.headers().add("Location", "/v1/documents?uri=" + doc_uri);
+    request.reply(created);
+  } else if (request.method() == methods::PATCH) {
+    std::string body = request.extract_string(true).get();
+    if (body.compare(0, 10, "{\"patch\":[") != 0 && body.compare(0, 11, "<rapi:patch") != 0) {
+      ReplyError(request, status_codes::BadRequest, "RESTAPI-INVALIDCONTENT",
+          "Not a patch");
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_documents.find(doc_uri) == _documents.end()) {
+        ReplyError(request, status_codes::NotFound, "RESTAPI-NODOCUMENT",
+            "Document not found");
+        return;
+      }
+      _patches[doc_uri + (query["category"] == "metadata" ? "#metadata" : "")].push_back(body);
+      _timestamp++;
+    }
+    request.reply(status_codes::NoContent);
+  } else if (request.method() == methods::DEL) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _documents.erase(doc_uri);
+      _timestamp++;
+    }
+    request.reply(status_codes::NoContent);
+  } else {
+    request.reply(status_codes::MethodNotAllowed);
+  }
+}
+
+void StubServer::HandleBulkRead(http_request& request, const std::vector<std::string>& uris,
+    const std::string& category)
+{
+  const std::string& boundary = BOUNDARY;
+  bool metadata = category.compare(0, 8, "metadata") == 0;
+  std::string body;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& doc_uri : uris) {
+      std::map<std::string, std::string>::const_iterator found = _documents.find(doc_uri);
+      if (found == _documents.end()) {
+        continue;
+      }
+      std::string content = found->second;
+      if (metadata) {
+        std::map<std::string, std::string>::const_iterator stored = _metadata.find(doc_uri);
+        content = stored == _metadata.end() ? "{\"metadataValues\":{}}" : stored->second;
+      }
+      body += "--" + boundary + "\r\n"
+          "Content-Type: application/json\r\n"
+          "Content-Disposition: attachment; filename=\"" + doc_uri + "\"; category=" +
+          (metadata ? "metadata" : "content") + "; format=json\r\n"
+          "Content-Length: " + std::to_string(content.size()) + "\r\n"
+          "vnd.marklogic.document-format: json\r\n\r\n";
+      body += content;
+      body += "\r\n";
+    }
+  }
+  body += "--" + boundary + "--\r\n";
+
+  http_response response(status_codes::OK);
+  response.set_body(body, "multipart/mixed; boundary=" + boundary);
+  request.reply(response);
+}
+
+void StubServer::HandleBulkWrite(http_request& request) {
+  std::string body = request.extract_string(true).get();
+  std::vector<std::pair<std::string, std::string> > parts;
+  std::vector<std::pair<std::string, std::string> > metadata;
+  try {
+    MultipartReader reader(body, MultipartReader::Boundary(request.headers().content_type()));
+    MultipartPart part;
+    while (reader.Next(part)) {
+      if (part.Filename().empty()) {
+        ReplyError(request, status_codes::BadRequest, "RESTAPI-INVALIDREQ",
+            "A part has no document URI");
+        return;
+      }
+      if (part.Header("Content-Disposition").find("category=metadata") != std::string::npos) {
+        metadata.push_back(std::make_pair(part.Filename(), part.Content()));
+      } else {
+        parts.push_back(std::make_pair(part.Filename(), part.Content()));
+      }
+    }
+  } catch (const MultipartException& e) {
+    ReplyError(request, status_codes::BadRequest, "RESTAPI-INVALIDCONTENT", e.what());
+    return;
+  }
+
+  std::string documents;
+  {
+    // The whole batch is one transaction.
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& part : metadata) {
+      _metadata[part.first] = part.second;
+    }
+    for (auto& part : parts) {
+      _documents[part.first] = part.second;
+      _modified[part.first] = _timestamp + 1;
+      documents += (documents.empty() ? "" : ",") + std::string("{\"uri\":\"") + part.first +
+          "\"}";
+    }
+    _timestamp++;
+    _bulk_writes++;
+  }
+  request.reply(status_codes::OK, "{\"documents\":[" + documents + "]}", "application/json");
+}
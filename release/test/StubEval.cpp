@@ -0,0 +1,86 @@
+/*
+ * File:   StubEval.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "StubServer.hpp"
+
+
+using namespace web;
+using namespace web::http;
+
+void StubServer::HandleEval(http_request& request, const std::string& path,
+    query_t& query)
+{
+  if (request.method() != methods::POST) {
+    request.reply(status_codes::MethodNotAllowed);
+    return;
+  }
+  std::map<std::string, std::string> form = uri::split_query(request.extract_string(true).get());
+  for (auto& iter : form) {
+    iter.second = uri::decode(iter.second);
+  }
+
+  std::string code = path == "/v1/invoke" ? form["module"] :
+      form["xquery"].empty() ? form["javascript"] : form["xquery"];
+  if (path == "/v1/invoke" && code != "/echo.sjs") {
+    ReplyError(request, status_codes::InternalError, "XDMP-MODNOTFOUND",
+        "Module " + code + " not found");
+    return;
+  }
+
+  std::string body;
+  if (code == "cts:uris()" || code == "cts.uris()") {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& document : _documents) {
+      AddItem(body, "text/plain", "anyURI", document.first);
+    }
+  } else if (!form["vars"].empty()) {
+    json::value vars = json::value::parse(form["vars"]);
+    for (auto& variable : vars.as_object()) {
+      const json::value& value = variable.second;
+      if (value.is_string()) {
+        AddItem(body, "text/plain", "string", value.as_string());
+      } else if (value.is_boolean()) {
+        AddItem(body, "text/plain", "boolean", value.serialize());
+      } else if (value.is_number()) {
+        AddItem(body, "text/plain", value.is_integer() ? "integer" : "decimal",
+            value.serialize());
+      } else {
+        AddItem(body, "application/json", value.is_array() ? "array" : "map",
+            value.serialize());
+      }
+    }
+  }
+  body += "--" + BOUNDARY + "--\r\n";
+
+  http_response response(status_codes::OK);
+  response.set_body(body, "multipart/mixed; boundary=" + BOUNDARY);
+  request.reply(response);
+}
+
+void StubServer::HandleResources(http_request& request, const std::string& path,
+    query_t& query)
+{
+  if (request.method() == methods::GET) {
+    std::string body;
+    for (auto& param : query) {
+      if (param.first.compare(0, 3, "rs:") == 0) {
+        AddItem(body, "text/plain", "string", param.first.substr(3) + "=" + param.second);
+      }
+    }
+    body += "--" + BOUNDARY + "--\r\n";
+
+    http_response response(status_codes::OK);
+    response.set_body(body, "multipart/mixed; boundary=" + BOUNDARY);
+    request.reply(response);
+  } else if (request.method() == methods::POST || request.method() == methods::PUT) {
+    std::string content_type = request.headers().content_type();
+    request.reply(status_codes::OK, request.extract_string(true).get(), content_type);
+  } else if (request.method() == methods::DEL) {
+    request.reply(status_codes::NoContent);
+  } else {
+    request.reply(status_codes::MethodNotAllowed);
+  }
+}
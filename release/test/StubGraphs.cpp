@@ -0,0 +1,75 @@
+/*
+ * File:   StubGraphs.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "StubServer.hpp"
+
+#include <sstream>
+
+using namespace web;
+using namespace web::http;
+
+void StubServer::HandleGraphs(http_request& request, const std::string& path,
+    query_t& query)
+{
+  if (request.method() != methods::POST) {
+    request.reply(status_codes::MethodNotAllowed);
+    return;
+  }
+  std::string body = request.extract_string(true).get();
+
+  if (path == "/v1/graphs") {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _graphs[query["graph"]] += body;
+    _graph_requests++;
+    request.reply(status_codes::NoContent);
+    return;
+  }
+
+  if (path != "/v1/graphs/sparql") {
+    request.reply(status_codes::NotFound);
+    return;
+  }
+  if (body.compare(0, 3, "ASK") == 0) {
+    request.reply(status_codes::OK, "{\"head\":{},\"boolean\":true}",
+        "application/sparql-results+json");
+    return;
+  }
+
+  // One row per "<s> <p> <o> ." line, across every graph.
+  std::ostringstream results;
+  results << "{\"head\":{\"vars\":[\"s\",\"p\",\"o\"]},\"results\":{\"bindings\":[";
+  bool first = true;
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (auto& graph : _graphs) {
+    std::istringstream lines(graph.second);
+    std::string line;
+    while (std::getline(lines, line)) {
+      size_t p = line.find(' ');
+      size_t o = p == std::string::npos ? p : line.find(' ', p + 1);
+      size_t end = line.rfind(" .");
+      if (o == std::string::npos || end == std::string::npos || end <= o) {
+        continue;
+      }
+      std::string terms[3] = { line.substr(0, p), line.substr(p + 1, o - p - 1),
+                               line.substr(o + 1, end - o - 1) };
+      results << (first ? "" : ",") << "{";
+      const char* names[3] = { "s", "p", "o" };
+      for (int i = 0; i < 3; i++) {
+        bool uri = terms[i].size() > 1 && terms[i][0] == '<';
+        std::string value = uri ? terms[i].substr(1, terms[i].size() - 2) : terms[i];
+        if (!uri && value.size() > 1 && value[0] == '"') {
+          value = value.substr(1, value.rfind('"') - 1);
+        }
+        results << (i > 0 ? "," : "") << "\"" << names[i] << "\":{\"type\":\""
+                << (uri ? "uri" : "literal") << "\",\"value\":\"" << value << "\"}";
+      }
+      results << "}";
+      first = false;
+    }
+  }
+  results << "]}}";
+  request.reply(status_codes::OK, results.str(), "application/sparql-results+json");
+}
@@ -0,0 +1,94 @@
+/*
+ * File:   StubSearch.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "StubServer.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace web;
+using namespace web::http;
+
+void StubServer::HandleSearch(http_request& request, const std::string& path,
+    query_t& query)
+{
+  std::string since;
+  if (request.method() == methods::POST) {
+    // Only the value of a last-modified range-query is understood.
+    std::string search = request.extract_string().get();
+    size_t range = search.find("\"last-modified\"");
+    size_t value = range == std::string::npos ? range : search.find("\"value\":[\"", range);
+    if (value != std::string::npos) {
+      value += 10;
+      since = search.substr(value, search.find('"', value) - value);
+    }
+  }
+
+  size_t start = std::max<size_t>(QueryNumber(query, "start", 1), 1);
+  size_t page_length = QueryNumber(query, "pageLength", 10);
+  std::string forest = query["forest-name"];
+
+  std::ostringstream body;
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  std::vector<const std::string*> matches;
+  matches.reserve(_documents.size());
+  for (auto& document : _documents) {
+    if ((forest.empty() || ForestOf(document.first, _config.forests) == forest) &&
+        (since.empty() || ClockTime(_modified.count(document.first) > 0 ?
+            _modified.at(document.first) : 0) >= since)) {
+      matches.push_back(&document.first);
+    }
+  }
+
+  if (query["format"] == "xml") {
+    body << "<search:response snippet-format=\"snippet\" total=\"" << matches.size()
+         << "\" start=\"" << start << "\" page-length=\"" << page_length
+         << "\" xmlns:search=\"http://marklogic.com/appservices/search\">";
+    for (size_t i = 0; i < page_length && start - 1 + i < matches.size(); i++) {
+      const std::string& doc_uri = *matches[start - 1 + i];
+      body << "<search:result index=\"" << start + i << "\" uri=\"" << doc_uri
+           << "\" path=\"fn:doc(&quot;" << doc_uri << "&quot;)\" score=\"0\" confidence=\"0\""
+           << " fitness=\"0\" href=\"/v1/documents?uri=" << doc_uri
+           << "\" mimetype=\"application/json\" format=\"json\">"
+           << "<search:snippet><search:match path=\"fn:doc(&quot;" << doc_uri
+           << "&quot;)\"/></search:snippet></search:result>";
+    }
+    body << "<search:metrics><search:total-time>PT0S</search:total-time></search:metrics>"
+         << "</search:response>";
+
+    http_response response(status_codes::OK);
+    response.headers().add("ML-Effective-Timestamp", std::to_string(_timestamp));
+    response.set_body(body.str(), "application/xml");
+    request.reply(response);
+    return;
+  }
+
+  body << "{\"snippet-format\":\"snippet\",\"total\":" << matches.size()
+       << ",\"start\":" << start << ",\"page-length\":" << page_length
+       << ",\"results\":[";
+
+  for (size_t i = 0; i < page_length && start - 1 + i < matches.size(); i++) {
+    const std::string& doc_uri = *matches[start - 1 + i];
+    if (i > 0) {
+      body << ",";
+    }
+    body << "{\"index\":" << start + i
+         << ",\"uri\":\"" << doc_uri << "\""
+         << ",\"path\":\"fn:doc(\\\"" << doc_uri << "\\\")\""
+         << ",\"score\":0,\"confidence\":0,\"fitness\":0"
+         << ",\"href\":\"/v1/documents?uri=" << doc_uri << "\""
+         << ",\"mimetype\":\"application/json\",\"format\":\"json\"}";
+  }
+  body << "]}";
+
+  http_response response(status_codes::OK);
+  response.headers().add("ML-Effective-Timestamp", std::to_string(_timestamp));
+  // Any later write is stamped with a later second.
+  response.headers().add("Date", ClockTime(_timestamp + 1, true));
+  response.set_body(body.str(), "application/json");
+  request.reply(response);
+}
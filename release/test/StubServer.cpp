@@ -0,0 +1,313 @@
+/*
+ * File:   StubServer.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "StubServer.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <thread>
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+#include "AuthorizationBuilder.hpp"
+#include "MLCrypto.hpp"
+
+using namespace web;
+using namespace web::http;
+using namespace web::http::experimental::listener;
+
+const std::string STUB_REALM = "public";
+
+namespace {
+
+std::string RandomHex(void) {
+  MLCrypto crypto;
+  return crypto.Md5(boost::uuids::to_string(boost::uuids::random_generator()()));
+}
+
+///
+/// Splits 'Digest username="admin", nc=00000001, ...' into its fields.
+///
+bool ParseDigest(const std::string& header, std::map<std::string, std::string>& fields) {
+  size_t pos = header.find("Digest");
+  if (pos == std::string::npos) {
+    return false;
+  }
+  pos += 6;
+
+  while (pos < header.size()) {
+    while (pos < header.size() && (header[pos] == ' ' || header[pos] == ',')) {
+      pos++;
+    }
+    size_t equals = header.find('=', pos);
+    if (equals == std::string::npos) {
+      break;
+    }
+
+    std::string key = header.substr(pos, equals - pos);
+    pos = equals + 1;
+    if (pos < header.size() && header[pos] == '"') {
+      size_t close = header.find('"', pos + 1);
+      if (close == std::string::npos) {
+        return false;
+      }
+      fields[key] = header.substr(pos + 1, close - pos - 1);
+      pos = close + 1;
+    } else {
+      size_t comma = header.find(',', pos);
+      if (comma == std::string::npos) {
+        comma = header.size();
+      }
+      fields[key] = header.substr(pos, comma - pos);
+      pos = comma;
+    }
+  }
+  return true;
+}
+
+}
+
+const std::string StubServer::BOUNDARY = "ML_BOUNDARY_STUB";
+
+const StubServer::Route StubServer::ROUTES[] = {
+  { "/v1/documents",    false, &StubServer::HandleDocuments },
+  { "/v1/search",       false, &StubServer::HandleSearch },
+  { "/v1/transactions", true,  &StubServer::HandleTransactions },
+  { "/v1/graphs",       true,  &StubServer::HandleGraphs },
+  { "/v1/values/",      true,  &StubServer::HandleValues },
+  { "/v1/eval",         false, &StubServer::HandleEval },
+  { "/v1/invoke",       false, &StubServer::HandleEval },
+  { "/v1/resources/",   true,  &StubServer::HandleResources },
+  { nullptr,            false, nullptr }
+};
+
+size_t StubServer::QueryNumber(query_t& query, const std::string& key, const size_t& fallback) {
+  query_t::const_iterator found = query.find(key);
+  if (found == query.end() || found->second.empty()) {
+    return fallback;
+  }
+  return (size_t)std::stoul(found->second);
+}
+
+void StubServer::AddItem(std::string& body, const std::string& content_type,
+    const std::string& primitive, const std::string& content)
+{
+  body += "--" + BOUNDARY + "\r\n"
+      "Content-Type: " + content_type + "\r\n"
+      "X-Primitive: " + primitive + "\r\n\r\n";
+  body += content;
+  body += "\r\n";
+}
+
+void StubServer::ReplyError(http_request& request, const status_code& status,
+    const std::string& code, const std::string& message)
+{
+  request.reply(status, "{\"errorResponse\":{\"statusCode\":" + std::to_string(status) +
+      ",\"messageCode\":\"" + code + "\",\"message\":\"" + message + "\"}}",
+      "application/json");
+}
+
+StubServerConfig::StubServerConfig() : address("http://127.0.0.1:8399"),
+    username("admin"), password("admin"), latency_us(0), document_bytes(1024),
+    forests(1)
+{
+
+}
+
+StubServer::StubServer(const StubServerConfig& config) : _config(config),
+    _nonce(RandomHex()), _opaque(RandomHex().substr(0, 16)), _next_id(0),
+    _timestamp(1), _bulk_writes(0), _graph_requests(0), _next_txid(0), _host_id(RandomHex().substr(0, 12)),
+    _requests(0), _challenges(0), _affinity_misses(0)
+{
+
+}
+
+StubServer::~StubServer() {
+  Stop();
+}
+
+void StubServer::Start(void) {
+  _listener.reset(new http_listener(uri(_config.address)));
+  _listener->support([this](http_request request) {
+    Handle(request);
+  });
+  _listener->open().wait();
+}
+
+void StubServer::Stop(void) {
+  if (_listener) {
+    _listener->close().wait();
+    _listener.reset();
+  }
+}
+
+std::string StubServer::Address(void) const {
+  return _config.address;
+}
+
+std::string StubServer::MakeDocument(const size_t& bytes) {
+  std::string head = "{\"title\":\"Benchmark document\",\"tags\":[\"bench\",\"stub\"],\"payload\":\"";
+  std::string tail = "\"}";
+  std::string filler;
+  if (bytes > head.size() + tail.size()) {
+    filler.reserve(bytes - head.size() - tail.size());
+    for (size_t i = 0; i < bytes - head.size() - tail.size(); i++) {
+      filler.push_back((char)('a' + i % 26));
+    }
+  }
+  return head + filler + tail;
+}
+
+std::string StubServer::ForestOf(const std::string& uri, const unsigned& forests) {
+  return "Forest-" + std::to_string(forests > 1 ? std::hash<std::string>()(uri) % forests : 0);
+}
+
+void StubServer::Seed(const size_t& count) {
+  std::string document = MakeDocument(_config.document_bytes);
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (size_t i = 0; i < count; i++) {
+    _documents["/bench/" + std::to_string(i) + ".json"] = document;
+    _modified["/bench/" + std::to_string(i) + ".json"] = _timestamp + 1;
+  }
+  _timestamp++;
+}
+
+void StubServer::Store(const std::string& uri, const std::string& body) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _documents[uri] = body;
+  _modified[uri] = _timestamp + 1;
+  _timestamp++;
+}
+
+size_t StubServer::DocumentCount(void) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _documents.size();
+}
+
+uint64_t StubServer::Requests(void) const {
+  return _requests.load();
+}
+
+uint64_t StubServer::Challenges(void) const {
+  return _challenges.load();
+}
+
+uint64_t StubServer::AffinityMisses(void) const {
+  return _affinity_misses.load();
+}
+
+size_t StubServer::OpenTransactions(void) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _transactions.size();
+}
+
+std::string StubServer::Graph(const std::string& graph) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::map<std::string, std::string>::const_iterator found = _graphs.find(graph);
+  return found == _graphs.end() ? std::string() : found->second;
+}
+
+uint64_t StubServer::BulkWrites(void) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _bulk_writes;
+}
+
+std::vector<std::string> StubServer::Patches(const std::string& uri) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::map<std::string, std::vector<std::string> >::const_iterator found = _patches.find(uri);
+  return found == _patches.end() ? std::vector<std::string>() : found->second;
+}
+
+std::string StubServer::ClockTime(const uint64_t& timestamp, const bool& http_date) {
+  std::time_t time = (std::time_t)(1792368000 + timestamp);
+  std::tm parts;
+#ifdef _WIN32
+  gmtime_s(&parts, &time);
+#else
+  gmtime_r(&time, &parts);
+#endif
+  char text[64];
+  std::strftime(text, sizeof(text), http_date ? "%a, %d %b %Y %H:%M:%S GMT" :
+      "%Y-%m-%dT%H:%M:%SZ", &parts);
+  return text;
+}
+
+std::string StubServer::Metadata(const std::string& uri) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::map<std::string, std::string>::const_iterator found = _metadata.find(uri);
+  return found == _metadata.end() ? std::string() : found->second;
+}
+
+uint64_t StubServer::GraphRequests(void) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _graph_requests;
+}
+
+bool StubServer::Authorized(const http_request& request) const {
+  http_headers::const_iterator header = request.headers().find("Authorization");
+  if (header == request.headers().end()) {
+    return false;
+  }
+
+  std::map<std::string, std::string> fields;
+  if (!ParseDigest(header->second, fields) || fields["nonce"] != _nonce ||
+      fields["username"] != _config.username || fields["realm"] != STUB_REALM) {
+    return false;
+  }
+
+  AuthorizationBuilder builder;
+  std::string ha1 = builder.UsernameRealmAndPassword(_config.username, STUB_REALM,
+      _config.password);
+  std::string ha2 = builder.MethodAndURL(request.method(), fields["uri"]);
+  std::string expected = builder.Response(ha1, _nonce, fields["nc"], fields["cnonce"],
+      fields["qop"], ha2);
+  return expected == fields["response"];
+}
+
+void StubServer::Handle(http_request request) {
+  _requests.fetch_add(1);
+
+  if (_config.latency_us > 0) {
+    std::this_thread::sleep_for(std::chrono::microseconds(_config.latency_us));
+  }
+
+  if (!Authorized(request)) {
+    _challenges.fetch_add(1);
+    http_response challenge(status_codes::Unauthorized);
+    challenge.headers().add("WWW-Authenticate", "Digest realm=\"" + STUB_REALM +
+        "\", qop=\"auth\", nonce=\"" + _nonce + "\", opaque=\"" + _opaque + "\"");
+    challenge.set_body("Unauthorized", "text/plain");
+    request.reply(challenge);
+    return;
+  }
+
+  query_t query = uri::split_query(request.relative_uri().query());
+  for (auto& iter : query) {
+    iter.second = uri::decode(iter.second);
+  }
+
+  std::string path = request.relative_uri().path();
+  if (!query["txid"].empty()) {
+    http_headers::const_iterator cookie = request.headers().find("Cookie");
+    if (cookie == request.headers().end() ||
+        cookie->second.find("HostId=" + _host_id) == std::string::npos) {
+      _affinity_misses.fetch_add(1);
+    }
+  }
+
+  for (const Route* route = ROUTES; route->path != nullptr; route++) {
+    size_t length = std::strlen(route->path);
+    if (path.compare(0, length, route->path) == 0 &&
+        (route->prefix || path.size() == length)) {
+      (this->*route->handle)(request, path, query);
+      return;
+    }
+  }
+  request.reply(status_codes::NotFound);
+}
@@ -0,0 +1,308 @@
+/*
+ * File:   StubServer.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef STUBSERVER_HPP
+#define	STUBSERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <cpprest/http_listener.h>
+
+///
+/// Settings for the StubServer.
+///
+struct StubServerConfig {
+    std::string address;        /*!< Listen address ("http://127.0.0.1:8399") */
+    std::string username;       /*!< The only user the digest check accepts */
+    std::string password;       /*!< That user's password */
+    uint32_t    latency_us;     /*!< Added to every response */
+    size_t      document_bytes; /*!< Size of the documents Seed() creates */
+    unsigned    forests;        /*!< Documents are spread over Forest-0, Forest-1, ... */
+
+    StubServerConfig();
+};
+
+///
+/// An in-process stand in for a MarkLogic REST server, for benchmarks and
+/// tests that cannot reach a real one.
+///
+/// Requests must carry a digest Authorization the library's own
+/// AuthorizationBuilder agrees with; anything else gets a 401 challenge.
+/// Authorized requests are routed by path through ROUTES to one handler per
+/// resource, each in its own file (StubDocuments.cpp, StubSearch.cpp, ...).
+/// The handlers share one in-memory store whose timestamp goes up with
+/// every write; ClockTime maps timestamps to the stub's clock.  Each
+/// handler's declaration says how much of its resource is implemented.
+///
+class StubServer {
+    StubServerConfig _config;
+    std::unique_ptr<web::http::experimental::listener::http_listener> _listener;
+    std::string _nonce;
+    std::string _opaque;
+
+    mutable std::mutex _mutex;
+    std::map<std::string, std::string> _documents;
+    std::map<std::string, std::string> _metadata;     /*!< uri to metadata JSON, from bulk writes */
+    std::map<std::string, uint64_t> _modified;        /*!< uri to the timestamp of its last write */
+    uint64_t _next_id;
+    uint64_t _timestamp;
+    uint64_t _bulk_writes;
+    std::map<std::string, std::vector<std::string> > _patches;
+
+    typedef std::map<std::string, std::pair<bool, std::string> > staged_t; /*!< uri to (deleted, body) */
+    std::map<std::string, staged_t> _transactions;
+    std::map<std::string, std::string> _graphs;
+    uint64_t _graph_requests;
+    uint64_t _next_txid;
+    std::string _host_id;
+
+    std::atomic<uint64_t> _requests;
+    std::atomic<uint64_t> _challenges;
+    std::atomic<uint64_t> _affinity_misses;
+
+    StubServer(const StubServer& orig);
+    StubServer& operator=(const StubServer& orig);
+
+    typedef std::map<std::string, std::string> query_t;
+    typedef void (StubServer::*handler_t)(web::http::http_request& request,
+                                          const std::string& path, query_t& query);
+
+    ///
+    /// Sends requests for a path, or for every path under it, to a handler.
+    ///
+    struct Route {
+        const char* path;   /*!< The path, "/v1/search" */
+        bool        prefix; /*!< Whether paths under it match too */
+        handler_t   handle; /*!< The handler */
+    };
+    static const Route ROUTES[];
+    static const std::string BOUNDARY;
+
+    void Handle(web::http::http_request request);
+    bool Authorized(const web::http::http_request& request) const;
+
+    ///
+    /// /v1/documents: GET, PUT, POST, PATCH and DELETE against the store.
+    /// URIs ending in ".xml" are served as application/xml.  A GET with
+    /// several uri parameters or "Accept: multipart/mixed" is a bulk read,
+    /// and a POST with a multipart/mixed body a multi-document write.  PATCH
+    /// records the patch without applying it.  Requests carrying a txid are
+    /// staged in their transaction.
+    ///
+    void HandleDocuments(web::http::http_request& request, const std::string& path,
+                         query_t& query);
+    void HandleBulkWrite(web::http::http_request& request);
+    void HandleBulkRead(web::http::http_request& request,
+                        const std::vector<std::string>& uris, const std::string& category);
+
+    ///
+    /// /v1/search: pages of the stored URIs in the usual search response
+    /// shape, as XML with format=xml.  forest-name limits a search to one
+    /// forest, and a structured range-query on last-modified with a GE value
+    /// to the documents written at or after that time.  Responses carry
+    /// ML-Effective-Timestamp and a Date from the stub's clock; the
+    /// timestamp parameter is accepted but old versions are not kept.
+    ///
+    void HandleSearch(web::http::http_request& request, const std::string& path,
+                      query_t& query);
+
+    ///
+    /// /v1/transactions: POST starts a transaction whose document writes are
+    /// staged until it is committed or rolled back.
+    ///
+    void HandleTransactions(web::http::http_request& request, const std::string& path,
+                            query_t& query);
+    void HandleTransactionalDocuments(web::http::http_request& request, query_t& query);
+
+    ///
+    /// /v1/graphs: POST appends the body to the named graph; POST
+    /// /v1/graphs/sparql answers ASK with true and anything else with a row
+    /// per stored line of N-Triples.
+    ///
+    void HandleGraphs(web::http::http_request& request, const std::string& path,
+                      query_t& query);
+
+    ///
+    /// /v1/values/{name}: pages through the stored URIs, as a URI lexicon
+    /// would, or through (uri, size) tuples when the name ends in "-tuples".
+    ///
+    void HandleValues(web::http::http_request& request, const std::string& path,
+                      query_t& query);
+
+    ///
+    /// /v1/eval: answers "cts:uris()" or "cts.uris()" with the stored URIs
+    /// and any other code with its external variables, one item each.
+    /// /v1/invoke does the same for the module "/echo.sjs" only.
+    ///
+    void HandleEval(web::http::http_request& request, const std::string& path,
+                    query_t& query);
+
+    ///
+    /// /v1/resources/{name}: GET returns an item per rs: parameter, and POST
+    /// and PUT echo the body.
+    ///
+    void HandleResources(web::http::http_request& request, const std::string& path,
+                         query_t& query);
+
+    static size_t QueryNumber(query_t& query, const std::string& key, const size_t& fallback);
+    static void AddItem(std::string& body, const std::string& content_type,
+                        const std::string& primitive, const std::string& content);
+    static void ReplyError(web::http::http_request& request,
+                           const web::http::status_code& status, const std::string& code,
+                           const std::string& message);
+public:
+    ///
+    /// Constructor
+    ///
+    /// \param config The settings
+    ///
+    explicit StubServer(const StubServerConfig& config);
+    ~StubServer();
+
+    ///
+    /// Starts listening.
+    ///
+    void Start(void);
+
+    ///
+    /// Stops listening.
+    ///
+    void Stop(void);
+
+    ///
+    /// Returns the base URL to hand to the proxy.
+    ///
+    /// \return The address
+    ///
+    std::string Address(void) const;
+
+    ///
+    /// Stores count JSON documents of the configured size under
+    /// /bench/<n>.json.
+    ///
+    /// \param count The number of documents
+    ///
+    void Seed(const size_t& count);
+
+    ///
+    /// Stores a document, as a PUT would.
+    ///
+    /// \param uri The document URI
+    /// \param body The document
+    ///
+    void Store(const std::string& uri, const std::string& body);
+
+    ///
+    /// Returns the number of documents in the store.
+    ///
+    /// \return The count
+    ///
+    size_t DocumentCount(void) const;
+
+    ///
+    /// Returns the number of requests handled, including challenges.
+    ///
+    /// \return The count
+    ///
+    uint64_t Requests(void) const;
+
+    ///
+    /// Returns the number of 401 challenges sent.
+    ///
+    /// \return The count
+    ///
+    uint64_t Challenges(void) const;
+
+    ///
+    /// Returns the number of transaction requests that did not send the
+    /// HostId cookie.
+    ///
+    /// \return The count
+    ///
+    uint64_t AffinityMisses(void) const;
+
+    ///
+    /// Returns the number of transactions neither committed nor abandoned.
+    ///
+    /// \return The count
+    ///
+    size_t OpenTransactions(void) const;
+
+    ///
+    /// Returns everything loaded into a graph.
+    ///
+    /// \param graph The graph URI, empty for the default graph
+    /// \return The concatenated request bodies
+    ///
+    std::string Graph(const std::string& graph) const;
+
+    ///
+    /// Returns the number of multi-document writes.
+    ///
+    /// \return The count
+    ///
+    uint64_t BulkWrites(void) const;
+
+    ///
+    /// Returns the patches received for a document, in order.
+    ///
+    /// \param uri The document URI, with "#metadata" appended for patches
+    ///        to its metadata
+    /// \return The patch bodies
+    ///
+    std::vector<std::string> Patches(const std::string& uri) const;
+
+    ///
+    /// Returns the metadata last written for a document in a multi-document
+    /// write.
+    ///
+    /// \param uri The document URI
+    /// \return The metadata JSON, empty if there is none
+    ///
+    std::string Metadata(const std::string& uri) const;
+
+    ///
+    /// Returns the number of POST /v1/graphs requests.
+    ///
+    /// \return The count
+    ///
+    uint64_t GraphRequests(void) const;
+
+    ///
+    /// Builds a JSON document of roughly the given size.
+    ///
+    /// \param bytes The size
+    /// \return The document
+    ///
+    static std::string MakeDocument(const size_t& bytes);
+
+    ///
+    /// Returns the forest a document is stored in.
+    ///
+    /// \param uri The document URI
+    /// \param forests The number of forests
+    /// \return The forest name ("Forest-0")
+    ///
+    static std::string ForestOf(const std::string& uri, const unsigned& forests);
+
+    ///
+    /// Returns the stub's clock at a timestamp, one second per timestamp
+    /// from 2026-10-19T00:00:00Z.
+    ///
+    /// \param timestamp The timestamp
+    /// \param http_date As an HTTP date rather than an xs:dateTime
+    /// \return The time
+    ///
+    static std::string ClockTime(const uint64_t& timestamp, const bool& http_date = false);
+};
+
+#endif	/* STUBSERVER_HPP */
@@ -0,0 +1,103 @@
+/*
+ * File:   StubTransactions.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "StubServer.hpp"
+
+
+using namespace web;
+using namespace web::http;
+
+void StubServer::HandleTransactions(http_request& request, const std::string& path,
+    query_t& query)
+{
+  if (request.method() != methods::POST) {
+    request.reply(status_codes::MethodNotAllowed);
+    return;
+  }
+  request.extract_string().wait();
+
+  if (path == "/v1/transactions") {
+    std::string txid;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      txid = std::to_string(++_next_txid) + "0" + _host_id.substr(0, 4);
+      _transactions[txid];
+    }
+    http_response started(status_codes::SeeOther);
+    started.headers().add("Location", "/v1/transactions/" + txid);
+    started.headers().add("Set-Cookie", "HostId=" + _host_id + "; path=/");
+    request.reply(started);
+    return;
+  }
+
+  std::string txid = path.substr(path.rfind('/') + 1);
+  std::string result = query["result"];
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::map<std::string, staged_t>::iterator transaction = _transactions.find(txid);
+  if (transaction == _transactions.end() || (result != "commit" && result != "rollback")) {
+    request.reply(status_codes::BadRequest);
+    return;
+  }
+  if (result == "commit") {
+    for (auto& staged : transaction->second) {
+      if (staged.second.first) {
+        _documents.erase(staged.first);
+      } else {
+        _documents[staged.first] = staged.second.second;
+        _modified[staged.first] = _timestamp + 1;
+      }
+    }
+    _timestamp++;
+  }
+  _transactions.erase(transaction);
+  request.reply(status_codes::NoContent);
+}
+
+void StubServer::HandleTransactionalDocuments(http_request& request, query_t& query)
+{
+  std::string doc_uri = query["uri"];
+  std::string body;
+  if (request.method() == methods::PUT) {
+    body = request.extract_string().get();
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::map<std::string, staged_t>::iterator transaction = _transactions.find(query["txid"]);
+  if (transaction == _transactions.end()) {
+    request.reply(status_codes::BadRequest);
+    return;
+  }
+  staged_t& staged = transaction->second;
+
+  if (request.method() == methods::GET) {
+    // The transaction sees its own writes first.
+    staged_t::const_iterator pending = staged.find(doc_uri);
+    if (pending != staged.end()) {
+      if (pending->second.first) {
+        request.reply(status_codes::NotFound);
+      } else {
+        request.reply(status_codes::OK, pending->second.second, "application/json");
+      }
+      return;
+    }
+    std::map<std::string, std::string>::const_iterator found = _documents.find(doc_uri);
+    if (found == _documents.end()) {
+      request.reply(status_codes::NotFound);
+    } else {
+      request.reply(status_codes::OK, found->second, "application/json");
+    }
+  } else if (request.method() == methods::PUT) {
+    bool exists = _documents.count(doc_uri) > 0 || (staged.count(doc_uri) > 0 &&
+        !staged[doc_uri].first);
+    staged[doc_uri] = std::make_pair(false, body);
+    request.reply(exists ? status_codes::NoContent : status_codes::Created);
+  } else if (request.method() == methods::DEL) {
+    staged[doc_uri] = std::make_pair(true, std::string());
+    request.reply(status_codes::NoContent);
+  } else {
+    request.reply(status_codes::MethodNotAllowed);
+  }
+}
@@ -0,0 +1,55 @@
+/*
+ * File:   StubValues.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include "StubServer.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace web;
+using namespace web::http;
+
+void StubServer::HandleValues(http_request& request, const std::string& path,
+    query_t& query)
+{
+  std::string name = uri::decode(path.substr(11));
+  if (request.method() == methods::POST) {
+    request.extract_string().wait();
+  }
+
+  size_t start = std::max<size_t>(QueryNumber(query, "start", 1), 1);
+  size_t page_length = QueryNumber(query, "pageLength", 10);
+  bool tuples = name.size() > 7 && name.compare(name.size() - 7, 7, "-tuples") == 0;
+
+  std::ostringstream body;
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (start > _documents.size()) {
+    request.reply(status_codes::NoContent);
+    return;
+  }
+
+  body << "{\"values-response\":{\"name\":\"" << name << "\",\"type\":\""
+       << (tuples ? "tuples" : "xs:string") << "\",\"" << (tuples ? "tuple" : "distinct-value")
+       << "\":[";
+  std::map<std::string, std::string>::const_iterator iter = _documents.begin();
+  for (size_t skip = 1; skip < start; skip++) {
+    iter++;
+  }
+  for (size_t i = 0; i < page_length && iter != _documents.end(); i++, iter++) {
+    if (i > 0) {
+      body << ",";
+    }
+    if (tuples) {
+      body << "{\"frequency\":1,\"distinct-value\":[\"" << iter->first << "\","
+           << iter->second.size() << "]}";
+    } else {
+      body << "{\"frequency\":1,\"_value\":\"" << iter->first << "\"}";
+    }
+  }
+  body << "],\"metrics\":{\"values-resolution-time\":\"PT0.0001S\"}}}";
+
+  request.reply(status_codes::OK, body.str(), "application/json");
+}
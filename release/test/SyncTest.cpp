@@ -0,0 +1,269 @@
+/*
+ * File:   SyncTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "SyncTest.hpp"
+#include "MLCrypto.hpp"
+#include "Sync.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SyncTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8387";
+const std::string SYNC_DIRECTORY = "mlcpptest-sync";
+const std::string MANIFEST = "mlcpptest-sync.manifest";
+const int FILES = 20;
+const std::string MIRROR_DIRECTORY = "mlcpptest-mirror";
+const std::string MARK = "mlcpptest-mirror.mark";
+
+std::string FilePath(const int& i) {
+  return SYNC_DIRECTORY + "/" + std::to_string(i) + ".json";
+}
+
+std::string Uri(const int& i) {
+  return "/sync/" + std::to_string(i) + ".json";
+}
+
+void WriteFile(const std::string& path, const std::string& contents) {
+  std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+  out << contents;
+}
+
+void MakeFiles(void) {
+  mkdir(SYNC_DIRECTORY.c_str(), 0755);
+  for (int i = 0; i < FILES; i++) {
+    WriteFile(FilePath(i), "{\"id\":" + std::to_string(i) + "}");
+  }
+}
+
+void RemoveFiles(void) {
+  for (int i = 0; i < FILES; i++) {
+    std::remove(FilePath(i).c_str());
+  }
+  rmdir(SYNC_DIRECTORY.c_str());
+  std::remove(MANIFEST.c_str());
+}
+
+std::string MirrorPath(const int& i) {
+  return MIRROR_DIRECTORY + "/mirror/" + std::to_string(i) + ".json";
+}
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream in(path.c_str(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void RemoveMirror(void) {
+  for (int i = 0; i < FILES; i++) {
+    std::remove(MirrorPath(i).c_str());
+  }
+  rmdir((MIRROR_DIRECTORY + "/mirror").c_str());
+  rmdir(MIRROR_DIRECTORY.c_str());
+  std::remove(MARK.c_str());
+}
+
+UploadSyncSummary Upload(const Credentials& credentials, const UploadSyncOptions& options) {
+  UploadSync sync(ADDRESS, credentials, options);
+  for (int i = 0; i < FILES; i++) {
+    sync.Add(Uri(i), FilePath(i));
+  }
+  return sync.Run();
+}
+
+}
+
+SyncTest::SyncTest() {
+
+}
+
+SyncTest::SyncTest(const SyncTest& orig) {
+
+}
+
+SyncTest::~SyncTest() {
+
+}
+
+void SyncTest::TestMetadataPath() {
+  std::vector<std::string> uris;
+  uris.push_back("/a b.json");
+  uris.push_back("/c.json");
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/documents?category=metadata-values&format=json"
+      "&uri=%2Fa%20b.json&uri=%2Fc.json"), UploadSync::MetadataPath(uris));
+}
+
+void SyncTest::TestUploadWithManifest() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+  MakeFiles();
+  std::remove(MANIFEST.c_str());
+
+  Credentials credentials(config.username, config.password);
+  UploadSyncOptions options;
+  options.manifest_path = MANIFEST;
+  options.lookup_batch = 8;
+
+  UploadSyncSummary first = Upload(credentials, options);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)FILES, first.uploaded);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)FILES, first.hashed);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)3, first.lookups);
+  CPPUNIT_ASSERT_EQUAL((size_t)FILES, server.DocumentCount());
+  MLCrypto crypto;
+  CPPUNIT_ASSERT_EQUAL("{\"metadataValues\":{\"mlcpp-hash\":\"" + crypto.FastHash("{\"id\":3}") +
+      "\"}}", server.Metadata(Uri(3)));
+
+  // Nothing changed: no file is read and nothing is sent.
+  uint64_t requests = server.Requests();
+  UploadSyncSummary second = Upload(credentials, options);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)FILES, second.unchanged);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, second.uploaded);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, second.hashed);
+  CPPUNIT_ASSERT_EQUAL(requests, server.Requests());
+
+  // One file changed size, so only it is hashed, looked up and sent.
+  WriteFile(FilePath(5), "{\"id\":5,\"changed\":true}");
+  uint64_t writes = server.BulkWrites();
+  UploadSyncSummary third = Upload(credentials, options);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, third.uploaded);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)FILES - 1, third.unchanged);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, third.hashed);
+  CPPUNIT_ASSERT_EQUAL(writes + 1, server.BulkWrites());
+
+  RemoveFiles();
+  server.Stop();
+}
+
+void SyncTest::TestUploadWithoutManifest() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+  MakeFiles();
+
+  // Without a manifest every file is hashed and compared with the hash the
+  // server holds.
+  Credentials credentials(config.username, config.password);
+  UploadSyncOptions options;
+  options.lookup_batch = 100;
+  CPPUNIT_ASSERT_EQUAL((uint64_t)FILES, Upload(credentials, options).uploaded);
+
+  WriteFile(FilePath(0), "{\"id\":\"zero\"}");
+  uint64_t writes = server.BulkWrites();
+  UploadSyncSummary second = Upload(credentials, options);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)FILES, second.hashed);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, second.lookups);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, second.uploaded);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)FILES - 1, second.unchanged);
+  CPPUNIT_ASSERT_EQUAL(writes + 1, server.BulkWrites());
+
+  RemoveFiles();
+  server.Stop();
+}
+
+void SyncTest::TestUploadFailures() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+  MakeFiles();
+  std::remove(MANIFEST.c_str());
+
+  Credentials credentials(config.username, config.password);
+  UploadSyncOptions options;
+  options.manifest_path = MANIFEST;
+  UploadSync sync(ADDRESS, credentials, options);
+  sync.Add(Uri(1), FilePath(1));
+  sync.Add("/sync/missing.json", SYNC_DIRECTORY + "/missing.json");
+  UploadSyncSummary summary = sync.Run();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, summary.uploaded);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1, summary.failed);
+  CPPUNIT_ASSERT_EQUAL(std::string("/sync/missing.json"), summary.failures[0].first);
+
+  WriteFile(MANIFEST, "not a manifest\n");
+  UploadSync corrupt(ADDRESS, credentials, options);
+  corrupt.Add(Uri(1), FilePath(1));
+  CPPUNIT_ASSERT_THROW(corrupt.Run(), SyncException);
+
+  RemoveFiles();
+  server.Stop();
+}
+
+void SyncTest::TestChangedQuery() {
+  CPPUNIT_ASSERT_EQUAL(std::string("2026-10-19T02:12:31Z"),
+      DownloadSync::DateTimeFromHttpDate("Mon, 19 Oct 2026 02:12:31 GMT"));
+  CPPUNIT_ASSERT_EQUAL(std::string("2027-01-05T23:00:09Z"),
+      DownloadSync::DateTimeFromHttpDate("Tue, 05 Jan 2027 23:00:09 GMT"));
+  CPPUNIT_ASSERT(DownloadSync::DateTimeFromHttpDate("Mon, 19 Oct 2026 02:12:31 PST").empty());
+  CPPUNIT_ASSERT(DownloadSync::DateTimeFromHttpDate("Mon, 19 Foo 2026 02:12:31 GMT").empty());
+  CPPUNIT_ASSERT(DownloadSync::DateTimeFromHttpDate("").empty());
+
+  DownloadSyncOptions options;
+  CPPUNIT_ASSERT(DownloadSync::ChangedQuery(options, "").is_null());
+  web::json::value query = DownloadSync::ChangedQuery(options, "2026-10-19T02:12:31Z");
+  web::json::value range = query["range-query"];
+  CPPUNIT_ASSERT_EQUAL(std::string("last-modified"), range["element"]["name"].as_string());
+  CPPUNIT_ASSERT_EQUAL(std::string("properties"), range["fragment-scope"].as_string());
+  CPPUNIT_ASSERT_EQUAL(std::string("GE"), range["range-operator"].as_string());
+  CPPUNIT_ASSERT_EQUAL(std::string("2026-10-19T02:12:31Z"), range["value"][0].as_string());
+
+  options.source = ChangeSource::COLLECTION;
+  options.changed_collection = "changed";
+  query = DownloadSync::ChangedQuery(options, "");
+  CPPUNIT_ASSERT_EQUAL(std::string("changed"), query["collection-query"]["uri"][0].as_string());
+}
+
+void SyncTest::TestDownload() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+  RemoveMirror();
+  for (int i = 0; i < FILES; i++) {
+    server.Store("/mirror/" + std::to_string(i) + ".json", "{\"id\":" + std::to_string(i) + "}");
+  }
+
+  Credentials credentials(config.username, config.password);
+  DownloadSyncOptions options;
+  options.mirror_directory = MIRROR_DIRECTORY;
+  options.state_path = MARK;
+  options.workers = 3;
+  options.batch_size = 4;
+
+  // No mark yet, so everything is downloaded.
+  DownloadSyncSummary first = DownloadSync(ADDRESS, credentials, options).Run();
+  CPPUNIT_ASSERT(first.since.empty());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)FILES, first.downloaded);
+  CPPUNIT_ASSERT_EQUAL(std::string("{\"id\":7}"), ReadFile(MirrorPath(7)));
+  CPPUNIT_ASSERT_EQUAL("# mlcpp download mark 1\n" + first.mark + "\n", ReadFile(MARK));
+
+  DownloadSyncSummary second = DownloadSync(ADDRESS, credentials, options).Run();
+  CPPUNIT_ASSERT_EQUAL(first.mark, second.since);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, second.downloaded);
+
+  server.Store("/mirror/3.json", "{\"id\":3,\"changed\":true}");
+  server.Store("/mirror/12.json", "{\"id\":12,\"changed\":true}");
+  DownloadSyncSummary third = DownloadSync(ADDRESS, credentials, options).Run();
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, third.downloaded);
+  CPPUNIT_ASSERT_EQUAL(std::string("{\"id\":3,\"changed\":true}"), ReadFile(MirrorPath(3)));
+  CPPUNIT_ASSERT(ReadFile(MirrorPath(3) + ".mlexport").empty());
+  CPPUNIT_ASSERT(third.mark > second.mark);
+
+  WriteFile(MARK, "not a mark\n");
+  CPPUNIT_ASSERT_THROW(DownloadSync(ADDRESS, credentials, options).Run(), SyncException);
+
+  RemoveMirror();
+  server.Stop();
+}
@@ -0,0 +1,37 @@
+/*
+ * File:   SyncTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef SYNCTEST_HPP
+#define	SYNCTEST_HPP
+
+class SyncTest : public CppUnit::TestCase {
+public:
+    SyncTest();
+    SyncTest(const SyncTest& orig);
+    virtual ~SyncTest();
+
+    void TestMetadataPath();
+    void TestUploadWithManifest();
+    void TestUploadWithoutManifest();
+    void TestUploadFailures();
+    void TestChangedQuery();
+    void TestDownload();
+private:
+    CPPUNIT_TEST_SUITE(SyncTest);
+    CPPUNIT_TEST(TestMetadataPath);
+    CPPUNIT_TEST(TestUploadWithManifest);
+    CPPUNIT_TEST(TestUploadWithoutManifest);
+    CPPUNIT_TEST(TestUploadFailures);
+    CPPUNIT_TEST(TestChangedQuery);
+    CPPUNIT_TEST(TestDownload);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* SYNCTEST_HPP */
@@ -0,0 +1,102 @@
+/*
+ * File:   TracerTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TracerTest.hpp"
+#include "RingBuffer.hpp"
+#include "Tracer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TracerTest);
+
+TracerTest::TracerTest() {
+}
+
+TracerTest::TracerTest(const TracerTest& orig) {
+}
+
+TracerTest::~TracerTest() {
+}
+
+void TracerTest::TestRingBuffer() {
+  RingBuffer<int> buffer(3);
+  int value = 0;
+
+  CPPUNIT_ASSERT_EQUAL((size_t)4, buffer.Capacity());
+  CPPUNIT_ASSERT(!buffer.TryPop(value));
+
+  for (int i = 0; i < 4; i++) {
+    CPPUNIT_ASSERT(buffer.TryPush(i));
+  }
+  CPPUNIT_ASSERT(!buffer.TryPush(4));
+
+  for (int i = 0; i < 4; i++) {
+    CPPUNIT_ASSERT(buffer.TryPop(value));
+    CPPUNIT_ASSERT_EQUAL(i, value);
+  }
+  CPPUNIT_ASSERT(!buffer.TryPop(value));
+}
+
+void TracerTest::TestRingBufferProducers() {
+  RingBuffer<int> buffer(4096);
+  std::vector<std::thread> producers;
+
+  for (int t = 0; t < 4; t++) {
+    producers.push_back(std::thread([&buffer, t]() {
+      for (int i = 0; i < 1000; i++) {
+        while (!buffer.TryPush(t * 1000 + i)) {
+          ;
+        }
+      }
+    }));
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  std::vector<bool> seen(4000, false);
+  int value = 0;
+  int count = 0;
+  while (buffer.TryPop(value)) {
+    CPPUNIT_ASSERT(!seen[value]);
+    seen[value] = true;
+    count++;
+  }
+  CPPUNIT_ASSERT_EQUAL(4000, count);
+}
+
+void TracerTest::TestChromeExport() {
+#ifdef MLCPLUSPLUS_TRACING
+  const std::string file_path = "mlcpptest-trace.json";
+  CPPUNIT_ASSERT(Tracer::Instance()->Start(file_path, TraceFormat::CHROME));
+
+  {
+    Span outer("batch");
+    RequestTrace trace("GET", "/v1/documents?uri=/document/test.json");
+    trace.Begin(TracePhase::SEND);
+    trace.End(TracePhase::SEND);
+  }
+  Tracer::Instance()->Stop();
+
+  std::ifstream in(file_path.c_str());
+  std::stringstream contents;
+  contents << in.rdbuf();
+  std::string json = contents.str();
+  std::remove(file_path.c_str());
+
+  CPPUNIT_ASSERT(json.find("\"name\":\"batch\"") != std::string::npos);
+  CPPUNIT_ASSERT(json.find("\"name\":\"send\"") != std::string::npos);
+  CPPUNIT_ASSERT(json.find("/v1/documents?uri=/document/test.json") != std::string::npos);
+  CPPUNIT_ASSERT(json[json.find_last_not_of("\n")] == ']');
+#else
+  CPPUNIT_ASSERT(!Tracer::Instance()->Start("mlcpptest-trace.json"));
+  CPPUNIT_ASSERT(!Tracer::Instance()->Active());
+#endif
+}
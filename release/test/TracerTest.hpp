@@ -0,0 +1,31 @@
+/*
+ * File:   TracerTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef TRACERTEST_HPP
+#define	TRACERTEST_HPP
+
+class TracerTest : public CppUnit::TestCase {
+public:
+    TracerTest();
+    TracerTest(const TracerTest& orig);
+    virtual ~TracerTest();
+
+    void TestRingBuffer();
+    void TestRingBufferProducers();
+    void TestChromeExport();
+private:
+    CPPUNIT_TEST_SUITE(TracerTest);
+    CPPUNIT_TEST(TestRingBuffer);
+    CPPUNIT_TEST(TestRingBufferProducers);
+    CPPUNIT_TEST(TestChromeExport);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* TRACERTEST_HPP */
@@ -0,0 +1,119 @@
+/*
+ * File:   TrafficRecorderTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "TrafficRecorderTest.hpp"
+#include "TrafficRecorder.hpp"
+#include "MLCrypto.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TrafficRecorderTest);
+
+namespace {
+
+const std::string LOG_PATH = "mlcpptest-traffic.bin";
+const std::string BODY = "{\"title\":\"Recorded\"}";
+
+void RecordSample(const TrafficBodies& bodies) {
+  CPPUNIT_ASSERT(TrafficRecorder::Instance()->Start(LOG_PATH, bodies));
+
+  header_t headers;
+  headers["Accept"] = "application/json";
+  headers["Authorization"] = "Digest username=\"admin\"";
+  headers["authorization"] = "Basic YWRtaW46YWRtaW4=";
+  {
+    RecordedRequest recorded("GET", "/v1/documents?uri=/a.json", headers);
+    CPPUNIT_ASSERT(recorded.Recording());
+    recorded.Status(ResponseCodes::OK);
+  }
+  {
+    RecordedRequest recorded("PUT", "/v1/documents?uri=/b.json", header_t());
+    recorded.Body(BODY);
+    recorded.Status(ResponseCodes::CREATED);
+  }
+  {
+    RecordedRequest recorded("PUT", "/v1/documents?uri=/c.bin", header_t());
+    recorded.BodyLength(4096);
+    recorded.Status(ResponseCodes::CREATED);
+  }
+
+  CPPUNIT_ASSERT_EQUAL((uint64_t)3, TrafficRecorder::Instance()->Records());
+  TrafficRecorder::Instance()->Stop();
+}
+
+}
+
+TrafficRecorderTest::TrafficRecorderTest() {
+}
+
+TrafficRecorderTest::TrafficRecorderTest(const TrafficRecorderTest& orig) {
+}
+
+TrafficRecorderTest::~TrafficRecorderTest() {
+}
+
+void TrafficRecorderTest::TestInactive() {
+  CPPUNIT_ASSERT(!TrafficRecorder::Instance()->Active());
+  RecordedRequest recorded("GET", "/v1/search", header_t());
+  CPPUNIT_ASSERT(!recorded.Recording());
+}
+
+void TrafficRecorderTest::TestRoundTrip() {
+  RecordSample(TrafficBodies::FULL);
+
+  TrafficReader reader(LOG_PATH);
+  TrafficRecord record;
+  CPPUNIT_ASSERT(reader.Next(record));
+  CPPUNIT_ASSERT_EQUAL(std::string("GET"), record.method);
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/documents?uri=/a.json"), record.path);
+  CPPUNIT_ASSERT_EQUAL((uint16_t)200, record.status);
+  CPPUNIT_ASSERT_EQUAL((size_t)1, record.headers.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("application/json"), record.headers["Accept"]);
+  CPPUNIT_ASSERT(record.body_kind == TrafficBodies::NONE);
+  uint64_t first_offset = record.offset_ns;
+
+  CPPUNIT_ASSERT(reader.Next(record));
+  CPPUNIT_ASSERT_EQUAL(std::string("PUT"), record.method);
+  CPPUNIT_ASSERT_EQUAL((uint16_t)201, record.status);
+  CPPUNIT_ASSERT(record.headers.empty());
+  CPPUNIT_ASSERT(record.body_kind == TrafficBodies::FULL);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)BODY.size(), record.body_length);
+  CPPUNIT_ASSERT_EQUAL(BODY, record.body);
+  CPPUNIT_ASSERT(record.offset_ns >= first_offset);
+
+  // A file's bytes are not kept, only how many there were.
+  CPPUNIT_ASSERT(reader.Next(record));
+  CPPUNIT_ASSERT(record.body_kind == TrafficBodies::NONE);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)4096, record.body_length);
+  CPPUNIT_ASSERT(record.body.empty());
+
+  CPPUNIT_ASSERT(!reader.Next(record));
+  std::remove(LOG_PATH.c_str());
+}
+
+void TrafficRecorderTest::TestHashedBodies() {
+  RecordSample(TrafficBodies::HASH);
+
+  TrafficReader reader(LOG_PATH);
+  TrafficRecord record;
+  CPPUNIT_ASSERT(reader.Next(record));
+  CPPUNIT_ASSERT(reader.Next(record));
+  CPPUNIT_ASSERT(record.body_kind == TrafficBodies::HASH);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)BODY.size(), record.body_length);
+  CPPUNIT_ASSERT_EQUAL(MLCrypto().Md5(BODY), record.body);
+  std::remove(LOG_PATH.c_str());
+}
+
+void TrafficRecorderTest::TestNotALog() {
+  {
+    std::ofstream out(LOG_PATH.c_str());
+    out << "not a traffic log";
+  }
+  CPPUNIT_ASSERT_THROW(TrafficReader reader(LOG_PATH), std::runtime_error);
+  std::remove(LOG_PATH.c_str());
+}
@@ -0,0 +1,33 @@
+/*
+ * File:   TrafficRecorderTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef TRAFFICRECORDERTEST_HPP
+#define	TRAFFICRECORDERTEST_HPP
+
+class TrafficRecorderTest : public CppUnit::TestCase {
+public:
+    TrafficRecorderTest();
+    TrafficRecorderTest(const TrafficRecorderTest& orig);
+    virtual ~TrafficRecorderTest();
+
+    void TestInactive();
+    void TestRoundTrip();
+    void TestHashedBodies();
+    void TestNotALog();
+private:
+    CPPUNIT_TEST_SUITE(TrafficRecorderTest);
+    CPPUNIT_TEST(TestInactive);
+    CPPUNIT_TEST(TestRoundTrip);
+    CPPUNIT_TEST(TestHashedBodies);
+    CPPUNIT_TEST(TestNotALog);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* TRAFFICRECORDERTEST_HPP */
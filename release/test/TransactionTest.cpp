@@ -0,0 +1,125 @@
+/*
+ * File:   TransactionTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <stdexcept>
+#include <string>
+#include "TransactionTest.hpp"
+#include "Transaction.hpp"
+#include "AuthenticatingProxy.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TransactionTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8395";
+
+StubServerConfig Config(void) {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  return config;
+}
+
+web::json::value Order(const int& id) {
+  web::json::value order = web::json::value::object();
+  order["id"] = web::json::value::number(id);
+  return order;
+}
+
+}
+
+TransactionTest::TransactionTest() {
+
+}
+
+TransactionTest::TransactionTest(const TransactionTest& orig) {
+
+}
+
+TransactionTest::~TransactionTest() {
+
+}
+
+void TransactionTest::TestWithTxid() {
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/documents?txid=42"),
+      Transaction::WithTxid("/v1/documents", "42"));
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/documents?uri=/a.json&txid=42"),
+      Transaction::WithTxid("/v1/documents?uri=/a.json", "42"));
+}
+
+void TransactionTest::TestCommit() {
+  StubServerConfig config = Config();
+  StubServer server(config);
+  server.Start();
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+  {
+    Transaction txn(proxy, ADDRESS, "orders", 30);
+    CPPUNIT_ASSERT(txn.Open());
+    CPPUNIT_ASSERT(!txn.Id().empty());
+
+    for (int i = 0; i < 10; i++) {
+      Response response = txn.Put("/v1/documents?uri=/orders/" + std::to_string(i) + ".json",
+          Order(i));
+      CPPUNIT_ASSERT(ResponseCodes::CREATED == response.GetResponseCode());
+    }
+
+    // Visible inside the transaction, not outside it, until the commit.
+    CPPUNIT_ASSERT(ResponseCodes::OK ==
+        txn.Get("/v1/documents?uri=/orders/3.json").GetResponseCode());
+    CPPUNIT_ASSERT(ResponseCodes::NOT_FOUND ==
+        proxy.Get(ADDRESS, "/v1/documents?uri=/orders/3.json").GetResponseCode());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, server.DocumentCount());
+
+    txn.Commit();
+    CPPUNIT_ASSERT(!txn.Open());
+  }
+
+  CPPUNIT_ASSERT_EQUAL((size_t)10, server.DocumentCount());
+  CPPUNIT_ASSERT_EQUAL((size_t)0, server.OpenTransactions());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)0, server.AffinityMisses());
+  server.Stop();
+}
+
+void TransactionTest::TestAbandonOnScopeExit() {
+  StubServerConfig config = Config();
+  StubServer server(config);
+  server.Store("/orders/keep.json", "{}");
+  server.Start();
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+  try {
+    Transaction txn(proxy, ADDRESS);
+    txn.Put("/v1/documents?uri=/orders/new.json", Order(1));
+    txn.Delete("/v1/documents?uri=/orders/keep.json");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, server.OpenTransactions());
+    throw std::runtime_error("failed part way through");
+  } catch (const std::runtime_error&) {
+  }
+
+  CPPUNIT_ASSERT_EQUAL((size_t)0, server.OpenTransactions());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, server.DocumentCount());
+  CPPUNIT_ASSERT(ResponseCodes::OK ==
+      proxy.Get(ADDRESS, "/v1/documents?uri=/orders/keep.json").GetResponseCode());
+  server.Stop();
+}
+
+void TransactionTest::TestClosed() {
+  StubServerConfig config = Config();
+  StubServer server(config);
+  server.Start();
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+  Transaction txn(proxy, ADDRESS);
+  txn.Abandon();
+  CPPUNIT_ASSERT(!txn.Open());
+  CPPUNIT_ASSERT_THROW(txn.Commit(), TransactionException);
+  CPPUNIT_ASSERT_THROW(txn.Get("/v1/documents?uri=/a.json"), TransactionException);
+  server.Stop();
+}
@@ -0,0 +1,33 @@
+/*
+ * File:   TransactionTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef TRANSACTIONTEST_HPP
+#define	TRANSACTIONTEST_HPP
+
+class TransactionTest : public CppUnit::TestCase {
+public:
+    TransactionTest();
+    TransactionTest(const TransactionTest& orig);
+    virtual ~TransactionTest();
+
+    void TestWithTxid();
+    void TestCommit();
+    void TestAbandonOnScopeExit();
+    void TestClosed();
+private:
+    CPPUNIT_TEST_SUITE(TransactionTest);
+    CPPUNIT_TEST(TestWithTxid);
+    CPPUNIT_TEST(TestCommit);
+    CPPUNIT_TEST(TestAbandonOnScopeExit);
+    CPPUNIT_TEST(TestClosed);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* TRANSACTIONTEST_HPP */
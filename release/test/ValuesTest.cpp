@@ -0,0 +1,137 @@
+/*
+ * File:   ValuesTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <string>
+#include <vector>
+#include "ValuesTest.hpp"
+#include "Values.hpp"
+#include "StubServer.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ValuesTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8394";
+
+// Trimmed from a MarkLogic 7 response to POST /v1/values/status?format=json.
+const std::string VALUES =
+    "{\"values-response\":{\"name\":\"status\", \"type\":\"xs:string\", "
+    "\"distinct-value\":[{\"frequency\":12, \"_value\":\"open\"}, "
+    "{\"frequency\":3, \"_value\":\"shipped\"}], "
+    "\"metrics\":{\"values-resolution-time\":\"PT0.00012S\", \"total-time\":\"PT0.0009S\"}}}";
+
+const std::string TUPLES =
+    "{\"values-response\":{\"name\":\"status-customer\", \"type\":\"tuples\", "
+    "\"tuple\":[{\"frequency\":2, \"distinct-value\":[\"open\", 9007199254740993]}, "
+    "{\"frequency\":1, \"distinct-value\":[{\"type\":\"xs:string\", \"_value\":\"shipped\"}, "
+    "{\"type\":\"xs:long\", \"_value\":\"17\"}]}]}}";
+
+}
+
+ValuesTest::ValuesTest() {
+
+}
+
+ValuesTest::ValuesTest(const ValuesTest& orig) {
+
+}
+
+ValuesTest::~ValuesTest() {
+
+}
+
+void ValuesTest::TestParseValues() {
+  ValuesPage page;
+  ValuesPage::Parse(VALUES, page);
+  CPPUNIT_ASSERT_EQUAL(std::string("status"), page.name);
+  CPPUNIT_ASSERT_EQUAL(std::string("xs:string"), page.type);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, page.tuples.size());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)12, page.tuples[0].frequency);
+  CPPUNIT_ASSERT_EQUAL((size_t)1, page.tuples[0].values.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("open"), page.tuples[0].values[0]);
+  CPPUNIT_ASSERT_EQUAL(std::string("shipped"), page.tuples[1].values[0]);
+}
+
+void ValuesTest::TestParseTuples() {
+  ValuesPage page;
+  ValuesPage::Parse(TUPLES, page);
+  CPPUNIT_ASSERT_EQUAL(std::string("tuples"), page.type);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, page.tuples.size());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, page.tuples[0].frequency);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, page.tuples[0].values.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("open"), page.tuples[0].values[0]);
+  CPPUNIT_ASSERT_EQUAL(std::string("9007199254740993"), page.tuples[0].values[1]);
+  CPPUNIT_ASSERT_EQUAL(std::string("shipped"), page.tuples[1].values[0]);
+  CPPUNIT_ASSERT_EQUAL(std::string("17"), page.tuples[1].values[1]);
+}
+
+void ValuesTest::TestQueryPath() {
+  ValuesQuery query("uris");
+  query.OptionsName("reconcile").Timestamp(42);
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/values/uris?format=json&start=1001&pageLength=1000"
+      "&options=reconcile&timestamp=42"), query.Path(1001, 1000));
+}
+
+void ValuesTest::TestScan() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Seed(250);
+  server.Start();
+
+  {
+    ValuesResults uris(ADDRESS, Credentials(config.username, config.password),
+        ValuesQuery("uris").Options(ValuesQuery::UriLexicon("uris")), 25, 4);
+    std::vector<std::string> seen;
+    ValuesTuple tuple;
+    while (uris.Next(tuple)) {
+      CPPUNIT_ASSERT_EQUAL((size_t)1, tuple.values.size());
+      seen.push_back(tuple.values[0]);
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t)250, seen.size());
+    // Pages come back in order whichever worker fetched them.
+    for (size_t i = 1; i < seen.size(); i++) {
+      CPPUNIT_ASSERT(seen[i - 1] < seen[i]);
+    }
+    CPPUNIT_ASSERT(!uris.Next(tuple));
+  }
+
+  {
+    // Stopping part way through must not hang or leak the workers.
+    ValuesResults uris(ADDRESS, Credentials(config.username, config.password),
+        ValuesQuery("uris"), 10, 3);
+    ValuesTuple tuple;
+    CPPUNIT_ASSERT(uris.Next(tuple));
+  }
+
+  server.Stop();
+}
+
+void ValuesTest::TestScanTuples() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  config.document_bytes = 100;
+  StubServer server(config);
+  server.Seed(30);
+  server.Start();
+
+  std::vector<std::pair<std::string, std::string> > properties;
+  properties.push_back(std::make_pair("uri", "xs:string"));
+  properties.push_back(std::make_pair("size", "xs:int"));
+  ValuesResults tuples(ADDRESS, Credentials(config.username, config.password),
+      ValuesQuery("size-tuples").Options(ValuesQuery::CoOccurrence("size-tuples", properties)),
+      10, 2);
+
+  size_t count = 0;
+  ValuesTuple tuple;
+  while (tuples.Next(tuple)) {
+    CPPUNIT_ASSERT_EQUAL((size_t)2, tuple.values.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("100"), tuple.values[1]);
+    count++;
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t)30, count);
+  server.Stop();
+}
@@ -0,0 +1,35 @@
+/*
+ * File:   ValuesTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef VALUESTEST_HPP
+#define	VALUESTEST_HPP
+
+class ValuesTest : public CppUnit::TestCase {
+public:
+    ValuesTest();
+    ValuesTest(const ValuesTest& orig);
+    virtual ~ValuesTest();
+
+    void TestParseValues();
+    void TestParseTuples();
+    void TestQueryPath();
+    void TestScan();
+    void TestScanTuples();
+private:
+    CPPUNIT_TEST_SUITE(ValuesTest);
+    CPPUNIT_TEST(TestParseValues);
+    CPPUNIT_TEST(TestParseTuples);
+    CPPUNIT_TEST(TestQueryPath);
+    CPPUNIT_TEST(TestScan);
+    CPPUNIT_TEST(TestScanTuples);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* VALUESTEST_HPP */
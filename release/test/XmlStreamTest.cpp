@@ -0,0 +1,395 @@
+/*
+ * File:   XmlStreamTest.cpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <libxml/parser.h>
+#include "XmlStreamTest.hpp"
+#include "AuthenticatingProxy.hpp"
+#include "Request.hpp"
+#include "Search.hpp"
+#include "StubServer.hpp"
+#include "XmlStream.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(XmlStreamTest);
+
+namespace {
+
+const std::string ADDRESS = "http://127.0.0.1:8383";
+
+const std::string DOCUMENT =
+    "<?xml version=\"1.0\"?>\n"
+    "<order xmlns=\"http://example.com/orders\" id=\"7\">"
+    "<item sku=\"a-1\">Tea &amp; cake</item>"
+    "<!-- a note -->"
+    "<gift/>"
+    "<note><![CDATA[<fragile>]]></note>"
+    "</order>";
+
+const std::string SEARCH =
+    "<search:response snippet-format=\"snippet\" total=\"1234\" start=\"11\" page-length=\"2\""
+    " xmlns:search=\"http://marklogic.com/appservices/search\">"
+    "<search:result index=\"11\" uri=\"/a.xml\" path=\"fn:doc(&quot;/a.xml&quot;)\""
+    " score=\"12\" confidence=\"0.5\" fitness=\"0.25\" href=\"/v1/documents?uri=%2Fa.xml\""
+    " mimetype=\"application/xml\" format=\"xml\">"
+    "<search:snippet><search:match path=\"/a\">x <search:highlight>cat</search:highlight>"
+    "</search:match></search:snippet></search:result>"
+    "<search:result index=\"12\" uri=\"/b.json\" format=\"json\"/>"
+    "<search:facet name=\"color\"><search:facet-value name=\"red\" count=\"1\">red"
+    "</search:facet-value></search:facet>"
+    "<search:qtext>cat</search:qtext>"
+    "<search:metrics><search:total-time>PT0.01S</search:total-time></search:metrics>"
+    "</search:response>";
+
+}
+
+XmlStreamTest::XmlStreamTest() {
+
+}
+
+XmlStreamTest::XmlStreamTest(const XmlStreamTest& orig) {
+
+}
+
+XmlStreamTest::~XmlStreamTest() {
+
+}
+
+void XmlStreamTest::TestReader() {
+  XmlReader reader(DOCUMENT.data(), DOCUMENT.size());
+
+  CPPUNIT_ASSERT(reader.Next());
+  CPPUNIT_ASSERT(XmlNodeType::ELEMENT == reader.Type());
+  CPPUNIT_ASSERT_EQUAL(std::string("order"), reader.Name());
+  CPPUNIT_ASSERT_EQUAL(std::string("http://example.com/orders"), reader.NamespaceUri());
+  CPPUNIT_ASSERT_EQUAL(std::string("7"), reader.Attribute("id"));
+  CPPUNIT_ASSERT(reader.Attribute("missing").empty());
+  CPPUNIT_ASSERT_EQUAL(0, reader.Depth());
+
+  CPPUNIT_ASSERT(reader.NextElement());
+  CPPUNIT_ASSERT_EQUAL(std::string("item"), reader.Name());
+  CPPUNIT_ASSERT_EQUAL(1, reader.Depth());
+  CPPUNIT_ASSERT_EQUAL(std::string("Tea & cake"), reader.Text());
+  CPPUNIT_ASSERT(reader.Next());
+  CPPUNIT_ASSERT(XmlNodeType::TEXT == reader.Type());
+  CPPUNIT_ASSERT_EQUAL(std::string("Tea & cake"), reader.Value());
+  CPPUNIT_ASSERT(reader.Next());
+  CPPUNIT_ASSERT(XmlNodeType::END_ELEMENT == reader.Type());
+  CPPUNIT_ASSERT(reader.Next());
+  CPPUNIT_ASSERT(XmlNodeType::COMMENT == reader.Type());
+  CPPUNIT_ASSERT_EQUAL(std::string(" a note "), reader.Value());
+
+  CPPUNIT_ASSERT(reader.NextElement());
+  CPPUNIT_ASSERT_EQUAL(std::string("gift"), reader.Name());
+  CPPUNIT_ASSERT(reader.Empty());
+  CPPUNIT_ASSERT(reader.NextElement());
+  CPPUNIT_ASSERT_EQUAL(std::string("note"), reader.Name());
+  CPPUNIT_ASSERT(!reader.Empty());
+  CPPUNIT_ASSERT(reader.Next());
+  CPPUNIT_ASSERT(XmlNodeType::CDATA == reader.Type());
+  CPPUNIT_ASSERT_EQUAL(std::string("<fragile>"), reader.Value());
+
+  CPPUNIT_ASSERT(!reader.NextElement());
+  CPPUNIT_ASSERT(!reader.Next());
+}
+
+void XmlStreamTest::TestSource() {
+  std::string xml = "<list>";
+  for (int i = 0; i < 10000; i++) {
+    xml += "<n>" + std::to_string(i) + "</n>";
+  }
+  xml += "</list>";
+
+  // Handed over seven bytes at a time, so elements and names are split.
+  size_t offset = 0;
+  size_t largest = 0;
+  XmlReader reader([&](char* buffer, const size_t& size) {
+    largest = std::max(largest, size);
+    size_t count = std::min(std::min(size, (size_t)7), xml.size() - offset);
+    std::memcpy(buffer, xml.data() + offset, count);
+    offset += count;
+    return count;
+  });
+  int count = 0;
+  std::string last;
+  while (reader.NextElement()) {
+    if (reader.Name() == "n") {
+      count++;
+      last = reader.Text();
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL(10000, count);
+  CPPUNIT_ASSERT_EQUAL(std::string("9999"), last);
+  CPPUNIT_ASSERT_EQUAL(xml.size(), offset);
+  CPPUNIT_ASSERT(largest < xml.size());
+
+  // A source that fails stops the reader with its message.
+  bool thrown = false;
+  try {
+    XmlReader failing([](char* buffer, const size_t& size) -> size_t {
+      throw std::runtime_error("connection reset");
+    });
+    while (failing.Next()) {
+    }
+  } catch (const XmlParseException& e) {
+    thrown = std::string(e.what()).find("connection reset") != std::string::npos;
+  }
+  CPPUNIT_ASSERT_MESSAGE("A failing source should stop the reader", thrown);
+}
+
+void XmlStreamTest::TestMalformed() {
+  const char* bad[] = { "<a><b></a>", "<a>", "<a x=1/>", "text", "<a></a><b/>" };
+  for (const char* xml : bad) {
+    bool thrown = false;
+    try {
+      XmlReader reader(xml, std::strlen(xml));
+      while (reader.Next()) {
+      }
+    } catch (const XmlParseException& e) {
+      thrown = std::string(e.what()).find("line 1") != std::string::npos;
+    }
+    CPPUNIT_ASSERT_MESSAGE(xml, thrown);
+  }
+
+  // Entities are left alone rather than expanded.
+  const std::string entity = "<!DOCTYPE a [<!ENTITY e SYSTEM \"file:///etc/passwd\">]><a>&e;</a>";
+  XmlReader reader(entity.data(), entity.size());
+  CPPUNIT_ASSERT(reader.NextElement());
+  CPPUNIT_ASSERT(reader.Text().find("root") == std::string::npos);
+}
+
+void XmlStreamTest::TestSubtree() {
+  XmlReader reader(SEARCH.data(), SEARCH.size());
+  CPPUNIT_ASSERT(reader.NextElement());
+  CPPUNIT_ASSERT(reader.NextElement());
+  CPPUNIT_ASSERT_EQUAL(std::string("result"), reader.Name());
+
+  // The copy keeps the namespace declared on the response.
+  xmlDocPtr result = reader.Subtree();
+  xmlNodePtr root = xmlDocGetRootElement(result);
+  CPPUNIT_ASSERT_EQUAL(std::string("result"), std::string((const char*)root->name));
+  CPPUNIT_ASSERT(root->ns != nullptr);
+  CPPUNIT_ASSERT_EQUAL(std::string("http://marklogic.com/appservices/search"),
+      std::string((const char*)root->ns->href));
+  xmlChar* text = xmlNodeGetContent(root);
+  CPPUNIT_ASSERT_EQUAL(std::string("x cat"), std::string((const char*)text));
+  xmlFree(text);
+  xmlFreeDoc(result);
+
+  // Skip goes to the next sibling, which NextElement then returns.
+  CPPUNIT_ASSERT(reader.Skip());
+  CPPUNIT_ASSERT(reader.NextElement());
+  CPPUNIT_ASSERT_EQUAL(std::string("result"), reader.Name());
+  CPPUNIT_ASSERT_EQUAL(std::string("/b.json"), reader.Attribute("uri"));
+  CPPUNIT_ASSERT(reader.Skip());
+  CPPUNIT_ASSERT(reader.NextElement());
+  CPPUNIT_ASSERT_EQUAL(std::string("facet"), reader.Name());
+
+  while (reader.Next() && reader.Type() != XmlNodeType::TEXT) {
+  }
+  CPPUNIT_ASSERT_EQUAL(std::string("red"), reader.Value());
+  bool thrown = false;
+  try {
+    reader.Subtree();
+  } catch (const XmlParseException& e) {
+    thrown = true;
+  }
+  CPPUNIT_ASSERT_MESSAGE("Subtree should need an element", thrown);
+}
+
+void XmlStreamTest::TestWrite() {
+  xmlDocPtr document = xmlReadMemory(DOCUMENT.data(), (int)DOCUMENT.size(), "order.xml",
+      nullptr, 0);
+  std::string text;
+  size_t pieces = 0;
+  XmlOutput::WriteDocument(document, [&](const char* data, const size_t& size) {
+    text.append(data, size);
+    pieces++;
+  });
+  xmlFreeDoc(document);
+  CPPUNIT_ASSERT(pieces > 0);
+  CPPUNIT_ASSERT(text.compare(0, 38, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>") == 0);
+  CPPUNIT_ASSERT(text.find("<item sku=\"a-1\">Tea &amp; cake</item>") != std::string::npos);
+  CPPUNIT_ASSERT_EQUAL(text, PayloadTraits<xmlDocPtr>::Recorded(
+      xmlReadMemory(text.data(), (int)text.size(), "order.xml", nullptr, 0)));
+
+  // Open elements are closed at the end.
+  XmlBodyWriter write = [](xmlTextWriterPtr writer) {
+    xmlTextWriterStartElement(writer, BAD_CAST "orders");
+    xmlTextWriterWriteAttribute(writer, BAD_CAST "count", BAD_CAST "2");
+    xmlTextWriterWriteElement(writer, BAD_CAST "id", BAD_CAST "1 < 2");
+    xmlTextWriterWriteElement(writer, BAD_CAST "id", BAD_CAST "3");
+  };
+  text = PayloadTraits<XmlBodyWriter>::Recorded(write);
+  CPPUNIT_ASSERT(text.find("<orders count=\"2\"><id>1 &lt; 2</id><id>3</id></orders>") !=
+      std::string::npos);
+  XmlReader reader(text.data(), text.size());
+  CPPUNIT_ASSERT(reader.NextElement());
+  CPPUNIT_ASSERT_EQUAL(std::string("orders"), reader.Name());
+  CPPUNIT_ASSERT_EQUAL((int64_t)-1, PayloadTraits<XmlBodyWriter>::Length(write));
+  CPPUNIT_ASSERT(PayloadTraits<XmlBodyWriter>::REPLAYABLE);
+
+  bool thrown = false;
+  try {
+    XmlOutput::WriteBody(write, [](const char* data, const size_t& size) {
+      throw std::runtime_error("closed");
+    });
+  } catch (const XmlWriteException& e) {
+    thrown = std::string(e.what()).find("closed") != std::string::npos;
+  }
+  CPPUNIT_ASSERT_MESSAGE("A failing sink should stop the writer", thrown);
+
+  thrown = false;
+  try {
+    XmlOutput::WriteBody([](xmlTextWriterPtr writer) {
+      throw std::runtime_error("no orders");
+    }, [](const char* data, const size_t& size) { });
+  } catch (const std::runtime_error& e) {
+    thrown = true;
+  }
+  CPPUNIT_ASSERT_MESSAGE("What the writer throws should be passed on", thrown);
+}
+
+void XmlStreamTest::TestSearch() {
+  XmlReader reader(SEARCH.data(), SEARCH.size());
+  XmlSearchReader results(reader);
+  CPPUNIT_ASSERT_EQUAL((uint64_t)1234, results.Total());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)11, results.Start());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, results.PageLength());
+
+  SearchResult result;
+  CPPUNIT_ASSERT(results.Next(result));
+  CPPUNIT_ASSERT_EQUAL((uint64_t)11, result.index);
+  CPPUNIT_ASSERT_EQUAL(std::string("/a.xml"), result.uri);
+  CPPUNIT_ASSERT_EQUAL(std::string("fn:doc(\"/a.xml\")"), result.path);
+  CPPUNIT_ASSERT_EQUAL(std::string("/v1/documents?uri=%2Fa.xml"), result.href);
+  CPPUNIT_ASSERT_EQUAL(std::string("application/xml"), result.mimetype);
+  CPPUNIT_ASSERT_EQUAL(std::string("xml"), result.format);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(12.0, result.score, 0.0);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, result.confidence, 0.0);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.25, result.fitness, 0.0);
+
+  CPPUNIT_ASSERT(results.Next(result));
+  CPPUNIT_ASSERT_EQUAL(std::string("/b.json"), result.uri);
+  CPPUNIT_ASSERT(result.path.empty());
+  CPPUNIT_ASSERT(!results.Next(result));
+  CPPUNIT_ASSERT(!results.Next(result));
+
+  const std::string empty = "<response xmlns=\"http://marklogic.com/appservices/search\""
+      " total=\"0\"/>";
+  XmlReader empty_reader(empty.data(), empty.size());
+  XmlSearchReader none(empty_reader);
+  CPPUNIT_ASSERT(!none.Next(result));
+
+  bool thrown = false;
+  try {
+    XmlReader other(DOCUMENT.data(), DOCUMENT.size());
+    XmlSearchReader wrong(other);
+  } catch (const XmlParseException& e) {
+    thrown = true;
+  }
+  CPPUNIT_ASSERT_MESSAGE("Only a search response should be read", thrown);
+}
+
+void XmlStreamTest::TestResponse() {
+  Response response;
+  response.SetResponseType(ResponseType::XML);
+  response.SetBody(DOCUMENT);
+
+  xmlDocPtr document = response.Xml();
+  CPPUNIT_ASSERT(document != nullptr);
+  CPPUNIT_ASSERT(document == response.Xml());
+  CPPUNIT_ASSERT_EQUAL(std::string("order"),
+      std::string((const char*)xmlDocGetRootElement(document)->name));
+
+  // A copy shares the document; a new body drops it.
+  Response copy = response;
+  CPPUNIT_ASSERT(document == copy.Xml());
+  response.SetBody("<receipt/>");
+  CPPUNIT_ASSERT_EQUAL(std::string("receipt"),
+      std::string((const char*)xmlDocGetRootElement(response.Xml())->name));
+  CPPUNIT_ASSERT_EQUAL(std::string("order"),
+      std::string((const char*)xmlDocGetRootElement(copy.Xml())->name));
+
+  response.SetBody("<unclosed>");
+  CPPUNIT_ASSERT(response.Xml() == nullptr);
+  response.SetResponseType(ResponseType::JSON);
+  response.SetBody(DOCUMENT);
+  CPPUNIT_ASSERT(response.Xml() == nullptr);
+}
+
+void XmlStreamTest::TestServer() {
+  StubServerConfig config;
+  config.address = ADDRESS;
+  StubServer server(config);
+  server.Start();
+
+  AuthenticatingProxy proxy;
+  proxy.AddCredentials(Credentials(config.username, config.password));
+
+  // The document goes through an output buffer, and comes back as a DOM.
+  xmlDocPtr document = xmlReadMemory(DOCUMENT.data(), (int)DOCUMENT.size(), "order.xml",
+      nullptr, 0);
+  Response response = proxy.Put(ADDRESS, "/v1/documents?uri=/order.xml", document);
+  xmlFreeDoc(document);
+  CPPUNIT_ASSERT(ResponseCodes::CREATED == response.GetResponseCode());
+  response = proxy.Get(ADDRESS, "/v1/documents?uri=/order.xml");
+  CPPUNIT_ASSERT(response.Xml() != nullptr);
+  CPPUNIT_ASSERT_EQUAL(std::string("order"),
+      std::string((const char*)xmlDocGetRootElement(response.Xml())->name));
+
+  XmlBodyWriter write = [](xmlTextWriterPtr writer) {
+    xmlTextWriterWriteElement(writer, BAD_CAST "receipt", BAD_CAST "paid");
+  };
+  response = proxy.Send(ADDRESS,
+      Request<XmlBodyWriter>(RequestMethod::PUT, "/v1/documents?uri=/receipt.xml", write));
+  CPPUNIT_ASSERT(ResponseCodes::CREATED == response.GetResponseCode());
+
+  // The search page is read off the wire, one result at a time.
+  std::vector<std::string> uris;
+  uint64_t total = 0;
+  response = proxy.Stream(ADDRESS, Request<NoPayload>(RequestMethod::GET,
+      "/v1/search?format=xml&pageLength=10", NO_PAYLOAD),
+      [&](const Response& head, Concurrency::streams::istream& body) {
+        CPPUNIT_ASSERT(head.GetResponseType() == ResponseType::XML);
+        XmlReader reader(body);
+        XmlSearchReader results(reader);
+        total = results.Total();
+        SearchResult result;
+        while (results.Next(result)) {
+          uris.push_back(result.uri);
+        }
+      });
+  CPPUNIT_ASSERT(ResponseCodes::OK == response.GetResponseCode());
+  CPPUNIT_ASSERT(response.Body().empty());
+  CPPUNIT_ASSERT_EQUAL((uint64_t)2, total);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, uris.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("/order.xml"), uris[0]);
+  CPPUNIT_ASSERT_EQUAL(std::string("/receipt.xml"), uris[1]);
+
+  // What the reader throws comes back to the caller; errors keep their body.
+  bool thrown = false;
+  try {
+    proxy.Stream(ADDRESS, Request<NoPayload>(RequestMethod::GET,
+        "/v1/documents?uri=/receipt.xml", NO_PAYLOAD),
+        [](const Response& head, Concurrency::streams::istream& body) {
+          XmlReader reader(body);
+          XmlSearchReader results(reader);
+        });
+  } catch (const XmlParseException& e) {
+    thrown = true;
+  }
+  CPPUNIT_ASSERT_MESSAGE("The reader's exception should be thrown", thrown);
+  response = proxy.Stream(ADDRESS, Request<NoPayload>(RequestMethod::GET,
+      "/v1/documents?uri=/missing.xml", NO_PAYLOAD),
+      [](const Response& head, Concurrency::streams::istream& body) {
+        CPPUNIT_FAIL("A 404 should not be streamed");
+      });
+  CPPUNIT_ASSERT(ResponseCodes::NOT_FOUND == response.GetResponseCode());
+  server.Stop();
+}
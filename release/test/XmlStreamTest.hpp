@@ -0,0 +1,41 @@
+/*
+ * File:   XmlStreamTest.hpp
+ *
+ * Created on October 19, 2026
+ */
+
+#include <cppunit/Test.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef XMLSTREAMTEST_HPP
+#define	XMLSTREAMTEST_HPP
+
+class XmlStreamTest : public CppUnit::TestCase {
+public:
+    XmlStreamTest();
+    XmlStreamTest(const XmlStreamTest& orig);
+    virtual ~XmlStreamTest();
+
+    void TestReader();
+    void TestSource();
+    void TestMalformed();
+    void TestSubtree();
+    void TestWrite();
+    void TestSearch();
+    void TestResponse();
+    void TestServer();
+private:
+    CPPUNIT_TEST_SUITE(XmlStreamTest);
+    CPPUNIT_TEST(TestReader);
+    CPPUNIT_TEST(TestSource);
+    CPPUNIT_TEST(TestMalformed);
+    CPPUNIT_TEST(TestSubtree);
+    CPPUNIT_TEST(TestWrite);
+    CPPUNIT_TEST(TestSearch);
+    CPPUNIT_TEST(TestResponse);
+    CPPUNIT_TEST(TestServer);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+#endif	/* XMLSTREAMTEST_HPP */
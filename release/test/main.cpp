@@ -27,6 +27,6 @@ int main(int argc, const char * argv[])
     CppUnit::TestRunner::TestRunner runner;
     runner.addTest(CppUnit::TestFactoryRegistry::getRegistry().makeTest());
     runner.run(controller);
-    return 0;
+    return collector.wasSuccessful() ? 0 : 1;
 }
 